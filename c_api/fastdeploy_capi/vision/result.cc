@@ -162,14 +162,16 @@ FD_C_DetectionResult* FD_C_DetectionResultWrapperGetData(
   fd_c_detection_result->masks.data =
       new FD_C_Mask[fd_c_detection_result->masks.size];
   for (size_t i = 0; i < detection_result->masks.size(); i++) {
-    // copy data in mask
-    fd_c_detection_result->masks.data[i].data.size =
-        detection_result->masks[i].data.size();
-    fd_c_detection_result->masks.data[i].data.data =
-        new uint8_t[detection_result->masks[i].data.size()];
-    memcpy(fd_c_detection_result->masks.data[i].data.data,
-           detection_result->masks[i].data.data(),
-           sizeof(uint8_t) * detection_result->masks[i].data.size());
+    // copy data in mask, the RLE mask is decoded to the dense data
+    size_t mask_size = detection_result->masks[i].data.size();
+    if (detection_result->masks[i].is_rle) {
+      mask_size = detection_result->masks[i].shape[0] *
+                  detection_result->masks[i].shape[1];
+    }
+    fd_c_detection_result->masks.data[i].data.size = mask_size;
+    fd_c_detection_result->masks.data[i].data.data = new uint8_t[mask_size];
+    detection_result->masks[i].DecodeTo(
+        fd_c_detection_result->masks.data[i].data.data);
     // copy shape in mask
     fd_c_detection_result->masks.data[i].shape.size =
         detection_result->masks[i].shape.size();
@@ -12,12 +12,52 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #pragma once
+#include <chrono>  // NOLINT
 #include "fastdeploy/core/config.h"
 #include "fastdeploy/utils/utils.h"
 #include "fastdeploy/utils/perf.h"
 #include "fastdeploy/benchmark/option.h"
 #include "fastdeploy/benchmark/results.h"
 
+namespace fastdeploy {
+namespace benchmark {
+
+using StageClock = std::chrono::steady_clock;
+
+// Split the last inference into H2D, backend and D2H by the time points
+// taken in the profile loop macros
+inline void RecordStageTimes(const StageClock::time_point& begin,
+                             const StageClock::time_point& backend_begin,
+                             const StageClock::time_point& backend_end,
+                             BenchmarkResult* result) {
+  auto end = StageClock::now();
+  result->time_of_h2d =
+      std::chrono::duration<double>(backend_begin - begin).count();
+  result->time_of_backend =
+      std::chrono::duration<double>(backend_end - backend_begin).count();
+  result->time_of_d2h =
+      std::chrono::duration<double>(end - backend_end).count();
+}
+
+}  // namespace benchmark
+}  // namespace fastdeploy
+
+// The stage time points are always taken, they're cheap compared with an
+// inference and feed the per-stage latency of FastDeployModel
+#define __RUNTIME_PROFILE_STAGE_BEGIN                                   \
+  auto __p_stage_begin = benchmark::StageClock::now();                  \
+  auto __p_stage_backend_begin = __p_stage_begin;                       \
+  auto __p_stage_backend_end = __p_stage_begin;
+#define __RUNTIME_PROFILE_STAGE_RESTART                                 \
+  __p_stage_begin = benchmark::StageClock::now();
+#define __RUNTIME_PROFILE_STAGE_BACKEND_BEGIN                           \
+  __p_stage_backend_begin = benchmark::StageClock::now();
+#define __RUNTIME_PROFILE_STAGE_BACKEND_END                             \
+  __p_stage_backend_end = benchmark::StageClock::now();
+#define __RUNTIME_PROFILE_STAGE_END(result)                             \
+  benchmark::RecordStageTimes(__p_stage_begin, __p_stage_backend_begin, \
+                              __p_stage_backend_end, &(result));
+
 #ifdef ENABLE_BENCHMARK
   #define __RUNTIME_PROFILE_LOOP_BEGIN(option, base_loop)               \
     int __p_loop = (base_loop);                                         \
@@ -0,0 +1,299 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "fastdeploy/benchmark/latency_histogram.h"
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <vector>
+
+namespace fastdeploy {
+namespace benchmark {
+
+namespace {
+
+// 16 linear sub-buckets in every power of 2
+const int kSubBucketBits = 4;
+const int kSubBuckets = 1 << kSubBucketBits;
+// Latencies beyond 2^32us(~71 minutes) are counted in the last bucket
+const int kMaxBits = 32;
+const int kNumBuckets = (kMaxBits - kSubBucketBits + 1) * kSubBuckets;
+
+int HighestBit(uint64_t value) {
+  int bit = -1;
+  while (value != 0) {
+    value >>= 1;
+    ++bit;
+  }
+  return bit;
+}
+
+void AtomicMax(std::atomic<uint64_t>* target, uint64_t value) {
+  uint64_t current = target->load(std::memory_order_relaxed);
+  while (current < value &&
+         !target->compare_exchange_weak(current, value,
+                                        std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace
+
+std::string Str(const LatencyStage& stage) {
+  switch (stage) {
+    case LatencyStage::PREPROCESS:
+      return "Preprocess";
+    case LatencyStage::RUNTIME:
+      return "Runtime";
+    case LatencyStage::H2D:
+      return "H2D";
+    case LatencyStage::BACKEND:
+      return "Backend";
+    case LatencyStage::D2H:
+      return "D2H";
+    case LatencyStage::POSTPROCESS:
+      return "Postprocess";
+    default:
+      return "Unknown";
+  }
+}
+
+struct LatencyHistogram::Slice {
+  std::atomic<int64_t> epoch{-1};
+  std::atomic<uint64_t> count{0};
+  std::atomic<uint64_t> sum_us{0};
+  std::atomic<uint64_t> max_us{0};
+  std::atomic<uint64_t> buckets[kNumBuckets];
+
+  void Clear() {
+    count.store(0, std::memory_order_relaxed);
+    sum_us.store(0, std::memory_order_relaxed);
+    max_us.store(0, std::memory_order_relaxed);
+    for (int i = 0; i < kNumBuckets; ++i) {
+      buckets[i].store(0, std::memory_order_relaxed);
+    }
+  }
+};
+
+LatencyHistogram::LatencyHistogram(int window_seconds, int num_slices) {
+  num_slices_ = std::max(num_slices, 1);
+  slice_ns_ = std::max<int64_t>(
+      static_cast<int64_t>(std::max(window_seconds, 1)) * 1000000000LL /
+          num_slices_,
+      1);
+  slices_.reset(new Slice[num_slices_]);
+  Reset();
+}
+
+LatencyHistogram::~LatencyHistogram() = default;
+
+int LatencyHistogram::BucketIndex(uint64_t micros) {
+  if (micros < 2 * kSubBuckets) {
+    return static_cast<int>(micros);
+  }
+  int shift = HighestBit(micros) - kSubBucketBits;
+  int index = (shift + 1) * kSubBuckets +
+              static_cast<int>(micros >> shift) - kSubBuckets;
+  return std::min(index, kNumBuckets - 1);
+}
+
+uint64_t LatencyHistogram::BucketUpperBound(int index) {
+  if (index < 2 * kSubBuckets) {
+    return static_cast<uint64_t>(index);
+  }
+  int shift = index / kSubBuckets - 1;
+  uint64_t mantissa = static_cast<uint64_t>(index % kSubBuckets + kSubBuckets);
+  return ((mantissa + 1) << shift) - 1;
+}
+
+int64_t LatencyHistogram::CurrentEpoch() const {
+  int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch())
+                    .count();
+  return now / slice_ns_;
+}
+
+void LatencyHistogram::Record(double seconds) {
+  uint64_t micros =
+      seconds <= 0 ? 0 : static_cast<uint64_t>(seconds * 1000000.0 + 0.5);
+  int64_t epoch = CurrentEpoch();
+  Slice& slice = slices_[epoch % num_slices_];
+  int64_t slice_epoch = slice.epoch.load(std::memory_order_acquire);
+  if (slice_epoch != epoch) {
+    // The slice belongs to an expired period, the thread winning the CAS
+    // clears it. The records racing with the clearing may be dropped, which
+    // is negligible for the statistics.
+    if (slice_epoch < epoch &&
+        slice.epoch.compare_exchange_strong(slice_epoch, epoch,
+                                            std::memory_order_acq_rel)) {
+      slice.Clear();
+    }
+  }
+  slice.buckets[BucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+  slice.count.fetch_add(1, std::memory_order_relaxed);
+  slice.sum_us.fetch_add(micros, std::memory_order_relaxed);
+  AtomicMax(&slice.max_us, micros);
+}
+
+LatencyStats LatencyHistogram::GetStats() const {
+  std::vector<uint64_t> buckets(kNumBuckets, 0);
+  uint64_t count = 0;
+  uint64_t sum_us = 0;
+  uint64_t max_us = 0;
+  int64_t epoch = CurrentEpoch();
+  for (int i = 0; i < num_slices_; ++i) {
+    const Slice& slice = slices_[i];
+    int64_t slice_epoch = slice.epoch.load(std::memory_order_acquire);
+    if (slice_epoch < 0 || slice_epoch <= epoch - num_slices_) {
+      continue;
+    }
+    for (int j = 0; j < kNumBuckets; ++j) {
+      buckets[j] += slice.buckets[j].load(std::memory_order_relaxed);
+    }
+    count += slice.count.load(std::memory_order_relaxed);
+    sum_us += slice.sum_us.load(std::memory_order_relaxed);
+    max_us = std::max(max_us, slice.max_us.load(std::memory_order_relaxed));
+  }
+
+  LatencyStats stats;
+  // The buckets and count are read at slightly different moments, so count
+  // the total from the buckets
+  uint64_t total = 0;
+  for (int j = 0; j < kNumBuckets; ++j) {
+    total += buckets[j];
+  }
+  if (total == 0) {
+    return stats;
+  }
+  stats.count = total;
+  stats.mean = count == 0 ? 0.0 : sum_us / 1000.0 / count;
+  stats.max = max_us / 1000.0;
+  const double quantiles[3] = {0.5, 0.9, 0.99};
+  double* results[3] = {&stats.p50, &stats.p90, &stats.p99};
+  for (int q = 0; q < 3; ++q) {
+    uint64_t rank = static_cast<uint64_t>(quantiles[q] * total + 0.5);
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t accumulated = 0;
+    for (int j = 0; j < kNumBuckets; ++j) {
+      accumulated += buckets[j];
+      if (accumulated >= rank) {
+        uint64_t bound = std::min(BucketUpperBound(j), max_us);
+        *results[q] = bound / 1000.0;
+        break;
+      }
+    }
+  }
+  return stats;
+}
+
+void LatencyHistogram::Reset() {
+  for (int i = 0; i < num_slices_; ++i) {
+    slices_[i].Clear();
+    slices_[i].epoch.store(-1, std::memory_order_release);
+  }
+}
+
+namespace {
+
+// 64 blocks of records in every power of 2 of the record index
+const int kBlockBits = 6;
+const int kBlocksPerPower = 1 << kBlockBits;
+const int kNumCumulativeBlocks = (64 - kBlockBits + 1) * kBlocksPerPower;
+
+int CumulativeBlockIndex(uint64_t record) {
+  if (record < 2 * kBlocksPerPower) {
+    return static_cast<int>(record);
+  }
+  int shift = HighestBit(record) - kBlockBits;
+  return (shift + 1) * kBlocksPerPower + static_cast<int>(record >> shift) -
+         kBlocksPerPower;
+}
+
+// Index of the first record in the block
+uint64_t CumulativeBlockBegin(int index) {
+  if (index < 2 * kBlocksPerPower) {
+    return static_cast<uint64_t>(index);
+  }
+  int shift = index / kBlocksPerPower - 1;
+  return static_cast<uint64_t>(index % kBlocksPerPower + kBlocksPerPower)
+         << shift;
+}
+
+}  // namespace
+
+CumulativeLatency::CumulativeLatency()
+    : blocks_ns_(new std::atomic<uint64_t>[kNumCumulativeBlocks]) {
+  Reset();
+}
+
+CumulativeLatency::~CumulativeLatency() = default;
+
+void CumulativeLatency::Record(double seconds) {
+  uint64_t ns = static_cast<uint64_t>(std::max(seconds, 0.0) * 1e9 + 0.5);
+  uint64_t record = count_.fetch_add(1, std::memory_order_relaxed);
+  blocks_ns_[CumulativeBlockIndex(record)].fetch_add(
+      ns, std::memory_order_relaxed);
+}
+
+CumulativeLatencyStats CumulativeLatency::GetStats() const {
+  CumulativeLatencyStats stats;
+  stats.count = count_.load(std::memory_order_relaxed);
+  stats.warmup_count = stats.count / 5;
+  if (stats.count == 0) {
+    return stats;
+  }
+  int last = CumulativeBlockIndex(stats.count - 1);
+  uint64_t total_ns = 0;
+  uint64_t warmup_ns = 0;
+  double warmup_split = 0.0;
+  for (int i = 0; i <= last; ++i) {
+    uint64_t block_ns = blocks_ns_[i].load(std::memory_order_relaxed);
+    total_ns += block_ns;
+    uint64_t begin = CumulativeBlockBegin(i);
+    if (begin >= stats.warmup_count) {
+      continue;
+    }
+    uint64_t end = i == last ? stats.count : CumulativeBlockBegin(i + 1);
+    if (end <= stats.warmup_count) {
+      warmup_ns += block_ns;
+    } else {
+      warmup_split = static_cast<double>(block_ns) *
+                     (stats.warmup_count - begin) / (end - begin);
+    }
+  }
+  stats.total = total_ns * 1e-9;
+  stats.warmup_time = (warmup_ns + warmup_split) * 1e-9;
+  return stats;
+}
+
+void CumulativeLatency::Reset() {
+  count_.store(0, std::memory_order_relaxed);
+  for (int i = 0; i < kNumCumulativeBlocks; ++i) {
+    blocks_ns_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+StageLatencyRecorder::StageLatencyRecorder(int window_seconds) {
+  for (int i = 0; i < static_cast<int>(LatencyStage::NUM_STAGES); ++i) {
+    histograms_[i].reset(new LatencyHistogram(window_seconds));
+  }
+}
+
+void StageLatencyRecorder::Reset() {
+  for (int i = 0; i < static_cast<int>(LatencyStage::NUM_STAGES); ++i) {
+    histograms_[i]->Reset();
+  }
+  runtime_total_.Reset();
+}
+
+}  // namespace benchmark
+}  // namespace fastdeploy
@@ -0,0 +1,167 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fastdeploy/utils/utils.h"
+
+namespace fastdeploy {
+namespace benchmark {
+
+/*! @brief Stages of a Predict() call
+ */
+enum class LatencyStage {
+  PREPROCESS,   ///< From the beginning of Predict() to the first Infer()
+  RUNTIME,      ///< The whole Infer(), equals to H2D + BACKEND + D2H + overhead
+  H2D,          ///< Copy/bind the inputs to backend
+  BACKEND,      ///< Pure backend inference
+  D2H,          ///< Copy/bind the outputs from backend
+  POSTPROCESS,  ///< From the last Infer() to the end of Predict()
+  NUM_STAGES
+};
+
+FASTDEPLOY_DECL std::string Str(const LatencyStage& stage);
+
+/*! @brief Latency statistics over a sliding window, all the time in milliseconds
+ */
+struct FASTDEPLOY_DECL LatencyStats {
+  uint64_t count = 0;
+  double mean = 0.0;
+  double p50 = 0.0;
+  double p90 = 0.0;
+  double p99 = 0.0;
+  double max = 0.0;
+};
+
+/*! @brief Lock-free latency histogram with fixed memory over a sliding window
+ *
+ * The latencies are counted in log-linear buckets in microseconds(HDR style,
+ * 16 linear sub-buckets per power of 2, so the percentiles are within 1/16
+ * relative error). The window is split into several time slices, a slice is
+ * reset by the first record landing in it after it expires. Records never
+ * take a lock or allocate memory.
+ */
+class FASTDEPLOY_DECL LatencyHistogram {
+ public:
+  /** \brief Create the histogram
+   *
+   * \param[in] window_seconds Length of the sliding window
+   * \param[in] num_slices Number of the time slices the window is split into, the statistics cover the last `num_slices - 1` complete slices and the current one
+   */
+  explicit LatencyHistogram(int window_seconds = 60, int num_slices = 4);
+  ~LatencyHistogram();
+
+  LatencyHistogram(const LatencyHistogram&) = delete;
+  LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+  /// Record a latency in seconds
+  void Record(double seconds);
+
+  /// Get statistics of the latencies in the window
+  LatencyStats GetStats() const;
+
+  /// Drop all the records
+  void Reset();
+
+  /// Index of the bucket of `micros`
+  static int BucketIndex(uint64_t micros);
+  /// Largest value counted in the bucket
+  static uint64_t BucketUpperBound(int index);
+
+ private:
+  struct Slice;
+  int64_t CurrentEpoch() const;
+
+  int64_t slice_ns_;
+  int num_slices_;
+  std::unique_ptr<Slice[]> slices_;
+};
+
+/*! @brief Cumulative latencies since the recording starts, all the time in seconds
+ */
+struct FASTDEPLOY_DECL CumulativeLatencyStats {
+  uint64_t count = 0;
+  double total = 0.0;
+  /// The first 20% of the records are counted as warmup
+  uint64_t warmup_count = 0;
+  double warmup_time = 0.0;
+};
+
+/*! @brief Sum of all the latencies with fixed memory, which tells the warmup time apart
+ *
+ * The latencies are summed in nanoseconds into blocks of consecutive records,
+ * laid out like the buckets of LatencyHistogram: the first 128 records have
+ * their own blocks, after that there are 64 blocks per power of 2 of the
+ * record index. A record only adds to the block of its index, so records
+ * never take a lock, the reader sums the blocks up. The warmup time is exact
+ * for the first 128 records, after that the block containing the end of
+ * warmup(at most 1/64 of the warmup records) is split in proportion.
+ */
+class FASTDEPLOY_DECL CumulativeLatency {
+ public:
+  CumulativeLatency();
+  ~CumulativeLatency();
+
+  CumulativeLatency(const CumulativeLatency&) = delete;
+  CumulativeLatency& operator=(const CumulativeLatency&) = delete;
+
+  /// Record a latency in seconds
+  void Record(double seconds);
+
+  CumulativeLatencyStats GetStats() const;
+
+  /// Drop all the records
+  void Reset();
+
+ private:
+  std::atomic<uint64_t> count_{0};
+  std::unique_ptr<std::atomic<uint64_t>[]> blocks_ns_;
+};
+
+/*! @brief Latency histograms of all the stages of a model, and the cumulative latency of runtime
+ */
+class FASTDEPLOY_DECL StageLatencyRecorder {
+ public:
+  explicit StageLatencyRecorder(int window_seconds = 60);
+
+  void Record(LatencyStage stage, double seconds) {
+    histograms_[static_cast<int>(stage)]->Record(seconds);
+    if (stage == LatencyStage::RUNTIME) {
+      runtime_total_.Record(seconds);
+    }
+  }
+
+  LatencyStats GetStats(LatencyStage stage) const {
+    return histograms_[static_cast<int>(stage)]->GetStats();
+  }
+
+  CumulativeLatencyStats GetRuntimeTotal() const {
+    return runtime_total_.GetStats();
+  }
+
+  void Reset();
+
+ private:
+  CumulativeLatency runtime_total_;
+  std::unique_ptr<LatencyHistogram>
+      histograms_[static_cast<int>(LatencyStage::NUM_STAGES)];
+};
+
+}  // namespace benchmark
+}  // namespace fastdeploy
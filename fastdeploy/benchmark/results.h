@@ -21,6 +21,12 @@ namespace benchmark {
 struct BenchmarkResult {
   ///< Means pure_backend_time+time_of_h2d_d2h(if include_h2d_d2h=true).
   double time_of_runtime = 0.0f; 
+  ///< Time of copying/binding the inputs in the last inference, in seconds.
+  double time_of_h2d = 0.0;
+  ///< Time of the pure backend inference in the last inference, in seconds.
+  double time_of_backend = 0.0;
+  ///< Time of copying/binding the outputs in the last inference, in seconds.
+  double time_of_d2h = 0.0;
 };
 
 } // namespace benchmark
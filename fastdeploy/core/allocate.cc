@@ -17,8 +17,39 @@
 
 #include "fastdeploy/core/allocate.h"
 
+#include <atomic>
+
 namespace fastdeploy {
 
+// Accessed with std::atomic_load/atomic_store, FDTensor reads it from
+// many threads while allocating
+static std::shared_ptr<FDAllocator> default_host_allocator = nullptr;
+
+void SetDefaultHostAllocator(const std::shared_ptr<FDAllocator>& allocator) {
+  std::atomic_store(&default_host_allocator, allocator);
+}
+
+std::shared_ptr<FDAllocator> GetDefaultHostAllocator() {
+  return std::atomic_load(&default_host_allocator);
+}
+
+static thread_local std::shared_ptr<FDAllocator> thread_host_allocator =
+    nullptr;
+
+std::shared_ptr<FDAllocator>
+SetThreadHostAllocator(const std::shared_ptr<FDAllocator>& allocator) {
+  std::shared_ptr<FDAllocator> previous = thread_host_allocator;
+  thread_host_allocator = allocator;
+  return previous;
+}
+
+std::shared_ptr<FDAllocator> GetCurrentHostAllocator() {
+  if (thread_host_allocator != nullptr) {
+    return thread_host_allocator;
+  }
+  return GetDefaultHostAllocator();
+}
+
 bool FDHostAllocator::operator()(void** ptr, size_t size) const {
   *ptr = malloc(size);
   return *ptr != nullptr;
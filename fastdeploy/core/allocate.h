@@ -23,6 +23,64 @@
 
 namespace fastdeploy {
 
+/*! @brief Statistics of the memory managed by a FDAllocator
+ */
+struct FASTDEPLOY_DECL FDAllocatorStats {
+  /// Bytes currently handed out to tensors
+  size_t bytes_in_use = 0;
+  /// The max value `bytes_in_use` has ever reached
+  size_t peak_bytes_in_use = 0;
+  /// Bytes held by the allocator for reuse, not in use and not returned to
+  /// system
+  size_t bytes_cached = 0;
+  /// Number of Allocate() calls
+  size_t num_allocs = 0;
+  /// Number of Allocate() calls served from cached blocks
+  size_t num_hits = 0;
+
+  double HitRate() const {
+    return num_allocs == 0 ? 0.0 : static_cast<double>(num_hits) / num_allocs;
+  }
+};
+
+/*! @brief Interface of the allocator used by FDTensor to manage host memory
+ */
+class FASTDEPLOY_DECL FDAllocator {
+ public:
+  virtual ~FDAllocator() = default;
+  /// Allocate at least `size` bytes, return nullptr if failed
+  virtual void* Allocate(size_t size) = 0;
+  /// Release the memory returned by Allocate()
+  virtual void Free(void* ptr) = 0;
+  /// Usable size of the memory returned by Allocate(), may larger than the
+  /// requested size
+  virtual size_t UsableSize(void* ptr) const = 0;
+  virtual FDAllocatorStats GetStats() const { return FDAllocatorStats(); }
+  virtual std::string Name() const = 0;
+};
+
+/** \brief Set the allocator used by FDTensor to allocate host memory.
+ *
+ * Only affects the tensors allocated after this call, the tensors hold a
+ * reference of the allocator they are allocated from. Set nullptr to go back
+ * to malloc/free.
+ */
+FASTDEPLOY_DECL void
+SetDefaultHostAllocator(const std::shared_ptr<FDAllocator>& allocator);
+
+/// Get the allocator used by FDTensor to allocate host memory, nullptr means
+/// malloc/free
+FASTDEPLOY_DECL std::shared_ptr<FDAllocator> GetDefaultHostAllocator();
+
+/// Set the host allocator of current thread, which takes precedence over the
+/// default host allocator. Return the previous one of current thread.
+FASTDEPLOY_DECL std::shared_ptr<FDAllocator>
+SetThreadHostAllocator(const std::shared_ptr<FDAllocator>& allocator);
+
+/// Get the allocator FDTensor will use in current thread, the allocator of
+/// current thread if set, otherwise the default host allocator
+FASTDEPLOY_DECL std::shared_ptr<FDAllocator> GetCurrentHostAllocator();
+
 class FASTDEPLOY_DECL FDHostAllocator {
  public:
   bool operator()(void** ptr, size_t size) const;
@@ -0,0 +1,234 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "fastdeploy/core/arena_allocator.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace fastdeploy {
+
+struct FDArenaAllocator::Chunk {
+  char* data = nullptr;
+  size_t capacity = 0;
+  size_t offset = 0;
+  size_t live_blocks = 0;
+};
+
+namespace {
+
+// Every block starts with a header, keep it 16 bytes so the returned pointer
+// has the same alignment as malloc
+struct ArenaBlockHeader {
+  FDArenaAllocator::Chunk* chunk;
+  uint64_t size;
+};
+const size_t kHeaderSize = 16;
+const size_t kAlignment = 16;
+static_assert(sizeof(ArenaBlockHeader) <= kHeaderSize,
+              "ArenaBlockHeader must not exceed 16 bytes.");
+
+size_t AlignUp(size_t size) {
+  return (size + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+ArenaBlockHeader* HeaderOf(void* ptr) {
+  return reinterpret_cast<ArenaBlockHeader*>(reinterpret_cast<char*>(ptr) -
+                                             kHeaderSize);
+}
+
+}  // namespace
+
+FDArenaAllocator::FDArenaAllocator(size_t chunk_size)
+    : chunk_size_(AlignUp(chunk_size)) {}
+
+FDArenaAllocator::~FDArenaAllocator() {
+  for (auto& chunk : chunks_) {
+    free(chunk->data);
+    delete chunk;
+  }
+  chunks_.clear();
+}
+
+FDArenaAllocator::Chunk* FDArenaAllocator::NewChunk(size_t size) {
+  char* data = reinterpret_cast<char*>(malloc(size));
+  if (data == nullptr) {
+    return nullptr;
+  }
+  Chunk* chunk = new Chunk();
+  chunk->data = data;
+  chunk->capacity = size;
+  chunks_.push_back(chunk);
+  total_chunk_bytes_ += size;
+  return chunk;
+}
+
+void* FDArenaAllocator::Allocate(size_t size) {
+  size_t block_size = AlignUp(size) + kHeaderSize;
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.num_allocs += 1;
+  Chunk* chunk = nullptr;
+  bool new_chunk = false;
+  if (current_ != nullptr &&
+      current_->offset + block_size <= current_->capacity) {
+    chunk = current_;
+  } else {
+    // Reuse a drained chunk before asking system for a new one
+    for (auto& c : chunks_) {
+      if (c->live_blocks == 0 && c->capacity >= block_size) {
+        c->offset = 0;
+        chunk = c;
+        break;
+      }
+    }
+    if (chunk == nullptr) {
+      chunk = NewChunk(std::max(chunk_size_, block_size));
+      if (chunk == nullptr) {
+        return nullptr;
+      }
+      new_chunk = true;
+    }
+    // Requests larger than a chunk should not replace the current chunk
+    if (block_size <= chunk_size_ || current_ == nullptr) {
+      current_ = chunk;
+    }
+  }
+  if (!new_chunk) {
+    stats_.num_hits += 1;
+  }
+
+  ArenaBlockHeader* header =
+      reinterpret_cast<ArenaBlockHeader*>(chunk->data + chunk->offset);
+  header->chunk = chunk;
+  header->size = block_size - kHeaderSize;
+  chunk->offset += block_size;
+  chunk->live_blocks += 1;
+
+  stats_.bytes_in_use += header->size;
+  stats_.peak_bytes_in_use =
+      std::max(stats_.peak_bytes_in_use, stats_.bytes_in_use);
+  return reinterpret_cast<char*>(header) + kHeaderSize;
+}
+
+void FDArenaAllocator::Free(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  ArenaBlockHeader* header = HeaderOf(ptr);
+  std::lock_guard<std::mutex> lock(mutex_);
+  FDASSERT(header->chunk->live_blocks > 0,
+           "The pointer %p is freed twice or not allocated by "
+           "FDArenaAllocator.",
+           ptr);
+  Chunk* chunk = header->chunk;
+  chunk->live_blocks -= 1;
+  stats_.bytes_in_use -= header->size;
+  if (chunk->live_blocks == 0) {
+    chunk->offset = 0;
+  } else if (reinterpret_cast<char*>(ptr) + header->size ==
+             chunk->data + chunk->offset) {
+    // The last block of the chunk, e.g a temporary tensor of a step
+    chunk->offset = reinterpret_cast<char*>(header) - chunk->data;
+  }
+}
+
+size_t FDArenaAllocator::UsableSize(void* ptr) const {
+  if (ptr == nullptr) {
+    return 0;
+  }
+  return HeaderOf(ptr)->size;
+}
+
+FDAllocatorStats FDArenaAllocator::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  FDAllocatorStats stats = stats_;
+  stats.bytes_cached = total_chunk_bytes_ - stats_.bytes_in_use;
+  return stats;
+}
+
+void FDArenaAllocator::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& chunk : chunks_) {
+    if (chunk->live_blocks == 0) {
+      chunk->offset = 0;
+    }
+  }
+}
+
+void FDArenaAllocator::ReleaseFreeChunks() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<Chunk*> kept;
+  for (auto& chunk : chunks_) {
+    if (chunk->live_blocks == 0) {
+      if (chunk == current_) {
+        current_ = nullptr;
+      }
+      total_chunk_bytes_ -= chunk->capacity;
+      free(chunk->data);
+      delete chunk;
+    } else {
+      kept.push_back(chunk);
+    }
+  }
+  chunks_.swap(kept);
+}
+
+std::shared_ptr<FDArenaAllocator> FDArenaAllocator::ThreadLocalArena(
+    size_t chunk_size) {
+  thread_local std::shared_ptr<FDArenaAllocator> arena = nullptr;
+  if (arena == nullptr) {
+    arena = std::make_shared<FDArenaAllocator>(chunk_size);
+  }
+  return arena;
+}
+
+void MoveOutOfArena(FDTensor* tensor) {
+  if (tensor->host_allocator == nullptr ||
+      dynamic_cast<FDArenaAllocator*>(tensor->host_allocator.get()) ==
+          nullptr) {
+    return;
+  }
+  // The copy is allocated by the current host allocator, which may be the
+  // arena itself inside an ArenaScope
+  auto previous = SetThreadHostAllocator(nullptr);
+  FDTensor moved(*tensor);
+  SetThreadHostAllocator(previous);
+  *tensor = std::move(moved);
+}
+
+void MoveOutOfArena(std::vector<FDTensor>* tensors) {
+  for (auto& tensor : *tensors) {
+    MoveOutOfArena(&tensor);
+  }
+}
+
+ArenaScope::ArenaScope(const std::shared_ptr<FDArenaAllocator>& arena)
+    : arena_(arena) {
+  if (arena_ == nullptr) {
+    return;
+  }
+  previous_ = SetThreadHostAllocator(arena_);
+  outermost_ = (previous_ != arena_);
+}
+
+ArenaScope::~ArenaScope() {
+  if (arena_ == nullptr) {
+    return;
+  }
+  SetThreadHostAllocator(previous_);
+  if (outermost_) {
+    arena_->Reset();
+  }
+}
+
+}  // namespace fastdeploy
@@ -0,0 +1,93 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "fastdeploy/core/allocate.h"
+#include "fastdeploy/core/fd_tensor.h"
+
+namespace fastdeploy {
+
+/*! @brief Bump allocator for the short-lived tensors of one request
+ *
+ * Memory is carved out of large chunks by moving a pointer forward. Every
+ * chunk counts its live blocks, a chunk is rewound once all of its blocks
+ * are freed, and freeing the last block of a chunk moves the pointer back.
+ * The tensors which outlive the request are still valid, but they keep
+ * their chunk from being recycled, so the tensors owned by a model across
+ * the requests should be moved out by MoveOutOfArena().
+ */
+class FASTDEPLOY_DECL FDArenaAllocator : public FDAllocator {
+ public:
+  explicit FDArenaAllocator(size_t chunk_size = 4 * 1024 * 1024);
+  ~FDArenaAllocator();
+
+  void* Allocate(size_t size) override;
+  void Free(void* ptr) override;
+  size_t UsableSize(void* ptr) const override;
+  FDAllocatorStats GetStats() const override;
+  std::string Name() const override { return "FDArenaAllocator"; }
+
+  /// Rewind all the chunks without live blocks, called at the end of request
+  void Reset();
+
+  /// Return the chunks without live blocks to system
+  void ReleaseFreeChunks();
+
+  /// Get the arena of current thread, it's created with `chunk_size` at the
+  /// first call in this thread
+  static std::shared_ptr<FDArenaAllocator> ThreadLocalArena(
+      size_t chunk_size = 4 * 1024 * 1024);
+
+  struct Chunk;
+
+ private:
+  Chunk* NewChunk(size_t size);
+
+  size_t chunk_size_;
+  mutable std::mutex mutex_;
+  std::vector<Chunk*> chunks_;
+  Chunk* current_ = nullptr;
+  size_t total_chunk_bytes_ = 0;
+  FDAllocatorStats stats_;
+};
+
+/*! @brief The FDTensors allocated by current thread draw their host memory
+ * from the arena until the scope exits, and the arena is reset while the
+ * outermost scope of this arena exits. Passing nullptr makes it a no-op.
+ */
+class FASTDEPLOY_DECL ArenaScope {
+ public:
+  explicit ArenaScope(const std::shared_ptr<FDArenaAllocator>& arena);
+  ~ArenaScope();
+
+ private:
+  std::shared_ptr<FDArenaAllocator> arena_;
+  std::shared_ptr<FDAllocator> previous_;
+  bool outermost_ = false;
+};
+
+/** \brief Move the host buffer of the tensor to the default host allocator if it's allocated from an arena, otherwise do nothing
+ *
+ * The tensors kept across the requests, e.g the reused tensors of a model and the caches of a preprocessor, are moved out before the request ends, so they don't keep the chunks of the arena from being rewound.
+ */
+FASTDEPLOY_DECL void MoveOutOfArena(FDTensor* tensor);
+
+/// Call MoveOutOfArena() for every tensor
+FASTDEPLOY_DECL void MoveOutOfArena(std::vector<FDTensor>* tensors);
+
+}  // namespace fastdeploy
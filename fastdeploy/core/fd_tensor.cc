@@ -296,11 +296,37 @@ bool FDTensor::ReallocFn(size_t nbytes) {
                "so this is an unexpected problem happend.");
 #endif
     }
+    if (host_allocator == nullptr && buffer_ == nullptr) {
+      host_allocator = GetCurrentHostAllocator();
+    }
+    if (host_allocator != nullptr) {
+      size_t capacity = host_allocator->UsableSize(buffer_);
+      if (buffer_ != nullptr && nbytes <= capacity) {
+        return true;
+      }
+      void* new_buffer = host_allocator->Allocate(nbytes);
+      if (new_buffer == nullptr) {
+        return false;
+      }
+      // Keep the same behavior with realloc
+      if (buffer_ != nullptr) {
+        std::memcpy(new_buffer, buffer_, capacity);
+        host_allocator->Free(buffer_);
+      }
+      buffer_ = new_buffer;
+      return true;
+    }
     buffer_ = realloc(buffer_, nbytes);
     return buffer_ != nullptr;
   }
 }
 
+void FDTensor::SetHostAllocator(const std::shared_ptr<FDAllocator>& allocator) {
+  FreeFn();
+  host_allocator = allocator;
+  explicit_host_allocator = allocator != nullptr;
+}
+
 void FDTensor::FreeFn() {
   if (external_data_ptr != nullptr) external_data_ptr = nullptr;
   if (buffer_ != nullptr) {
@@ -313,12 +339,17 @@ void FDTensor::FreeFn() {
 #ifdef WITH_GPU
         FDDeviceHostFree()(buffer_);
 #endif
+      } else if (host_allocator != nullptr) {
+        host_allocator->Free(buffer_);
       } else {
         FDHostFree()(buffer_);
       }
     }
     buffer_ = nullptr;
   }
+  if (!explicit_host_allocator) {
+    host_allocator = nullptr;
+  }
 }
 
 // TODO(liqi): no src_device and dst_device
@@ -415,8 +446,11 @@ FDTensor::FDTensor(FDTensor&& other)
       dtype(other.dtype),
       external_data_ptr(other.external_data_ptr),
       device(other.device),
-      device_id(other.device_id) {
+      device_id(other.device_id),
+      host_allocator(std::move(other.host_allocator)),
+      explicit_host_allocator(other.explicit_host_allocator) {
   other.name = "";
+  other.explicit_host_allocator = false;
   // Note(zhoushunjie): Avoid double free.
   other.buffer_ = nullptr;
   other.external_data_ptr = nullptr;
@@ -448,6 +482,9 @@ FDTensor& FDTensor::operator=(FDTensor&& other) {
     FreeFn();
     buffer_ = other.buffer_;
     external_data_ptr = other.external_data_ptr;
+    host_allocator = std::move(other.host_allocator);
+    explicit_host_allocator = other.explicit_host_allocator;
+    other.explicit_host_allocator = false;
 
     shape = std::move(other.shape);
     name = std::move(other.name);
@@ -49,6 +49,15 @@ struct FASTDEPLOY_DECL FDTensor {
   // with cudaMallocHost()
   bool is_pinned_memory = false;
 
+  // The allocator which owns `buffer_` while the data is in host memory.
+  // nullptr means `buffer_` is managed by malloc/free. It's decided by
+  // GetCurrentHostAllocator() when the tensor allocates its first buffer
+  // after FreeFn(), unless it's set by SetHostAllocator().
+  std::shared_ptr<FDAllocator> host_allocator = nullptr;
+  // Whether `host_allocator` is set by SetHostAllocator(), which is kept
+  // when the buffer is freed
+  bool explicit_host_allocator = false;
+
   // if the external data is not on CPU, we use this temporary buffer
   // to transfer data to CPU at some cases we need to visit the
   // other devices' data
@@ -125,6 +134,11 @@ struct FASTDEPLOY_DECL FDTensor {
 
   bool ReallocFn(size_t nbytes);
 
+  // Use a specified allocator to manage the host memory of this tensor,
+  // the current buffer will be released. nullptr goes back to the allocator
+  // decided by GetCurrentHostAllocator()
+  void SetHostAllocator(const std::shared_ptr<FDAllocator>& allocator);
+
   void FreeFn();
 
   FDTensor() {}
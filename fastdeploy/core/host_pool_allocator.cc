@@ -0,0 +1,337 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "fastdeploy/core/host_pool_allocator.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace fastdeploy {
+
+namespace {
+
+// Every block starts with a header, keep it 16 bytes so the returned pointer
+// has the same alignment as malloc
+struct BlockHeader {
+  uint64_t bucket_size;
+  int32_t bucket;
+  uint32_t magic;
+};
+static_assert(sizeof(BlockHeader) == 16, "BlockHeader must be 16 bytes.");
+
+const uint32_t kBlockMagic = 0xFD9001u;
+const int32_t kUnpooledBucket = -1;
+const int kMinShift = 8;  // The smallest bucket is 256 bytes
+const int kSubBuckets = 4;
+
+int FloorLog2(size_t value) {
+  int shift = 0;
+  while (value >>= 1) {
+    ++shift;
+  }
+  return shift;
+}
+
+// Round `size` up to its bucket, 4 buckets for every power of two
+int BucketIndex(size_t size, size_t* bucket_size) {
+  const size_t min_size = static_cast<size_t>(1) << kMinShift;
+  if (size <= min_size) {
+    *bucket_size = min_size;
+    return 0;
+  }
+  int shift = FloorLog2(size - 1);
+  size_t step = static_cast<size_t>(1) << (shift - 2);
+  size_t steps = (size + step - 1) / step;
+  *bucket_size = steps * step;
+  return 1 + (shift - kMinShift) * kSubBuckets + static_cast<int>(steps) - 5;
+}
+
+BlockHeader* HeaderOf(void* ptr) {
+  BlockHeader* header = reinterpret_cast<BlockHeader*>(
+      reinterpret_cast<char*>(ptr) - sizeof(BlockHeader));
+  FDASSERT(header->magic == kBlockMagic,
+           "The pointer %p is not allocated by FDHostPoolAllocator.", ptr);
+  return header;
+}
+
+void* UserPtrOf(BlockHeader* header) {
+  return reinterpret_cast<char*>(header) + sizeof(BlockHeader);
+}
+
+BlockHeader* NewBlock(size_t bucket_size, int32_t bucket) {
+  BlockHeader* header = reinterpret_cast<BlockHeader*>(
+      malloc(bucket_size + sizeof(BlockHeader)));
+  if (header == nullptr) {
+    return nullptr;
+  }
+  header->bucket_size = bucket_size;
+  header->bucket = bucket;
+  header->magic = kBlockMagic;
+  return header;
+}
+
+}  // namespace
+
+struct FDHostPoolAllocator::Central {
+  explicit Central(const HostPoolAllocatorOption& opt) : option(opt) {
+    size_t max_bucket_size = 0;
+    num_buckets = BucketIndex(option.max_pooled_block_size, &max_bucket_size);
+    num_buckets += 1;
+    free_lists.resize(num_buckets);
+  }
+
+  ~Central() { ReleaseFreeLists(); }
+
+  void ReleaseFreeLists() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& list : free_lists) {
+      for (auto& header : list) {
+        bytes_cached -= header->bucket_size;
+        free(header);
+      }
+      list.clear();
+    }
+    central_cached_bytes = 0;
+  }
+
+  // Put the block back to the shared free list, or return it to system
+  // while the cache is full
+  void Recycle(BlockHeader* header) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (central_cached_bytes + header->bucket_size <=
+          option.max_cached_bytes) {
+        central_cached_bytes += header->bucket_size;
+        free_lists[header->bucket].push_back(header);
+        return;
+      }
+    }
+    bytes_cached -= header->bucket_size;
+    free(header);
+  }
+
+  BlockHeader* Fetch(int bucket) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& list = free_lists[bucket];
+    if (list.empty()) {
+      return nullptr;
+    }
+    BlockHeader* header = list.back();
+    list.pop_back();
+    central_cached_bytes -= header->bucket_size;
+    return header;
+  }
+
+  void AddInUse(size_t nbytes) {
+    size_t current = (bytes_in_use += nbytes);
+    size_t peak = peak_bytes_in_use.load();
+    while (current > peak &&
+           !peak_bytes_in_use.compare_exchange_weak(peak, current)) {
+    }
+  }
+
+  HostPoolAllocatorOption option;
+  int num_buckets = 0;
+
+  std::mutex mutex;
+  std::vector<std::vector<BlockHeader*>> free_lists;
+  size_t central_cached_bytes = 0;
+
+  std::atomic<size_t> bytes_in_use{0};
+  std::atomic<size_t> peak_bytes_in_use{0};
+  std::atomic<size_t> bytes_cached{0};
+  std::atomic<size_t> num_allocs{0};
+  std::atomic<size_t> num_hits{0};
+};
+
+namespace {
+
+// Blocks cached by one thread for one allocator. The allocator may be
+// destroyed before the thread exits, so it's only referenced weakly.
+struct ThreadCache {
+  explicit ThreadCache(const std::shared_ptr<FDHostPoolAllocator::Central>& central)
+      : owner(central), key(central.get()) {
+    lists.resize(central->num_buckets);
+  }
+
+  ~ThreadCache() { Flush(); }
+
+  void Flush() {
+    auto central = owner.lock();
+    for (auto& list : lists) {
+      for (auto& header : list) {
+        if (central != nullptr) {
+          central->Recycle(header);
+        } else {
+          free(header);
+        }
+      }
+      list.clear();
+    }
+  }
+
+  std::weak_ptr<FDHostPoolAllocator::Central> owner;
+  const FDHostPoolAllocator::Central* key;
+  std::vector<std::vector<BlockHeader*>> lists;
+};
+
+ThreadCache* GetThreadCache(
+    const std::shared_ptr<FDHostPoolAllocator::Central>& central) {
+  thread_local std::vector<std::unique_ptr<ThreadCache>> caches;
+  for (size_t i = 0; i < caches.size(); ++i) {
+    if (caches[i]->owner.expired()) {
+      // The allocator is released, and its address may be reused by a new one
+      caches[i]->Flush();
+      caches.erase(caches.begin() + i);
+      --i;
+      continue;
+    }
+    if (caches[i]->key == central.get()) {
+      return caches[i].get();
+    }
+  }
+  caches.emplace_back(new ThreadCache(central));
+  return caches.back().get();
+}
+
+}  // namespace
+
+FDHostPoolAllocator::FDHostPoolAllocator(
+    const HostPoolAllocatorOption& option) {
+  central_ = std::make_shared<Central>(option);
+}
+
+FDHostPoolAllocator::~FDHostPoolAllocator() {}
+
+void* FDHostPoolAllocator::Allocate(size_t size) {
+  if (size == 0) {
+    size = 1;
+  }
+  central_->num_allocs += 1;
+  if (size > central_->option.max_pooled_block_size) {
+    BlockHeader* header = NewBlock(size, kUnpooledBucket);
+    if (header == nullptr) {
+      return nullptr;
+    }
+    central_->AddInUse(size);
+    return UserPtrOf(header);
+  }
+
+  size_t bucket_size = 0;
+  int bucket = BucketIndex(size, &bucket_size);
+  BlockHeader* header = nullptr;
+  ThreadCache* cache = GetThreadCache(central_);
+  auto& list = cache->lists[bucket];
+  if (!list.empty()) {
+    header = list.back();
+    list.pop_back();
+  } else {
+    header = central_->Fetch(bucket);
+  }
+  if (header != nullptr) {
+    central_->num_hits += 1;
+    central_->bytes_cached -= bucket_size;
+  } else {
+    header = NewBlock(bucket_size, bucket);
+    if (header == nullptr) {
+      return nullptr;
+    }
+  }
+  central_->AddInUse(bucket_size);
+  return UserPtrOf(header);
+}
+
+void FDHostPoolAllocator::Free(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  BlockHeader* header = HeaderOf(ptr);
+  central_->bytes_in_use -= header->bucket_size;
+  if (header->bucket == kUnpooledBucket) {
+    free(header);
+    return;
+  }
+  central_->bytes_cached += header->bucket_size;
+  ThreadCache* cache = GetThreadCache(central_);
+  auto& list = cache->lists[header->bucket];
+  if (static_cast<int>(list.size()) < central_->option.max_thread_cached_blocks) {
+    list.push_back(header);
+    return;
+  }
+  central_->Recycle(header);
+}
+
+size_t FDHostPoolAllocator::UsableSize(void* ptr) const {
+  if (ptr == nullptr) {
+    return 0;
+  }
+  return HeaderOf(ptr)->bucket_size;
+}
+
+FDAllocatorStats FDHostPoolAllocator::GetStats() const {
+  FDAllocatorStats stats;
+  stats.bytes_in_use = central_->bytes_in_use.load();
+  stats.peak_bytes_in_use = central_->peak_bytes_in_use.load();
+  stats.bytes_cached = central_->bytes_cached.load();
+  stats.num_allocs = central_->num_allocs.load();
+  stats.num_hits = central_->num_hits.load();
+  return stats;
+}
+
+void FDHostPoolAllocator::ReleaseCachedMemory() {
+  GetThreadCache(central_)->Flush();
+  central_->ReleaseFreeLists();
+}
+
+// The pool installed by EnableHostMemoryPool(), only this one is touched by
+// DisableHostMemoryPool(), the allocators set by SetDefaultHostAllocator()
+// are left as they are
+static std::mutex host_memory_pool_mutex;
+static std::shared_ptr<FDHostPoolAllocator> host_memory_pool = nullptr;
+
+static std::shared_ptr<FDHostPoolAllocator> GetInstalledHostMemoryPool() {
+  if (host_memory_pool != nullptr &&
+      GetDefaultHostAllocator() != host_memory_pool) {
+    host_memory_pool.reset();
+  }
+  return host_memory_pool;
+}
+
+void EnableHostMemoryPool(const HostPoolAllocatorOption& option) {
+  std::lock_guard<std::mutex> lock(host_memory_pool_mutex);
+  host_memory_pool = std::make_shared<FDHostPoolAllocator>(option);
+  SetDefaultHostAllocator(host_memory_pool);
+  FDINFO << "Host memory pool is enabled, max cached bytes: "
+         << option.max_cached_bytes << "." << std::endl;
+}
+
+void DisableHostMemoryPool() {
+  std::lock_guard<std::mutex> lock(host_memory_pool_mutex);
+  if (GetInstalledHostMemoryPool() != nullptr) {
+    SetDefaultHostAllocator(nullptr);
+    host_memory_pool.reset();
+  }
+}
+
+FDAllocatorStats GetHostMemoryPoolStats() {
+  std::lock_guard<std::mutex> lock(host_memory_pool_mutex);
+  auto pool = GetInstalledHostMemoryPool();
+  if (pool == nullptr) {
+    return FDAllocatorStats();
+  }
+  return pool->GetStats();
+}
+
+}  // namespace fastdeploy
@@ -0,0 +1,77 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <memory>
+
+#include "fastdeploy/core/allocate.h"
+
+namespace fastdeploy {
+
+/*! @brief Option to configure FDHostPoolAllocator
+ */
+struct FASTDEPLOY_DECL HostPoolAllocatorOption {
+  /// Max bytes kept in the shared free lists, blocks beyond this limit are
+  /// returned to system
+  size_t max_cached_bytes = 1024UL * 1024UL * 1024UL;
+  /// Max blocks of each size bucket kept in the cache of every thread
+  int max_thread_cached_blocks = 4;
+  /// Requests larger than this size bypass the pool and go to malloc/free
+  size_t max_pooled_block_size = 256UL * 1024UL * 1024UL;
+};
+
+/*! @brief Host allocator which caches freed blocks in size buckets
+ *
+ * Sizes are rounded up to 4 buckets per power of two, so a block is at most
+ * 25% larger than requested. Freed blocks are kept in a small per-thread
+ * cache first and then in a shared free list guarded by a mutex, so the
+ * tensors of a steady-state pipeline are served without calling malloc/free.
+ */
+class FASTDEPLOY_DECL FDHostPoolAllocator : public FDAllocator {
+ public:
+  explicit FDHostPoolAllocator(
+      const HostPoolAllocatorOption& option = HostPoolAllocatorOption());
+  ~FDHostPoolAllocator();
+
+  void* Allocate(size_t size) override;
+  void Free(void* ptr) override;
+  size_t UsableSize(void* ptr) const override;
+  FDAllocatorStats GetStats() const override;
+  std::string Name() const override { return "FDHostPoolAllocator"; }
+
+  /// Return all the cached blocks to system
+  void ReleaseCachedMemory();
+
+  struct Central;
+
+ private:
+  std::shared_ptr<Central> central_;
+};
+
+/** \brief Install a FDHostPoolAllocator as the default host allocator of FDTensor
+ *
+ * It's a process level setting shared by all the Runtimes and models in the process. Calling it again replaces the pool by a new one created with `option`, the tensors allocated from the previous pool keep it alive until they are released.
+ *
+ * \param[in] option The option of the pool
+ */
+FASTDEPLOY_DECL void EnableHostMemoryPool(
+    const HostPoolAllocatorOption& option = HostPoolAllocatorOption());
+
+/// Uninstall the pool installed by EnableHostMemoryPool(), the tensors allocated afterwards go back to malloc/free
+FASTDEPLOY_DECL void DisableHostMemoryPool();
+
+/// Get statistics of the pool installed by EnableHostMemoryPool(), all zero if the pool is not enabled
+FASTDEPLOY_DECL FDAllocatorStats GetHostMemoryPoolStats();
+
+}  // namespace fastdeploy
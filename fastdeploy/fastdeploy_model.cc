@@ -13,6 +13,8 @@
 // limitations under the License.
 #include "fastdeploy/fastdeploy_model.h"
 
+#include <algorithm>
+
 #include "fastdeploy/utils/utils.h"
 
 namespace fastdeploy {
@@ -373,24 +375,97 @@ bool FastDeployModel::CreateIpuBackend() {
   return false;
 }
 
+namespace {
+// Innermost PredictScope of current thread
+thread_local void* current_predict_scope = nullptr;
+}  // namespace
+
+FastDeployModel::PredictScope::PredictScope(FastDeployModel* model)
+    : model_(model), parent_(current_predict_scope) {
+  if (!model_->enable_record_time_of_runtime_) {
+    return;
+  }
+  // Predict() may be implemented by BatchPredict() of the same model
+  for (auto scope = static_cast<PredictScope*>(parent_); scope != nullptr;
+       scope = static_cast<PredictScope*>(scope->parent_)) {
+    if (scope->model_ == model_ && scope->active_) {
+      return;
+    }
+  }
+  active_ = true;
+  begin_ = std::chrono::steady_clock::now();
+  current_predict_scope = this;
+}
+
+FastDeployModel::PredictScope::~PredictScope() {
+  if (!active_) {
+    return;
+  }
+  current_predict_scope = parent_;
+  if (num_infers_ == 0 || model_->stage_latency_ == nullptr) {
+    return;
+  }
+  double total = std::chrono::duration<double>(
+                     std::chrono::steady_clock::now() - begin_)
+                     .count();
+  double preprocess =
+      std::chrono::duration<double>(first_infer_begin_ - begin_).count();
+  model_->stage_latency_->Record(benchmark::LatencyStage::PREPROCESS,
+                                 preprocess);
+  model_->stage_latency_->Record(benchmark::LatencyStage::POSTPROCESS,
+                                 total - preprocess - infer_time_);
+}
+
+FastDeployModel::RequestArenaScope::RequestArenaScope(
+    FastDeployModel* model, std::vector<FDTensor>* outputs)
+    : model_(model), outputs_(outputs), arena_scope_(model->RequestArena()) {}
+
+FastDeployModel::RequestArenaScope::~RequestArenaScope() {
+  if (model_->request_arena_chunk_size_ == 0) {
+    return;
+  }
+  MoveOutOfArena(&model_->reused_input_tensors_);
+  MoveOutOfArena(&model_->reused_output_tensors_);
+  if (outputs_ != nullptr) {
+    MoveOutOfArena(outputs_);
+  }
+}
+
 bool FastDeployModel::Infer(std::vector<FDTensor>& input_tensors,
                             std::vector<FDTensor>* output_tensors) {
-  TimeCounter tc;
-  if (enable_record_time_of_runtime_) {
-    tc.Start();
+  RequestArenaScope arena_scope(this, output_tensors);
+  if (!enable_record_time_of_runtime_ || stage_latency_ == nullptr) {
+    return runtime_->Infer(input_tensors, output_tensors);
   }
+  auto begin = std::chrono::steady_clock::now();
   auto ret = runtime_->Infer(input_tensors, output_tensors);
-  if (enable_record_time_of_runtime_) {
-    tc.End();
-    if (time_of_runtime_.size() > 50000) {
-      FDWARNING << "There are already 50000 records of runtime, will force to "
-                    "disable record time of runtime now."
-                << std::endl;
-      enable_record_time_of_runtime_ = false;
+  double duration = std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - begin)
+                        .count();
+  const auto& stage_times = runtime_->GetStageTimes();
+  stage_latency_->Record(benchmark::LatencyStage::RUNTIME, duration);
+  // The backends without the profile macros(e.g RKNPU2) don't split stages
+  if (stage_times.time_of_backend > 0) {
+    stage_latency_->Record(benchmark::LatencyStage::H2D,
+                           stage_times.time_of_h2d);
+    stage_latency_->Record(benchmark::LatencyStage::BACKEND,
+                           stage_times.time_of_backend);
+    stage_latency_->Record(benchmark::LatencyStage::D2H,
+                           stage_times.time_of_d2h);
+  }
+
+  for (auto scope = static_cast<PredictScope*>(current_predict_scope);
+       scope != nullptr; scope = static_cast<PredictScope*>(scope->parent_)) {
+    if (scope->model_ != this || !scope->active_) {
+      continue;
+    }
+    if (scope->num_infers_ == 0) {
+      scope->first_infer_begin_ = begin;
     }
-    time_of_runtime_.push_back(tc.Duration());
+    scope->num_infers_ += 1;
+    scope->infer_time_ += duration;
+    break;
   }
-  
   return ret;
 }
 
@@ -400,41 +475,63 @@ bool FastDeployModel::Infer() {
 
 std::map<std::string, float> FastDeployModel::PrintStatisInfoOfRuntime() {
   std::map<std::string, float> statis_info_of_runtime_dict;
-
-  if (time_of_runtime_.size() < 10) {
+  if (stage_latency_ == nullptr) {
+    FDWARNING << "PrintStatisInfoOfRuntime require the time of runtime is "
+                 "recorded, please call EnableRecordTimeOfRuntime() first."
+              << std::endl;
+    return statis_info_of_runtime_dict;
+  }
+  auto runtime_total = stage_latency_->GetRuntimeTotal();
+  if (runtime_total.count < 10) {
     FDWARNING << "PrintStatisInfoOfRuntime require the runtime ran 10 times at "
                  "least, but now you only ran "
-              << time_of_runtime_.size() << " times." << std::endl;
-  }
-  double warmup_time = 0.0;
-  double remain_time = 0.0;
-  int warmup_iter = time_of_runtime_.size() / 5;
-  for (size_t i = 0; i < time_of_runtime_.size(); ++i) {
-    if (i < warmup_iter) {
-      warmup_time += time_of_runtime_[i];
-    } else {
-      remain_time += time_of_runtime_[i];
-    }
+              << runtime_total.count << " times." << std::endl;
   }
-  double avg_time = remain_time / (time_of_runtime_.size() - warmup_iter);
+  // The keys of the previous version are cumulative since the recording
+  // starts and exclude the warmup, all in seconds
+  double remain_time = runtime_total.total - runtime_total.warmup_time;
+  uint64_t remain_iter = runtime_total.count - runtime_total.warmup_count;
+  double avg_time = remain_iter == 0 ? 0.0 : remain_time / remain_iter;
   std::cout << "============= Runtime Statis Info(" << ModelName()
             << ") =============" << std::endl;
-  std::cout << "Total iterations: " << time_of_runtime_.size() << std::endl;
-  std::cout << "Total time of runtime: " << warmup_time + remain_time << "s."
+  std::cout << "Total iterations: " << runtime_total.count << std::endl;
+  std::cout << "Total time of runtime: " << runtime_total.total << "s."
             << std::endl;
-  std::cout << "Warmup iterations: " << warmup_iter << std::endl;
-  std::cout << "Total time of runtime in warmup step: " << warmup_time << "s."
+  std::cout << "Warmup iterations: " << runtime_total.warmup_count
             << std::endl;
+  std::cout << "Total time of runtime in warmup step: "
+            << runtime_total.warmup_time << "s." << std::endl;
   std::cout << "Average time of runtime exclude warmup step: "
             << avg_time * 1000 << "ms." << std::endl;
-
-  statis_info_of_runtime_dict["total_time"] = warmup_time + remain_time;
-  statis_info_of_runtime_dict["warmup_time"] = warmup_time;
+  statis_info_of_runtime_dict["total_time"] = runtime_total.total;
+  statis_info_of_runtime_dict["warmup_time"] = runtime_total.warmup_time;
   statis_info_of_runtime_dict["remain_time"] = remain_time;
-  statis_info_of_runtime_dict["warmup_iter"] = warmup_iter;
+  statis_info_of_runtime_dict["warmup_iter"] = runtime_total.warmup_count;
   statis_info_of_runtime_dict["avg_time"] = avg_time;
-  statis_info_of_runtime_dict["iterations"] = time_of_runtime_.size();
-  
+  statis_info_of_runtime_dict["iterations"] = runtime_total.count;
+
+  // The stages over the sliding window, in milliseconds
+  auto runtime_stats =
+      stage_latency_->GetStats(benchmark::LatencyStage::RUNTIME);
+  std::cout << "Iterations in the recent window: " << runtime_stats.count
+            << std::endl;
+  std::cout << "Stage\tcount\tmean\tp50\tp90\tp99\tmax(ms)" << std::endl;
+  for (int i = 0; i < static_cast<int>(benchmark::LatencyStage::NUM_STAGES);
+       ++i) {
+    auto stage = static_cast<benchmark::LatencyStage>(i);
+    auto stats = stage_latency_->GetStats(stage);
+    std::string name = benchmark::Str(stage);
+    std::cout << name << "\t" << stats.count << "\t" << stats.mean << "\t"
+              << stats.p50 << "\t" << stats.p90 << "\t" << stats.p99 << "\t"
+              << stats.max << std::endl;
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    statis_info_of_runtime_dict[name + "_mean"] = stats.mean;
+    statis_info_of_runtime_dict[name + "_p50"] = stats.p50;
+    statis_info_of_runtime_dict[name + "_p90"] = stats.p90;
+    statis_info_of_runtime_dict[name + "_p99"] = stats.p99;
+    statis_info_of_runtime_dict[name + "_max"] = stats.max;
+  }
+  statis_info_of_runtime_dict["window_iterations"] = runtime_stats.count;
   return statis_info_of_runtime_dict;
 }
 }  // namespace fastdeploy
@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #pragma once
+#include <chrono>  // NOLINT
+#include "fastdeploy/benchmark/latency_histogram.h"
+#include "fastdeploy/core/arena_allocator.h"
 #include "fastdeploy/runtime.h"
 
 namespace fastdeploy {
@@ -75,7 +78,7 @@ class FASTDEPLOY_DECL FastDeployModel {
     return runtime_initialized_ && initialized;
   }
 
-  /** \brief This is a debug interface, used to record the time of runtime (backend + h2d + d2h)
+  /** \brief Record the latency of every stage(preprocess, h2d, backend, d2h, postprocess) of Predict() in lock-free histograms with fixed memory, the statistics cover a sliding window of the recent 60 seconds. The cloned models share the histograms of the model they're cloned from
    *
    * example code @code
    * auto model = fastdeploy::vision::PPYOLOE("model.pdmodel", "model.pdiparams", "infer_cfg.yml");
@@ -93,8 +96,11 @@ class FASTDEPLOY_DECL FastDeployModel {
    * @endcode After called the `PrintStatisInfoOfRuntime()`, the statistical information of runtime will be printed in the console
    */
   virtual void EnableRecordTimeOfRuntime() {
-    time_of_runtime_.clear();
-    std::vector<double>().swap(time_of_runtime_);
+    if (stage_latency_ == nullptr) {
+      stage_latency_ = std::make_shared<benchmark::StageLatencyRecorder>();
+    } else {
+      stage_latency_->Reset();
+    }
     enable_record_time_of_runtime_ = true;
   }
 
@@ -105,9 +111,18 @@ class FASTDEPLOY_DECL FastDeployModel {
   }
 
   /** \brief Print the statistic information of runtime in the console, see function `EnableRecordTimeOfRuntime()` for more detail
+   *
+   * \return The keys total_time, warmup_time, remain_time, warmup_iter, avg_time and iterations are in seconds and cumulative since the recording starts, the first 20% of the iterations are counted as warmup. The keys `<stage>_mean/_p50/_p90/_p99/_max`(e.g runtime_p99) are in milliseconds over the sliding window of `window_iterations` iterations
   */
   virtual std::map<std::string, float> PrintStatisInfoOfRuntime();
 
+  /** \brief Get the latency statistics(p50/p90/p99/max in milliseconds) of a stage over the sliding window, see function `EnableRecordTimeOfRuntime()` for more detail
+  */
+  virtual benchmark::LatencyStats GetStageLatency(benchmark::LatencyStage stage) {
+    return stage_latency_ == nullptr ? benchmark::LatencyStats()
+                                     : stage_latency_->GetStats(stage);
+  }
+
   /** \brief Check if the `EnableRecordTimeOfRuntime()` method is enabled.
   */
   virtual bool EnabledRecordTimeOfRuntime() {
@@ -126,11 +141,31 @@ class FASTDEPLOY_DECL FastDeployModel {
     std::vector<FDTensor>().swap(reused_output_tensors_);
   }
 
+  /** \brief Draw the host memory of the FDTensors created while predicting from a request-scoped arena, which is recycled in a single reset after each request. Every thread has its own arena, so the cloned models running in different threads don't contend for the allocator
+   *
+   * \param[in] chunk_size Size of the memory chunk the arena carves tensors from
+   */
+  virtual void EnableRequestArena(size_t chunk_size = 4 * 1024 * 1024) {
+    request_arena_chunk_size_ = chunk_size;
+  }
+
+  /** \brief Disable the request-scoped arena, see `EnableRequestArena()` for more detail
+  */
+  virtual void DisableRequestArena() { request_arena_chunk_size_ = 0; }
+
+  /** \brief Get statistics of the request arena of current thread
+  */
+  virtual FDAllocatorStats GetRequestArenaStats() {
+    auto arena = RequestArena();
+    return arena == nullptr ? FDAllocatorStats() : arena->GetStats();
+  }
+
   virtual fastdeploy::Runtime* CloneRuntime() { return runtime_->Clone(); }
 
   virtual bool SetRuntime(fastdeploy::Runtime* clone_runtime) {
     runtime_ = std::unique_ptr<Runtime>(clone_runtime);
-    return true;
+    runtime_initialized_ = runtime_ != nullptr;
+    return runtime_initialized_;
   }
 
   virtual std::unique_ptr<FastDeployModel> Clone() {
@@ -147,6 +182,52 @@ class FASTDEPLOY_DECL FastDeployModel {
   // Reused output tensors
   std::vector<FDTensor> reused_output_tensors_;
 
+  /** \brief Scope of a Predict() call, which records the time before the first Infer() as preprocess and the rest besides Infer() as postprocess while recording time of runtime. Declare it at the beginning of Predict()/BatchPredict(), the nested scopes of the same model are ignored
+   */
+  class FASTDEPLOY_DECL PredictScope {
+   public:
+    explicit PredictScope(FastDeployModel* model);
+    ~PredictScope();
+
+   private:
+    friend class FastDeployModel;
+    FastDeployModel* model_;
+    void* parent_;
+    bool active_ = false;
+    std::chrono::steady_clock::time_point begin_;
+    std::chrono::steady_clock::time_point first_infer_begin_;
+    double infer_time_ = 0.0;
+    int num_infers_ = 0;
+  };
+
+  /** \brief Scope of the request arena, declare it at the beginning of Predict()/BatchPredict() to cover the whole preprocess -> infer -> postprocess lifetime. The reused tensors of the model are moved out of the arena before it's reset, so they don't pin its chunks across the requests
+   */
+  class FASTDEPLOY_DECL RequestArenaScope {
+   public:
+    /** \brief Open the scope, it's a no-op if the request arena is disabled
+     *
+     * \param[in] model The model
+     * \param[in] outputs The tensors returned to the caller besides the reused tensors, which are moved out of the arena as well
+     */
+    explicit RequestArenaScope(FastDeployModel* model,
+                               std::vector<FDTensor>* outputs = nullptr);
+    ~RequestArenaScope();
+
+   private:
+    FastDeployModel* model_;
+    std::vector<FDTensor>* outputs_;
+    ArenaScope arena_scope_;
+  };
+
+  // Arena of current thread if the request arena is enabled, otherwise
+  // nullptr
+  std::shared_ptr<FDArenaAllocator> RequestArena() {
+    if (request_arena_chunk_size_ == 0) {
+      return nullptr;
+    }
+    return FDArenaAllocator::ThreadLocalArena(request_arena_chunk_size_);
+  }
+
  private:
   bool InitRuntimeWithSpecifiedBackend();
   bool InitRuntimeWithSpecifiedDevice();
@@ -165,7 +246,10 @@ class FASTDEPLOY_DECL FastDeployModel {
   bool runtime_initialized_ = false;
   // whether to record inference time
   bool enable_record_time_of_runtime_ = false;
-  std::vector<double> time_of_runtime_;
+  // Shared by the cloned models, so the statistics cover all the instances
+  std::shared_ptr<benchmark::StageLatencyRecorder> stage_latency_;
+  // 0 means the request arena is disabled
+  size_t request_arena_chunk_size_ = 0;
 };
 
 }  // namespace fastdeploy
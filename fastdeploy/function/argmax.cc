@@ -0,0 +1,128 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fastdeploy/function/argmax.h"
+
+// The AVX2 kernel is compiled by the target attribute, so the library
+// doesn't require -mavx2 and still runs on the CPUs without AVX2
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define FD_ARGMAX_AVX2
+#define FD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace fastdeploy {
+namespace function {
+
+namespace {
+
+void RowArgMaxAndMax(const float* row, size_t cols, int32_t* index,
+                     float* value) {
+  size_t best = 0;
+  for (size_t j = 1; j < cols; ++j) {
+    if (row[best] < row[j]) {
+      best = j;
+    }
+  }
+  *index = static_cast<int32_t>(best);
+  *value = row[best];
+}
+
+#ifdef FD_ARGMAX_AVX2
+bool Avx2Enabled() {
+  static const bool enabled = __builtin_cpu_supports("avx2");
+  return enabled;
+}
+
+// Every lane keeps the first max element of the columns j with j % 8 equal
+// to the lane, then the lanes are reduced to the first max element of the
+// row, so the result is the same with std::max_element
+FD_TARGET_AVX2 void RowArgMaxAndMaxAvx2(const float* row, size_t cols,
+                                        int32_t* index, float* value) {
+  __m256 max_values = _mm256_loadu_ps(row);
+  __m256i max_indices = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  __m256i indices = max_indices;
+  const __m256i step = _mm256_set1_epi32(8);
+  size_t simd_end = cols / 8 * 8;
+  for (size_t j = 8; j < simd_end; j += 8) {
+    indices = _mm256_add_epi32(indices, step);
+    __m256 x = _mm256_loadu_ps(row + j);
+    __m256 greater = _mm256_cmp_ps(x, max_values, _CMP_GT_OQ);
+    max_values = _mm256_blendv_ps(max_values, x, greater);
+    max_indices = _mm256_blendv_epi8(max_indices, indices,
+                                     _mm256_castps_si256(greater));
+  }
+  alignas(32) float lane_values[8];
+  alignas(32) int32_t lane_indices[8];
+  _mm256_store_ps(lane_values, max_values);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lane_indices), max_indices);
+  float best_value = lane_values[0];
+  int32_t best_index = lane_indices[0];
+  for (int k = 1; k < 8; ++k) {
+    if (best_value < lane_values[k] ||
+        (best_value == lane_values[k] && lane_indices[k] < best_index)) {
+      best_value = lane_values[k];
+      best_index = lane_indices[k];
+    }
+  }
+  for (size_t j = simd_end; j < cols; ++j) {
+    if (best_value < row[j]) {
+      best_value = row[j];
+      best_index = static_cast<int32_t>(j);
+    }
+  }
+  *index = best_index;
+  *value = best_value;
+}
+#endif
+
+}  // namespace
+
+void ArgMaxAndMax(const float* data, size_t rows, size_t cols,
+                  int32_t* indices, float* values) {
+  FDASSERT(cols > 0, "The number of columns should be > 0.");
+#ifdef FD_ARGMAX_AVX2
+  if (cols >= 8 && Avx2Enabled()) {
+    for (size_t i = 0; i < rows; ++i) {
+      RowArgMaxAndMaxAvx2(data + i * cols, cols, indices + i, values + i);
+    }
+    return;
+  }
+#endif
+  for (size_t i = 0; i < rows; ++i) {
+    RowArgMaxAndMax(data + i * cols, cols, indices + i, values + i);
+  }
+}
+
+void ArgMaxAndMax(const FDTensor& x, FDTensor* indices, FDTensor* values) {
+  FDASSERT(x.dtype == FDDataType::FP32,
+           "ArgMaxAndMax only supports FP32 input, but now it's %s.",
+           Str(x.dtype).c_str());
+  FDASSERT(x.shape.size() > 0, "The input tensor should not be a scalar.");
+  std::vector<int64_t> out_shape(x.shape.begin(), x.shape.end() - 1);
+  size_t cols = static_cast<size_t>(x.shape.back());
+  size_t rows = cols == 0 ? 0 : x.Numel() / cols;
+  indices->Allocate(out_shape, FDDataType::INT32);
+  values->Allocate(out_shape, FDDataType::FP32);
+  if (rows == 0) {
+    return;
+  }
+  ArgMaxAndMax(reinterpret_cast<const float*>(x.Data()), rows, cols,
+               reinterpret_cast<int32_t*>(indices->Data()),
+               reinterpret_cast<float*>(values->Data()));
+}
+
+}  // namespace function
+}  // namespace fastdeploy
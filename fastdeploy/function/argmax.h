@@ -0,0 +1,42 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "fastdeploy/core/fd_tensor.h"
+
+namespace fastdeploy {
+namespace function {
+
+/** \brief Compute the index and the value of the max element of every row in one pass, vectorized by AVX2 if supported
+ *
+ * \param[in] data The rows of `cols` floats
+ * \param[in] rows The number of rows
+ * \param[in] cols The number of floats of a row, should be > 0
+ * \param[out] indices The index of the first max element of every row, same as std::max_element
+ * \param[out] values The value of the max element of every row
+ */
+FASTDEPLOY_DECL void ArgMaxAndMax(const float* data, size_t rows, size_t cols,
+                                  int32_t* indices, float* values);
+
+/** Excute the argmax and max operation for input FDTensor along the last axis in one pass.
+    @param x The input tensor of FP32.
+    @param indices The INT32 indices of the max elements, the shape is the one of x without the last axis.
+    @param values The max elements, the shape is the one of x without the last axis.
+*/
+FASTDEPLOY_DECL void ArgMaxAndMax(const FDTensor& x, FDTensor* indices,
+                                  FDTensor* values);
+
+}  // namespace function
+}  // namespace fastdeploy
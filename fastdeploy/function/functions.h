@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include "fastdeploy/function/argmax.h"
 #include "fastdeploy/function/cast.h"
 #include "fastdeploy/function/clip.h"
 #include "fastdeploy/function/concat.h"
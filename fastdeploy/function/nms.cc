@@ -0,0 +1,409 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fastdeploy/function/nms.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+// The AVX2 kernel is compiled by the target attribute, so the library
+// doesn't require -mavx2 and still runs on the CPUs without AVX2
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define FD_NMS_AVX2
+#define FD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace fastdeploy {
+namespace function {
+
+namespace {
+
+// The IoUs are computed by chunks, so the hard NMS stops soon after the
+// first suppressing box
+const int kIoUChunk = 64;
+
+// The boxes in separated arrays of the coordinates
+struct BoxesSoA {
+  std::vector<float> x1;
+  std::vector<float> y1;
+  std::vector<float> x2;
+  std::vector<float> y2;
+  std::vector<float> area;
+
+  size_t Size() const { return x1.size(); }
+
+  void Reserve(size_t n) {
+    x1.reserve(n);
+    y1.reserve(n);
+    x2.reserve(n);
+    y2.reserve(n);
+    area.reserve(n);
+  }
+
+  void Push(const float* box, float box_area) {
+    x1.push_back(box[0]);
+    y1.push_back(box[1]);
+    x2.push_back(box[2]);
+    y2.push_back(box[3]);
+    area.push_back(box_area);
+  }
+
+  // Move the box at `from` to `to`, to compact the boxes in place
+  void Move(size_t from, size_t to) {
+    x1[to] = x1[from];
+    y1[to] = y1[from];
+    x2[to] = x2[from];
+    y2[to] = y2[from];
+    area[to] = area[from];
+  }
+
+  void Resize(size_t n) {
+    x1.resize(n);
+    y1.resize(n);
+    x2.resize(n);
+    y2.resize(n);
+    area.resize(n);
+  }
+};
+
+// `norm` is 1 for the boxes not normalized, as BBoxArea of Paddle
+float BoxArea(const float* box, float norm) {
+  if (box[2] < box[0] || box[3] < box[1]) {
+    return 0.0f;
+  }
+  return (box[2] - box[0] + norm) * (box[3] - box[1] + norm);
+}
+
+#ifdef FD_NMS_AVX2
+bool Avx2Enabled() {
+  static const bool enabled = __builtin_cpu_supports("avx2");
+  return enabled;
+}
+
+FD_TARGET_AVX2 void ComputeIoUsAvx2(const float* box, float box_area,
+                                    const BoxesSoA& boxes, size_t begin,
+                                    size_t end, float norm, float* ious) {
+  __m256 bx1 = _mm256_set1_ps(box[0]);
+  __m256 by1 = _mm256_set1_ps(box[1]);
+  __m256 bx2 = _mm256_set1_ps(box[2]);
+  __m256 by2 = _mm256_set1_ps(box[3]);
+  __m256 barea = _mm256_set1_ps(box_area);
+  __m256 vnorm = _mm256_set1_ps(norm);
+  __m256 zero = _mm256_setzero_ps();
+  for (size_t j = begin; j < end; j += 8) {
+    __m256 w = _mm256_sub_ps(
+        _mm256_min_ps(bx2, _mm256_loadu_ps(boxes.x2.data() + j)),
+        _mm256_max_ps(bx1, _mm256_loadu_ps(boxes.x1.data() + j)));
+    __m256 h = _mm256_sub_ps(
+        _mm256_min_ps(by2, _mm256_loadu_ps(boxes.y2.data() + j)),
+        _mm256_max_ps(by1, _mm256_loadu_ps(boxes.y1.data() + j)));
+    __m256 valid = _mm256_and_ps(_mm256_cmp_ps(w, zero, _CMP_GE_OQ),
+                                 _mm256_cmp_ps(h, zero, _CMP_GE_OQ));
+    __m256 inter =
+        _mm256_mul_ps(_mm256_add_ps(w, vnorm), _mm256_add_ps(h, vnorm));
+    __m256 iou = _mm256_div_ps(
+        inter, _mm256_sub_ps(
+                   _mm256_add_ps(barea, _mm256_loadu_ps(boxes.area.data() + j)),
+                   inter));
+    _mm256_storeu_ps(ious + j - begin, _mm256_and_ps(iou, valid));
+  }
+}
+#endif
+
+// IoUs of `box` and the boxes [begin, end), same as JaccardOverlap of Paddle
+void ComputeIoUs(const float* box, float box_area, const BoxesSoA& boxes,
+                 size_t begin, size_t end, float norm, float* ious) {
+  size_t j = begin;
+#ifdef FD_NMS_AVX2
+  if (Avx2Enabled()) {
+    size_t simd_end = begin + (end - begin) / 8 * 8;
+    ComputeIoUsAvx2(box, box_area, boxes, begin, simd_end, norm, ious);
+    j = simd_end;
+  }
+#endif
+  for (; j < end; ++j) {
+    float w = std::min(box[2], boxes.x2[j]) - std::max(box[0], boxes.x1[j]);
+    float h = std::min(box[3], boxes.y2[j]) - std::max(box[1], boxes.y1[j]);
+    if (w < 0.0f || h < 0.0f) {
+      ious[j - begin] = 0.0f;
+      continue;
+    }
+    float inter = (w + norm) * (h + norm);
+    ious[j - begin] = inter / (box_area + boxes.area[j] - inter);
+  }
+}
+
+// The boxes with score greater than the threshold in descending order of the
+// scores, the boxes of the same score keep their order
+void SortBoxes(const float* scores, int num_boxes, const NMSParams& params,
+               std::vector<std::pair<float, int>>* sorted) {
+  sorted->clear();
+  sorted->reserve(num_boxes);
+  for (int i = 0; i < num_boxes; ++i) {
+    if (scores[i] > params.score_threshold) {
+      sorted->emplace_back(scores[i], i);
+    }
+  }
+  std::stable_sort(sorted->begin(), sorted->end(),
+                   [](const std::pair<float, int>& a,
+                      const std::pair<float, int>& b) {
+                     return a.first > b.first;
+                   });
+  if (params.top_k > -1 &&
+      params.top_k < static_cast<int>(sorted->size())) {
+    sorted->resize(params.top_k);
+  }
+}
+
+void HardNMS(const float* boxes, int box_stride,
+             const std::vector<std::pair<float, int>>& sorted,
+             const NMSParams& params, std::vector<int>* keep,
+             std::vector<float>* keep_scores) {
+  float norm = params.normalized ? 0.0f : 1.0f;
+  float threshold = params.iou_threshold;
+  BoxesSoA kept;
+  kept.Reserve(sorted.size());
+  float ious[kIoUChunk];
+  for (const auto& item : sorted) {
+    const float* box = boxes + static_cast<size_t>(item.second) * box_stride;
+    float area = BoxArea(box, norm);
+    bool suppressed = false;
+    for (size_t begin = 0; begin < kept.Size() && !suppressed;
+         begin += kIoUChunk) {
+      size_t end = std::min(begin + kIoUChunk, kept.Size());
+      ComputeIoUs(box, area, kept, begin, end, norm, ious);
+      for (size_t j = 0; j < end - begin; ++j) {
+        if (ious[j] > threshold) {
+          suppressed = true;
+          break;
+        }
+      }
+    }
+    if (suppressed) {
+      continue;
+    }
+    kept.Push(box, area);
+    keep->push_back(item.second);
+    if (keep_scores != nullptr) {
+      keep_scores->push_back(item.first);
+    }
+    if (params.eta < 1.0f && threshold > 0.5f) {
+      threshold *= params.eta;
+    }
+  }
+}
+
+void SoftNMS(const float* boxes, int box_stride,
+             const std::vector<std::pair<float, int>>& sorted,
+             const NMSParams& params, std::vector<int>* keep,
+             std::vector<float>* keep_scores) {
+  float norm = params.normalized ? 0.0f : 1.0f;
+  // The remaining boxes, compacted after every decay
+  BoxesSoA remain;
+  remain.Reserve(sorted.size());
+  std::vector<float> scores;
+  std::vector<int> indices;
+  for (const auto& item : sorted) {
+    const float* box = boxes + static_cast<size_t>(item.second) * box_stride;
+    remain.Push(box, BoxArea(box, norm));
+    scores.push_back(item.first);
+    indices.push_back(item.second);
+  }
+  std::vector<float> ious(sorted.size());
+  while (remain.Size() > 0) {
+    size_t best = std::max_element(scores.begin(), scores.end()) -
+                  scores.begin();
+    if (!(scores[best] > params.post_threshold)) {
+      break;
+    }
+    keep->push_back(indices[best]);
+    if (keep_scores != nullptr) {
+      keep_scores->push_back(scores[best]);
+    }
+    float box[4] = {remain.x1[best], remain.y1[best], remain.x2[best],
+                    remain.y2[best]};
+    float area = remain.area[best];
+    ComputeIoUs(box, area, remain, 0, remain.Size(), norm, ious.data());
+    size_t count = 0;
+    for (size_t j = 0; j < remain.Size(); ++j) {
+      if (j == best) {
+        continue;
+      }
+      float score = scores[j];
+      if (params.gaussian) {
+        score *= std::exp(-ious[j] * ious[j] / params.sigma);
+      } else if (ious[j] > params.iou_threshold) {
+        score *= 1.0f - ious[j];
+      }
+      if (score > params.post_threshold) {
+        remain.Move(j, count);
+        scores[count] = score;
+        indices[count] = indices[j];
+        ++count;
+      }
+    }
+    remain.Resize(count);
+    scores.resize(count);
+    indices.resize(count);
+  }
+}
+
+void MatrixNMS(const float* boxes, int box_stride,
+               const std::vector<std::pair<float, int>>& sorted,
+               const NMSParams& params, std::vector<int>* keep,
+               std::vector<float>* keep_scores) {
+  float norm = params.normalized ? 0.0f : 1.0f;
+  BoxesSoA sorted_boxes;
+  sorted_boxes.Reserve(sorted.size());
+  for (const auto& item : sorted) {
+    const float* box = boxes + static_cast<size_t>(item.second) * box_stride;
+    sorted_boxes.Push(box, BoxArea(box, norm));
+  }
+  // The IoUs of a box and the boxes of higher scores, and the max IoU of
+  // every box with the boxes of higher scores
+  std::vector<float> ious(sorted.size());
+  std::vector<float> max_ious(sorted.size(), 0.0f);
+  std::vector<std::pair<float, int>> decayed;
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    float box[4] = {sorted_boxes.x1[i], sorted_boxes.y1[i],
+                    sorted_boxes.x2[i], sorted_boxes.y2[i]};
+    ComputeIoUs(box, sorted_boxes.area[i], sorted_boxes, 0, i, norm,
+                ious.data());
+    float min_decay = 1.0f;
+    for (size_t j = 0; j < i; ++j) {
+      max_ious[i] = std::max(max_ious[i], ious[j]);
+      float decay = 0.0f;
+      if (params.gaussian) {
+        decay = std::exp((max_ious[j] * max_ious[j] - ious[j] * ious[j]) *
+                         params.sigma);
+      } else {
+        decay = (1.0f - ious[j]) / (1.0f - max_ious[j]);
+      }
+      min_decay = std::min(min_decay, decay);
+    }
+    float score = sorted[i].first * min_decay;
+    if (score > params.post_threshold) {
+      decayed.emplace_back(score, sorted[i].second);
+    }
+  }
+  std::stable_sort(decayed.begin(), decayed.end(),
+                   [](const std::pair<float, int>& a,
+                      const std::pair<float, int>& b) {
+                     return a.first > b.first;
+                   });
+  for (const auto& item : decayed) {
+    keep->push_back(item.second);
+    if (keep_scores != nullptr) {
+      keep_scores->push_back(item.first);
+    }
+  }
+}
+
+}  // namespace
+
+void NMS(const float* boxes, const float* scores, int num_boxes,
+         const NMSParams& params, std::vector<int>* keep,
+         std::vector<float>* keep_scores, int box_stride) {
+  keep->clear();
+  if (keep_scores != nullptr) {
+    keep_scores->clear();
+  }
+  std::vector<std::pair<float, int>> sorted;
+  SortBoxes(scores, num_boxes, params, &sorted);
+  if (params.type == NMSType::SOFT) {
+    SoftNMS(boxes, box_stride, sorted, params, keep, keep_scores);
+  } else if (params.type == NMSType::MATRIX) {
+    MatrixNMS(boxes, box_stride, sorted, params, keep, keep_scores);
+  } else {
+    HardNMS(boxes, box_stride, sorted, params, keep, keep_scores);
+  }
+}
+
+void MultiClassNMSResult::Clear() {
+  labels.clear();
+  indices.clear();
+  scores.clear();
+}
+
+void MultiClassNMS(const float* boxes, const float* scores, int batch,
+                   int num_boxes, int num_classes, const NMSParams& params,
+                   int background_label, int keep_top_k,
+                   std::vector<MultiClassNMSResult>* results, TaskPool* pool) {
+  // NMS of every class of every image, the classes of all the images are
+  // independent, so they run in one parallel loop
+  size_t num_tasks = static_cast<size_t>(batch) * num_classes;
+  std::vector<std::vector<int>> keeps(num_tasks);
+  std::vector<std::vector<float>> keep_scores(num_tasks);
+  auto run = [&](size_t task) {
+    int image = static_cast<int>(task / num_classes);
+    int label = static_cast<int>(task % num_classes);
+    if (label == background_label) {
+      return true;
+    }
+    NMS(boxes + static_cast<size_t>(image) * num_boxes * 4,
+        scores + task * num_boxes, num_boxes, params, &keeps[task],
+        &keep_scores[task]);
+    return true;
+  };
+  if (pool != nullptr && pool->NumThreads() > 1 && num_tasks > 1) {
+    pool->ParallelFor(num_tasks, run);
+  } else {
+    for (size_t task = 0; task < num_tasks; ++task) {
+      run(task);
+    }
+  }
+
+  results->resize(batch);
+  for (int image = 0; image < batch; ++image) {
+    auto& result = (*results)[image];
+    result.Clear();
+    for (int label = 0; label < num_classes; ++label) {
+      size_t task = static_cast<size_t>(image) * num_classes + label;
+      for (size_t j = 0; j < keeps[task].size(); ++j) {
+        result.labels.push_back(label);
+        result.indices.push_back(keeps[task][j]);
+        result.scores.push_back(keep_scores[task][j]);
+      }
+    }
+    if (keep_top_k < 0 || static_cast<int>(result.Size()) <= keep_top_k) {
+      continue;
+    }
+    // Keep the boxes of the highest scores, and group them by the labels
+    // again, the boxes of a label stay in descending order of the scores
+    std::vector<size_t> order(result.Size());
+    for (size_t j = 0; j < order.size(); ++j) {
+      order[j] = j;
+    }
+    std::stable_sort(order.begin(), order.end(), [&result](size_t a, size_t b) {
+      return result.scores[a] > result.scores[b];
+    });
+    order.resize(keep_top_k);
+    std::stable_sort(order.begin(), order.end(), [&result](size_t a, size_t b) {
+      return result.labels[a] < result.labels[b];
+    });
+    MultiClassNMSResult top;
+    for (size_t j : order) {
+      top.labels.push_back(result.labels[j]);
+      top.indices.push_back(result.indices[j]);
+      top.scores.push_back(result.scores[j]);
+    }
+    result = std::move(top);
+  }
+}
+
+}  // namespace function
+}  // namespace fastdeploy
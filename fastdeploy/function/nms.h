@@ -0,0 +1,107 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include "fastdeploy/utils/task_pool.h"
+#include "fastdeploy/utils/utils.h"
+
+namespace fastdeploy {
+namespace function {
+
+/// The suppression of NMS
+enum class NMSType {
+  /// Remove the boxes overlapping a kept box
+  HARD,
+  /// Soft-NMS, decay the scores of the boxes overlapping a kept box one by one
+  SOFT,
+  /// Matrix-NMS of SOLOv2, decay the scores of all the boxes in parallel
+  MATRIX,
+};
+
+/*! @brief Parameters of NMS
+ */
+struct FASTDEPLOY_DECL NMSParams {
+  NMSType type = NMSType::HARD;
+  /// The boxes with IoU greater than it are suppressed by HARD, and decayed by the linear SOFT
+  float iou_threshold = 0.5f;
+  /// Only the boxes with score greater than it are considered
+  float score_threshold = -std::numeric_limits<float>::infinity();
+  /// Only the top_k boxes of highest scores are considered, -1 for all
+  int top_k = -1;
+  /// The IoU threshold is multiplied by eta after a box is kept while it's greater than 0.5, 1.0 to disable the adaptive threshold
+  float eta = 1.0f;
+  /// Whether the coordinates are normalized, the width and height of the boxes in pixels are x2 - x1 + 1 and y2 - y1 + 1 otherwise, as Paddle
+  bool normalized = true;
+  /// Whether the SOFT and MATRIX decay the scores by gaussian, otherwise linearly
+  bool gaussian = false;
+  /// The gaussian decay of SOFT is exp(-iou^2 / sigma), and the one of MATRIX is exp((max_iou^2 - iou^2) * sigma) as Paddle's matrix_nms, which uses 2.0
+  float sigma = 0.5f;
+  /// The boxes with decayed score not greater than it are removed by SOFT and MATRIX
+  float post_threshold = 0.0f;
+};
+
+/** \brief Apply NMS to the boxes of one class
+ *
+ * The boxes are sorted by a stable sort of the scores, and stored as separated arrays of the coordinates, so the IoU of a box is computed against 8 kept boxes at once by AVX2 if supported. The hard NMS only compares a box with the kept boxes, and stops at the first suppressing one.
+ *
+ * \param[in] boxes The boxes in [x1, y1, x2, y2]
+ * \param[in] scores The scores of the boxes
+ * \param[in] num_boxes The number of the boxes
+ * \param[in] params The parameters of NMS
+ * \param[out] keep The indices of the kept boxes in descending order of the scores
+ * \param[out] keep_scores The scores of the kept boxes, which are the decayed scores for SOFT and MATRIX, nullptr if not needed
+ * \param[in] box_stride Number of floats between two boxes
+ */
+FASTDEPLOY_DECL void NMS(const float* boxes, const float* scores, int num_boxes,
+                         const NMSParams& params, std::vector<int>* keep,
+                         std::vector<float>* keep_scores = nullptr,
+                         int box_stride = 4);
+
+/*! @brief The kept boxes of an image after MultiClassNMS(), grouped by the labels in ascending order, the boxes of a label are in descending order of the scores
+ */
+struct FASTDEPLOY_DECL MultiClassNMSResult {
+  std::vector<int> labels;
+  std::vector<int> indices;
+  std::vector<float> scores;
+
+  size_t Size() const { return indices.size(); }
+  void Clear();
+};
+
+/** \brief Apply NMS to every class of the images, as the multiclass_nms of Paddle
+ *
+ * \param[in] boxes The boxes of the images in shape [batch, num_boxes, 4], shared by all the classes
+ * \param[in] scores The scores in shape [batch, num_classes, num_boxes]
+ * \param[in] batch The number of images
+ * \param[in] num_boxes The number of boxes of an image
+ * \param[in] num_classes The number of classes
+ * \param[in] params The parameters of NMS of a class
+ * \param[in] background_label The class skipped, -1 for none
+ * \param[in] keep_top_k Only the keep_top_k boxes of highest scores of an image are kept, -1 for all
+ * \param[out] results The kept boxes of every image, the indices are the indices of the boxes of the image
+ * \param[in] pool Run the classes of all the images in parallel if not nullptr
+ */
+FASTDEPLOY_DECL void MultiClassNMS(const float* boxes, const float* scores,
+                                   int batch, int num_boxes, int num_classes,
+                                   const NMSParams& params,
+                                   int background_label, int keep_top_k,
+                                   std::vector<MultiClassNMSResult>* results,
+                                   TaskPool* pool = nullptr);
+
+}  // namespace function
+}  // namespace fastdeploy
@@ -0,0 +1,138 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "fastdeploy/fastdeploy_model.h"
+#include "fastdeploy/runtime/runtime_pool.h"
+
+namespace fastdeploy {
+
+/*! @brief Pool of model instances cloned from one model, dispatching the requests across them
+ *
+ * `Model` is the type returned by the model's Clone(), e.g PPDetBase for the detection models, or PaddleSegModel/PaddleClasModel/PPOCRv3.
+ *
+ * example code @code
+ * auto model = fastdeploy::utils::make_unique<fastdeploy::vision::detection::PPYOLOE>(
+ *     "model.pdmodel", "model.pdiparams", "infer_cfg.yml");
+ * fastdeploy::ModelPool<fastdeploy::vision::detection::PPDetBase> pool(std::move(model), 4);
+ * // Called from any number of threads
+ * fastdeploy::vision::DetectionResult result;
+ * pool.Run([&](fastdeploy::vision::detection::PPDetBase* model) {
+ *   return model->Predict(im, &result);
+ * });
+ * @endcode
+ */
+template <typename Model>
+class ModelPool {
+ public:
+  /** \brief Clone the model into `num_instances` instances
+   *
+   * \param[in] model The initialized model, used as the first instance
+   * \param[in] num_instances Number of the model instances
+   * \param[in] queue_capacity Max number of the requests waiting in queue, the requests submitted to a full queue fail
+   */
+  ModelPool(std::unique_ptr<Model>&& model, int num_instances,
+            size_t queue_capacity = 1024) {
+    if (model == nullptr || !model->Initialized()) {
+      FDERROR << "ModelPool requires an initialized model." << std::endl;
+      return;
+    }
+    if (num_instances <= 0) {
+      FDERROR << "The number of instances should be > 0, but now it's "
+              << num_instances << "." << std::endl;
+      return;
+    }
+    models_.push_back(std::move(model));
+    for (int i = 1; i < num_instances; ++i) {
+      std::unique_ptr<Model> clone = models_[0]->Clone();
+      if (clone == nullptr || !clone->Initialized()) {
+        FDERROR << "Failed to clone the instance " << i << " of "
+                << models_[0]->ModelName() << "." << std::endl;
+        models_.clear();
+        return;
+      }
+      models_.push_back(std::move(clone));
+    }
+    dispatcher_.reset(new InstanceDispatcher(num_instances, queue_capacity));
+  }
+
+  /// Check if all the instances are created successfully
+  bool Initialized() const { return dispatcher_ != nullptr; }
+
+  /** \brief Queue a request and return without waiting
+   *
+   * \param[in] task Called with an idle instance in the worker thread, returns true if the request successed. Everything it refers to must be kept alive until it's done
+   * \param[in] callback Called with the result of `task`
+   */
+  void Submit(const std::function<bool(Model*)>& task,
+              const std::function<void(bool)>& callback) {
+    if (!Initialized()) {
+      FDERROR << "ModelPool is not initialized." << std::endl;
+      callback(false);
+      return;
+    }
+    bool queued = dispatcher_->Submit([this, task, callback](int index) {
+      callback(task(models_[index].get()));
+    });
+    if (!queued) {
+      FDERROR << "The request queue of ModelPool is full, there're "
+              << QueueDepth() << " requests waiting." << std::endl;
+      callback(false);
+    }
+  }
+
+  /// Queue a request and return the future of its result
+  std::future<bool> Submit(const std::function<bool(Model*)>& task) {
+    auto promise = std::make_shared<std::promise<bool>>();
+    std::future<bool> result = promise->get_future();
+    Submit(task, [promise](bool success) { promise->set_value(success); });
+    return result;
+  }
+
+  /// Run the request by an idle instance and wait for the result
+  bool Run(const std::function<bool(Model*)>& task) {
+    return Submit(task).get();
+  }
+
+  /// Get number of the model instances
+  int NumInstances() const { return static_cast<int>(models_.size()); }
+  /// Get the model instance by index, it's not thread-safe to use it while the pool is running requests
+  Model* GetModel(int index) { return models_[index].get(); }
+  /// Get number of the requests waiting in queue
+  size_t QueueDepth() const {
+    return Initialized() ? dispatcher_->QueueDepth() : 0;
+  }
+  /// Get statistics of the requests dispatched across the instances
+  InstancePoolStats GetStats() const {
+    return Initialized() ? dispatcher_->GetStats() : InstancePoolStats();
+  }
+  /// Reset the statistics of requests and utilization
+  void ResetStats() {
+    if (Initialized()) {
+      dispatcher_->ResetStats();
+    }
+  }
+
+ private:
+  std::vector<std::unique_ptr<Model>> models_;
+  std::unique_ptr<InstanceDispatcher> dispatcher_;
+};
+
+}  // namespace fastdeploy
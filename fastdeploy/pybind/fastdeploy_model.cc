@@ -18,6 +18,24 @@
 namespace fastdeploy {
 
 void BindFDModel(pybind11::module& m) {
+  pybind11::enum_<benchmark::LatencyStage>(m, "LatencyStage",
+                                           "Stage of a Predict() call.")
+      .value("PREPROCESS", benchmark::LatencyStage::PREPROCESS)
+      .value("RUNTIME", benchmark::LatencyStage::RUNTIME)
+      .value("H2D", benchmark::LatencyStage::H2D)
+      .value("BACKEND", benchmark::LatencyStage::BACKEND)
+      .value("D2H", benchmark::LatencyStage::D2H)
+      .value("POSTPROCESS", benchmark::LatencyStage::POSTPROCESS);
+
+  pybind11::class_<benchmark::LatencyStats>(m, "LatencyStats")
+      .def(pybind11::init())
+      .def_readonly("count", &benchmark::LatencyStats::count)
+      .def_readonly("mean", &benchmark::LatencyStats::mean)
+      .def_readonly("p50", &benchmark::LatencyStats::p50)
+      .def_readonly("p90", &benchmark::LatencyStats::p90)
+      .def_readonly("p99", &benchmark::LatencyStats::p99)
+      .def_readonly("max", &benchmark::LatencyStats::max);
+
   pybind11::class_<FastDeployModel>(m, "FastDeployModel")
       .def(pybind11::init<>(), "Default Constructor")
       .def("model_name", &FastDeployModel::ModelName)
@@ -30,8 +48,12 @@ void BindFDModel(pybind11::module& m) {
            &FastDeployModel::DisableRecordTimeOfRuntime)
       .def("print_statis_info_of_runtime",
            &FastDeployModel::PrintStatisInfoOfRuntime)
+      .def("get_stage_latency", &FastDeployModel::GetStageLatency)
       .def("get_profile_time",
            &FastDeployModel::GetProfileTime)     
+      .def("enable_request_arena", &FastDeployModel::EnableRequestArena)
+      .def("disable_request_arena", &FastDeployModel::DisableRequestArena)
+      .def("get_request_arena_stats", &FastDeployModel::GetRequestArenaStats)
       .def("initialized", &FastDeployModel::Initialized)
       .def_readwrite("runtime_option", &FastDeployModel::runtime_option)
       .def_readwrite("valid_cpu_backends", &FastDeployModel::valid_cpu_backends)
@@ -22,6 +22,7 @@
 #include <type_traits>
 
 #include "fastdeploy/runtime/runtime.h"
+#include "fastdeploy/runtime/runtime_pool.h"
 
 #ifdef ENABLE_VISION
 #include "fastdeploy/vision.h"
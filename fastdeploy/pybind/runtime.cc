@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "fastdeploy/core/host_pool_allocator.h"
 #include "fastdeploy/pybind/main.h"
 
 namespace fastdeploy {
@@ -26,6 +27,26 @@ void BindRuntime(pybind11::module& m) {
       .def_readwrite("shape", &TensorInfo::shape)
       .def_readwrite("dtype", &TensorInfo::dtype);
 
+  pybind11::class_<FDAllocatorStats>(m, "FDAllocatorStats")
+      .def(pybind11::init())
+      .def_readonly("bytes_in_use", &FDAllocatorStats::bytes_in_use)
+      .def_readonly("peak_bytes_in_use", &FDAllocatorStats::peak_bytes_in_use)
+      .def_readonly("bytes_cached", &FDAllocatorStats::bytes_cached)
+      .def_readonly("num_allocs", &FDAllocatorStats::num_allocs)
+      .def_readonly("num_hits", &FDAllocatorStats::num_hits)
+      .def("hit_rate", &FDAllocatorStats::HitRate);
+
+  m.def(
+      "enable_host_memory_pool",
+      [](size_t max_cached_bytes) {
+        HostPoolAllocatorOption option;
+        option.max_cached_bytes = max_cached_bytes;
+        EnableHostMemoryPool(option);
+      },
+      pybind11::arg("max_cached_bytes") = 1024UL * 1024UL * 1024UL);
+  m.def("disable_host_memory_pool", &DisableHostMemoryPool);
+  m.def("get_host_memory_pool_stats", &GetHostMemoryPoolStats);
+
   pybind11::class_<Runtime>(m, "Runtime")
       .def(pybind11::init())
       .def("init", &Runtime::Init)
@@ -126,6 +147,59 @@ void BindRuntime(pybind11::module& m) {
       .def("get_profile_time", &Runtime::GetProfileTime)
       .def_readonly("option", &Runtime::option);
 
+  pybind11::class_<InstancePoolStats>(m, "InstancePoolStats")
+      .def(pybind11::init())
+      .def_readonly("queue_depth", &InstancePoolStats::queue_depth)
+      .def_readonly("num_requests", &InstancePoolStats::num_requests)
+      .def_readonly("utilization", &InstancePoolStats::utilization);
+
+  pybind11::class_<RuntimePool>(m, "RuntimePool")
+      .def(pybind11::init())
+      .def("init", &RuntimePool::Init)
+      .def("infer",
+           [](RuntimePool& self, std::map<std::string, pybind11::array>& data) {
+             std::vector<FDTensor> inputs(data.size());
+             int index = 0;
+             for (auto iter = data.begin(); iter != data.end(); ++iter) {
+               std::vector<int64_t> data_shape;
+               data_shape.insert(data_shape.begin(), iter->second.shape(),
+                                 iter->second.shape() + iter->second.ndim());
+               auto dtype = NumpyDataTypeToFDDataType(iter->second.dtype());
+               inputs[index].Resize(data_shape, dtype);
+               memcpy(inputs[index].MutableData(), iter->second.mutable_data(),
+                      iter->second.nbytes());
+               inputs[index].name = iter->first;
+               index += 1;
+             }
+
+             std::vector<FDTensor> outputs;
+             bool success = false;
+             {
+               // Let the other python threads submit requests meanwhile
+               pybind11::gil_scoped_release release;
+               success = self.Infer(inputs, &outputs);
+             }
+             if (!success) {
+               throw std::runtime_error(
+                   "Failed to inference with RuntimePool.");
+             }
+
+             std::vector<pybind11::array> results;
+             results.reserve(outputs.size());
+             for (size_t i = 0; i < outputs.size(); ++i) {
+               auto numpy_dtype = FDDataTypeToNumpyDataType(outputs[i].dtype);
+               results.emplace_back(
+                   pybind11::array(numpy_dtype, outputs[i].shape));
+               memcpy(results[i].mutable_data(), outputs[i].Data(),
+                      outputs[i].Numel() * FDDataTypeSize(outputs[i].dtype));
+             }
+             return results;
+           })
+      .def("num_instances", &RuntimePool::NumInstances)
+      .def("queue_depth", &RuntimePool::QueueDepth)
+      .def("get_stats", &RuntimePool::GetStats)
+      .def("reset_stats", &RuntimePool::ResetStats);
+
   pybind11::enum_<Backend>(m, "Backend", pybind11::arithmetic(),
                            "Backend for inference.")
       .value("UNKOWN", Backend::UNKNOWN)
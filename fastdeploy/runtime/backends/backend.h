@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -80,6 +81,17 @@ class BaseBackend {
   virtual bool Infer(std::vector<FDTensor>& inputs,
                      std::vector<FDTensor>* outputs,
                      bool copy_to_fd = true) = 0;
+  // Optional: For those backends which can run inference asynchronously by
+  // themselves, e.g OpenVINO. The outputs are always copied to FDTensor, and
+  // `callback` is called with the result once they're ready. The inputs and
+  // outputs must be kept alive until then.
+  virtual bool SupportAsync() const { return false; }
+  virtual bool InferAsync(std::vector<FDTensor>& inputs,
+                          std::vector<FDTensor>* outputs,
+                          const std::function<void(bool)>& callback) {
+    FDERROR << "InferAsync no support" << std::endl;
+    return false;
+  }
   // Optional: For those backends which can share memory
   // while creating multiple inference engines with same model file
   virtual std::unique_ptr<BaseBackend> Clone(RuntimeOption &runtime_option,
@@ -143,15 +155,25 @@ class BaseBackend {
  * subsequent tasks. So, we set 'base_loop' as 0 and lanuch
  * another infer to get the valid outputs beyond the scope 
  * of 'BEGIN ~ END' for subsequent tasks.
+ *
+ * Besides, the macros always split the last inference into
+ * H2D('H2D_D2H_BEGIN ~ BEGIN'), backend('BEGIN ~ END') and
+ * D2H('END ~ H2D_D2H_END') time in 'benchmark_result_', so
+ * 'BEGIN ~ END' must be nested in 'H2D_D2H_BEGIN ~ H2D_D2H_END'.
  */
 
 #define RUNTIME_PROFILE_LOOP_BEGIN(base_loop)            \
+  __RUNTIME_PROFILE_STAGE_BACKEND_BEGIN                  \
   __RUNTIME_PROFILE_LOOP_BEGIN(benchmark_option_, (base_loop))
 #define RUNTIME_PROFILE_LOOP_END                         \
-  __RUNTIME_PROFILE_LOOP_END(benchmark_result_)
+  __RUNTIME_PROFILE_LOOP_END(benchmark_result_)          \
+  __RUNTIME_PROFILE_STAGE_BACKEND_END
 #define RUNTIME_PROFILE_LOOP_H2D_D2H_BEGIN               \
-  __RUNTIME_PROFILE_LOOP_H2D_D2H_BEGIN(benchmark_option_, 1)
+  __RUNTIME_PROFILE_STAGE_BEGIN                          \
+  __RUNTIME_PROFILE_LOOP_H2D_D2H_BEGIN(benchmark_option_, 1) \
+  __RUNTIME_PROFILE_STAGE_RESTART
 #define RUNTIME_PROFILE_LOOP_H2D_D2H_END                 \
-  __RUNTIME_PROFILE_LOOP_H2D_D2H_END(benchmark_result_)
+  __RUNTIME_PROFILE_LOOP_H2D_D2H_END(benchmark_result_)  \
+  __RUNTIME_PROFILE_STAGE_END(benchmark_result_)
 
 }  // namespace fastdeploy
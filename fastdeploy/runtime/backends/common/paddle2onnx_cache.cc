@@ -0,0 +1,377 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "fastdeploy/runtime/backends/common/paddle2onnx_cache.h"
+
+#include <sys/stat.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <thread>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "fastdeploy/utils/path.h"
+
+namespace fastdeploy {
+
+namespace {
+
+// Bump it while the layout of the cached files or the hash changes
+const char* kCacheVersion = "p2o-cache-v2";
+
+const uint64_t kPrime1 = 11400714785074694791ULL;
+const uint64_t kPrime2 = 14029467366897019727ULL;
+const uint64_t kPrime3 = 1609587929392839161ULL;
+const uint64_t kPrime4 = 9650029242287828579ULL;
+const uint64_t kPrime5 = 2870177450012600261ULL;
+
+inline uint64_t RotateLeft(uint64_t value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t Read64(const char* data) {
+  uint64_t word;
+  std::memcpy(&word, data, 8);
+  return word;
+}
+
+inline uint64_t Read32(const char* data) {
+  uint32_t word;
+  std::memcpy(&word, data, 4);
+  return word;
+}
+
+inline uint64_t Round(uint64_t acc, uint64_t input) {
+  acc += input * kPrime2;
+  return RotateLeft(acc, 31) * kPrime1;
+}
+
+inline uint64_t MergeRound(uint64_t acc, uint64_t value) {
+  acc ^= Round(0, value);
+  return acc * kPrime1 + kPrime4;
+}
+
+// XXH64 of the bytes, the parameters may be hundreds of MB so it's done over
+// 8-byte words in 4 lanes. Every input bit affects all the bits of the hash,
+// unlike FNV over words whose flips of the top bits cancel out each other.
+uint64_t HashBytes(const char* data, size_t size, uint64_t seed) {
+  const char* end = data + size;
+  uint64_t hash;
+  if (size >= 32) {
+    uint64_t v1 = seed + kPrime1 + kPrime2;
+    uint64_t v2 = seed + kPrime2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - kPrime1;
+    const char* limit = end - 32;
+    do {
+      v1 = Round(v1, Read64(data));
+      v2 = Round(v2, Read64(data + 8));
+      v3 = Round(v3, Read64(data + 16));
+      v4 = Round(v4, Read64(data + 24));
+      data += 32;
+    } while (data <= limit);
+    hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) +
+           RotateLeft(v4, 18);
+    hash = MergeRound(hash, v1);
+    hash = MergeRound(hash, v2);
+    hash = MergeRound(hash, v3);
+    hash = MergeRound(hash, v4);
+  } else {
+    hash = seed + kPrime5;
+  }
+  hash += static_cast<uint64_t>(size);
+  for (; data + 8 <= end; data += 8) {
+    hash ^= Round(0, Read64(data));
+    hash = RotateLeft(hash, 27) * kPrime1 + kPrime4;
+  }
+  if (data + 4 <= end) {
+    hash ^= Read32(data) * kPrime1;
+    hash = RotateLeft(hash, 23) * kPrime2 + kPrime3;
+    data += 4;
+  }
+  for (; data < end; ++data) {
+    hash ^= static_cast<unsigned char>(*data) * kPrime5;
+    hash = RotateLeft(hash, 11) * kPrime1;
+  }
+  hash ^= hash >> 33;
+  hash *= kPrime2;
+  hash ^= hash >> 29;
+  hash *= kPrime3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+uint64_t HashString(const std::string& str, uint64_t hash) {
+  return HashBytes(str.data(), str.size(), hash);
+}
+
+int MakeDir(const std::string& path) {
+#ifdef _WIN32
+  return _mkdir(path.c_str());
+#else
+  return mkdir(path.c_str(), 0755);
+#endif
+}
+
+bool IsDir(const std::string& path) {
+  struct stat info;
+  if (stat(path.c_str(), &info) != 0) {
+    return false;
+  }
+  return (info.st_mode & S_IFDIR) != 0;
+}
+
+// Create the directory and its parents, other processes may be creating it
+// at the same time
+bool CreateDirs(const std::string& path) {
+  if (path.empty() || IsDir(path)) {
+    return true;
+  }
+  std::string parent = GetDirFromPath(path);
+  if (parent != path && !CreateDirs(parent)) {
+    return false;
+  }
+  return MakeDir(path) == 0 || errno == EEXIST || IsDir(path);
+}
+
+int ProcessId() {
+#ifdef _WIN32
+  return _getpid();
+#else
+  return static_cast<int>(getpid());
+#endif
+}
+
+int RemoveDir(const std::string& path) {
+#ifdef _WIN32
+  return _rmdir(path.c_str());
+#else
+  return rmdir(path.c_str());
+#endif
+}
+
+// Suffix of the temporary files unique to this process/thread
+std::string TempSuffix() {
+  static std::atomic<uint64_t> counter{0};
+  std::ostringstream suffix;
+  suffix << ".tmp." << ProcessId() << "."
+         << std::hash<std::thread::id>()(std::this_thread::get_id()) << "."
+         << counter++;
+  return suffix.str();
+}
+
+// Files of an entry with external data
+const char* kExternalModelName = "model.onnx";
+const char* kExternalDataName = "model.onnx.data";
+const char* kExternalCalibrationName = "model.calib";
+
+// Write to a file unique to this process/thread, then rename it to `path`
+bool AtomicWrite(const std::string& path, const std::string& contents) {
+  std::ostringstream tmp_path;
+  tmp_path << path << TempSuffix();
+  {
+    std::ofstream fout(tmp_path.str(), std::ios::out | std::ios::binary);
+    if (!fout.is_open()) {
+      return false;
+    }
+    fout.write(contents.data(), contents.size());
+    fout.close();
+    if (!fout) {
+      std::remove(tmp_path.str().c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmp_path.str().c_str(), path.c_str()) != 0) {
+    std::remove(tmp_path.str().c_str());
+    // Rename doesn't replace an existing file on Windows, which is written by
+    // another process with the same contents
+    return CheckFileExists(path);
+  }
+  return true;
+}
+
+}  // namespace
+
+Paddle2OnnxCache::Paddle2OnnxCache(const std::string& cache_dir)
+    : cache_dir_(cache_dir) {}
+
+std::string Paddle2OnnxCache::ComputeKey(const ModelSource& model_buffer,
+                                         const ModelSource& params_buffer,
+                                         const Paddle2OnnxConvertInfo& info) {
+  uint64_t hash = HashString(kCacheVersion, 0);
+  hash = HashBytes(model_buffer.Data(), model_buffer.Size(), hash);
+  hash = HashBytes(params_buffer.Data(), params_buffer.Size(), hash);
+  hash = HashString(std::to_string(info.opset_version), hash);
+  hash = HashString(info.deploy_backend, hash);
+  for (const auto& op : info.custom_ops) {
+    hash = HashString(op.first, hash);
+    hash = HashString(op.second, hash);
+  }
+  char key[17];
+  std::snprintf(key, sizeof(key), "%016llx",
+                static_cast<unsigned long long>(hash));
+  return std::string(key);
+}
+
+std::string Paddle2OnnxCache::ModelPath(const std::string& key) const {
+  return PathJoin(cache_dir_, key + ".onnx");
+}
+
+std::string Paddle2OnnxCache::CalibrationPath(const std::string& key) const {
+  return PathJoin(cache_dir_, key + ".calib");
+}
+
+bool Paddle2OnnxCache::Load(const std::string& key, std::string* onnx_model,
+                            std::string* calibration_cache) const {
+  if (!Enabled() || !CheckFileExists(ModelPath(key))) {
+    return false;
+  }
+  if (!ReadBinaryFromFile(ModelPath(key), onnx_model)) {
+    return false;
+  }
+  if (calibration_cache != nullptr) {
+    calibration_cache->clear();
+    if (CheckFileExists(CalibrationPath(key)) &&
+        !ReadBinaryFromFile(CalibrationPath(key), calibration_cache)) {
+      return false;
+    }
+  }
+  FDINFO << "Load converted ONNX model from cache: " << ModelPath(key) << "."
+         << std::endl;
+  return true;
+}
+
+bool Paddle2OnnxCache::Save(const std::string& key,
+                            const std::string& onnx_model,
+                            const std::string& calibration_cache) const {
+  if (!Enabled()) {
+    return false;
+  }
+  if (!CreateDirs(cache_dir_)) {
+    FDWARNING << "Failed to create the cache directory: " << cache_dir_
+              << ", the converted ONNX model will not be cached." << std::endl;
+    return false;
+  }
+  // The model file marks a complete entry, so it's renamed into place after
+  // the calibration cache
+  if (!calibration_cache.empty() &&
+      !AtomicWrite(CalibrationPath(key), calibration_cache)) {
+    FDWARNING << "Failed to write the calibration cache to "
+              << CalibrationPath(key) << "." << std::endl;
+    return false;
+  }
+  if (!AtomicWrite(ModelPath(key), onnx_model)) {
+    FDWARNING << "Failed to write the converted ONNX model to "
+              << ModelPath(key) << "." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+std::string Paddle2OnnxCache::ExternalDir(const std::string& key) const {
+  return PathJoin(cache_dir_, key + ".external");
+}
+
+std::string Paddle2OnnxCache::ExternalDataPath(const std::string& staging_dir) {
+  return PathJoin(staging_dir, kExternalDataName);
+}
+
+bool Paddle2OnnxCache::LoadExternal(const std::string& key,
+                                    std::string* model_path,
+                                    std::string* calibration_cache) const {
+  std::string path = PathJoin(ExternalDir(key), kExternalModelName);
+  if (!Enabled() || !CheckFileExists(path)) {
+    return false;
+  }
+  if (calibration_cache != nullptr) {
+    calibration_cache->clear();
+    std::string calibration_path =
+        PathJoin(ExternalDir(key), kExternalCalibrationName);
+    if (CheckFileExists(calibration_path) &&
+        !ReadBinaryFromFile(calibration_path, calibration_cache)) {
+      return false;
+    }
+  }
+  *model_path = path;
+  FDINFO << "Load converted ONNX model from cache: " << path << "."
+         << std::endl;
+  return true;
+}
+
+bool Paddle2OnnxCache::CreateStagingDir(const std::string& key,
+                                        std::string* staging_dir) const {
+  if (!Enabled() || !CreateDirs(cache_dir_)) {
+    return false;
+  }
+  std::string dir = ExternalDir(key) + TempSuffix();
+  if (MakeDir(dir) != 0) {
+    return false;
+  }
+  *staging_dir = dir;
+  return true;
+}
+
+bool Paddle2OnnxCache::SaveExternal(const std::string& key,
+                                    const std::string& staging_dir,
+                                    const std::string& onnx_model,
+                                    const std::string& calibration_cache,
+                                    std::string* model_path) const {
+  model_path->clear();
+  std::string staging_model = PathJoin(staging_dir, kExternalModelName);
+  std::string staging_calibration =
+      PathJoin(staging_dir, kExternalCalibrationName);
+  if (!AtomicWrite(staging_model, onnx_model) ||
+      (!calibration_cache.empty() &&
+       !AtomicWrite(staging_calibration, calibration_cache))) {
+    FDWARNING << "Failed to write the converted ONNX model to " << staging_dir
+              << "." << std::endl;
+    return false;
+  }
+  if (std::rename(staging_dir.c_str(), ExternalDir(key).c_str()) == 0) {
+    *model_path = PathJoin(ExternalDir(key), kExternalModelName);
+    return true;
+  }
+  // Renaming fails if another process has saved the same entry, then the
+  // staging files are dropped and that entry is used
+  std::string entry_model = PathJoin(ExternalDir(key), kExternalModelName);
+  if (!CheckFileExists(entry_model)) {
+    FDWARNING << "Failed to move " << staging_dir << " to " << ExternalDir(key)
+              << ", the converted ONNX model will not be cached." << std::endl;
+    *model_path = staging_model;
+    return false;
+  }
+  DropStagingDir(staging_dir);
+  *model_path = entry_model;
+  return true;
+}
+
+void Paddle2OnnxCache::DropStagingDir(const std::string& staging_dir) const {
+  std::remove(PathJoin(staging_dir, kExternalModelName).c_str());
+  std::remove(PathJoin(staging_dir, kExternalCalibrationName).c_str());
+  std::remove(ExternalDataPath(staging_dir).c_str());
+  RemoveDir(staging_dir);
+}
+
+}  // namespace fastdeploy
@@ -0,0 +1,121 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fastdeploy/utils/model_source.h"
+#include "fastdeploy/utils/utils.h"
+
+namespace fastdeploy {
+
+/*! @brief Everything that decides the result of a Paddle->ONNX conversion
+ */
+struct Paddle2OnnxConvertInfo {
+  int opset_version = 11;
+  /// Target backend passed to paddle2onnx, e.g "onnxruntime"/"tensorrt"
+  std::string deploy_backend = "";
+  /// Pairs of (paddle op name, exported op name)
+  std::vector<std::pair<std::string, std::string>> custom_ops;
+};
+
+/*! @brief On-disk cache of the converted ONNX models
+ *
+ * Every entry is named by the XXH64 hash of the Paddle model/parameters
+ * bytes and the conversion info, so a changed model only hits a stale entry
+ * by a 64-bit hash collision. Entries are written to a temporary file and
+ * renamed into place, several processes sharing one cache directory will
+ * never read a partial file. The models bigger than 2GB are exported with
+ * external data, such an entry is a directory holding the model and its
+ * data file, which is exported to a staging directory and renamed into
+ * place as a whole.
+ */
+class FASTDEPLOY_DECL Paddle2OnnxCache {
+ public:
+  /// An empty `cache_dir` disables the cache, Load/Save always fail
+  explicit Paddle2OnnxCache(const std::string& cache_dir);
+
+  bool Enabled() const { return !cache_dir_.empty(); }
+
+  /// Hash of the model, parameters and conversion info in hex string
+  static std::string ComputeKey(const ModelSource& model_buffer,
+                                const ModelSource& params_buffer,
+                                const Paddle2OnnxConvertInfo& info);
+
+  /** \brief Load the converted model of `key`
+   *
+   * \param[in] key Key computed by ComputeKey()
+   * \param[out] onnx_model The serialized ONNX model
+   * \param[out] calibration_cache The calibration cache exported with the model, can be nullptr if not needed
+   * \return false if there's no such entry
+   */
+  bool Load(const std::string& key, std::string* onnx_model,
+            std::string* calibration_cache = nullptr) const;
+
+  /// Save the converted model of `key`, failure only leads to a warning
+  bool Save(const std::string& key, const std::string& onnx_model,
+            const std::string& calibration_cache = "") const;
+
+  /// Path of the ONNX model file of `key`
+  std::string ModelPath(const std::string& key) const;
+
+  /** \brief Find the converted model with external data of `key`
+   *
+   * \param[in] key Key computed by ComputeKey()
+   * \param[out] model_path Path of the ONNX model file, its external data is in the same directory
+   * \param[out] calibration_cache The calibration cache exported with the model, can be nullptr if not needed
+   * \return false if there's no such entry
+   */
+  bool LoadExternal(const std::string& key, std::string* model_path,
+                    std::string* calibration_cache = nullptr) const;
+
+  /** \brief Create a directory private to the caller, the model with external data of `key` is exported into it
+   *
+   * \param[in] key Key computed by ComputeKey()
+   * \param[out] staging_dir The created directory
+   * \return false if the directory can't be created
+   */
+  bool CreateStagingDir(const std::string& key,
+                        std::string* staging_dir) const;
+
+  /// Path of the external data file to export into `staging_dir`
+  static std::string ExternalDataPath(const std::string& staging_dir);
+
+  /** \brief Write the model into `staging_dir` with its external data, and move the directory into place as the entry of `key`
+   *
+   * \param[in] key Key computed by ComputeKey()
+   * \param[in] staging_dir Directory created by CreateStagingDir(), holding the external data
+   * \param[in] onnx_model The serialized ONNX model
+   * \param[in] calibration_cache The calibration cache exported with the model
+   * \param[out] model_path Path of the ONNX model file to load, in the entry if it's saved, otherwise in `staging_dir`
+   * \return false if the entry isn't saved, `model_path` can still be loaded if it's not empty
+   */
+  bool SaveExternal(const std::string& key, const std::string& staging_dir,
+                    const std::string& onnx_model,
+                    const std::string& calibration_cache,
+                    std::string* model_path) const;
+
+  /// Remove the directory created by CreateStagingDir() and the files exported into it
+  void DropStagingDir(const std::string& staging_dir) const;
+
+ private:
+  std::string CalibrationPath(const std::string& key) const;
+  std::string ExternalDir(const std::string& key) const;
+
+  std::string cache_dir_;
+};
+
+}  // namespace fastdeploy
@@ -32,6 +32,9 @@ struct OpenVINOBackendOption {
   /// Number of streams while use OpenVINO
   int num_streams = 0;
 
+  /// Milliseconds Runtime::InferAsync() waits for an idle infer request while all of them are busy, the request fails after that. -1 means waiting forever
+  int async_request_timeout_ms = 60000;
+
   /**
    * @brief Set device name for OpenVINO, default 'CPU', can also be 'AUTO', 'GPU', 'GPU.1'....
    */
@@ -22,6 +22,8 @@ void BindOpenVINOOption(pybind11::module& m) {
       .def(pybind11::init())
       .def_readwrite("cpu_thread_num", &OpenVINOBackendOption::cpu_thread_num)
       .def_readwrite("num_streams", &OpenVINOBackendOption::num_streams)
+      .def_readwrite("async_request_timeout_ms",
+                     &OpenVINOBackendOption::async_request_timeout_ms)
       .def("set_device", &OpenVINOBackendOption::SetDevice)
       .def("set_shape_info", &OpenVINOBackendOption::SetShapeInfo)
       .def("set_cpu_operators", &OpenVINOBackendOption::SetCpuOperators);
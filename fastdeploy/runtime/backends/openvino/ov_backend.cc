@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #include "fastdeploy/runtime/backends/openvino/ov_backend.h"
+
+#include <algorithm>
+#include <chrono>  // NOLINT
 #ifdef ENABLE_PADDLE2ONNX
 #include "paddle2onnx/converter.h"
 #endif
@@ -410,6 +413,136 @@ bool OpenVINOBackend::Infer(std::vector<FDTensor>& inputs,
   return true;
 }
 
+OpenVINOBackend::~OpenVINOBackend() {
+  std::unique_lock<std::mutex> lock(async_mutex_);
+  async_cond_.wait(lock, [this] { return num_running_async_requests_ == 0; });
+}
+
+ov::InferRequest* OpenVINOBackend::AcquireAsyncRequest() {
+  std::unique_lock<std::mutex> lock(async_mutex_);
+  if (idle_async_requests_.empty()) {
+    size_t max_requests = 1;
+    try {
+      max_requests = compiled_model_.get_property(
+          ov::optimal_number_of_infer_requests);
+    } catch (const std::exception& e) {
+      FDWARNING << "Failed to get the optimal number of infer requests, "
+                   "will use 1 request for asynchronous inference."
+                << std::endl;
+    }
+    if (async_requests_.size() < std::max(max_requests, size_t(1))) {
+      async_requests_.emplace_back(
+          new ov::InferRequest(compiled_model_.create_infer_request()));
+      ++num_running_async_requests_;
+      return async_requests_.back().get();
+    }
+  }
+  auto is_idle = [this] { return !idle_async_requests_.empty(); };
+  if (option_.async_request_timeout_ms < 0) {
+    async_cond_.wait(lock, is_idle);
+  } else if (!async_cond_.wait_for(
+                 lock,
+                 std::chrono::milliseconds(option_.async_request_timeout_ms),
+                 is_idle)) {
+    FDERROR << "[OpenVINOBackend] All the " << async_requests_.size()
+            << " infer requests are still busy after "
+            << option_.async_request_timeout_ms << "ms." << std::endl;
+    return nullptr;
+  }
+  ov::InferRequest* request = idle_async_requests_.back();
+  idle_async_requests_.pop_back();
+  ++num_running_async_requests_;
+  return request;
+}
+
+void OpenVINOBackend::ReleaseAsyncRequest(ov::InferRequest* request) {
+  {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    idle_async_requests_.push_back(request);
+  }
+  async_cond_.notify_all();
+}
+
+void OpenVINOBackend::FinishAsyncRequest() {
+  {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    --num_running_async_requests_;
+  }
+  async_cond_.notify_all();
+}
+
+bool OpenVINOBackend::InferAsync(std::vector<FDTensor>& inputs,
+                                 std::vector<FDTensor>* outputs,
+                                 const std::function<void(bool)>& callback) {
+  if (inputs.size() != input_infos_.size()) {
+    FDERROR << "[OpenVINOBackend] Size of the inputs(" << inputs.size()
+            << ") should keep same with the inputs of this model("
+            << input_infos_.size() << ")." << std::endl;
+    return false;
+  }
+
+  ov::InferRequest* request = AcquireAsyncRequest();
+  if (request == nullptr) {
+    return false;
+  }
+  // Same stages as Infer(), the profile loop isn't available since the
+  // request can't be repeated, Runtime runs Infer() instead while profiling
+  auto stage_begin = benchmark::StageClock::now();
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    ov::Shape shape(inputs[i].shape.begin(), inputs[i].shape.end());
+    ov::Tensor ov_tensor(FDDataTypeToOV(inputs[i].dtype), shape,
+                         inputs[i].Data());
+    request->set_tensor(inputs[i].name, ov_tensor);
+  }
+  auto backend_begin = benchmark::StageClock::now();
+
+  // The request is reused by others once it's released, so the outputs are
+  // always copied to FDTensor
+  request->set_callback([this, request, outputs, callback, stage_begin,
+                         backend_begin](std::exception_ptr exception) {
+    auto backend_end = benchmark::StageClock::now();
+    bool success = (exception == nullptr);
+    if (success) {
+      outputs->resize(output_infos_.size());
+      for (size_t i = 0; i < output_infos_.size(); ++i) {
+        auto out_tensor = request->get_output_tensor(i);
+        auto out_tensor_shape = out_tensor.get_shape();
+        std::vector<int64_t> shape(out_tensor_shape.begin(),
+                                   out_tensor_shape.end());
+        (*outputs)[i].Resize(
+            shape, OpenVINODataTypeToFD(out_tensor.get_element_type()),
+            output_infos_[i].name, Device::CPU);
+        memcpy((*outputs)[i].MutableData(), out_tensor.data(),
+               (*outputs)[i].Nbytes());
+      }
+      std::lock_guard<std::mutex> lock(async_mutex_);
+      benchmark::RecordStageTimes(stage_begin, backend_begin, backend_end,
+                                  &benchmark_result_);
+    } else {
+      try {
+        std::rethrow_exception(exception);
+      } catch (const std::exception& e) {
+        FDERROR << "Failed to Infer: " << e.what() << std::endl;
+      } catch (...) {
+        FDERROR << "Failed to Infer." << std::endl;
+      }
+    }
+    ReleaseAsyncRequest(request);
+    callback(success);
+    FinishAsyncRequest();
+  });
+  try {
+    request->start_async();
+  } catch (const std::exception& e) {
+    FDERROR << "Failed to start asynchronous inference: " << e.what()
+            << std::endl;
+    ReleaseAsyncRequest(request);
+    FinishAsyncRequest();
+    return false;
+  }
+  return true;
+}
+
 std::unique_ptr<BaseBackend> OpenVINOBackend::Clone(
     RuntimeOption& runtime_option, void* stream, int device_id) {
   std::unique_ptr<BaseBackend> new_backend =
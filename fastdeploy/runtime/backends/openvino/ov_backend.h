@@ -14,8 +14,10 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -30,13 +32,21 @@ class OpenVINOBackend : public BaseBackend {
  public:
   static ov::Core core_;
   OpenVINOBackend() {}
-  virtual ~OpenVINOBackend() = default;
+  // Waits for the asynchronous requests in flight, their callbacks use this
+  // backend
+  virtual ~OpenVINOBackend();
 
   bool Init(const RuntimeOption& option);
 
   bool Infer(std::vector<FDTensor>& inputs, std::vector<FDTensor>* outputs,
              bool copy_to_fd = true) override;
 
+  bool SupportAsync() const override { return true; }
+
+  bool InferAsync(std::vector<FDTensor>& inputs,
+                  std::vector<FDTensor>* outputs,
+                  const std::function<void(bool)>& callback) override;
+
   int NumInputs() const override;
 
   int NumOutputs() const override;
@@ -63,8 +73,24 @@ class OpenVINOBackend : public BaseBackend {
   void InitTensorInfo(const std::vector<ov::Output<ov::Node>>& ov_outputs,
                       std::map<std::string, TensorInfo>* tensor_infos);
 
+  // Get an idle request for asynchronous inference, waits while all the
+  // requests are busy, nullptr if none is released in
+  // OpenVINOBackendOption::async_request_timeout_ms
+  ov::InferRequest* AcquireAsyncRequest();
+  void ReleaseAsyncRequest(ov::InferRequest* request);
+  // Called once the callback of an asynchronous request returns
+  void FinishAsyncRequest();
+
   ov::CompiledModel compiled_model_;
   ov::InferRequest request_;
+  // The requests for asynchronous inference, created on demand and up to the
+  // optimal number of requests of the compiled model
+  std::vector<std::unique_ptr<ov::InferRequest>> async_requests_;
+  std::vector<ov::InferRequest*> idle_async_requests_;
+  // Number of the asynchronous requests whose callbacks are not returned
+  int num_running_async_requests_ = 0;
+  std::mutex async_mutex_;
+  std::condition_variable async_cond_;
   OpenVINOBackendOption option_;
   std::vector<TensorInfo> input_infos_;
   std::vector<TensorInfo> output_infos_;
@@ -17,6 +17,7 @@
 #include <map>
 
 #ifndef NON_64_PLATFORM
+#include "fastdeploy/function/nms.h"
 #include "onnxruntime_cxx_api.h"  // NOLINT
 
 namespace fastdeploy {
@@ -32,6 +33,9 @@ struct MultiClassNmsKernel {
   float score_threshold;
   Ort::CustomOpApi ort_;
 
+  // The parameters of the NMS of a class
+  function::NMSParams GetNMSParams() const;
+
  public:
   MultiClassNmsKernel(Ort::CustomOpApi ort, const OrtKernelInfo* info)
       : ort_(ort) {
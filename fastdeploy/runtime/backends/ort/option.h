@@ -41,11 +41,18 @@ struct OrtBackendOption {
    * @brief Execution mode for the graph, -1: default(Sequential mode)/0: Sequential mode, execute the operators in graph one by one. /1: Parallel mode, execute the operators in graph parallelly.
    */
   int execution_mode = -1;
+  /*
+   * @brief Bind the output FDTensors as the outputs of ONNX Runtime while their shapes are known, i.e the static output shapes or the shapes seen with the same input shapes before. Inference writes into the FDTensors directly, without binding and copying the outputs every time
+   */
+  bool prebind_outputs = false;
   /// Inference device, OrtBackend supports CPU/GPU
   Device device = Device::CPU;
   /// Inference device id
   int device_id = 0;
 
   void* external_stream_ = nullptr;
+  // Directory to cache the ONNX model converted from Paddle, empty means
+  // converting every time
+  std::string paddle2onnx_cache_dir_ = "";
 };
 }  // namespace fastdeploy
@@ -27,6 +27,7 @@ void BindOrtOption(pybind11::module& m) {
       .def_readwrite("inter_op_num_threads",
                      &OrtBackendOption::inter_op_num_threads)
       .def_readwrite("execution_mode", &OrtBackendOption::execution_mode)
+      .def_readwrite("prebind_outputs", &OrtBackendOption::prebind_outputs)
       .def_readwrite("device", &OrtBackendOption::device)
       .def_readwrite("device_id", &OrtBackendOption::device_id);
 }
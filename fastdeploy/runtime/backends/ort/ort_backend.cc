@@ -14,6 +14,7 @@
 
 #include "fastdeploy/runtime/backends/ort/ort_backend.h"
 #include "fastdeploy/core/float16.h"
+#include "fastdeploy/runtime/backends/common/paddle2onnx_cache.h"
 #include "fastdeploy/runtime/backends/ort/ops/adaptive_pool2d.h"
 #include "fastdeploy/runtime/backends/ort/ops/multiclass_nms.h"
 #include "fastdeploy/runtime/backends/ort/utils.h"
@@ -22,6 +23,7 @@
 #include "paddle2onnx/converter.h"
 #endif
 
+#include <algorithm>
 #include <memory>
 
 
@@ -84,35 +86,26 @@ bool OrtBackend::Init(const RuntimeOption& option) {
   ort_option.device = option.device;
   ort_option.device_id = option.device_id;
   ort_option.external_stream_ = option.external_stream_;
+  ort_option.paddle2onnx_cache_dir_ = option.paddle2onnx_cache_dir;
 
-  if (option.model_format == ModelFormat::PADDLE) {
-    if (option.model_from_memory_) {
-      return InitFromPaddle(option.model_file, option.params_file, ort_option);
-    }
-    std::string model_buffer, params_buffer;
-    FDASSERT(ReadBinaryFromFile(option.model_file, &model_buffer),
-             "Failed to read model file.");
-    FDASSERT(ReadBinaryFromFile(option.params_file, &params_buffer),
-             "Failed to read parameters file.");
-    return InitFromPaddle(model_buffer, params_buffer, ort_option);
-  } else if (option.model_format == ModelFormat::ONNX) {
-    if (option.model_from_memory_) {
-      return InitFromOnnx(option.model_file, ort_option);
-    }
-    std::string model_buffer;
-    FDASSERT(ReadBinaryFromFile(option.model_file, &model_buffer),
-             "Failed to read model file.");
-    return InitFromOnnx(model_buffer, ort_option);
-  } else {
+  if (option.model_format != ModelFormat::PADDLE &&
+      option.model_format != ModelFormat::ONNX) {
     FDERROR << "Only support Paddle/ONNX model format for OrtBackend."
             << std::endl;
     return false;
   }
-  return false;
+  ModelSource model_buffer;
+  ModelSource params_buffer;
+  FDASSERT(option.GetModelSource(&model_buffer, &params_buffer),
+           "Failed to read model file or parameters file.");
+  if (option.model_format == ModelFormat::PADDLE) {
+    return InitFromPaddle(model_buffer, params_buffer, ort_option);
+  }
+  return InitFromOnnx(model_buffer, ort_option);
 }
 
-bool OrtBackend::InitFromPaddle(const std::string& model_buffer,
-                                const std::string& params_buffer,
+bool OrtBackend::InitFromPaddle(const ModelSource& model_buffer,
+                                const ModelSource& params_buffer,
                                 const OrtBackendOption& option, bool verbose) {
   if (initialized_) {
     FDERROR << "OrtBackend is already initlized, cannot initialize again."
@@ -123,20 +116,50 @@ bool OrtBackend::InitFromPaddle(const std::string& model_buffer,
   int model_content_size = 0;
   bool save_external = false;
 #ifdef ENABLE_PADDLE2ONNX
+  Paddle2OnnxConvertInfo convert_info;
+  convert_info.deploy_backend = "onnxruntime";
+  convert_info.custom_ops = {{"multiclass_nms3", "MultiClassNMS"},
+                             {"pool2d", "AdaptivePool2d"}};
+  Paddle2OnnxCache cache(option.paddle2onnx_cache_dir_);
+  std::string cache_key;
+  if (cache.Enabled()) {
+    cache_key =
+        Paddle2OnnxCache::ComputeKey(model_buffer, params_buffer, convert_info);
+    std::string onnx_model_proto;
+    if (cache.Load(cache_key, &onnx_model_proto)) {
+      return InitFromOnnx(ModelSource::View(onnx_model_proto), option);
+    }
+    std::string model_file;
+    if (cache.LoadExternal(cache_key, &model_file)) {
+      return InitFromOnnx(ModelSource(), option, model_file);
+    }
+  }
+  // The external data of the models bigger than 2GB is exported into the
+  // staging directory of the cache entry, otherwise the current directory
+  std::string staging_dir;
+  std::string external_file;
+  if (cache.Enabled() && cache.CreateStagingDir(cache_key, &staging_dir)) {
+    external_file = Paddle2OnnxCache::ExternalDataPath(staging_dir);
+  }
+
   std::vector<paddle2onnx::CustomOp> ops;
-  ops.resize(2);
-  strcpy(ops[0].op_name, "multiclass_nms3");
-  strcpy(ops[0].export_op_name, "MultiClassNMS");
-  strcpy(ops[1].op_name, "pool2d");
-  strcpy(ops[1].export_op_name, "AdaptivePool2d");
-
-  if (!paddle2onnx::Export(model_buffer.c_str(), model_buffer.size(),
-                           params_buffer.c_str(), params_buffer.size(),
-                           &model_content_ptr, &model_content_size, 11, true,
-                           verbose, true, true, true, ops.data(), 2,
-                           "onnxruntime", nullptr, 0, "", &save_external)) {
+  ops.resize(convert_info.custom_ops.size());
+  for (size_t i = 0; i < ops.size(); ++i) {
+    strcpy(ops[i].op_name, convert_info.custom_ops[i].first.c_str());
+    strcpy(ops[i].export_op_name, convert_info.custom_ops[i].second.c_str());
+  }
+
+  if (!paddle2onnx::Export(
+          model_buffer.Data(), model_buffer.Size(), params_buffer.Data(),
+          params_buffer.Size(), &model_content_ptr, &model_content_size,
+          convert_info.opset_version, true, verbose, true, true, true,
+          ops.data(), ops.size(), convert_info.deploy_backend.c_str(), nullptr,
+          0, external_file.c_str(), &save_external)) {
     FDERROR << "Error occured while export PaddlePaddle to ONNX format."
             << std::endl;
+    if (!staging_dir.empty()) {
+      cache.DropStagingDir(staging_dir);
+    }
     return false;
   }
 
@@ -144,6 +167,18 @@ bool OrtBackend::InitFromPaddle(const std::string& model_buffer,
                                model_content_ptr + model_content_size);
   delete[] model_content_ptr;
   model_content_ptr = nullptr;
+  if (save_external && !staging_dir.empty()) {
+    // The external data is found next to the model file
+    std::string model_file;
+    cache.SaveExternal(cache_key, staging_dir, onnx_model_proto, "",
+                       &model_file);
+    FDASSERT(!model_file.empty(), "Can not save model to directory: %s.",
+             staging_dir.c_str());
+    return InitFromOnnx(ModelSource(), option, model_file);
+  }
+  if (!staging_dir.empty()) {
+    cache.DropStagingDir(staging_dir);
+  }
   if (save_external) {
     std::string model_file_name = "model.onnx";
     std::fstream f(model_file_name, std::ios::out);
@@ -151,8 +186,10 @@ bool OrtBackend::InitFromPaddle(const std::string& model_buffer,
              model_file_name.c_str());
     f << onnx_model_proto;
     f.close();
+  } else if (cache.Enabled()) {
+    cache.Save(cache_key, onnx_model_proto);
   }
-  return InitFromOnnx(onnx_model_proto, option);
+  return InitFromOnnx(ModelSource::View(onnx_model_proto), option);
 #else
   FDERROR << "Didn't compile with PaddlePaddle Frontend, you can try to "
              "call `InitFromOnnx` instead."
@@ -161,8 +198,9 @@ bool OrtBackend::InitFromPaddle(const std::string& model_buffer,
   return false;
 }
 
-bool OrtBackend::InitFromOnnx(const std::string& model_file,
-                              const OrtBackendOption& option) {
+bool OrtBackend::InitFromOnnx(const ModelSource& model_buffer,
+                              const OrtBackendOption& option,
+                              const std::string& model_file) {
   if (initialized_) {
     FDERROR << "OrtBackend is already initlized, cannot initialize again."
             << std::endl;
@@ -171,7 +209,18 @@ bool OrtBackend::InitFromOnnx(const std::string& model_file,
 
   BuildOption(option);
   InitCustomOperators();
-  session_ = {env_, model_file.data(), model_file.size(), session_options_};
+  if (!model_file.empty()) {
+    // Loaded from the file, so the external data is resolved relative to it
+#ifdef _WIN32
+    std::wstring model_path(model_file.begin(), model_file.end());
+    session_ = {env_, model_path.c_str(), session_options_};
+#else
+    session_ = {env_, model_file.c_str(), session_options_};
+#endif
+  } else {
+    session_ = {env_, model_buffer.Data(), model_buffer.Size(),
+                session_options_};
+  }
   binding_ = std::make_shared<Ort::IoBinding>(session_);
 
   Ort::MemoryInfo memory_info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
@@ -204,6 +253,18 @@ bool OrtBackend::InitFromOnnx(const std::string& model_file,
 
     allocator.Free(output_name);
   }
+  bound_output_ptrs_.assign(n_outputs, nullptr);
+  bound_output_shapes_.assign(n_outputs, std::vector<int64_t>());
+  static_output_shapes_.clear();
+  for (size_t i = 0; i < n_outputs; ++i) {
+    const auto& shape = outputs_desc_[i].shape;
+    if (std::any_of(shape.begin(), shape.end(),
+                    [](int64_t dim) { return dim <= 0; })) {
+      static_output_shapes_.clear();
+      break;
+    }
+    static_output_shapes_.push_back(shape);
+  }
   initialized_ = true;
   return true;
 }
@@ -264,10 +325,9 @@ bool OrtBackend::Infer(std::vector<FDTensor>& inputs,
     binding_->BindInput(inputs[i].name.c_str(), ort_value);
   }
 
-  for (size_t i = 0; i < outputs_desc_.size(); ++i) {
-    Ort::MemoryInfo memory_info("Cpu", OrtDeviceAllocator, 0,
-                                OrtMemTypeDefault);
-    binding_->BindOutput(outputs_desc_[i].name.c_str(), memory_info);
+  bool prebound = option_.prebind_outputs && PrebindOutputs(inputs, outputs);
+  if (!prebound) {
+    BindAllocatedOutputs();
   }
 
   // Inference with inputs
@@ -275,22 +335,128 @@ bool OrtBackend::Infer(std::vector<FDTensor>& inputs,
   try {
     session_.Run({}, *(binding_.get()));
   } catch (const std::exception& e) {
-    FDERROR << "Failed to Infer: " << e.what() << std::endl;
-    return false;
+    if (!prebound) {
+      FDERROR << "Failed to Infer: " << e.what() << std::endl;
+      return false;
+    }
+    // The output shapes depend on the input data, never prebind them again
+    if (!static_output_shapes_.empty()) {
+      static_output_shapes_.clear();
+    } else {
+      RecordOutputShapes(inputs, std::vector<FDTensor>());
+    }
+    prebound = false;
+    BindAllocatedOutputs();
+    try {
+      session_.Run({}, *(binding_.get()));
+    } catch (const std::exception& e) {
+      FDERROR << "Failed to Infer: " << e.what() << std::endl;
+      return false;
+    }
   }
   RUNTIME_PROFILE_LOOP_END
 
-  // Convert result after inference
-  std::vector<Ort::Value> ort_outputs = binding_->GetOutputValues();
-  outputs->resize(ort_outputs.size());
-  for (size_t i = 0; i < ort_outputs.size(); ++i) {
-    OrtValueToFDTensor(ort_outputs[i], &((*outputs)[i]), outputs_desc_[i].name,
-                       copy_to_fd);
+  // The outputs are written into FDTensors directly while they're prebound
+  if (!prebound) {
+    // Convert result after inference. While prebinding, the outputs always
+    // own their buffers, which will be bound by the following calls.
+    std::vector<Ort::Value> ort_outputs = binding_->GetOutputValues();
+    outputs->resize(ort_outputs.size());
+    for (size_t i = 0; i < ort_outputs.size(); ++i) {
+      OrtValueToFDTensor(ort_outputs[i], &((*outputs)[i]),
+                         outputs_desc_[i].name,
+                         copy_to_fd || option_.prebind_outputs);
+    }
+    if (option_.prebind_outputs) {
+      RecordOutputShapes(inputs, *outputs);
+    }
   }
   RUNTIME_PROFILE_LOOP_H2D_D2H_END
   return true;
 }
 
+bool OrtBackend::PrebindOutputs(const std::vector<FDTensor>& inputs,
+                                std::vector<FDTensor>* outputs) {
+  const std::vector<std::vector<int64_t>>* output_shapes =
+      &static_output_shapes_;
+  if (static_output_shapes_.empty()) {
+    std::vector<std::vector<int64_t>> input_shapes;
+    input_shapes.reserve(inputs.size());
+    for (const auto& input : inputs) {
+      input_shapes.push_back(input.shape);
+    }
+    auto iter = seen_output_shapes_.find(input_shapes);
+    if (iter == seen_output_shapes_.end() || iter->second.empty()) {
+      return false;
+    }
+    output_shapes = &(iter->second);
+  }
+
+  outputs->resize(outputs_desc_.size());
+  for (size_t i = 0; i < outputs_desc_.size(); ++i) {
+    FDTensor& tensor = (*outputs)[i];
+    const auto& shape = (*output_shapes)[i];
+    FDDataType dtype = GetFdDtype(outputs_desc_[i].dtype);
+    // The buffer provided by user is used as it is if it fits the output,
+    // otherwise the tensor allocates its own buffer, which is reused by the
+    // following calls
+    bool user_buffer = tensor.external_data_ptr != nullptr &&
+                       tensor.device == Device::CPU && tensor.dtype == dtype &&
+                       tensor.shape == shape;
+    if (!user_buffer) {
+      tensor.Resize(shape, dtype, outputs_desc_[i].name, Device::CPU);
+    }
+    tensor.name = outputs_desc_[i].name;
+    void* data = tensor.MutableData();
+    if (bound_output_ptrs_[i] == data && bound_output_shapes_[i] == shape) {
+      continue;
+    }
+    auto ort_value = Ort::Value::CreateTensor(
+        cpu_memory_info_, data, tensor.Nbytes(), shape.data(), shape.size(),
+        outputs_desc_[i].dtype);
+    binding_->BindOutput(outputs_desc_[i].name.c_str(), ort_value);
+    bound_output_ptrs_[i] = data;
+    bound_output_shapes_[i] = shape;
+  }
+  return true;
+}
+
+void OrtBackend::BindAllocatedOutputs() {
+  for (size_t i = 0; i < outputs_desc_.size(); ++i) {
+    binding_->BindOutput(outputs_desc_[i].name.c_str(), cpu_memory_info_);
+    bound_output_ptrs_[i] = nullptr;
+    bound_output_shapes_[i].clear();
+  }
+}
+
+void OrtBackend::RecordOutputShapes(const std::vector<FDTensor>& inputs,
+                                    const std::vector<FDTensor>& outputs) {
+  // Too many different input shapes, the prebinding doesn't help much
+  const size_t max_recorded_shapes = 64;
+  if (!static_output_shapes_.empty() ||
+      seen_output_shapes_.size() >= max_recorded_shapes) {
+    return;
+  }
+  std::vector<std::vector<int64_t>> input_shapes;
+  input_shapes.reserve(inputs.size());
+  for (const auto& input : inputs) {
+    input_shapes.push_back(input.shape);
+  }
+  auto iter = seen_output_shapes_.find(input_shapes);
+  if (iter != seen_output_shapes_.end()) {
+    // An empty record means the shapes can't be prebound, which is kept
+    if (!iter->second.empty() && outputs.empty()) {
+      iter->second.clear();
+    }
+    return;
+  }
+  std::vector<std::vector<int64_t>> output_shapes;
+  for (const auto& output : outputs) {
+    output_shapes.push_back(output.shape);
+  }
+  seen_output_shapes_[input_shapes] = output_shapes;
+}
+
 TensorInfo OrtBackend::GetInputInfo(int index) {
   FDASSERT(index < NumInputs(),
            "The index: %d should less than the number of inputs: %d.", index,
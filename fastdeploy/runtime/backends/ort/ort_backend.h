@@ -56,13 +56,16 @@ class OrtBackend : public BaseBackend {
   void InitCustomOperators();
   
  private:
-  bool InitFromPaddle(const std::string& model_buffer,
-                      const std::string& params_buffer,
+  bool InitFromPaddle(const ModelSource& model_buffer,
+                      const ModelSource& params_buffer,
                       const OrtBackendOption& option = OrtBackendOption(),
                       bool verbose = false);
 
-  bool InitFromOnnx(const std::string& model_buffer,
-                    const OrtBackendOption& option = OrtBackendOption());
+  // Loads `model_file` instead of `model_buffer` if it's not empty, for the
+  // models with external data
+  bool InitFromOnnx(const ModelSource& model_buffer,
+                    const OrtBackendOption& option = OrtBackendOption(),
+                    const std::string& model_file = "");
 
   Ort::Env env_;
   Ort::Session session_{nullptr};
@@ -76,5 +79,27 @@ class OrtBackend : public BaseBackend {
   OrtBackendOption option_;
   void OrtValueToFDTensor(const Ort::Value& value, FDTensor* tensor,
                           const std::string& name, bool copy_to_fd);
+
+  // Bind the output tensors as the outputs of session while their shapes are
+  // known, return false if the outputs should be allocated by ONNX Runtime
+  bool PrebindOutputs(const std::vector<FDTensor>& inputs,
+                      std::vector<FDTensor>* outputs);
+  void BindAllocatedOutputs();
+  void RecordOutputShapes(const std::vector<FDTensor>& inputs,
+                          const std::vector<FDTensor>& outputs);
+
+  Ort::MemoryInfo cpu_memory_info_{
+      Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault)};
+  // Output shapes of the model if they're all static, otherwise empty
+  std::vector<std::vector<int64_t>> static_output_shapes_;
+  // Input shapes -> output shapes seen before, empty if the output shapes
+  // depend on the input data and can't be prebound
+  std::map<std::vector<std::vector<int64_t>>,
+           std::vector<std::vector<int64_t>>>
+      seen_output_shapes_;
+  // The buffers bound as outputs now, the binding is skipped while the
+  // buffer and shape are not changed
+  std::vector<const void*> bound_output_ptrs_;
+  std::vector<std::vector<int64_t>> bound_output_shapes_;
 };
 }  // namespace fastdeploy
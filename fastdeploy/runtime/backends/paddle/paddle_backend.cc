@@ -96,20 +96,27 @@ void PaddleBackend::BuildOption(const PaddleBackendOption& option) {
 bool PaddleBackend::InitFromPaddle(const std::string& model_buffer,
                                    const std::string& params_buffer,
                                    const PaddleBackendOption& option) {
+  return InitFromPaddle(ModelSource::View(model_buffer),
+                        ModelSource::View(params_buffer), option);
+}
+
+bool PaddleBackend::InitFromPaddle(const ModelSource& model_buffer,
+                                   const ModelSource& params_buffer,
+                                   const PaddleBackendOption& option) {
   if (initialized_) {
     FDERROR << "PaddleBackend is already initlized, cannot initialize again."
             << std::endl;
     return false;
   }
-  config_.SetModelBuffer(model_buffer.c_str(), model_buffer.size(),
-                         params_buffer.c_str(), params_buffer.size());
+  config_.SetModelBuffer(model_buffer.Data(), model_buffer.Size(),
+                         params_buffer.Data(), params_buffer.Size());
   config_.EnableMemoryOptim();
   BuildOption(option);
 
   // The input/output information get from predictor is not right, use
   // PaddleReader instead now
   auto reader =
-      paddle2onnx::PaddleReader(model_buffer.c_str(), model_buffer.size());
+      paddle2onnx::PaddleReader(model_buffer.Data(), model_buffer.Size());
   // If it's a quantized model, and use cpu with mkldnn, automaticaly switch to
   // int8 mode
   if (reader.is_quantize_model) {
@@ -174,9 +181,9 @@ bool PaddleBackend::InitFromPaddle(const std::string& model_buffer,
     if (!CheckFileExists(shape_range_info)) {
       FDINFO << "Start generating shape range info file." << std::endl;
       paddle_infer::Config analysis_config;
-      analysis_config.SetModelBuffer(model_buffer.c_str(), model_buffer.size(),
-                                     params_buffer.c_str(),
-                                     params_buffer.size());
+      analysis_config.SetModelBuffer(model_buffer.Data(), model_buffer.Size(),
+                                     params_buffer.Data(),
+                                     params_buffer.Size());
       analysis_config.CollectShapeRangeInfo(shape_range_info);
       auto predictor_tmp = paddle_infer::CreatePredictor(analysis_config);
       std::map<std::string, std::vector<int>> max_shape;
@@ -263,26 +270,25 @@ std::unique_ptr<BaseBackend> PaddleBackend::Clone(RuntimeOption& runtime_option,
     auto clone_option = option_;
     clone_option.device_id = device_id;
     clone_option.external_stream_ = stream;
+    ModelSource model_buffer;
+    ModelSource params_buffer;
     if (runtime_option.model_from_memory_) {
-      FDASSERT(
-          casted_backend->InitFromPaddle(runtime_option.model_file,
-                                         runtime_option.params_file,
-                                         clone_option),
-          "Clone model from Paddle failed while initialize PaddleBackend.");
+      FDASSERT(runtime_option.GetModelSource(&model_buffer, &params_buffer),
+               "Fail to get model buffer while cloning PaddleBackend");
     } else {
-      std::string model_buffer = "";
-      std::string params_buffer = "";
-      FDASSERT(
-          ReadBinaryFromFile(clone_option.model_file, &model_buffer),
-          "Fail to read binary from model file while cloning PaddleBackend");
-      FDASSERT(ReadBinaryFromFile(clone_option.params_file, &params_buffer),
+      FDASSERT(ModelSource::FromFile(clone_option.model_file, &model_buffer,
+                                     runtime_option.enable_model_mmap),
+               "Fail to read binary from model file while cloning "
+               "PaddleBackend");
+      FDASSERT(ModelSource::FromFile(clone_option.params_file, &params_buffer,
+                                     runtime_option.enable_model_mmap),
                "Fail to read binary from parameter file while cloning "
                "PaddleBackend");
-      FDASSERT(
-          casted_backend->InitFromPaddle(model_buffer, params_buffer,
-                                         clone_option),
-          "Clone model from Paddle failed while initialize PaddleBackend.");
     }
+    FDASSERT(
+        casted_backend->InitFromPaddle(model_buffer, params_buffer,
+                                       clone_option),
+        "Clone model from Paddle failed while initialize PaddleBackend.");
 
     FDWARNING << "The target device id:" << device_id
               << " is different from current device id:" << option_.device_id
@@ -57,6 +57,10 @@ class PaddleBackend : public BaseBackend {
                      const std::string& params_buffer,
                      const PaddleBackendOption& option = PaddleBackendOption());
 
+  bool InitFromPaddle(const ModelSource& model_buffer,
+                      const ModelSource& params_buffer,
+                      const PaddleBackendOption& option = PaddleBackendOption());
+
   bool Infer(std::vector<FDTensor>& inputs, std::vector<FDTensor>* outputs,
              bool copy_to_fd = true) override;
 
@@ -74,6 +74,8 @@ struct TrtBackendOption {
   bool enable_pinned_memory = false;
   void* external_stream_ = nullptr;
   int gpu_id = 0;
+  // Directory to cache the ONNX model converted from Paddle
+  std::string paddle2onnx_cache_dir_ = "";
   std::string model_file = "";   // Path of model file
   std::string params_file = "";  // Path of parameters file, can be empty
   // format of input model
@@ -19,6 +19,7 @@
 
 #include "NvInferRuntime.h"
 #include "fastdeploy/function/cuda_cast.h"
+#include "fastdeploy/runtime/backends/common/paddle2onnx_cache.h"
 #include "fastdeploy/utils/utils.h"
 #ifdef ENABLE_PADDLE2ONNX
 #include "paddle2onnx/converter.h"
@@ -126,39 +127,22 @@ bool TrtBackend::Init(const RuntimeOption& runtime_option) {
         << runtime_option.model_format << "." << std::endl;
     return false;
   }
+  ModelSource model_buffer;
+  ModelSource params_buffer;
+  FDASSERT(runtime_option.GetModelSource(&model_buffer, &params_buffer),
+           "Failed to read model file %s or parameters file %s.",
+           runtime_option.model_file.c_str(),
+           runtime_option.params_file.c_str());
   if (runtime_option.model_format == ModelFormat::PADDLE) {
-    if (runtime_option.model_from_memory_) {
-      return InitFromPaddle(runtime_option.model_file,
-                            runtime_option.params_file,
-                            runtime_option.trt_option);
-    } else {
-      std::string model_buffer;
-      std::string params_buffer;
-      FDASSERT(ReadBinaryFromFile(runtime_option.model_file, &model_buffer),
-               "Failed to read model file %s.",
-               runtime_option.model_file.c_str());
-      FDASSERT(ReadBinaryFromFile(runtime_option.params_file, &params_buffer),
-               "Failed to read parameters file %s.",
-               runtime_option.params_file.c_str());
-      return InitFromPaddle(model_buffer, params_buffer,
-                            runtime_option.trt_option);
-    }
-  } else {
-    if (runtime_option.model_from_memory_) {
-      return InitFromOnnx(runtime_option.model_file, runtime_option.trt_option);
-    } else {
-      std::string model_buffer;
-      FDASSERT(ReadBinaryFromFile(runtime_option.model_file, &model_buffer),
-               "Failed to read model file %s.",
-               runtime_option.model_file.c_str());
-      return InitFromOnnx(model_buffer, runtime_option.trt_option);
-    }
+    return InitFromPaddle(model_buffer, params_buffer,
+                          runtime_option.trt_option);
   }
-  return true;
+  // TensorRT keeps the ONNX model to rebuild engine while the shape changes
+  return InitFromOnnx(model_buffer.ToString(), runtime_option.trt_option);
 }
 
-bool TrtBackend::InitFromPaddle(const std::string& model_buffer,
-                                const std::string& params_buffer,
+bool TrtBackend::InitFromPaddle(const ModelSource& model_buffer,
+                                const ModelSource& params_buffer,
                                 const TrtBackendOption& option, bool verbose) {
   if (initialized_) {
     FDERROR << "TrtBackend is already initlized, cannot initialize again."
@@ -168,22 +152,56 @@ bool TrtBackend::InitFromPaddle(const std::string& model_buffer,
   option_ = option;
 
 #ifdef ENABLE_PADDLE2ONNX
+  Paddle2OnnxConvertInfo convert_info;
+  convert_info.deploy_backend = "tensorrt";
+  convert_info.custom_ops = {{"pool2d", "AdaptivePool2d"}};
+  Paddle2OnnxCache cache(option.paddle2onnx_cache_dir_);
+  std::string cache_key;
+  if (cache.Enabled()) {
+    cache_key =
+        Paddle2OnnxCache::ComputeKey(model_buffer, params_buffer, convert_info);
+    std::string onnx_model_proto;
+    if (cache.Load(cache_key, &onnx_model_proto, &calibration_str_)) {
+      save_external_ = false;
+      return InitFromOnnx(onnx_model_proto, option);
+    }
+    if (cache.LoadExternal(cache_key, &model_file_name_, &calibration_str_)) {
+      FDASSERT(ReadBinaryFromFile(model_file_name_, &onnx_model_proto),
+               "Can not read model file: %s.", model_file_name_.c_str());
+      save_external_ = true;
+      return InitFromOnnx(onnx_model_proto, option);
+    }
+  }
+  // The external data of the models bigger than 2GB is exported into the
+  // staging directory of the cache entry, otherwise the current directory
+  std::string staging_dir;
+  std::string external_file;
+  if (cache.Enabled() && cache.CreateStagingDir(cache_key, &staging_dir)) {
+    external_file = Paddle2OnnxCache::ExternalDataPath(staging_dir);
+  }
+
   std::vector<paddle2onnx::CustomOp> ops;
-  ops.resize(1);
-  strcpy(ops[0].op_name, "pool2d");
-  strcpy(ops[0].export_op_name, "AdaptivePool2d");
+  ops.resize(convert_info.custom_ops.size());
+  for (size_t i = 0; i < ops.size(); ++i) {
+    strcpy(ops[i].op_name, convert_info.custom_ops[i].first.c_str());
+    strcpy(ops[i].export_op_name, convert_info.custom_ops[i].second.c_str());
+  }
   char* model_content_ptr;
   int model_content_size = 0;
   char* calibration_cache_ptr;
   int calibration_cache_size = 0;
-  if (!paddle2onnx::Export(model_buffer.c_str(), model_buffer.size(),
-                           params_buffer.c_str(), params_buffer.size(),
-                           &model_content_ptr, &model_content_size, 11, true,
-                           verbose, true, true, true, ops.data(), 1, "tensorrt",
-                           &calibration_cache_ptr, &calibration_cache_size, "",
-                           &save_external_)) {
+  if (!paddle2onnx::Export(
+          model_buffer.Data(), model_buffer.Size(), params_buffer.Data(),
+          params_buffer.Size(), &model_content_ptr, &model_content_size,
+          convert_info.opset_version, true, verbose, true, true, true,
+          ops.data(), ops.size(), convert_info.deploy_backend.c_str(),
+          &calibration_cache_ptr, &calibration_cache_size,
+          external_file.c_str(), &save_external_)) {
     FDERROR << "Error occured while export PaddlePaddle to ONNX format."
             << std::endl;
+    if (!staging_dir.empty()) {
+      cache.DropStagingDir(staging_dir);
+    }
     return false;
   }
   std::string onnx_model_proto(model_content_ptr,
@@ -196,6 +214,17 @@ bool TrtBackend::InitFromPaddle(const std::string& model_buffer,
     calibration_str_ = calibration_str;
     delete[] calibration_cache_ptr;
   }
+  if (save_external_ && !staging_dir.empty()) {
+    // TensorRT parses the model file, the external data is found next to it
+    cache.SaveExternal(cache_key, staging_dir, onnx_model_proto,
+                       calibration_str_, &model_file_name_);
+    FDASSERT(!model_file_name_.empty(),
+             "Can not save model to directory: %s.", staging_dir.c_str());
+    return InitFromOnnx(onnx_model_proto, option);
+  }
+  if (!staging_dir.empty()) {
+    cache.DropStagingDir(staging_dir);
+  }
   if (save_external_) {
     model_file_name_ = "model.onnx";
     std::fstream f(model_file_name_, std::ios::out);
@@ -203,6 +232,8 @@ bool TrtBackend::InitFromPaddle(const std::string& model_buffer,
              model_file_name_.c_str());
     f << onnx_model_proto;
     f.close();
+  } else if (cache.Enabled()) {
+    cache.Save(cache_key, onnx_model_proto, calibration_str_);
   }
   return InitFromOnnx(onnx_model_proto, option);
 #else
@@ -778,33 +809,31 @@ std::unique_ptr<BaseBackend> TrtBackend::Clone(RuntimeOption& runtime_option,
     auto clone_option = option_;
     clone_option.gpu_id = device_id;
     clone_option.external_stream_ = stream;
+    ModelSource model_buffer;
+    ModelSource params_buffer;
     if (runtime_option.model_from_memory_) {
-      FDASSERT(casted_backend->InitFromPaddle(runtime_option.model_file,
-                                              runtime_option.params_file,
-                                              clone_option),
-               "Clone model from Paddle failed while initialize TrtBackend.");
+      FDASSERT(runtime_option.GetModelSource(&model_buffer, &params_buffer),
+               "Fail to get model buffer while cloning TrtBackend");
     } else {
-      if (option_.model_format == ModelFormat::ONNX) {
-        std::string model_buffer = "";
+      FDASSERT(ModelSource::FromFile(clone_option.model_file, &model_buffer,
+                                     runtime_option.enable_model_mmap),
+               "Fail to read binary from model file while cloning TrtBackend");
+      if (option_.model_format != ModelFormat::ONNX) {
         FDASSERT(
-            ReadBinaryFromFile(clone_option.model_file, &model_buffer),
-            "Fail to read binary from model file while cloning TrtBackend");
-        FDASSERT(casted_backend->InitFromOnnx(model_buffer, clone_option),
-                 "Clone model from ONNX failed while initialize TrtBackend.");
-      } else {
-        std::string model_buffer = "";
-        std::string params_buffer = "";
-        FDASSERT(
-            ReadBinaryFromFile(clone_option.model_file, &model_buffer),
-            "Fail to read binary from model file while cloning TrtBackend");
-        FDASSERT(
-            ReadBinaryFromFile(clone_option.params_file, &params_buffer),
+            ModelSource::FromFile(clone_option.params_file, &params_buffer,
+                                  runtime_option.enable_model_mmap),
             "Fail to read binary from parameter file while cloning TrtBackend");
-        FDASSERT(casted_backend->InitFromPaddle(model_buffer, params_buffer,
-                                                clone_option),
-                 "Clone model from Paddle failed while initialize TrtBackend.");
       }
     }
+    if (option_.model_format == ModelFormat::ONNX) {
+      FDASSERT(casted_backend->InitFromOnnx(model_buffer.ToString(),
+                                            clone_option),
+               "Clone model from ONNX failed while initialize TrtBackend.");
+    } else {
+      FDASSERT(casted_backend->InitFromPaddle(model_buffer, params_buffer,
+                                              clone_option),
+               "Clone model from Paddle failed while initialize TrtBackend.");
+    }
     FDWARNING << "The target device id:" << device_id
               << " is different from current device id:" << option_.gpu_id
               << ", cannot share memory with current engine." << std::endl;
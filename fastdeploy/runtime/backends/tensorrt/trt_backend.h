@@ -94,8 +94,8 @@ class TrtBackend : public BaseBackend {
  private:
   void BuildOption(const TrtBackendOption& option);
 
-  bool InitFromPaddle(const std::string& model_buffer,
-                      const std::string& params_buffer,
+  bool InitFromPaddle(const ModelSource& model_buffer,
+                      const ModelSource& params_buffer,
                       const TrtBackendOption& option = TrtBackendOption(),
                       bool verbose = false);
   bool InitFromOnnx(const std::string& model_buffer,
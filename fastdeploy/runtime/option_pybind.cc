@@ -34,7 +34,10 @@ void BindOption(pybind11::module& m) {
   pybind11::class_<RuntimeOption>(m, "RuntimeOption")
       .def(pybind11::init())
       .def("set_model_path", &RuntimeOption::SetModelPath)
-      .def("set_model_buffer", &RuntimeOption::SetModelBuffer)
+      .def("set_model_buffer",
+           static_cast<void (RuntimeOption::*)(
+               const std::string&, const std::string&, const ModelFormat&)>(
+               &RuntimeOption::SetModelBuffer))
       .def("set_encryption_key", &RuntimeOption::SetEncryptionKey)
       .def("use_gpu", &RuntimeOption::UseGpu)
       .def("use_cpu", &RuntimeOption::UseCpu)
@@ -58,6 +61,11 @@ void BindOption(pybind11::module& m) {
       .def("use_lite_backend", &RuntimeOption::UseLiteBackend)
       .def("enable_pinned_memory", &RuntimeOption::EnablePinnedMemory)
       .def("disable_pinned_memory", &RuntimeOption::DisablePinnedMemory)
+      .def("enable_model_mmap", &RuntimeOption::EnableModelMmap)
+      .def("disable_model_mmap", &RuntimeOption::DisableModelMmap)
+      .def("set_paddle2onnx_cache_dir", &RuntimeOption::SetPaddle2OnnxCacheDir)
+      .def("set_shape_buckets", &RuntimeOption::SetShapeBuckets)
+      .def("set_shape_bucket_crop", &RuntimeOption::SetShapeBucketCrop)
       .def("use_ipu", &RuntimeOption::UseIpu)
       .def("enable_profiling", &RuntimeOption::EnableProfiling)
       .def("disable_profiling", &RuntimeOption::DisableProfiling)
@@ -14,6 +14,10 @@
 
 #include "fastdeploy/runtime/runtime.h"
 
+#include <condition_variable>
+#include <queue>
+#include <thread>
+
 #include "fastdeploy/utils/unique_ptr.h"
 #include "fastdeploy/utils/utils.h"
 
@@ -108,6 +112,12 @@ bool Runtime::Init(const RuntimeOption& _option) {
   if ("" != option.encryption_key_) {
 #ifdef ENABLE_ENCRYPTION
     if (option.model_from_memory_) {
+      if (!option.model_source_.Empty()) {
+        option.model_file = option.model_source_.ToString();
+        option.params_file = option.params_source_.ToString();
+        option.model_source_ = ModelSource();
+        option.params_source_ = ModelSource();
+      }
       option.model_file = Decrypt(option.model_file, option.encryption_key_);
       if (!(option.params_file.empty())) {
         option.params_file =
@@ -169,9 +179,32 @@ bool Runtime::Init(const RuntimeOption& _option) {
             << std::endl;
     return false;
   }
+  InitShapeBucketer();
+  return true;
+}
+
+bool Runtime::Init(const RuntimeOption& _option,
+                   std::unique_ptr<BaseBackend>&& backend) {
+  if (backend == nullptr || !backend->Initialized()) {
+    FDERROR << "Runtime requires an initialized backend." << std::endl;
+    return false;
+  }
+  option = _option;
+  backend_ = std::move(backend);
+  backend_->benchmark_option_ = option.benchmark_option;
+  external_backend_ = true;
+  InitShapeBucketer();
   return true;
 }
 
+void Runtime::InitShapeBucketer() {
+  shape_bucketer_.reset();
+  if (!option.shape_bucket_option.buckets.empty()) {
+    shape_bucketer_ =
+        std::make_shared<ShapeBucketer>(option.shape_bucket_option);
+  }
+}
+
 TensorInfo Runtime::GetInputInfo(int index) {
   return backend_->GetInputInfo(index);
 }
@@ -188,16 +221,130 @@ std::vector<TensorInfo> Runtime::GetOutputInfos() {
   return backend_->GetOutputInfos();
 }
 
-bool Runtime::Infer(std::vector<FDTensor>& input_tensors,
-                    std::vector<FDTensor>* output_tensors) {
+void Runtime::CheckInputDevices(
+    const std::vector<FDTensor>& input_tensors) const {
   for (auto& tensor : input_tensors) {
     FDASSERT(tensor.device_id < 0 || tensor.device_id == option.device_id,
              "Device id of input tensor(%d) and runtime(%d) are not same.",
              tensor.device_id, option.device_id);
   }
+}
+
+bool Runtime::Infer(std::vector<FDTensor>& input_tensors,
+                    std::vector<FDTensor>* output_tensors) {
+  CheckInputDevices(input_tensors);
+  if (shape_bucketer_ != nullptr &&
+      shape_bucketer_->PadInputs(input_tensors, &bucketed_inputs_)) {
+    if (!backend_->Infer(bucketed_inputs_, output_tensors)) {
+      return false;
+    }
+    shape_bucketer_->CropOutputs(output_tensors);
+    return true;
+  }
   return backend_->Infer(input_tensors, output_tensors);
 }
 
+struct Runtime::AsyncWorker {
+  AsyncWorker() { thread = std::thread(&AsyncWorker::Run, this); }
+
+  ~AsyncWorker() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    cond.notify_all();
+    thread.join();
+  }
+
+  void Submit(std::function<void()>&& task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      tasks.push(std::move(task));
+    }
+    cond.notify_one();
+  }
+
+  // Run until all the submitted tasks are done after stopping
+  void Run() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this] { return stop || !tasks.empty(); });
+        if (tasks.empty()) {
+          return;
+        }
+        task = std::move(tasks.front());
+        tasks.pop();
+      }
+      task();
+    }
+  }
+
+  std::mutex mutex;
+  std::condition_variable cond;
+  std::queue<std::function<void()>> tasks;
+  bool stop = false;
+  std::thread thread;
+};
+
+// The padded inputs of an asynchronous request, kept until the request is
+// done since the backend reads them in flight
+struct Runtime::AsyncBucketedRequest {
+  std::vector<FDTensor> inputs;
+  std::map<std::string, std::vector<int64_t>> origin_shapes;
+};
+
+void Runtime::InferAsync(std::vector<FDTensor>& input_tensors,
+                         std::vector<FDTensor>* output_tensors,
+                         const std::function<void(bool)>& callback) {
+  // The profile loop of the backends repeats a request synchronously, so the
+  // requests go through the worker while profiling
+  if (backend_->SupportAsync() && !option.benchmark_option.enable_profile) {
+    CheckInputDevices(input_tensors);
+    std::shared_ptr<ShapeBucketer> bucketer = shape_bucketer_;
+    auto request = std::make_shared<AsyncBucketedRequest>();
+    bool padded = bucketer != nullptr &&
+                  bucketer->PadInputs(input_tensors, &request->inputs,
+                                      &request->origin_shapes);
+    if (!padded) {
+      bucketer.reset();
+      request.reset();
+    }
+    bool started = backend_->InferAsync(
+        padded ? request->inputs : input_tensors, output_tensors,
+        [bucketer, request, output_tensors, callback](bool success) {
+          if (success && bucketer != nullptr) {
+            bucketer->CropOutputs(request->origin_shapes, output_tensors);
+          }
+          callback(success);
+        });
+    if (!started) {
+      callback(false);
+    }
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(async_worker_mutex_);
+    if (async_worker_ == nullptr) {
+      async_worker_ = std::make_shared<AsyncWorker>();
+    }
+  }
+  std::vector<FDTensor>* inputs = &input_tensors;
+  async_worker_->Submit([this, inputs, output_tensors, callback]() {
+    callback(Infer(*inputs, output_tensors));
+  });
+}
+
+std::future<bool> Runtime::InferAsync(std::vector<FDTensor>& input_tensors,
+                                      std::vector<FDTensor>* output_tensors) {
+  auto promise = std::make_shared<std::promise<bool>>();
+  std::future<bool> result = promise->get_future();
+  InferAsync(input_tensors, output_tensors,
+             [promise](bool success) { promise->set_value(success); });
+  return result;
+}
+
 bool Runtime::Infer() {
   bool result = backend_->Infer(input_tensors_, &output_tensors_, false);
   for (auto& tensor : output_tensors_) {
@@ -240,6 +387,8 @@ void Runtime::ReleaseModelMemoryBuffer() {
     option.model_file.shrink_to_fit();
     option.params_file.clear();
     option.params_file.shrink_to_fit();
+    option.model_source_ = ModelSource();
+    option.params_source_ = ModelSource();
   }
 }
 
@@ -265,23 +414,14 @@ void Runtime::CreatePaddleBackend() {
   auto casted_backend = dynamic_cast<PaddleBackend*>(backend_.get());
   casted_backend->benchmark_option_ = option.benchmark_option;
 
-  if (option.model_from_memory_) {
-    FDASSERT(
-        casted_backend->InitFromPaddle(option.model_file, option.params_file,
-                                       option.paddle_infer_option),
-        "Load model from Paddle failed while initliazing PaddleBackend.");
-    ReleaseModelMemoryBuffer();
-  } else {
-    std::string model_buffer = "";
-    std::string params_buffer = "";
-    FDASSERT(ReadBinaryFromFile(option.model_file, &model_buffer),
-             "Fail to read binary from model file");
-    FDASSERT(ReadBinaryFromFile(option.params_file, &params_buffer),
-             "Fail to read binary from parameter file");
-    FDASSERT(casted_backend->InitFromPaddle(model_buffer, params_buffer,
-                                            option.paddle_infer_option),
-             "Load model from Paddle failed while initliazing PaddleBackend.");
-  }
+  ModelSource model_buffer;
+  ModelSource params_buffer;
+  FDASSERT(option.GetModelSource(&model_buffer, &params_buffer),
+           "Fail to read binary from model file or parameter file");
+  FDASSERT(casted_backend->InitFromPaddle(model_buffer, params_buffer,
+                                          option.paddle_infer_option),
+           "Load model from Paddle failed while initliazing PaddleBackend.");
+  ReleaseModelMemoryBuffer();
 #else
   FDASSERT(false,
            "PaddleBackend is not available, please compiled with "
@@ -328,6 +468,28 @@ void Runtime::CreateTrtBackend() {
   option.trt_option.gpu_id = option.device_id;
   option.trt_option.enable_pinned_memory = option.enable_pinned_memory;
   option.trt_option.external_stream_ = option.external_stream_;
+  option.trt_option.paddle2onnx_cache_dir_ = option.paddle2onnx_cache_dir;
+  // Cover all the shape buckets by the profile if the shape range is not set
+  for (const auto& iter : option.shape_bucket_option.buckets) {
+    if (iter.second.empty() ||
+        option.trt_option.min_shape.count(iter.first) > 0) {
+      continue;
+    }
+    std::vector<int32_t> min_shape(iter.second[0].begin(),
+                                   iter.second[0].end());
+    std::vector<int32_t> max_shape = min_shape;
+    bool all_static = true;
+    for (const auto& shape : iter.second) {
+      for (size_t i = 0; i < shape.size() && i < min_shape.size(); ++i) {
+        all_static = all_static && shape[i] > 0;
+        min_shape[i] = std::min(min_shape[i], static_cast<int32_t>(shape[i]));
+        max_shape[i] = std::max(max_shape[i], static_cast<int32_t>(shape[i]));
+      }
+    }
+    if (all_static) {
+      option.trt_option.SetShape(iter.first, min_shape, max_shape, max_shape);
+    }
+  }
   backend_ = utils::make_unique<TrtBackend>();
   backend_->benchmark_option_ = option.benchmark_option;
   FDASSERT(backend_->Init(option), "Failed to initialize TensorRT backend.");
@@ -394,23 +556,34 @@ void Runtime::CreateSophgoNPUBackend() {
 }
 
 Runtime* Runtime::Clone(void* stream, int device_id) {
-  Runtime* runtime = new Runtime();
-  if (option.backend != Backend::OPENVINO &&
+  std::unique_ptr<Runtime> runtime(new Runtime());
+  if (!external_backend_ && option.backend != Backend::OPENVINO &&
       option.backend != Backend::PDINFER) {
-    runtime->Init(option);
+    if (!runtime->Init(option)) {
+      FDERROR << "Failed to create a new engine with " << option.backend
+              << " while cloning the runtime." << std::endl;
+      return nullptr;
+    }
     FDWARNING << "Only OpenVINO/Paddle Inference support \
                   clone engine to  reduce CPU/GPU memory usage now. For "
               << option.backend
               << ", FastDeploy will create a new engine which \
                   will not share memory  with the current runtime."
               << std::endl;
-    return runtime;
+    return runtime.release();
   }
   FDINFO << "Runtime Clone with Backend:: " << option.backend << " in "
          << option.device << "." << std::endl;
   runtime->option = option;
   runtime->backend_ = backend_->Clone(option, stream, device_id);
-  return runtime;
+  if (runtime->backend_ == nullptr) {
+    FDERROR << "Failed to clone the backend " << option.backend << "."
+            << std::endl;
+    return nullptr;
+  }
+  runtime->external_backend_ = external_backend_;
+  runtime->InitShapeBucketer();
+  return runtime.release();
 }
 
 // only for poros backend
@@ -19,6 +19,9 @@
  */
 
 #pragma once
+#include <functional>
+#include <future>
+#include <mutex>
 #include "fastdeploy/runtime/backends/backend.h"
 #include "fastdeploy/core/fd_tensor.h"
 #include "fastdeploy/runtime/runtime_option.h"
@@ -39,6 +42,15 @@ struct FASTDEPLOY_DECL Runtime {
   /// Intialize a Runtime object with RuntimeOption
   bool Init(const RuntimeOption& _option);
 
+  /** \brief Intialize a Runtime object with a backend created outside, e.g a custom backend
+   *
+   * \param[in] _option Runtime option, the backend and model options in it are not used
+   * \param[in] backend The initialized backend, Clone() of the runtime calls BaseBackend::Clone() of it
+   * \return true if the initialization successed
+   */
+  bool Init(const RuntimeOption& _option,
+            std::unique_ptr<BaseBackend>&& backend);
+
   /** \brief Inference the model by the input data, and write to the output
    *
    * \param[in] input_tensors Notice the FDTensor::name should keep same with the model's input
@@ -48,6 +60,27 @@ struct FASTDEPLOY_DECL Runtime {
   bool Infer(std::vector<FDTensor>& input_tensors,
              std::vector<FDTensor>* output_tensors);
 
+  /** \brief Inference the model asynchronously, the call returns without waiting for the inference
+   *
+   * The backends supporting asynchronous inference(OpenVINO) keep several requests in flight, the others run the requests one by one in a worker thread of this Runtime, and so do the former ones while profiling. Don't call Infer() while there're requests in flight for the latter ones. The shape buckets apply as in Infer(), and GetStageTimes() gives the stages of the last finished request.
+   *
+   * \param[in] input_tensors Notice the FDTensor::name should keep same with the model's input, they must be kept alive until the inference is done
+   * \param[in] output_tensors Inference results, must be kept alive until the inference is done
+   * \return The future of inference result, true if the inference successed
+   */
+  std::future<bool> InferAsync(std::vector<FDTensor>& input_tensors,
+                               std::vector<FDTensor>* output_tensors);
+
+  /** \brief Inference the model asynchronously, and call `callback` with the inference result once it's done
+   *
+   * \param[in] input_tensors Notice the FDTensor::name should keep same with the model's input, they must be kept alive until the inference is done
+   * \param[in] output_tensors Inference results, must be kept alive until the inference is done
+   * \param[in] callback Called in the backend's or worker thread, true means the inference successed
+   */
+  void InferAsync(std::vector<FDTensor>& input_tensors,
+                  std::vector<FDTensor>* output_tensors,
+                  const std::function<void(bool)>& callback);
+
   /** \brief No params inference the model.
    *
    *  the input and output data need to pass through the BindInputTensor and GetOutputTensor interfaces.
@@ -82,7 +115,7 @@ struct FASTDEPLOY_DECL Runtime {
   /** \brief Clone new Runtime when multiple instances of the same model are created
    *
    * \param[in] stream CUDA Stream, defualt param is nullptr
-   * \return new Runtime* by this clone
+   * \return new Runtime* by this clone, nullptr if the new runtime failed to initialize
    */
   Runtime* Clone(void* stream = nullptr, int device_id = -1);
 
@@ -103,6 +136,11 @@ struct FASTDEPLOY_DECL Runtime {
   double GetProfileTime() {
     return backend_->benchmark_result_.time_of_runtime;
   }
+  /** \brief Get time of the last inference split into H2D, backend and D2H stages
+   */
+  const benchmark::BenchmarkResult& GetStageTimes() const {
+    return backend_->benchmark_result_;
+  }
 
  private:
   void CreateOrtBackend();
@@ -112,8 +150,23 @@ struct FASTDEPLOY_DECL Runtime {
   void CreateLiteBackend();
   void CreateRKNPU2Backend();
   void CreateSophgoNPUBackend();
+  void InitShapeBucketer();
+  void CheckInputDevices(const std::vector<FDTensor>& input_tensors) const;
   std::unique_ptr<BaseBackend> backend_;
+  // Whether backend_ is passed to Init() instead of created by option
+  bool external_backend_ = false;
   std::vector<FDTensor> input_tensors_;
   std::vector<FDTensor> output_tensors_;
+  // Pads the inputs to the shape buckets if RuntimeOption::SetShapeBuckets()
+  // is called, shared with the asynchronous requests in flight
+  std::shared_ptr<ShapeBucketer> shape_bucketer_;
+  std::vector<FDTensor> bucketed_inputs_;
+  struct AsyncBucketedRequest;
+
+  // Runs the asynchronous requests for the backends without asynchronous
+  // inference, it's destroyed first to drain the requests in flight
+  struct AsyncWorker;
+  std::mutex async_worker_mutex_;
+  std::shared_ptr<AsyncWorker> async_worker_;
 };
 }  // namespace fastdeploy
@@ -25,6 +25,8 @@ void RuntimeOption::SetModelPath(const std::string& model_path,
   params_file = params_path;
   model_format = format;
   model_from_memory_ = false;
+  model_source_ = ModelSource();
+  params_source_ = ModelSource();
 }
 
 void RuntimeOption::SetModelBuffer(const std::string& model_buffer,
@@ -34,6 +36,42 @@ void RuntimeOption::SetModelBuffer(const std::string& model_buffer,
   params_file = params_buffer;
   model_format = format;
   model_from_memory_ = true;
+  model_source_ = ModelSource();
+  params_source_ = ModelSource();
+}
+
+void RuntimeOption::SetModelBuffer(const ModelSource& model_buffer,
+                                   const ModelSource& params_buffer,
+                                   const ModelFormat& format) {
+  model_file = "";
+  params_file = "";
+  model_source_ = model_buffer;
+  params_source_ = params_buffer;
+  model_format = format;
+  model_from_memory_ = true;
+}
+
+bool RuntimeOption::GetModelSource(ModelSource* model,
+                                   ModelSource* params) const {
+  if (!model_source_.Empty()) {
+    *model = model_source_;
+    *params = params_source_;
+    return true;
+  }
+  if (model_from_memory_) {
+    *model = ModelSource::View(model_file);
+    *params = ModelSource::View(params_file);
+    return true;
+  }
+  if (!ModelSource::FromFile(model_file, model, enable_model_mmap)) {
+    return false;
+  }
+  // Only the Paddle model has a separate parameters file
+  if (params_file.empty() || model_format != ModelFormat::PADDLE) {
+    *params = ModelSource::View(params_file);
+    return true;
+  }
+  return ModelSource::FromFile(params_file, params, enable_model_mmap);
 }
 
 void RuntimeOption::SetEncryptionKey(const std::string& encryption_key) {
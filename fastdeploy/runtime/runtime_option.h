@@ -24,6 +24,7 @@
 #include <map>
 #include <vector>
 #include "fastdeploy/runtime/enum_variables.h"
+#include "fastdeploy/runtime/shape_bucket.h"
 #include "fastdeploy/runtime/backends/lite/option.h"
 #include "fastdeploy/runtime/backends/openvino/option.h"
 #include "fastdeploy/runtime/backends/ort/option.h"
@@ -33,6 +34,7 @@
 #include "fastdeploy/runtime/backends/sophgo/option.h"
 #include "fastdeploy/runtime/backends/tensorrt/option.h"
 #include "fastdeploy/benchmark/option.h"
+#include "fastdeploy/utils/model_source.h"
 
 namespace fastdeploy {
 
@@ -59,6 +61,24 @@ struct FASTDEPLOY_DECL RuntimeOption {
                       const std::string& params_buffer = "",
                       const ModelFormat& format = ModelFormat::PADDLE);
 
+  /** \brief Specify the model and parameter by ModelSource, e.g the memory mapped files. The bytes are shared with the source instead of copied
+   *
+   * \param[in] model_buffer The source of model
+   * \param[in] params_buffer The source of parameters
+   * \param[in] format Format of the loaded model
+   */
+  void SetModelBuffer(const ModelSource& model_buffer,
+                      const ModelSource& params_buffer = ModelSource(),
+                      const ModelFormat& format = ModelFormat::PADDLE);
+
+  /** \brief Map the model and parameter files into memory while loading model from disk, instead of reading them into heap. The pages are shared by all the processes loading the same model. ONNX Runtime and TensorRT parse the mapped bytes(or convert them by Paddle2ONNX) without a copy, while Paddle Inference copies the buffers into its config(the mapping still saves the heap copy made by reading the files)
+   */
+  void EnableModelMmap() { enable_model_mmap = true; }
+
+  /** \brief Read the model and parameter files into heap while loading model from disk
+   */
+  void DisableModelMmap() { enable_model_mmap = false; }
+
   /** \brief When loading encrypted model, encryption_key is required to decrypte model
    *
    * \param[in] encryption_key The key for decrypting model
@@ -172,6 +192,46 @@ struct FASTDEPLOY_DECL RuntimeOption {
   }
 
 
+  /** \brief Cache the ONNX model converted from Paddle model in a directory, ONNX Runtime and TensorRT backend load the cached model directly instead of converting it again while the same model is loaded next time
+   *
+   * \param[in] cache_dir Directory of the cache, it will be created if not exists, and can be shared by multiple processes
+   */
+  void SetPaddle2OnnxCacheDir(const std::string& cache_dir) {
+    paddle2onnx_cache_dir = cache_dir;
+  }
+
+  /** \brief Round the shape of a dynamic input up to the smallest of several canonical shapes by padding, so the backend only sees a few shapes and keeps a prepared plan for each of them. The outputs are returned as is unless they're set by SetShapeBucketCrop()
+   *
+   * \param[in] input_name Name of the input
+   * \param[in] shapes Canonical shapes of the input, -1 means the dimension is kept as is(e.g the batch size). The inputs beyond all the shapes are not padded
+   * \param[in] pad_value Value filled into the padded area of this input
+   */
+  void SetShapeBuckets(const std::string& input_name,
+                       const std::vector<std::vector<int64_t>>& shapes,
+                       float pad_value = 0.0) {
+    shape_bucket_option.buckets[input_name] = shapes;
+    shape_bucket_option.pad_values[input_name] = pad_value;
+  }
+
+  /** \brief Crop an axis of an output back after the input it follows is padded by the shape buckets, the outputs are returned as is by default
+   *
+   * \param[in] output_name Name of the output
+   * \param[in] output_axis Axis of the output to crop
+   * \param[in] input_name Name of the bucketed input
+   * \param[in] input_axis Axis of the input the output axis follows
+   * \param[in] scale The output axis is cropped to ceil(original size of the input axis * scale), e.g 0.25 for a feature map downsampled by 4
+   */
+  void SetShapeBucketCrop(const std::string& output_name, int output_axis,
+                          const std::string& input_name, int input_axis,
+                          float scale = 1.0) {
+    ShapeBucketCrop crop;
+    crop.output_axis = output_axis;
+    crop.input_name = input_name;
+    crop.input_axis = input_axis;
+    crop.scale = scale;
+    shape_bucket_option.crops[output_name].push_back(crop);
+  }
+
   /// Benchmark option
   benchmark::BenchmarkOption benchmark_option;
 
@@ -181,6 +241,15 @@ struct FASTDEPLOY_DECL RuntimeOption {
   std::string model_file = "";
   std::string params_file = "";
   bool model_from_memory_ = false;
+  // Set by SetModelBuffer(ModelSource), the model_file and params_file are
+  // empty while they're used
+  ModelSource model_source_;
+  ModelSource params_source_;
+  bool enable_model_mmap = false;
+
+  // Get the bytes of model and parameters, which may be the memory buffers,
+  // or the files mapped/read from disk
+  bool GetModelSource(ModelSource* model, ModelSource* params) const;
   /// format of input model
   ModelFormat model_format = ModelFormat::PADDLE;
 
@@ -198,6 +267,14 @@ struct FASTDEPLOY_DECL RuntimeOption {
 
   bool enable_pinned_memory = false;
 
+  // Directory to cache the ONNX model converted from Paddle model,
+  // the entries are named by the hash of model and conversion options
+  std::string paddle2onnx_cache_dir = "";
+
+  // The inputs with buckets are padded in Runtime::Infer(), and the outputs
+  // are cropped back
+  ShapeBucketOption shape_bucket_option;
+
   // ======Only for RKNPU2 Backend=======
   fastdeploy::rknpu2::CpuName rknpu2_cpu_name_ =
       fastdeploy::rknpu2::CpuName::RK3588;
@@ -0,0 +1,204 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "fastdeploy/runtime/runtime_pool.h"
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+
+namespace fastdeploy {
+
+namespace {
+
+int64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+InstanceDispatcher::InstanceDispatcher(int num_instances,
+                                       size_t queue_capacity)
+    : queue_(queue_capacity),
+      counters_(new InstanceCounter[std::max(num_instances, 1)]) {
+  FDASSERT(num_instances > 0,
+           "The number of instances should be > 0, but now it's %d.",
+           num_instances);
+  stats_start_ns_.store(NowNs());
+  workers_.reserve(num_instances);
+  for (int i = 0; i < num_instances; ++i) {
+    workers_.emplace_back(&InstanceDispatcher::Run, this, i);
+  }
+}
+
+InstanceDispatcher::~InstanceDispatcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_.store(true);
+  }
+  cond_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+bool InstanceDispatcher::Submit(Task&& task) {
+  if (!queue_.TryPush(std::move(task))) {
+    return false;
+  }
+  pending_.fetch_add(1);
+  // Pairs with the increment of num_sleeping_ before a worker checks
+  // pending_, so either the worker sees the task or we see the sleeper
+  if (num_sleeping_.load() > 0) {
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    cond_.notify_one();
+  }
+  return true;
+}
+
+void InstanceDispatcher::Run(int instance_id) {
+  InstanceCounter& counter = counters_[instance_id];
+  Task task;
+  while (true) {
+    if (queue_.TryPop(&task)) {
+      pending_.fetch_sub(1);
+      int64_t start = NowNs();
+      task(instance_id);
+      task = nullptr;
+      counter.busy_ns.fetch_add(static_cast<uint64_t>(NowNs() - start),
+                                std::memory_order_relaxed);
+      counter.num_requests.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    num_sleeping_.fetch_add(1);
+    cond_.wait(lock, [this] { return stop_.load() || pending_.load() > 0; });
+    num_sleeping_.fetch_sub(1);
+    if (stop_.load() && pending_.load() <= 0) {
+      return;
+    }
+  }
+}
+
+size_t InstanceDispatcher::QueueDepth() const {
+  return static_cast<size_t>(std::max<int64_t>(pending_.load(), 0));
+}
+
+InstancePoolStats InstanceDispatcher::GetStats() const {
+  InstancePoolStats stats;
+  stats.queue_depth = QueueDepth();
+  double elapsed = static_cast<double>(NowNs() - stats_start_ns_.load());
+  for (int i = 0; i < NumInstances(); ++i) {
+    stats.num_requests.push_back(counters_[i].num_requests.load());
+    double busy = static_cast<double>(counters_[i].busy_ns.load());
+    stats.utilization.push_back(elapsed > 0 ? std::min(busy / elapsed, 1.0)
+                                            : 0.0);
+  }
+  return stats;
+}
+
+void InstanceDispatcher::ResetStats() {
+  for (int i = 0; i < NumInstances(); ++i) {
+    counters_[i].busy_ns.store(0);
+    counters_[i].num_requests.store(0);
+  }
+  stats_start_ns_.store(NowNs());
+}
+
+bool RuntimePool::Init(const RuntimeOption& option, int num_instances,
+                       size_t queue_capacity) {
+  std::unique_ptr<Runtime> runtime(new Runtime());
+  if (!runtime->Init(option)) {
+    FDERROR << "Failed to initialize the runtime of RuntimePool." << std::endl;
+    return false;
+  }
+  return Init(std::move(runtime), num_instances, queue_capacity);
+}
+
+bool RuntimePool::Init(std::unique_ptr<Runtime>&& runtime, int num_instances,
+                       size_t queue_capacity) {
+  if (runtime == nullptr) {
+    FDERROR << "RuntimePool requires an initialized runtime." << std::endl;
+    return false;
+  }
+  if (num_instances <= 0) {
+    FDERROR << "The number of instances should be > 0, but now it's "
+            << num_instances << "." << std::endl;
+    return false;
+  }
+  dispatcher_.reset();
+  runtimes_.clear();
+  runtimes_.push_back(std::move(runtime));
+  for (int i = 1; i < num_instances; ++i) {
+    std::unique_ptr<Runtime> clone(runtimes_[0]->Clone());
+    if (clone == nullptr) {
+      FDERROR << "Failed to clone the instance " << i << " of the runtime."
+              << std::endl;
+      runtimes_.clear();
+      return false;
+    }
+    runtimes_.push_back(std::move(clone));
+  }
+  dispatcher_.reset(new InstanceDispatcher(num_instances, queue_capacity));
+  return true;
+}
+
+void RuntimePool::InferAsync(std::vector<FDTensor>& input_tensors,
+                             std::vector<FDTensor>* output_tensors,
+                             const std::function<void(bool)>& callback) {
+  FDASSERT(dispatcher_ != nullptr,
+           "RuntimePool is not initialized, please call Init() first.");
+  std::vector<FDTensor>* inputs = &input_tensors;
+  bool queued =
+      dispatcher_->Submit([this, inputs, output_tensors, callback](int index) {
+        callback(runtimes_[index]->Infer(*inputs, output_tensors));
+      });
+  if (!queued) {
+    FDERROR << "The request queue of RuntimePool is full, there're "
+            << QueueDepth() << " requests waiting." << std::endl;
+    callback(false);
+  }
+}
+
+std::future<bool> RuntimePool::InferAsync(
+    std::vector<FDTensor>& input_tensors,
+    std::vector<FDTensor>* output_tensors) {
+  auto promise = std::make_shared<std::promise<bool>>();
+  std::future<bool> result = promise->get_future();
+  InferAsync(input_tensors, output_tensors,
+             [promise](bool success) { promise->set_value(success); });
+  return result;
+}
+
+bool RuntimePool::Infer(std::vector<FDTensor>& input_tensors,
+                        std::vector<FDTensor>* output_tensors) {
+  return InferAsync(input_tensors, output_tensors).get();
+}
+
+size_t RuntimePool::QueueDepth() const {
+  return dispatcher_ == nullptr ? 0 : dispatcher_->QueueDepth();
+}
+
+InstancePoolStats RuntimePool::GetStats() const {
+  return dispatcher_ == nullptr ? InstancePoolStats()
+                                : dispatcher_->GetStats();
+}
+
+void RuntimePool::ResetStats() {
+  if (dispatcher_ != nullptr) {
+    dispatcher_->ResetStats();
+  }
+}
+
+}  // namespace fastdeploy
@@ -0,0 +1,161 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "fastdeploy/runtime/runtime.h"
+#include "fastdeploy/utils/mpmc_queue.h"
+
+namespace fastdeploy {
+
+/*! @brief Statistics of the requests dispatched across the instances of a pool
+ */
+struct FASTDEPLOY_DECL InstancePoolStats {
+  /// Number of the requests waiting in queue
+  size_t queue_depth = 0;
+  /// Number of the requests done by every instance
+  std::vector<uint64_t> num_requests;
+  /// Fraction of time every instance is busy since the pool started or the statistics were reset, in [0, 1]
+  std::vector<double> utilization;
+};
+
+/*! @brief Run tasks on a fixed set of instances, one worker thread per instance
+ *
+ * Tasks are queued in a lock-free queue and taken by whichever instance is
+ * idle, the idle workers only sleep on a condition variable while the queue
+ * stays empty.
+ */
+class FASTDEPLOY_DECL InstanceDispatcher {
+ public:
+  /// A task runs with the index of the instance it's dispatched to
+  using Task = std::function<void(int)>;
+
+  InstanceDispatcher(int num_instances, size_t queue_capacity);
+
+  /// Finish all the queued tasks, then stop the workers
+  ~InstanceDispatcher();
+
+  /// Queue the task, return false if the queue is full
+  bool Submit(Task&& task);
+
+  int NumInstances() const { return static_cast<int>(workers_.size()); }
+  size_t QueueDepth() const;
+  InstancePoolStats GetStats() const;
+  void ResetStats();
+
+ private:
+  void Run(int instance_id);
+
+  struct InstanceCounter {
+    std::atomic<uint64_t> busy_ns{0};
+    std::atomic<uint64_t> num_requests{0};
+  };
+
+  MPMCQueue<Task> queue_;
+  // Tasks pushed but not taken yet, the workers sleep while it's 0
+  std::atomic<int64_t> pending_{0};
+  std::atomic<int> num_sleeping_{0};
+  std::atomic<bool> stop_{false};
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::unique_ptr<InstanceCounter[]> counters_;
+  std::atomic<int64_t> stats_start_ns_{0};
+  std::vector<std::thread> workers_;
+};
+
+/*! @brief Pool of Runtime instances cloned from one model, dispatching the requests across them
+ *
+ * The instances are created by Runtime::Clone(), so the backends supporting clone(OpenVINO/Paddle Inference) share the model weights between them. Every instance is driven by its own worker thread, a request is run by the first idle instance.
+ *
+ * example code @code
+ * fastdeploy::RuntimePool pool;
+ * pool.Init(option, 4);
+ * // Called from any number of threads
+ * std::vector<fastdeploy::FDTensor> outputs;
+ * pool.Infer(inputs, &outputs);
+ * @endcode
+ */
+class FASTDEPLOY_DECL RuntimePool {
+ public:
+  /** \brief Create the runtime and its clones
+   *
+   * \param[in] option Runtime option of the model
+   * \param[in] num_instances Number of the runtime instances
+   * \param[in] queue_capacity Max number of the requests waiting in queue, the requests submitted to a full queue fail
+   * \return true if all the instances are created
+   */
+  bool Init(const RuntimeOption& option, int num_instances,
+            size_t queue_capacity = 1024);
+
+  /** \brief Use an initialized runtime as the first instance and create its clones
+   *
+   * \param[in] runtime The initialized runtime, e.g initialized with a custom backend
+   * \param[in] num_instances Number of the runtime instances
+   * \param[in] queue_capacity Max number of the requests waiting in queue, the requests submitted to a full queue fail
+   * \return true if all the instances are created
+   */
+  bool Init(std::unique_ptr<Runtime>&& runtime, int num_instances,
+            size_t queue_capacity = 1024);
+
+  /** \brief Inference by an idle instance and wait for the result, can be called from multiple threads
+   *
+   * \param[in] input_tensors Notice the FDTensor::name should keep same with the model's input
+   * \param[in] output_tensors Inference results
+   * \return true if the inference successed, otherwise false
+   */
+  bool Infer(std::vector<FDTensor>& input_tensors,
+             std::vector<FDTensor>* output_tensors);
+
+  /** \brief Queue a request and return without waiting, `callback` is called with the inference result in the worker thread
+   *
+   * \param[in] input_tensors Must be kept alive until the inference is done
+   * \param[in] output_tensors Must be kept alive until the inference is done
+   * \param[in] callback true means the inference successed
+   */
+  void InferAsync(std::vector<FDTensor>& input_tensors,
+                  std::vector<FDTensor>* output_tensors,
+                  const std::function<void(bool)>& callback);
+
+  /** \brief Queue a request and return the future of its result, see the callback version for more detail
+   */
+  std::future<bool> InferAsync(std::vector<FDTensor>& input_tensors,
+                               std::vector<FDTensor>* output_tensors);
+
+  /// Get number of the runtime instances
+  int NumInstances() const { return static_cast<int>(runtimes_.size()); }
+  /// Get the runtime instance by index
+  Runtime* GetRuntime(int index) { return runtimes_[index].get(); }
+  /// Get number of the requests waiting in queue
+  size_t QueueDepth() const;
+  /// Get statistics of the requests dispatched across the instances
+  InstancePoolStats GetStats() const;
+  /// Reset the statistics of requests and utilization
+  void ResetStats();
+
+ private:
+  std::vector<std::unique_ptr<Runtime>> runtimes_;
+  // Declared after runtimes_ so it drains the queued requests before the
+  // runtimes are destroyed
+  std::unique_ptr<InstanceDispatcher> dispatcher_;
+};
+
+}  // namespace fastdeploy
@@ -0,0 +1,173 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "fastdeploy/runtime/shape_bucket.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "fastdeploy/function/pad.h"
+#include "fastdeploy/function/slice.h"
+
+namespace fastdeploy {
+
+ShapeBucketer::ShapeBucketer(const ShapeBucketOption& option)
+    : option_(option) {
+  for (const auto& iter : option_.buckets) {
+    hits_[iter.first].resize(iter.second.size(), 0);
+  }
+}
+
+int ShapeBucketer::FindBucket(
+    const std::vector<int64_t>& shape,
+    const std::vector<std::vector<int64_t>>& buckets) {
+  int best = -1;
+  int64_t best_numel = 0;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    if (buckets[i].size() != shape.size()) {
+      continue;
+    }
+    bool fit = true;
+    int64_t numel = 1;
+    for (size_t j = 0; j < shape.size(); ++j) {
+      if (buckets[i][j] < 0) {
+        continue;
+      }
+      if (shape[j] > buckets[i][j]) {
+        fit = false;
+        break;
+      }
+      numel *= buckets[i][j];
+    }
+    if (fit && (best < 0 || numel < best_numel)) {
+      best = static_cast<int>(i);
+      best_numel = numel;
+    }
+  }
+  return best;
+}
+
+bool ShapeBucketer::PadInputs(std::vector<FDTensor>& inputs,
+                              std::vector<FDTensor>* padded) {
+  return PadInputs(inputs, padded, &origin_shapes_);
+}
+
+void ShapeBucketer::CropOutputs(std::vector<FDTensor>* outputs) const {
+  CropOutputs(origin_shapes_, outputs);
+}
+
+bool ShapeBucketer::PadInputs(
+    std::vector<FDTensor>& inputs, std::vector<FDTensor>* padded,
+    std::map<std::string, std::vector<int64_t>>* origin_shapes) {
+  origin_shapes->clear();
+  padded->resize(inputs.size());
+  bool any_padded = false;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    FDTensor& input = inputs[i];
+    FDTensor& output = (*padded)[i];
+    auto iter = option_.buckets.find(input.name);
+    int bucket = -1;
+    if (iter != option_.buckets.end() && input.device == Device::CPU) {
+      bucket = FindBucket(input.shape, iter->second);
+      if (bucket < 0) {
+        FDWARNING << "The shape " << Str(input.shape) << " of input "
+                  << input.name << " is beyond all the shape buckets, "
+                  << "it will not be padded." << std::endl;
+      }
+    }
+    std::vector<int> pads(input.shape.size() * 2, 0);
+    bool need_pad = false;
+    if (bucket >= 0) {
+      {
+        std::lock_guard<std::mutex> lock(hits_mutex_);
+        hits_[input.name][bucket] += 1;
+      }
+      const auto& bucket_shape = iter->second[bucket];
+      for (size_t j = 0; j < input.shape.size(); ++j) {
+        if (bucket_shape[j] >= 0 && bucket_shape[j] > input.shape[j]) {
+          pads[j * 2 + 1] = static_cast<int>(bucket_shape[j] - input.shape[j]);
+          need_pad = true;
+        }
+      }
+    }
+    if (!need_pad) {
+      output.SetExternalData(input.shape, input.dtype, input.MutableData(),
+                             input.device, input.device_id);
+      output.name = input.name;
+      continue;
+    }
+    auto pad_iter = option_.pad_values.find(input.name);
+    float pad_value =
+        pad_iter == option_.pad_values.end() ? 0.0f : pad_iter->second;
+    function::Pad(input, &output, pads, pad_value);
+    output.name = input.name;
+    (*origin_shapes)[input.name] = input.shape;
+    any_padded = true;
+  }
+  return any_padded;
+}
+
+void ShapeBucketer::CropOutputs(
+    const std::map<std::string, std::vector<int64_t>>& origin_shapes,
+    std::vector<FDTensor>* outputs) const {
+  if (option_.crops.empty() || origin_shapes.empty()) {
+    return;
+  }
+  for (auto& output : *outputs) {
+    auto iter = option_.crops.find(output.name);
+    if (iter == option_.crops.end() || output.device != Device::CPU) {
+      continue;
+    }
+    std::vector<int64_t> axes;
+    std::vector<int64_t> starts;
+    std::vector<int64_t> ends;
+    for (const auto& crop : iter->second) {
+      auto origin_iter = origin_shapes.find(crop.input_name);
+      if (origin_iter == origin_shapes.end()) {
+        continue;
+      }
+      const auto& origin_shape = origin_iter->second;
+      FDASSERT(crop.input_axis >= 0 &&
+                   crop.input_axis < static_cast<int>(origin_shape.size()),
+               "The input axis %d to crop output %s is out of the rank of "
+               "input %s.",
+               crop.input_axis, output.name.c_str(), crop.input_name.c_str());
+      FDASSERT(crop.output_axis >= 0 &&
+                   crop.output_axis < static_cast<int>(output.shape.size()),
+               "The axis %d to crop is out of the rank of output %s.",
+               crop.output_axis, output.name.c_str());
+      int64_t size = static_cast<int64_t>(
+          std::ceil(origin_shape[crop.input_axis] * crop.scale));
+      if (size < output.shape[crop.output_axis]) {
+        axes.push_back(crop.output_axis);
+        starts.push_back(0);
+        ends.push_back(size);
+      }
+    }
+    if (axes.empty()) {
+      continue;
+    }
+    FDTensor cropped;
+    function::Slice(output, axes, starts, ends, &cropped);
+    cropped.name = output.name;
+    output = std::move(cropped);
+  }
+}
+
+std::vector<uint64_t> ShapeBucketer::BucketHits(const std::string& name) const {
+  std::lock_guard<std::mutex> lock(hits_mutex_);
+  auto iter = hits_.find(name);
+  return iter == hits_.end() ? std::vector<uint64_t>() : iter->second;
+}
+
+}  // namespace fastdeploy
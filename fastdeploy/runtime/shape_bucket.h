@@ -0,0 +1,108 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "fastdeploy/core/fd_tensor.h"
+
+namespace fastdeploy {
+
+/*! @brief How an axis of an output is cropped back after an input is padded
+ */
+struct ShapeBucketCrop {
+  /// Axis of the output to crop
+  int output_axis = 0;
+  /// Name of the padded input the output axis follows
+  std::string input_name;
+  /// Axis of the input the output axis follows
+  int input_axis = 0;
+  /// The output axis is cropped to ceil(original size of the input axis * scale), e.g 0.25 for a feature map downsampled by 4
+  float scale = 1.0;
+};
+
+/*! @brief Option of rounding the dynamic input shapes up to canonical shapes
+ */
+struct ShapeBucketOption {
+  /// Canonical shapes of every bucketed input, -1 means the dimension is kept as is(e.g the batch size)
+  std::map<std::string, std::vector<std::vector<int64_t>>> buckets;
+  /// Value filled into the padded area of every bucketed input, 0 if not set
+  std::map<std::string, float> pad_values;
+  /// The axes of every output cropped back to the original inputs, the outputs not in it are returned as is
+  std::map<std::string, std::vector<ShapeBucketCrop>> crops;
+};
+
+/*! @brief Pad the inputs to the smallest bucket containing them, so the backends only see a few shapes
+ *
+ * The inputs are padded at the end of every dimension with function::Pad, and
+ * the outputs with crops in the option are cropped back with
+ * function::Slice. The backends then keep
+ * one prepared plan/binding per bucket, e.g the output binding of ONNX
+ * Runtime and the shape specific kernels of Paddle Inference, instead of
+ * preparing them again for every new shape.
+ */
+class FASTDEPLOY_DECL ShapeBucketer {
+ public:
+  explicit ShapeBucketer(const ShapeBucketOption& option);
+
+  /** \brief Pad the bucketed inputs
+   *
+   * \param[in] inputs The original inputs
+   * \param[out] padded The padded inputs, the inputs without bucket or beyond all the buckets are shared without a copy
+   * \return true if any input is padded
+   */
+  bool PadInputs(std::vector<FDTensor>& inputs, std::vector<FDTensor>* padded);
+
+  /// Crop the outputs by the crops of the option, following the inputs padded by the last PadInputs()
+  void CropOutputs(std::vector<FDTensor>* outputs) const;
+
+  /** \brief Pad the bucketed inputs of a request in flight, it can be called while other requests are not cropped yet
+   *
+   * \param[in] inputs The original inputs
+   * \param[out] padded The padded inputs, the inputs without bucket or beyond all the buckets are shared without a copy
+   * \param[out] origin_shapes The original shapes of the padded inputs, passed to CropOutputs() of the same request
+   * \return true if any input is padded
+   */
+  bool PadInputs(std::vector<FDTensor>& inputs, std::vector<FDTensor>* padded,
+                 std::map<std::string, std::vector<int64_t>>* origin_shapes);
+
+  /// Crop the outputs of a request by the original shapes from its PadInputs()
+  void CropOutputs(
+      const std::map<std::string, std::vector<int64_t>>& origin_shapes,
+      std::vector<FDTensor>* outputs) const;
+
+  /** \brief Find the smallest bucket containing `shape`
+   *
+   * \return index of the bucket, -1 if no bucket contains it
+   */
+  static int FindBucket(const std::vector<int64_t>& shape,
+                        const std::vector<std::vector<int64_t>>& buckets);
+
+  /// Number of the inputs padded to every bucket of `name`
+  std::vector<uint64_t> BucketHits(const std::string& name) const;
+
+ private:
+  ShapeBucketOption option_;
+  // The requests may be padded in different threads by Runtime::InferAsync()
+  mutable std::mutex hits_mutex_;
+  std::map<std::string, std::vector<uint64_t>> hits_;
+  // Original shapes of the inputs padded by the last call, used to crop the
+  // outputs
+  std::map<std::string, std::vector<int64_t>> origin_shapes_;
+};
+
+}  // namespace fastdeploy
@@ -23,6 +23,7 @@ namespace text {
 
 bool TextModel::Predict(const std::string& raw_text, Result* result,
                         const PredictionOption& option) {
+  PredictScope predict_scope(this);
   // Preprocess
   std::vector<FDTensor> input_tensor;
   std::vector<FDTensor> output_tensor;
@@ -50,6 +51,7 @@ bool TextModel::Predict(const std::string& raw_text, Result* result,
 
 bool TextModel::PredictBatch(const std::vector<std::string>& raw_text_array,
                              Result* results, const PredictionOption& option) {
+  PredictScope predict_scope(this);
   // Preprocess
   std::vector<FDTensor> input_tensor;
   std::vector<FDTensor> output_tensor;
@@ -723,6 +723,7 @@ void UIEModel::Predict(
     const std::vector<std::string>& texts,
     std::vector<std::unordered_map<std::string, std::vector<UIEResult>>>*
         results) {
+  PredictScope predict_scope(this);
   std::queue<SchemaNode> nodes;
   for (auto& node : schema_->root_->children_) {
     nodes.push(node);
@@ -0,0 +1,137 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace fastdeploy {
+
+/*! @brief Bounded queue connecting the stages of a pipeline
+ *
+ * Push() blocks while the queue is full, so a fast upstream stage is held
+ * back by the slower downstream one instead of queueing without limit. After
+ * Close(), the queued items can still be popped, and the consumers are woken
+ * once the queue is drained.
+ */
+template <typename T>
+class BlockingQueue {
+ public:
+  explicit BlockingQueue(size_t capacity)
+      : capacity_(std::max<size_t>(capacity, 1)) {}
+
+  BlockingQueue(const BlockingQueue&) = delete;
+  BlockingQueue& operator=(const BlockingQueue&) = delete;
+
+  size_t Capacity() const { return capacity_; }
+
+  size_t Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return items_.size();
+  }
+
+  /// Block while the queue is full, return false if the queue is closed
+  bool Push(T&& item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock,
+                   [this] { return closed_ || items_.size() < capacity_; });
+    if (closed_) {
+      return false;
+    }
+    items_.push_back(std::move(item));
+    lock.unlock();
+    not_empty_.notify_one();
+    return true;
+  }
+
+  /// Block until an item is popped, return false if the queue is closed and drained
+  bool Pop(T* item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+    if (items_.empty()) {
+      return false;
+    }
+    *item = std::move(items_.front());
+    items_.pop_front();
+    lock.unlock();
+    not_full_.notify_one();
+    return true;
+  }
+
+  /** \brief Pop a batch of items
+   *
+   * Block until the first item arrives, then wait at most `max_delay` for the queue to fill the batch. The popped items are appended to `items`.
+   *
+   * \param[in] items The popped items
+   * \param[in] max_size Max number of the items popped
+   * \param[in] max_delay Max time waiting for the batch to be full after the first item is popped
+   * \return Number of the popped items, 0 only if the queue is closed and drained
+   */
+  size_t PopBatch(std::vector<T>* items, size_t max_size,
+                  std::chrono::microseconds max_delay) {
+    max_size = std::max<size_t>(max_size, 1);
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+    if (items_.empty()) {
+      return 0;
+    }
+    size_t num = 0;
+    auto deadline = std::chrono::steady_clock::now() + max_delay;
+    while (true) {
+      while (num < max_size && !items_.empty()) {
+        items->push_back(std::move(items_.front()));
+        items_.pop_front();
+        ++num;
+      }
+      if (num >= max_size || closed_) {
+        break;
+      }
+      // Let the blocked producers refill the queue while waiting
+      not_full_.notify_all();
+      if (!not_empty_.wait_until(lock, deadline, [this] {
+            return closed_ || !items_.empty();
+          })) {
+        break;
+      }
+    }
+    lock.unlock();
+    not_full_.notify_all();
+    return num;
+  }
+
+  /// Wake all the producers and consumers, the following Push() fails
+  void Close() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+    }
+    not_full_.notify_all();
+    not_empty_.notify_all();
+  }
+
+ private:
+  size_t capacity_;
+  mutable std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+  std::deque<T> items_;
+  bool closed_ = false;
+};
+
+}  // namespace fastdeploy
@@ -0,0 +1,197 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "fastdeploy/utils/utils.h"
+
+namespace fastdeploy {
+
+/*! @brief Option of DynamicBatcher
+ */
+struct DynamicBatcherOption {
+  /// Max number of the requests coalesced into one batch
+  int max_batch_size = 8;
+  /// Max time in microseconds the first request of a batch waits for the others
+  int max_delay_us = 2000;
+};
+
+/*! @brief Statistics of the batches run by DynamicBatcher
+ */
+struct DynamicBatcherStats {
+  uint64_t num_requests = 0;
+  uint64_t num_batches = 0;
+  uint64_t num_failed_batches = 0;
+
+  double AverageBatchSize() const {
+    return num_batches == 0 ? 0.0
+                            : static_cast<double>(num_requests) / num_batches;
+  }
+};
+
+/*! @brief Coalesce the concurrent single requests into batches
+ *
+ * The requests are queued, and a batching thread runs the batch function once
+ * `max_batch_size` requests are queued or the first queued request has waited
+ * `max_delay_us`, then scatters the results back to the requests. The batch
+ * function is only called from the batching thread.
+ */
+template <typename Input, typename Result>
+class DynamicBatcher {
+ public:
+  /// Run a batch of inputs, the results must be in the same order with the inputs
+  using BatchFunc =
+      std::function<bool(const std::vector<Input>&, std::vector<Result>*)>;
+
+  explicit DynamicBatcher(const BatchFunc& batch_func,
+                          const DynamicBatcherOption& option =
+                              DynamicBatcherOption())
+      : batch_func_(batch_func), option_(option) {
+    FDASSERT(option_.max_batch_size > 0,
+             "The max_batch_size should be > 0, but now it's %d.",
+             option_.max_batch_size);
+    option_.max_delay_us = std::max(option_.max_delay_us, 0);
+    thread_ = std::thread(&DynamicBatcher::Run, this);
+  }
+
+  DynamicBatcher(const DynamicBatcher&) = delete;
+  DynamicBatcher& operator=(const DynamicBatcher&) = delete;
+
+  /// Run the queued requests, then stop the batching thread
+  ~DynamicBatcher() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cond_.notify_all();
+    thread_.join();
+  }
+
+  /** \brief Queue a request and return the future of its result
+   *
+   * \param[in] input The input of request, it's copied into the queue
+   * \param[in] result The result of request, must be kept alive until the request is done
+   * \return The future of request, true if the batch containing it successed
+   */
+  std::future<bool> PredictAsync(const Input& input, Result* result) {
+    Request request;
+    request.input = input;
+    request.result = result;
+    request.arrival = std::chrono::steady_clock::now();
+    std::future<bool> future = request.promise.get_future();
+    bool notify = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      requests_.push_back(std::move(request));
+      // Wake the batching thread for the first request of a batch, or once
+      // the batch is full
+      notify = requests_.size() == 1 ||
+               requests_.size() >= static_cast<size_t>(option_.max_batch_size);
+    }
+    if (notify) {
+      cond_.notify_one();
+    }
+    return future;
+  }
+
+  /// Queue a request and wait for its result, can be called from multiple threads
+  bool Predict(const Input& input, Result* result) {
+    return PredictAsync(input, result).get();
+  }
+
+  /// Get statistics of the batches
+  DynamicBatcherStats GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+  }
+
+ private:
+  struct Request {
+    Input input;
+    Result* result = nullptr;
+    std::promise<bool> promise;
+    std::chrono::steady_clock::time_point arrival;
+  };
+
+  void Run() {
+    std::vector<Request> batch;
+    std::vector<Input> inputs;
+    std::vector<Result> results;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      cond_.wait(lock, [this] { return stop_ || !requests_.empty(); });
+      if (requests_.empty()) {
+        return;
+      }
+      auto deadline = requests_.front().arrival +
+                      std::chrono::microseconds(option_.max_delay_us);
+      cond_.wait_until(lock, deadline, [this] {
+        return stop_ || requests_.size() >=
+                            static_cast<size_t>(option_.max_batch_size);
+      });
+      size_t batch_size = std::min(
+          requests_.size(), static_cast<size_t>(option_.max_batch_size));
+      for (size_t i = 0; i < batch_size; ++i) {
+        batch.push_back(std::move(requests_.front()));
+        requests_.pop_front();
+      }
+      lock.unlock();
+
+      for (auto& request : batch) {
+        inputs.push_back(std::move(request.input));
+      }
+      results.clear();
+      bool success = batch_func_(inputs, &results);
+      if (success && results.size() != batch.size()) {
+        FDERROR << "The batch function returns " << results.size()
+                << " results for " << batch.size() << " inputs." << std::endl;
+        success = false;
+      }
+      for (size_t i = 0; i < batch.size(); ++i) {
+        if (success) {
+          *batch[i].result = std::move(results[i]);
+        }
+        batch[i].promise.set_value(success);
+      }
+      batch.clear();
+      inputs.clear();
+
+      lock.lock();
+      stats_.num_requests += batch_size;
+      stats_.num_batches += 1;
+      stats_.num_failed_batches += success ? 0 : 1;
+    }
+  }
+
+  BatchFunc batch_func_;
+  DynamicBatcherOption option_;
+  mutable std::mutex mutex_;
+  std::condition_variable cond_;
+  std::deque<Request> requests_;
+  DynamicBatcherStats stats_;
+  bool stop_ = false;
+  std::thread thread_;
+};
+
+}  // namespace fastdeploy
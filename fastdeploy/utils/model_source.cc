@@ -0,0 +1,168 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "fastdeploy/utils/model_source.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fastdeploy {
+
+struct ModelSource::Storage {
+  virtual ~Storage() = default;
+  const char* data = nullptr;
+  size_t size = 0;
+  bool mapped = false;
+};
+
+namespace {
+
+struct OwnedStorage : public ModelSource::Storage {
+  explicit OwnedStorage(std::string&& buffer) : contents(std::move(buffer)) {
+    data = contents.data();
+    size = contents.size();
+  }
+  std::string contents;
+};
+
+struct MappedStorage : public ModelSource::Storage {
+  ~MappedStorage() {
+    if (data == nullptr || size == 0) {
+      return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+#else
+    munmap(const_cast<char*>(data), size);
+#endif
+  }
+
+  bool Map(const std::string& path) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+      return false;
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+      CloseHandle(file);
+      return false;
+    }
+    HANDLE mapping =
+        CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+      return false;
+    }
+    void* ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    // The view keeps the mapping alive
+    CloseHandle(mapping);
+    if (ptr == nullptr) {
+      return false;
+    }
+    size = static_cast<size_t>(file_size.QuadPart);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+      close(fd);
+      return false;
+    }
+    void* ptr = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ,
+                     MAP_SHARED, fd, 0);
+    // The mapping keeps the file alive
+    close(fd);
+    if (ptr == MAP_FAILED) {
+      return false;
+    }
+    size = static_cast<size_t>(info.st_size);
+#endif
+    data = reinterpret_cast<const char*>(ptr);
+    mapped = true;
+    return true;
+  }
+};
+
+}  // namespace
+
+bool ModelSource::FromFile(const std::string& path, ModelSource* source,
+                           bool use_mmap) {
+  if (use_mmap) {
+    auto storage = std::make_shared<MappedStorage>();
+    if (storage->Map(path)) {
+      source->storage_ = storage;
+      return true;
+    }
+    // Empty file or the file system doesn't support mapping
+  }
+  std::string contents;
+  if (!ReadBinaryFromFile(path, &contents)) {
+    return false;
+  }
+  *source = FromBuffer(std::move(contents));
+  return true;
+}
+
+ModelSource ModelSource::FromBuffer(std::string&& buffer) {
+  ModelSource source;
+  source.storage_ = std::make_shared<OwnedStorage>(std::move(buffer));
+  return source;
+}
+
+ModelSource ModelSource::View(const std::string& buffer) {
+  return View(buffer.data(), buffer.size());
+}
+
+ModelSource ModelSource::View(const char* data, size_t size) {
+  auto storage = std::make_shared<Storage>();
+  storage->data = data;
+  storage->size = size;
+  ModelSource source;
+  source.storage_ = storage;
+  return source;
+}
+
+const char* ModelSource::Data() const {
+  return storage_ == nullptr ? nullptr : storage_->data;
+}
+
+size_t ModelSource::Size() const {
+  return storage_ == nullptr ? 0 : storage_->size;
+}
+
+bool ModelSource::IsMapped() const {
+  return storage_ != nullptr && storage_->mapped;
+}
+
+std::string ModelSource::ToString() const {
+  if (storage_ == nullptr) {
+    return "";
+  }
+  return std::string(storage_->data, storage_->size);
+}
+
+}  // namespace fastdeploy
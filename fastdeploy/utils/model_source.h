@@ -0,0 +1,69 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "fastdeploy/utils/utils.h"
+
+namespace fastdeploy {
+
+/*! @brief Read-only bytes of a model or parameters file
+ *
+ * The bytes come from a memory mapped file, a buffer owned by the source, or
+ * a buffer borrowed from the caller. Copying a ModelSource only shares the
+ * underlying bytes. A mapped file is backed by the page cache, so the
+ * processes loading the same model share its physical pages, and the
+ * backends accepting a buffer read the pages directly without a copy.
+ */
+class FASTDEPLOY_DECL ModelSource {
+ public:
+  ModelSource() = default;
+
+  /** \brief Load the bytes of file
+   *
+   * \param[in] path Path of the file
+   * \param[out] source The loaded source
+   * \param[in] use_mmap Map the file into memory, will fall back to read the file if mapping fails
+   * \return false if the file can't be read
+   */
+  static bool FromFile(const std::string& path, ModelSource* source,
+                       bool use_mmap = true);
+
+  /// Take the ownership of `buffer`
+  static ModelSource FromBuffer(std::string&& buffer);
+
+  /// Refer to `buffer` without copying, it must outlive the source
+  static ModelSource View(const std::string& buffer);
+
+  /// Refer to `size` bytes at `data` without copying, they must outlive the
+  /// source
+  static ModelSource View(const char* data, size_t size);
+
+  const char* Data() const;
+  size_t Size() const;
+  bool Empty() const { return storage_ == nullptr; }
+  bool IsMapped() const;
+
+  /// Copy the bytes into a string
+  std::string ToString() const;
+
+  struct Storage;
+
+ private:
+  std::shared_ptr<const Storage> storage_;
+};
+
+}  // namespace fastdeploy
@@ -0,0 +1,145 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fastdeploy/utils/task_pool.h"
+
+namespace fastdeploy {
+
+struct TaskPool::Job {
+  const std::function<bool(size_t)>* func = nullptr;
+  size_t remaining = 0;
+  bool success = true;
+  std::mutex mutex;
+  std::condition_variable cv;
+};
+
+TaskPool::TaskPool(int num_threads) {
+  FDASSERT(num_threads > 0,
+           "The number of threads should be > 0, but now it's %d.",
+           num_threads);
+  for (int i = 1; i < num_threads; ++i) {
+    workers_.emplace_back(new Worker());
+  }
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    workers_[i]->thread = std::thread(&TaskPool::WorkerLoop, this, i);
+  }
+}
+
+TaskPool::~TaskPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+bool TaskPool::ParallelFor(size_t n, const std::function<bool(size_t)>& func) {
+  if (workers_.empty() || n <= 1) {
+    for (size_t i = 0; i < n; ++i) {
+      if (!func(i)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  Job job;
+  job.func = &func;
+  job.remaining = n;
+  {
+    // Count the tasks before they are visible, so pending_ never underflows
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_ += n;
+  }
+  // Deal the tasks round-robin, starting from a different worker for every
+  // job
+  size_t num_workers = workers_.size();
+  size_t start = next_worker_.fetch_add(1) % num_workers;
+  for (size_t w = 0; w < num_workers; ++w) {
+    Worker* worker = workers_[(start + w) % num_workers].get();
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    for (size_t i = w; i < n; i += num_workers) {
+      worker->tasks.push_back(Task{&job, i});
+    }
+  }
+  cv_.notify_all();
+
+  // The calling thread steals the tasks until the queues are drained
+  Task task;
+  while (GetTask(num_workers, &task)) {
+    RunTask(task);
+  }
+  std::unique_lock<std::mutex> lock(job.mutex);
+  job.cv.wait(lock, [&job] { return job.remaining == 0; });
+  return job.success;
+}
+
+void TaskPool::WorkerLoop(size_t id) {
+  Task task;
+  while (true) {
+    if (GetTask(id, &task)) {
+      RunTask(task);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return stop_ || pending_.load() > 0; });
+    if (stop_ && pending_.load() == 0) {
+      return;
+    }
+  }
+}
+
+bool TaskPool::GetTask(size_t id, Task* task) {
+  size_t num_workers = workers_.size();
+  if (id < num_workers) {
+    Worker* worker = workers_[id].get();
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    if (!worker->tasks.empty()) {
+      *task = worker->tasks.back();
+      worker->tasks.pop_back();
+      pending_.fetch_sub(1);
+      return true;
+    }
+  }
+  for (size_t k = 1; k <= num_workers; ++k) {
+    Worker* victim = workers_[(id + k) % num_workers].get();
+    std::lock_guard<std::mutex> lock(victim->mutex);
+    if (!victim->tasks.empty()) {
+      *task = victim->tasks.front();
+      victim->tasks.pop_front();
+      pending_.fetch_sub(1);
+      return true;
+    }
+  }
+  return false;
+}
+
+void TaskPool::RunTask(const Task& task) {
+  Job* job = task.job;
+  bool ret = (*job->func)(task.index);
+  // The job lives on the stack of ParallelFor(), it may be released as soon
+  // as the mutex is unlocked after the last task
+  std::lock_guard<std::mutex> lock(job->mutex);
+  if (!ret) {
+    job->success = false;
+  }
+  if (--job->remaining == 0) {
+    job->cv.notify_all();
+  }
+}
+
+}  // namespace fastdeploy
@@ -0,0 +1,83 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "fastdeploy/utils/utils.h"
+
+namespace fastdeploy {
+
+/*! @brief Work-stealing pool running the iterations of a parallel loop
+ *
+ * Every worker owns a task deque, it pops its own tasks from the back and
+ * steals the tasks of the other workers from the front once its deque is
+ * empty, so the images of different sizes in a batch are balanced between
+ * the workers. The thread calling ParallelFor() runs the tasks as well, so a
+ * pool of `num_threads` only starts `num_threads - 1` workers, and nested or
+ * concurrent ParallelFor() calls never deadlock.
+ */
+class FASTDEPLOY_DECL TaskPool {
+ public:
+  /// The number of threads includes the calling thread, 1 runs the loops sequentially
+  explicit TaskPool(int num_threads);
+  ~TaskPool();
+
+  TaskPool(const TaskPool&) = delete;
+  TaskPool& operator=(const TaskPool&) = delete;
+
+  int NumThreads() const { return static_cast<int>(workers_.size()) + 1; }
+
+  /** \brief Run func(i) for every i in [0, n), and block until all of them are finished
+   *
+   * \param[in] n The number of iterations
+   * \param[in] func The body of the loop, the iterations may run in any order and in parallel
+   * \return true if all the iterations returned true, otherwise false
+   */
+  bool ParallelFor(size_t n, const std::function<bool(size_t)>& func);
+
+ private:
+  struct Job;
+  struct Task {
+    Job* job;
+    size_t index;
+  };
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+    std::thread thread;
+  };
+
+  void WorkerLoop(size_t id);
+  // Pop a task of worker `id`, or steal one from the other workers
+  bool GetTask(size_t id, Task* task);
+  void RunTask(const Task& task);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  // Number of the queued tasks, the idle workers sleep while it's 0
+  std::atomic<size_t> pending_{0};
+  std::atomic<size_t> next_worker_{0};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_ = false;
+};
+
+}  // namespace fastdeploy
@@ -100,6 +100,7 @@ bool ResNet::Postprocess(FDTensor& infer_result,
 }
 
 bool ResNet::Predict(cv::Mat* im, ClassifyResult* result, int topk) {
+  PredictScope predict_scope(this);
 
   // In this function, the Preprocess(), Infer(), and Postprocess() are called sequentially.
 
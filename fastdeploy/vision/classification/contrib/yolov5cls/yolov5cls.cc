@@ -54,6 +54,7 @@ bool YOLOv5Cls::Predict(const cv::Mat& im, ClassifyResult* result) {
 }
 
 bool YOLOv5Cls::BatchPredict(const std::vector<cv::Mat>& images, std::vector<ClassifyResult>* results) {
+  PredictScope predict_scope(this);
   std::vector<std::map<std::string, std::array<float, 2>>> ims_info;
   std::vector<FDMat> fd_images = WrapMat(images);
 
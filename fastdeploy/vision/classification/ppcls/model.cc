@@ -81,7 +81,13 @@ bool PaddleClasModel::Predict(const cv::Mat& im, ClassifyResult* result) {
 
 bool PaddleClasModel::BatchPredict(const std::vector<cv::Mat>& images, std::vector<ClassifyResult>* results) {
   std::vector<FDMat> fd_images = WrapMat(images);
-  if (!preprocessor_.Run(&fd_images, &reused_input_tensors_)) {
+  return BatchPredict(&fd_images, results);
+}
+
+bool PaddleClasModel::BatchPredict(std::vector<FDMat>* images, std::vector<ClassifyResult>* results) {
+  RequestArenaScope arena_scope(this);
+  PredictScope predict_scope(this);
+  if (!preprocessor_.Run(images, &reused_input_tensors_)) {
     FDERROR << "Failed to preprocess the input image." << std::endl;
     return false;
   }
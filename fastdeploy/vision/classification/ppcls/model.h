@@ -75,6 +75,15 @@ class FASTDEPLOY_DECL PaddleClasModel : public FastDeployModel {
   virtual bool BatchPredict(const std::vector<cv::Mat>& imgs,
                             std::vector<ClassifyResult>* results);
 
+  /** \brief Predict the classification results for a batch of FDMat, e.g. the NV12 frames created by FDMat::CreateFromYuv()
+   *
+   * \param[in] imgs, The input image list, the frames are preprocessed without copy when the preprocessing can be fused
+   * \param[in] results The output classification result list
+   * \return true if the prediction successed, otherwise false
+   */
+  virtual bool BatchPredict(std::vector<FDMat>* imgs,
+                            std::vector<ClassifyResult>* results);
+
   /// Get preprocessor reference of PaddleClasModel
   virtual PaddleClasPreprocessor& GetPreprocessor() {
     return preprocessor_;
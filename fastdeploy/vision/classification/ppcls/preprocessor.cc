@@ -29,7 +29,29 @@ PaddleClasPreprocessor::PaddleClasPreprocessor(const std::string& config_file) {
 }
 
 bool PaddleClasPreprocessor::BuildPreprocessPipelineFromConfig() {
-  processors_.clear();
+  std::string options = "PaddleClas";
+  if (disable_normalize_) {
+    options += " DisableNormalize";
+  }
+  if (disable_permute_) {
+    options += " DisablePermute";
+  }
+  // The config is only parsed by the first preprocessor of the same config
+  auto plan = GetPreprocessPlan(
+      config_file_, options,
+      [this](std::vector<std::shared_ptr<Processor>>* processors) {
+        return ParseConfig(processors);
+      });
+  if (plan == nullptr) {
+    return false;
+  }
+  processors_ = plan->Processors();
+  SetPlan(plan);
+  return true;
+}
+
+bool PaddleClasPreprocessor::ParseConfig(
+    std::vector<std::shared_ptr<Processor>>* processors) const {
   YAML::Node cfg;
   try {
     cfg = YAML::LoadFile(config_file_);
@@ -39,7 +61,7 @@ bool PaddleClasPreprocessor::BuildPreprocessPipelineFromConfig() {
     return false;
   }
   auto preprocess_cfg = cfg["PreProcess"]["transform_ops"];
-  processors_.push_back(std::make_shared<BGR2RGB>());
+  processors->push_back(std::make_shared<BGR2RGB>());
   for (const auto& op : preprocess_cfg) {
     FDASSERT(op.IsMap(),
              "Require the transform information in yaml be Map type.");
@@ -48,12 +70,12 @@ bool PaddleClasPreprocessor::BuildPreprocessPipelineFromConfig() {
       int target_size = op.begin()->second["resize_short"].as<int>();
       bool use_scale = false;
       int interp = 1;
-      processors_.push_back(
+      processors->push_back(
           std::make_shared<ResizeByShort>(target_size, 1, use_scale));
     } else if (op_name == "CropImage") {
       int width = op.begin()->second["size"].as<int>();
       int height = op.begin()->second["size"].as<int>();
-      processors_.push_back(std::make_shared<CenterCrop>(width, height));
+      processors->push_back(std::make_shared<CenterCrop>(width, height));
     } else if (op_name == "NormalizeImage") {
       if (!disable_normalize_) {
         auto mean = op.begin()->second["mean"].as<std::vector<float>>();
@@ -63,11 +85,11 @@ bool PaddleClasPreprocessor::BuildPreprocessPipelineFromConfig() {
             (scale - 0.00392157) < 1e-06 && (scale - 0.00392157) > -1e-06,
             "Only support scale in Normalize be 0.00392157, means the pixel "
             "is in range of [0, 255].");
-        processors_.push_back(std::make_shared<Normalize>(mean, std));
+        processors->push_back(std::make_shared<Normalize>(mean, std));
       }
     } else if (op_name == "ToCHWImage") {
       if (!disable_permute_) {
-        processors_.push_back(std::make_shared<HWC2CHW>());
+        processors->push_back(std::make_shared<HWC2CHW>());
       }
     } else {
       FDERROR << "Unexcepted preprocess operator: " << op_name << "."
@@ -76,8 +98,6 @@ bool PaddleClasPreprocessor::BuildPreprocessPipelineFromConfig() {
     }
   }
 
-  // Fusion will improve performance
-  FuseTransforms(&processors_);
   return true;
 }
 
@@ -102,20 +122,52 @@ void PaddleClasPreprocessor::DisablePermute() {
 
 bool PaddleClasPreprocessor::Apply(FDMatBatch* image_batch,
                                    std::vector<FDTensor>* outputs) {
-  for (size_t j = 0; j < processors_.size(); ++j) {
-    ProcLib lib = ProcLib::DEFAULT;
-    if (initial_resize_on_cpu_ && j == 0 &&
-        processors_[j]->Name().find("Resize") == 0) {
-      lib = ProcLib::OPENCV;
-    }
-    if (!(*(processors_[j].get()))(image_batch, lib)) {
-      FDERROR << "Failed to processs image in " << processors_[j]->Name() << "."
-              << std::endl;
+  if (UseFusedPipeline(image_batch)) {
+    outputs->resize(1);
+    if (!fused_pipeline_->Run(image_batch, &((*outputs)[0]))) {
+      FDERROR << "Failed to process image in the fused pipeline." << std::endl;
       return false;
     }
+    return true;
   }
+  auto run_processors = [&](size_t begin, size_t end) {
+    for (size_t j = begin; j < end; ++j) {
+      ProcLib lib = ProcLib::DEFAULT;
+      if (initial_resize_on_cpu_ && j == 0 &&
+          processors_[j]->Name().find("Resize") == 0) {
+        lib = ProcLib::OPENCV;
+      }
+      if (!(*(processors_[j].get()))(image_batch, lib)) {
+        FDERROR << "Failed to processs image in " << processors_[j]->Name()
+                << "." << std::endl;
+        return false;
+      }
+    }
+    return true;
+  };
 
   outputs->resize(1);
+  // On CPU, the last processor is held back so that it may write the images
+  // into their slots of the batch tensor directly
+  size_t num_processors = processors_.size();
+  size_t num_held = (!CudaUsed() && num_processors > 0) ? 1 : 0;
+  if (!run_processors(0, num_processors - num_held)) {
+    return false;
+  }
+  if (num_held > 0) {
+    std::vector<FDMat>* images = image_batch->mats;
+    if (CheckShapeConsistency(images) &&
+        WriteToBatchTensor(processors_.back().get(), image_batch,
+                           (*images)[0].Height(), (*images)[0].Width(),
+                           std::vector<float>((*images)[0].Channels(), 0.0f),
+                           &((*outputs)[0]))) {
+      return true;
+    }
+    if (!run_processors(num_processors - 1, num_processors)) {
+      return false;
+    }
+  }
+
   (*outputs)[0] = std::move(*(image_batch->Tensor()));
   (*outputs)[0].device_id = DeviceId();
   return true;
@@ -55,6 +55,9 @@ class FASTDEPLOY_DECL PaddleClasPreprocessor : public ProcessorManager {
 
  private:
   bool BuildPreprocessPipelineFromConfig();
+  // Parse the processors of the config, before fusion
+  bool ParseConfig(std::vector<std::shared_ptr<Processor>>* processors) const;
+  // The processors of the plan, shared with the other preprocessors
   std::vector<std::shared_ptr<Processor>> processors_;
   // for recording the switch of hwc2chw
   bool disable_permute_ = false;
@@ -0,0 +1,62 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "fastdeploy/utils/dynamic_batcher.h"
+#include "fastdeploy/utils/unique_ptr.h"
+#include "opencv2/core/core.hpp"
+
+namespace fastdeploy {
+namespace vision {
+
+/// Batcher coalescing the single images into a batch of `BatchPredict()`
+template <typename Result>
+using ImageBatcher = DynamicBatcher<cv::Mat, Result>;
+
+/** \brief Create a batcher coalescing the concurrent single image requests into `model->BatchPredict()`, which runs the batched preprocessing(ProcessorManager over FDMatBatch), inference and postprocessing of the model
+ *
+ * The input images are shared with the queued requests without a copy, they should not be modified until the requests are done. The model should not be used by others while the batcher is alive.
+ *
+ * example code @code
+ * fastdeploy::vision::classification::PaddleClasModel model(...);
+ * fastdeploy::DynamicBatcherOption option;
+ * option.max_batch_size = 16;
+ * option.max_delay_us = 3000;
+ * auto batcher = fastdeploy::vision::CreateImageBatcher<fastdeploy::vision::ClassifyResult>(&model, option);
+ * // Called from any number of threads
+ * fastdeploy::vision::ClassifyResult result;
+ * batcher->Predict(im, &result);
+ * @endcode
+ *
+ * \param[in] model The model supporting BatchPredict(const std::vector<cv::Mat>&, std::vector<Result>*)
+ * \param[in] option Max batch size and max delay of the batcher
+ * \return The batcher driving `model`
+ */
+template <typename Result, typename Model>
+std::unique_ptr<ImageBatcher<Result>> CreateImageBatcher(
+    Model* model,
+    const DynamicBatcherOption& option = DynamicBatcherOption()) {
+  return fastdeploy::utils::make_unique<ImageBatcher<Result>>(
+      [model](const std::vector<cv::Mat>& images,
+              std::vector<Result>* results) {
+        return model->BatchPredict(images, results);
+      },
+      option);
+}
+
+}  // namespace vision
+}  // namespace fastdeploy
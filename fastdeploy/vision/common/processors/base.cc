@@ -14,6 +14,8 @@
 
 #include "fastdeploy/vision/common/processors/base.h"
 
+#include <algorithm>
+
 #include "fastdeploy/utils/utils.h"
 #include "fastdeploy/vision/common/processors/proc_lib.h"
 
@@ -21,10 +23,7 @@ namespace fastdeploy {
 namespace vision {
 
 bool Processor::operator()(FDMat* mat, ProcLib lib) {
-  ProcLib target = lib;
-  if (lib == ProcLib::DEFAULT) {
-    target = DefaultProcLib::default_lib;
-  }
+  ProcLib target = ResolveProcLib(Name(), lib);
   if (target == ProcLib::FLYCV) {
 #ifdef ENABLE_FLYCV
     return ImplByFlyCV(mat);
@@ -47,16 +46,15 @@ bool Processor::operator()(FDMat* mat, ProcLib lib) {
 #else
     FDASSERT(false, "FastDeploy didn't compile with CV-CUDA.");
 #endif
+  } else if (target == ProcLib::SIMD) {
+    return ImplBySimd(mat);
   }
   // DEFAULT & OPENCV
   return ImplByOpenCV(mat);
 }
 
 bool Processor::operator()(FDMatBatch* mat_batch, ProcLib lib) {
-  ProcLib target = lib;
-  if (lib == ProcLib::DEFAULT) {
-    target = DefaultProcLib::default_lib;
-  }
+  ProcLib target = ResolveProcLib(Name(), lib);
   if (target == ProcLib::FLYCV) {
 #ifdef ENABLE_FLYCV
     return ImplByFlyCV(mat_batch);
@@ -81,11 +79,72 @@ bool Processor::operator()(FDMatBatch* mat_batch, ProcLib lib) {
 #else
     FDASSERT(false, "FastDeploy didn't compile with CV-CUDA.");
 #endif
+  } else if (target == ProcLib::SIMD) {
+    return ImplBySimd(mat_batch);
   }
   // DEFAULT & OPENCV
   return ImplByOpenCV(mat_batch);
 }
 
+bool WriteToBatchTensor(Processor* processor, FDMatBatch* mat_batch,
+                        int dst_h, int dst_w,
+                        const std::vector<float>& pad_values,
+                        FDTensor* output) {
+  std::vector<FDMat>* mats = mat_batch->mats;
+  if (mats->empty()) {
+    return false;
+  }
+  int channels = (*mats)[0].Channels();
+  for (size_t i = 0; i < mats->size(); ++i) {
+    FDMat* mat = &((*mats)[i]);
+    if (!processor->CanWriteToBatch(mat) || mat->Channels() != channels ||
+        mat->Height() > dst_h || mat->Width() > dst_w) {
+      return false;
+    }
+  }
+  FDASSERT(pad_values.size() == static_cast<size_t>(channels),
+           "The size of pad_values should be %d, but now it's %lu.", channels,
+           pad_values.size());
+
+  int batch = static_cast<int>(mats->size());
+  output->Resize({batch, channels, dst_h, dst_w}, FDDataType::FP32,
+                 output->name, Device::CPU);
+  float* data = reinterpret_cast<float*>(output->MutableData());
+  size_t plane_size = static_cast<size_t>(dst_h) * dst_w;
+  auto write = [&](size_t i) {
+    FDMat* mat = &((*mats)[i]);
+    float* dst = data + i * channels * plane_size;
+    int h = mat->Height();
+    int w = mat->Width();
+    // Only the area outside the mat is padded
+    if (h < dst_h || w < dst_w) {
+      for (int c = 0; c < channels; ++c) {
+        float* plane = dst + c * plane_size;
+        for (int y = 0; y < h; ++y) {
+          std::fill(plane + y * dst_w + w, plane + (y + 1) * dst_w,
+                    pad_values[c]);
+        }
+        std::fill(plane + h * dst_w, plane + plane_size, pad_values[c]);
+      }
+    }
+    if (!processor->WriteToBatch(mat, dst, dst_h, dst_w)) {
+      FDERROR << "Failed to write image:" << i << " to the batch in "
+              << processor->Name() << "." << std::endl;
+      return false;
+    }
+    return true;
+  };
+  if (mat_batch->task_pool != nullptr) {
+    return mat_batch->task_pool->ParallelFor(mats->size(), write);
+  }
+  for (size_t i = 0; i < mats->size(); ++i) {
+    if (!write(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void EnableFlyCV() {
 #ifdef ENABLE_FLYCV
   DefaultProcLib::default_lib = ProcLib::FLYCV;
@@ -53,6 +53,15 @@ class FASTDEPLOY_DECL Processor {
   }
 
   virtual bool ImplByOpenCV(FDMatBatch* mat_batch) {
+    if (mat_batch->task_pool != nullptr) {
+      // The workers follow the ProcLibConfig of the calling thread
+      const ProcLibConfig* config = ProcLibScope::Current();
+      return mat_batch->task_pool->ParallelFor(
+          mat_batch->mats->size(), [this, mat_batch, config](size_t i) {
+            ProcLibScope scope(config);
+            return ImplByOpenCV(&(*(mat_batch->mats))[i]);
+          });
+    }
     for (size_t i = 0; i < mat_batch->mats->size(); ++i) {
       if (ImplByOpenCV(&(*(mat_batch->mats))[i]) != true) {
         return false;
@@ -66,6 +75,15 @@ class FASTDEPLOY_DECL Processor {
   }
 
   virtual bool ImplByFlyCV(FDMatBatch* mat_batch) {
+    if (mat_batch->task_pool != nullptr) {
+      // The workers follow the ProcLibConfig of the calling thread
+      const ProcLibConfig* config = ProcLibScope::Current();
+      return mat_batch->task_pool->ParallelFor(
+          mat_batch->mats->size(), [this, mat_batch, config](size_t i) {
+            ProcLibScope scope(config);
+            return ImplByFlyCV(&(*(mat_batch->mats))[i]);
+          });
+    }
     for (size_t i = 0; i < mat_batch->mats->size(); ++i) {
       if (ImplByFlyCV(&(*(mat_batch->mats))[i]) != true) {
         return false;
@@ -100,11 +118,69 @@ class FASTDEPLOY_DECL Processor {
     return true;
   }
 
+  /** \brief Process the mat by the kernels of simd_kernels.h on the buffer of the mat directly, the result is stored in the output cache of the mat
+   *
+   * Fall back to ImplByOpenCV() by default, and the processors implementing it
+   * fall back as well for the cases the kernels don't cover.
+   */
+  virtual bool ImplBySimd(FDMat* mat) {
+    return ImplByOpenCV(mat);
+  }
+
+  virtual bool ImplBySimd(FDMatBatch* mat_batch) {
+    if (mat_batch->task_pool != nullptr) {
+      // The workers follow the ProcLibConfig of the calling thread
+      const ProcLibConfig* config = ProcLibScope::Current();
+      return mat_batch->task_pool->ParallelFor(
+          mat_batch->mats->size(), [this, mat_batch, config](size_t i) {
+            ProcLibScope scope(config);
+            return ImplBySimd(&(*(mat_batch->mats))[i]);
+          });
+    }
+    for (size_t i = 0; i < mat_batch->mats->size(); ++i) {
+      if (ImplBySimd(&(*(mat_batch->mats))[i]) != true) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// Whether WriteToBatch() supports the mat, only the processors outputting CHW float data on CPU support it
+  virtual bool CanWriteToBatch(FDMat* mat) { return false; }
+
+  /** \brief Process the mat on CPU, and write the CHW result into the slot of the mat in a batched NCHW float tensor instead of the mat itself, the mat is left unchanged
+   *
+   * \param[in] mat The input mat, its height and width should be no more than dst_h and dst_w
+   * \param[in] dst The first element of the slot
+   * \param[in] dst_h The height of the batched tensor
+   * \param[in] dst_w The width of the batched tensor, i.e. the row pitch of the slot
+   * \return true if the process successed, otherwise false
+   */
+  virtual bool WriteToBatch(FDMat* mat, float* dst, int dst_h, int dst_w) {
+    FDERROR << Name() << " doesn't support writing to a batched tensor."
+            << std::endl;
+    return false;
+  }
+
   virtual bool operator()(FDMat* mat, ProcLib lib = ProcLib::DEFAULT);
 
   virtual bool operator()(FDMatBatch* mat_batch,
                           ProcLib lib = ProcLib::DEFAULT);
 };
 
+/*! @brief Run the last processor on the mats of a batch, and write the results directly into their slots of a batched NCHW float tensor
+ *
+ * It saves the per-image tensors and the copies of Pad + Concat after the
+ * preprocessing. The area of a slot outside its mat is filled with
+ * `pad_values`, one value for each channel. Return false without touching the
+ * mats if the processor can't write any of the mats to the batch, the caller
+ * should run the processor by itself then.
+ */
+FASTDEPLOY_DECL bool WriteToBatchTensor(Processor* processor,
+                                        FDMatBatch* mat_batch, int dst_h,
+                                        int dst_w,
+                                        const std::vector<float>& pad_values,
+                                        FDTensor* output);
+
 }  // namespace vision
 }  // namespace fastdeploy
@@ -14,6 +14,8 @@
 
 #include "fastdeploy/vision/common/processors/cast.h"
 
+#include "fastdeploy/vision/common/processors/simd_kernels.h"
+
 namespace fastdeploy {
 namespace vision {
 
@@ -35,6 +37,33 @@ bool Cast::ImplByOpenCV(Mat* mat) {
   return true;
 }
 
+bool Cast::ImplBySimd(Mat* mat) {
+  if (dtype_ == "float" && mat->Type() == FDDataType::FP32) {
+    return true;
+  }
+  // Only the uint8 to float conversion is vectorized
+  if (dtype_ != "float" || mat->Type() != FDDataType::UINT8) {
+    return ImplByOpenCV(mat);
+  }
+  const void* src = GetSimdInputData(mat);
+  FDTensor* output = GetSimdOutputCache(mat);
+  if (src == nullptr || output == nullptr) {
+    return ImplByOpenCV(mat);
+  }
+  int height = mat->Height();
+  int width = mat->Width();
+  int channels = mat->Channels();
+  std::vector<int64_t> shape = {height, width, channels};
+  if (mat->layout == Layout::CHW) {
+    shape = {channels, height, width};
+  }
+  output->Resize(shape, FDDataType::FP32, "output_cache", Device::CPU);
+  simd::Cast(static_cast<const uint8_t*>(src), output->Numel(),
+             static_cast<float*>(output->MutableData()));
+  SetSimdOutput(mat, output, height, width, channels);
+  return true;
+}
+
 #ifdef ENABLE_FLYCV
 bool Cast::ImplByFlyCV(Mat* mat) {
   fcv::Mat* im = mat->GetFlyCVMat();
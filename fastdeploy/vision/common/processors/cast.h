@@ -26,6 +26,7 @@ class FASTDEPLOY_DECL Cast : public Processor {
 #ifdef ENABLE_FLYCV
   bool ImplByFlyCV(Mat* mat);
 #endif
+  bool ImplBySimd(Mat* mat);
   std::string Name() { return "Cast"; }
   static bool Run(Mat* mat, const std::string& dtype,
                   ProcLib lib = ProcLib::DEFAULT);
@@ -14,6 +14,8 @@
 
 #include "fastdeploy/vision/common/processors/center_crop.h"
 
+#include "fastdeploy/vision/common/processors/simd_kernels.h"
+
 #ifdef ENABLE_CVCUDA
 #include <cvcuda/OpCustomCrop.hpp>
 
@@ -41,6 +43,33 @@ bool CenterCrop::ImplByOpenCV(FDMat* mat) {
   return true;
 }
 
+bool CenterCrop::ImplBySimd(FDMat* mat) {
+  int height = mat->Height();
+  int width = mat->Width();
+  if (height < height_ || width < width_) {
+    FDERROR << "[CenterCrop] Image size less than crop size" << std::endl;
+    return false;
+  }
+  if (mat->layout != Layout::HWC) {
+    return ImplByOpenCV(mat);
+  }
+  const void* src = GetSimdInputData(mat);
+  FDTensor* output = GetSimdOutputCache(mat);
+  if (src == nullptr || output == nullptr) {
+    return ImplByOpenCV(mat);
+  }
+  int offset_x = static_cast<int>((width - width_) / 2);
+  int offset_y = static_cast<int>((height - height_) / 2);
+  int channels = mat->Channels();
+  output->Resize({height_, width_, channels}, mat->Type(), "output_cache",
+                 Device::CPU);
+  simd::Crop(static_cast<const uint8_t*>(src), width,
+             channels * FDDataTypeSize(mat->Type()), offset_x, offset_y,
+             width_, height_, static_cast<uint8_t*>(output->MutableData()));
+  SetSimdOutput(mat, output, height_, width_, channels);
+  return true;
+}
+
 #ifdef ENABLE_FLYCV
 bool CenterCrop::ImplByFlyCV(FDMat* mat) {
   fcv::Mat* im = mat->GetFlyCVMat();
@@ -26,12 +26,17 @@ class FASTDEPLOY_DECL CenterCrop : public Processor {
 #ifdef ENABLE_FLYCV
   bool ImplByFlyCV(FDMat* mat);
 #endif
+  bool ImplBySimd(FDMat* mat);
 #ifdef ENABLE_CVCUDA
   bool ImplByCvCuda(FDMat* mat);
   bool ImplByCvCuda(FDMatBatch* mat_batch);
 #endif
   std::string Name() { return "CenterCrop"; }
 
+  std::tuple<int, int> GetWidthAndHeight() const {
+    return std::make_tuple(width_, height_);
+  }
+
   static bool Run(FDMat* mat, const int& width, const int& height,
                   ProcLib lib = ProcLib::DEFAULT);
 
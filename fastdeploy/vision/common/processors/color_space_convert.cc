@@ -17,6 +17,11 @@
 namespace fastdeploy {
 namespace vision {
 bool BGR2RGB::ImplByOpenCV(FDMat* mat) {
+  // A YUV frame is decoded as BGR, so convert it to RGB in one pass
+  if (mat->yuv_format != YuvFormat::NONE) {
+    mat->ConvertYuv(true);
+    return true;
+  }
   cv::Mat* im = mat->GetOpenCVMat();
   cv::Mat new_im;
   cv::cvtColor(*im, new_im, cv::COLOR_BGR2RGB);
@@ -26,6 +31,9 @@ bool BGR2RGB::ImplByOpenCV(FDMat* mat) {
 
 #ifdef ENABLE_FLYCV
 bool BGR2RGB::ImplByFlyCV(FDMat* mat) {
+  if (mat->yuv_format != YuvFormat::NONE) {
+    return ImplByOpenCV(mat);
+  }
   fcv::Mat* im = mat->GetFlyCVMat();
   if (im->channels() != 3) {
     FDERROR << "[BGR2RGB] The channel of input image must be 3, but not it's "
@@ -40,6 +48,11 @@ bool BGR2RGB::ImplByFlyCV(FDMat* mat) {
 #endif
 
 bool RGB2BGR::ImplByOpenCV(FDMat* mat) {
+  // Swapping the channels of the BGR image decoded from a YUV frame
+  if (mat->yuv_format != YuvFormat::NONE) {
+    mat->ConvertYuv(true);
+    return true;
+  }
   cv::Mat* im = mat->GetOpenCVMat();
   cv::Mat new_im;
   cv::cvtColor(*im, new_im, cv::COLOR_RGB2BGR);
@@ -49,6 +62,9 @@ bool RGB2BGR::ImplByOpenCV(FDMat* mat) {
 
 #ifdef ENABLE_FLYCV
 bool RGB2BGR::ImplByFlyCV(FDMat* mat) {
+  if (mat->yuv_format != YuvFormat::NONE) {
+    return ImplByOpenCV(mat);
+  }
   fcv::Mat* im = mat->GetFlyCVMat();
   if (im->channels() != 3) {
     FDERROR << "[RGB2BGR] The channel of input image must be 3, but not it's "
@@ -52,6 +52,30 @@ bool ConvertAndPermute::ImplByOpenCV(FDMat* mat) {
   return true;
 }
 
+bool ConvertAndPermute::CanWriteToBatch(FDMat* mat) {
+  return (mat->mat_type == ProcLib::OPENCV ||
+          mat->mat_type == ProcLib::SIMD) &&
+         mat->device == Device::CPU &&
+         mat->layout == Layout::HWC &&
+         mat->Channels() == static_cast<int>(alpha_.size());
+}
+
+bool ConvertAndPermute::WriteToBatch(FDMat* mat, float* dst, int dst_h,
+                                     int dst_w) {
+  cv::Mat* im = mat->GetOpenCVMat();
+  std::vector<cv::Mat> split_im;
+  cv::split(*im, split_im);
+  if (swap_rb_) std::swap(split_im[0], split_im[2]);
+  size_t plane_size = static_cast<size_t>(dst_h) * dst_w;
+  for (int c = 0; c < im->channels(); c++) {
+    // Convert into the plane of the slot directly, its row pitch is dst_w
+    cv::Mat plane(im->rows, im->cols, CV_32FC1, dst + c * plane_size,
+                  dst_w * sizeof(float));
+    split_im[c].convertTo(plane, CV_32FC1, alpha_[c], beta_[c]);
+  }
+  return true;
+}
+
 #ifdef ENABLE_FLYCV
 bool ConvertAndPermute::ImplByFlyCV(FDMat* mat) {
   if (mat->layout != Layout::HWC) {
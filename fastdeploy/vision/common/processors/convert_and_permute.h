@@ -24,6 +24,8 @@ class FASTDEPLOY_DECL ConvertAndPermute : public Processor {
                     const std::vector<float>& beta = std::vector<float>(),
                     bool swap_rb = false);
   bool ImplByOpenCV(FDMat* mat);
+  bool CanWriteToBatch(FDMat* mat);
+  bool WriteToBatch(FDMat* mat, float* dst, int dst_h, int dst_w);
 #ifdef ENABLE_FLYCV
   bool ImplByFlyCV(FDMat* mat);
 #endif
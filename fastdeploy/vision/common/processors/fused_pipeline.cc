@@ -0,0 +1,503 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fastdeploy/vision/common/processors/fused_pipeline.h"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+#include "fastdeploy/vision/common/processors/center_crop.h"
+#include "fastdeploy/vision/common/processors/convert_and_permute.h"
+#include "fastdeploy/vision/common/processors/normalize_and_permute.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define FD_FUSED_PIPELINE_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define FD_FUSED_PIPELINE_NEON
+#endif
+
+namespace fastdeploy {
+namespace vision {
+
+namespace {
+
+// Source coordinates and weights of the output coordinates along an axis
+struct AxisCoeffs {
+  std::vector<int> index0;
+  std::vector<int> index1;
+  // Weight of index1
+  std::vector<float> weight;
+};
+
+// Same geometry as INTER_NEAREST/INTER_LINEAR of cv::resize, `offset` is
+// the crop offset in the resized image
+void ComputeAxisCoeffs(int src_size, int out_size, int offset,
+                       double inv_scale, int interp, int step,
+                       AxisCoeffs* coeffs) {
+  coeffs->index0.resize(out_size);
+  coeffs->index1.resize(out_size);
+  coeffs->weight.resize(out_size);
+  for (int i = 0; i < out_size; ++i) {
+    int d = i + offset;
+    int s = 0;
+    float w = 0.0f;
+    if (interp == cv::INTER_NEAREST) {
+      s = std::min(static_cast<int>(std::floor(d * inv_scale)), src_size - 1);
+    } else {
+      double f = (d + 0.5) * inv_scale - 0.5;
+      s = static_cast<int>(std::floor(f));
+      w = static_cast<float>(f - s);
+      if (s < 0) {
+        s = 0;
+        w = 0.0f;
+      }
+      if (s >= src_size - 1) {
+        s = src_size - 1;
+        w = 0.0f;
+      }
+    }
+    coeffs->index0[i] = s * step;
+    coeffs->index1[i] = std::min(s + 1, src_size - 1) * step;
+    coeffs->weight[i] = w;
+  }
+}
+
+// Sample a source row horizontally into the planar rows of every output
+// channel
+void SampleRow(const uint8_t* src_row, const int* src_channels, int channels,
+               const AxisCoeffs& xc, int out_w, float* planar) {
+  const int* index0 = xc.index0.data();
+  const int* index1 = xc.index1.data();
+  const float* weight = xc.weight.data();
+  for (int c = 0; c < channels; ++c) {
+    const uint8_t* src = src_row + src_channels[c];
+    float* dst = planar + c * out_w;
+    for (int x = 0; x < out_w; ++x) {
+      float v0 = src[index0[x]];
+      float v1 = src[index1[x]];
+      dst[x] = v0 + (v1 - v0) * weight[x];
+    }
+  }
+}
+
+// Convert a row of a YUV 4:2:0 frame to BGR, with the same BT.601 fixed point
+// coefficients as cv::cvtColor, `uv_step` is the distance between the
+// chroma samples of adjacent pixel pairs
+void YuvRowToBgr(const uint8_t* y_row, const uint8_t* u_row,
+                 const uint8_t* v_row, int uv_step, int width, uint8_t* dst) {
+  const int kShift = 20;
+  const int kCY = 1220542;
+  const int kCUB = 2116026;
+  const int kCUG = -409993;
+  const int kCVG = -852492;
+  const int kCVR = 1673527;
+  const int kRound = 1 << (kShift - 1);
+  auto saturate = [](int v) -> uint8_t {
+    return static_cast<uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+  };
+  for (int x = 0; x < width; x += 2) {
+    int u = u_row[(x / 2) * uv_step] - 128;
+    int v = v_row[(x / 2) * uv_step] - 128;
+    int ruv = kRound + kCVR * v;
+    int guv = kRound + kCVG * v + kCUG * u;
+    int buv = kRound + kCUB * u;
+    for (int k = 0; k < 2 && x + k < width; ++k) {
+      int y = std::max(0, y_row[x + k] - 16) * kCY;
+      uint8_t* p = dst + (x + k) * 3;
+      p[0] = saturate((y + buv) >> kShift);
+      p[1] = saturate((y + guv) >> kShift);
+      p[2] = saturate((y + ruv) >> kShift);
+    }
+  }
+}
+
+// dst = (row0 * (1 - w) + row1 * w) * alpha + beta
+void BlendRow(const float* row0, const float* row1, float w, float alpha,
+              float beta, int n, float* dst) {
+  float alpha0 = alpha * (1.0f - w);
+  float alpha1 = alpha * w;
+  int x = 0;
+#if defined(FD_FUSED_PIPELINE_SSE)
+  __m128 a0 = _mm_set1_ps(alpha0);
+  __m128 a1 = _mm_set1_ps(alpha1);
+  __m128 b = _mm_set1_ps(beta);
+  for (; x + 4 <= n; x += 4) {
+    __m128 v = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(row0 + x), a0),
+                          _mm_mul_ps(_mm_loadu_ps(row1 + x), a1));
+    _mm_storeu_ps(dst + x, _mm_add_ps(v, b));
+  }
+#elif defined(FD_FUSED_PIPELINE_NEON)
+  float32x4_t a0 = vdupq_n_f32(alpha0);
+  float32x4_t a1 = vdupq_n_f32(alpha1);
+  float32x4_t b = vdupq_n_f32(beta);
+  for (; x + 4 <= n; x += 4) {
+    float32x4_t v = vmlaq_f32(b, vld1q_f32(row0 + x), a0);
+    vst1q_f32(dst + x, vmlaq_f32(v, vld1q_f32(row1 + x), a1));
+  }
+#endif
+  for (; x < n; ++x) {
+    dst[x] = row0[x] * alpha0 + row1[x] * alpha1 + beta;
+  }
+}
+
+// Keep the cache small when the input resolution keeps changing
+const size_t kMaxCachedGeometries = 32;
+
+}  // namespace
+
+// The sampling plan of an input resolution
+struct FusedPipeline::Geometry {
+  int resized_w = 0;
+  int resized_h = 0;
+  int out_w = 0;
+  int out_h = 0;
+  // The interpolations other than nearest and bilinear are resized by OpenCV
+  // first, then the kernel samples the resized image without scaling
+  bool pre_resize = false;
+  AxisCoeffs xc;
+  AxisCoeffs yc;
+};
+
+bool FusedPipeline::Compile(
+    const std::vector<std::shared_ptr<Processor>>& processors) {
+  compiled_ = false;
+  {
+    std::lock_guard<std::mutex> lock(geometry_mutex_);
+    geometries_.clear();
+  }
+  resize_.reset();
+  resize_by_short_.reset();
+  interp_ = cv::INTER_LINEAR;
+  crop_w_ = -1;
+  crop_h_ = -1;
+  swap_rb_ = false;
+  alpha_.clear();
+  beta_.clear();
+
+  for (size_t i = 0; i < processors.size(); ++i) {
+    std::string name = processors[i]->Name();
+    bool has_resize = resize_ != nullptr || resize_by_short_ != nullptr;
+    if (name == "BGR2RGB" || name == "RGB2BGR") {
+      // The color conversion commutes with resize and crop
+      swap_rb_ = !swap_rb_;
+    } else if (name == "Resize" && !has_resize && crop_w_ <= 0) {
+      resize_ = std::dynamic_pointer_cast<Resize>(processors[i]);
+      interp_ = resize_->GetInterp();
+    } else if (name == "ResizeByShort" && !has_resize && crop_w_ <= 0) {
+      resize_by_short_ =
+          std::dynamic_pointer_cast<ResizeByShort>(processors[i]);
+      interp_ = resize_by_short_->GetInterp();
+    } else if (name == "CenterCrop" && crop_w_ <= 0) {
+      std::tie(crop_w_, crop_h_) =
+          std::dynamic_pointer_cast<CenterCrop>(processors[i])
+              ->GetWidthAndHeight();
+    } else if (name == "NormalizeAndPermute" && i + 1 == processors.size()) {
+      auto processor =
+          std::dynamic_pointer_cast<NormalizeAndPermute>(processors[i]);
+      alpha_ = processor->GetAlpha();
+      beta_ = processor->GetBeta();
+      swap_rb_ = swap_rb_ != processor->GetSwapRB();
+    } else if (name == "ConvertAndPermute" && i + 1 == processors.size()) {
+      auto processor =
+          std::dynamic_pointer_cast<ConvertAndPermute>(processors[i]);
+      alpha_ = processor->GetAlpha();
+      beta_ = processor->GetBeta();
+      swap_rb_ = swap_rb_ != processor->GetSwapRB();
+    } else {
+      return false;
+    }
+  }
+  if (alpha_.empty() || alpha_.size() != beta_.size() ||
+      (swap_rb_ && alpha_.size() < 3)) {
+    return false;
+  }
+  compiled_ = true;
+  return true;
+}
+
+bool FusedPipeline::Supported(FDMat* mat) const {
+  // The YUV frames are decoded to 3 channels by the kernel
+  return compiled_ && mat->mat_type == ProcLib::OPENCV &&
+         mat->device == Device::CPU && mat->layout == Layout::HWC &&
+         mat->Type() == FDDataType::UINT8 && mat->Channels() == Channels();
+}
+
+bool FusedPipeline::ResizedShape(int origin_w, int origin_h, int* resized_w,
+                                 int* resized_h, double* inv_scale_w,
+                                 double* inv_scale_h) const {
+  if (resize_ != nullptr) {
+    return resize_->GetResizedShape(origin_w, origin_h, resized_w, resized_h,
+                                    inv_scale_w, inv_scale_h);
+  }
+  if (resize_by_short_ != nullptr) {
+    return resize_by_short_->GetResizedShape(
+        origin_w, origin_h, resized_w, resized_h, inv_scale_w, inv_scale_h);
+  }
+  *resized_w = origin_w;
+  *resized_h = origin_h;
+  *inv_scale_w = 1.0;
+  *inv_scale_h = 1.0;
+  return true;
+}
+
+bool FusedPipeline::InferShape(int origin_w, int origin_h, int* resized_w,
+                               int* resized_h, int* out_w, int* out_h) const {
+  double inv_scale_w = 1.0;
+  double inv_scale_h = 1.0;
+  if (!ResizedShape(origin_w, origin_h, resized_w, resized_h, &inv_scale_w,
+                    &inv_scale_h)) {
+    return false;
+  }
+  *out_w = *resized_w;
+  *out_h = *resized_h;
+  if (crop_w_ > 0) {
+    if (*resized_w < crop_w_ || *resized_h < crop_h_) {
+      return false;
+    }
+    *out_w = crop_w_;
+    *out_h = crop_h_;
+  }
+  return *out_w > 0 && *out_h > 0;
+}
+
+std::shared_ptr<const FusedPipeline::Geometry> FusedPipeline::GetGeometry(
+    int origin_w, int origin_h) const {
+  std::pair<int, int> key(origin_w, origin_h);
+  {
+    std::lock_guard<std::mutex> lock(geometry_mutex_);
+    auto iter = geometries_.find(key);
+    if (iter != geometries_.end()) {
+      return iter->second;
+    }
+  }
+
+  auto geometry = std::make_shared<Geometry>();
+  double inv_scale_w = 1.0;
+  double inv_scale_h = 1.0;
+  if (!ResizedShape(origin_w, origin_h, &geometry->resized_w,
+                    &geometry->resized_h, &inv_scale_w, &inv_scale_h) ||
+      geometry->resized_w <= 0 || geometry->resized_h <= 0) {
+    FDERROR << "FusedPipeline: Failed to compute the resized shape."
+            << std::endl;
+    return nullptr;
+  }
+  geometry->out_w = geometry->resized_w;
+  geometry->out_h = geometry->resized_h;
+  int offset_x = 0;
+  int offset_y = 0;
+  if (crop_w_ > 0) {
+    if (geometry->resized_w < crop_w_ || geometry->resized_h < crop_h_) {
+      FDERROR << "[CenterCrop] Image size less than crop size" << std::endl;
+      return nullptr;
+    }
+    geometry->out_w = crop_w_;
+    geometry->out_h = crop_h_;
+    offset_x = (geometry->resized_w - crop_w_) / 2;
+    offset_y = (geometry->resized_h - crop_h_) / 2;
+  }
+
+  // Only nearest and bilinear are sampled by the kernel
+  int interp = interp_;
+  int src_w = origin_w;
+  int src_h = origin_h;
+  if (interp != cv::INTER_NEAREST && interp != cv::INTER_LINEAR &&
+      (geometry->resized_w != origin_w || geometry->resized_h != origin_h)) {
+    geometry->pre_resize = true;
+    src_w = geometry->resized_w;
+    src_h = geometry->resized_h;
+    inv_scale_w = 1.0;
+    inv_scale_h = 1.0;
+    interp = cv::INTER_LINEAR;
+  }
+  ComputeAxisCoeffs(src_w, geometry->out_w, offset_x, inv_scale_w, interp,
+                    Channels(), &geometry->xc);
+  ComputeAxisCoeffs(src_h, geometry->out_h, offset_y, inv_scale_h, interp, 1,
+                    &geometry->yc);
+
+  std::lock_guard<std::mutex> lock(geometry_mutex_);
+  if (geometries_.size() >= kMaxCachedGeometries) {
+    geometries_.clear();
+  }
+  geometries_[key] = geometry;
+  return geometry;
+}
+
+bool FusedPipeline::Prepare(int origin_w, int origin_h) const {
+  return compiled_ && GetGeometry(origin_w, origin_h) != nullptr;
+}
+
+bool FusedPipeline::Run(FDMat* mat, float* dst, int dst_h, int dst_w) const {
+  if (!Supported(mat)) {
+    FDERROR << "FusedPipeline: Only supports the uint8 HWC image with "
+            << Channels() << " channels on CPU." << std::endl;
+    return false;
+  }
+  int origin_w = mat->Width();
+  int origin_h = mat->Height();
+  std::shared_ptr<const Geometry> geometry = GetGeometry(origin_w, origin_h);
+  if (geometry == nullptr) {
+    return false;
+  }
+  const AxisCoeffs& xc = geometry->xc;
+  const AxisCoeffs& yc = geometry->yc;
+  int out_w = geometry->out_w;
+  int out_h = geometry->out_h;
+  if (dst_w < out_w || dst_h < out_h) {
+    FDERROR << "FusedPipeline: The output buffer " << dst_h << "x" << dst_w
+            << " is smaller than the image " << out_h << "x" << out_w << "."
+            << std::endl;
+    return false;
+  }
+
+  // Resize by OpenCV first for the interpolations other than nearest and
+  // bilinear
+  const cv::Mat* src = nullptr;
+  cv::Mat resized;
+  if (geometry->pre_resize) {
+    cv::Mat* im = mat->GetOpenCVMat();
+    cv::resize(*im, resized,
+               cv::Size(geometry->resized_w, geometry->resized_h), 0, 0,
+               interp_);
+    src = &resized;
+    origin_w = geometry->resized_w;
+    origin_h = geometry->resized_h;
+  } else if (mat->yuv_format == YuvFormat::NONE) {
+    src = mat->GetOpenCVMat();
+  }
+
+  // The rows of a YUV frame are converted to BGR on demand, so the frame is
+  // read in the same pass as the sampling
+  const uint8_t* yuv = src == nullptr ? mat->YuvData() : nullptr;
+  const uint8_t* u_plane = nullptr;
+  const uint8_t* v_plane = nullptr;
+  int uv_step = 1;
+  int uv_stride = origin_w / 2;
+  if (yuv != nullptr) {
+    const uint8_t* chroma = yuv + static_cast<size_t>(origin_h) * origin_w;
+    if (mat->yuv_format == YuvFormat::I420) {
+      u_plane = chroma;
+      v_plane = chroma + static_cast<size_t>(origin_h / 2) * uv_stride;
+    } else {
+      uv_step = 2;
+      uv_stride = origin_w;
+      u_plane = mat->yuv_format == YuvFormat::NV12 ? chroma : chroma + 1;
+      v_plane = mat->yuv_format == YuvFormat::NV12 ? chroma + 1 : chroma;
+    }
+  }
+  std::vector<uint8_t> bgr_row(yuv != nullptr ? origin_w * 3 : 0);
+  auto source_row = [&](int sy) -> const uint8_t* {
+    if (yuv == nullptr) {
+      return src->ptr<uint8_t>(sy);
+    }
+    size_t uv_offset = static_cast<size_t>(sy / 2) * uv_stride;
+    YuvRowToBgr(yuv + static_cast<size_t>(sy) * origin_w, u_plane + uv_offset,
+                v_plane + uv_offset, uv_step, origin_w, bgr_row.data());
+    return bgr_row.data();
+  };
+
+  int channels = Channels();
+  std::vector<int> src_channels(channels);
+  for (int c = 0; c < channels; ++c) {
+    src_channels[c] = c;
+  }
+  if (swap_rb_) {
+    std::swap(src_channels[0], src_channels[2]);
+  }
+
+  // The horizontally sampled rows are cached, so every source row is sampled
+  // once while upscaling
+  size_t row_size = static_cast<size_t>(channels) * out_w;
+  std::vector<float> rows(row_size * 2);
+  int cached[2] = {-1, -1};
+  auto sample = [&](int sy, int avoid_slot) -> int {
+    if (cached[0] == sy) {
+      return 0;
+    }
+    if (cached[1] == sy) {
+      return 1;
+    }
+    int slot = avoid_slot == 0 ? 1 : 0;
+    SampleRow(source_row(sy), src_channels.data(), channels, xc, out_w,
+              rows.data() + slot * row_size);
+    cached[slot] = sy;
+    return slot;
+  };
+
+  size_t plane_size = static_cast<size_t>(dst_h) * dst_w;
+  for (int y = 0; y < out_h; ++y) {
+    float w = yc.weight[y];
+    // Keep the row of index1 while sampling index0
+    int keep = cached[0] == yc.index1[y] ? 0
+               : cached[1] == yc.index1[y] ? 1
+                                           : -1;
+    int slot0 = sample(yc.index0[y], keep);
+    int slot1 = w == 0.0f ? slot0 : sample(yc.index1[y], slot0);
+    const float* row0 = rows.data() + slot0 * row_size;
+    const float* row1 = rows.data() + slot1 * row_size;
+    for (int c = 0; c < channels; ++c) {
+      BlendRow(row0 + c * out_w, row1 + c * out_w, w, alpha_[c], beta_[c],
+               out_w, dst + c * plane_size + static_cast<size_t>(y) * dst_w);
+    }
+  }
+  return true;
+}
+
+bool FusedPipeline::Run(FDMatBatch* mat_batch, FDTensor* output) const {
+  std::vector<FDMat>* mats = mat_batch->mats;
+  int out_w = 0;
+  int out_h = 0;
+  for (size_t i = 0; i < mats->size(); ++i) {
+    int resized_w = 0;
+    int resized_h = 0;
+    int w = 0;
+    int h = 0;
+    if (!InferShape((*mats)[i].Width(), (*mats)[i].Height(), &resized_w,
+                    &resized_h, &w, &h)) {
+      FDERROR << "FusedPipeline: Failed to compute the output shape of image "
+              << i << "." << std::endl;
+      return false;
+    }
+    if (i > 0 && (w != out_w || h != out_h)) {
+      FDERROR << "FusedPipeline: The output shapes of the images in a batch "
+                 "should be the same."
+              << std::endl;
+      return false;
+    }
+    out_w = w;
+    out_h = h;
+  }
+  int channels = Channels();
+  output->Resize({static_cast<int64_t>(mats->size()), channels, out_h, out_w},
+                 FDDataType::FP32, output->name, Device::CPU);
+  float* data = reinterpret_cast<float*>(output->MutableData());
+  size_t image_size = static_cast<size_t>(channels) * out_h * out_w;
+  auto run = [&](size_t i) {
+    return Run(&((*mats)[i]), data + i * image_size, out_h, out_w);
+  };
+  if (mat_batch->task_pool != nullptr) {
+    return mat_batch->task_pool->ParallelFor(mats->size(), run);
+  }
+  for (size_t i = 0; i < mats->size(); ++i) {
+    if (!run(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace vision
+}  // namespace fastdeploy
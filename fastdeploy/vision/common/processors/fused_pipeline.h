@@ -0,0 +1,135 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include "fastdeploy/vision/common/processors/base.h"
+#include "fastdeploy/vision/common/processors/resize.h"
+#include "fastdeploy/vision/common/processors/resize_by_short.h"
+
+namespace fastdeploy {
+namespace vision {
+
+/*! @brief Single pass CPU preprocessing compiled from a processor chain
+ *
+ * The chain(after FuseTransforms) of
+ * [BGR2RGB/RGB2BGR] -> [Resize/ResizeByShort] -> [CenterCrop] ->
+ * NormalizeAndPermute/ConvertAndPermute is compiled into one kernel, which
+ * samples the source pixels(nearest or bilinear with the same geometry as
+ * OpenCV), swaps the channels, normalizes and writes the planar float data
+ * directly into the batch tensor. The other interpolations are resized by
+ * OpenCV first and then run the rest of the kernel. The bilinear result is
+ * computed in float without rounding back to uint8, so it may differ from the
+ * processor chain by 1 level of the pixel value.
+ *
+ * The NV12/NV21/I420 frames created by FDMat::CreateFromYuv() are decoded row
+ * by row inside the kernel, so the frame is never converted to a full BGR
+ * image. The decoding is bit exact with cv::cvtColor.
+ *
+ * The sampling coefficients are cached per input resolution, so the frames
+ * of a video only compute them once.
+ *
+ * The pipeline is immutable after compiled, Run() can be called from multiple
+ * threads.
+ */
+class FASTDEPLOY_DECL FusedPipeline {
+ public:
+  /** \brief Compile the processors
+   *
+   * \param[in] processors The processor chain
+   * \return true if the chain can be fused, otherwise false and the processors should run one by one
+   */
+  bool Compile(const std::vector<std::shared_ptr<Processor>>& processors);
+
+  bool Compiled() const { return compiled_; }
+
+  /// Whether the kernel supports the image, e.g. it's a uint8 HWC image on CPU
+  bool Supported(FDMat* mat) const;
+
+  /** \brief Compute the shape of an image processed by the pipeline
+   *
+   * \param[in] origin_w Width of the input image
+   * \param[in] origin_h Height of the input image
+   * \param[out] resized_w Width of the image after the resize step
+   * \param[out] resized_h Height of the image after the resize step
+   * \param[out] out_w Width of the output image
+   * \param[out] out_h Height of the output image
+   * \return true if the image can be processed
+   */
+  bool InferShape(int origin_w, int origin_h, int* resized_w, int* resized_h,
+                  int* out_w, int* out_h) const;
+
+  /** \brief Precompute the sampling coefficients for an input resolution, which are computed by the first Run() of the resolution otherwise
+   *
+   * \param[in] origin_w Width of the input image
+   * \param[in] origin_h Height of the input image
+   * \return true if the image of this size can be processed
+   */
+  bool Prepare(int origin_w, int origin_h) const;
+
+  /** \brief Process an image into a planar float buffer
+   *
+   * \param[in] mat The input image, which is not modified
+   * \param[in] dst The output buffer with `Channels() x dst_h x dst_w` floats, the image is written to the top left corner of every plane and the rest is kept as is
+   * \param[in] dst_h Height of the output planes, not less than the output height of the image
+   * \param[in] dst_w Width of the output planes, not less than the output width of the image
+   * \return true if the process successed, otherwise false
+   */
+  bool Run(FDMat* mat, float* dst, int dst_h, int dst_w) const;
+
+  /** \brief Process a batch of images into a NCHW float tensor
+   *
+   * \param[in] mat_batch The input images, the images should have the same output shape
+   * \param[in] output The output tensor
+   * \return true if the process successed, otherwise false
+   */
+  bool Run(FDMatBatch* mat_batch, FDTensor* output) const;
+
+  /// Number of the output channels
+  int Channels() const { return static_cast<int>(alpha_.size()); }
+
+ private:
+  struct Geometry;
+
+  bool ResizedShape(int origin_w, int origin_h, int* resized_w, int* resized_h,
+                    double* inv_scale_w, double* inv_scale_h) const;
+  // Get the cached geometry of an input resolution, nullptr if the image
+  // can't be processed
+  std::shared_ptr<const Geometry> GetGeometry(int origin_w,
+                                              int origin_h) const;
+
+  bool compiled_ = false;
+  // Resize step, at most one of them is set
+  std::shared_ptr<Resize> resize_;
+  std::shared_ptr<ResizeByShort> resize_by_short_;
+  int interp_ = cv::INTER_LINEAR;
+  // CenterCrop step, <= 0 means there's no crop
+  int crop_w_ = -1;
+  int crop_h_ = -1;
+  bool swap_rb_ = false;
+  std::vector<float> alpha_;
+  std::vector<float> beta_;
+
+  // The cache is cleared by Compile(), or once it holds too many resolutions
+  mutable std::mutex geometry_mutex_;
+  mutable std::map<std::pair<int, int>, std::shared_ptr<const Geometry>>
+      geometries_;
+};
+
+}  // namespace vision
+}  // namespace fastdeploy
@@ -15,6 +15,7 @@
 #include "fastdeploy/vision/common/processors/hwc2chw.h"
 
 #include "fastdeploy/function/transpose.h"
+#include "fastdeploy/vision/common/processors/simd_kernels.h"
 
 namespace fastdeploy {
 namespace vision {
@@ -41,6 +42,57 @@ bool HWC2CHW::ImplByOpenCV(Mat* mat) {
   return true;
 }
 
+bool HWC2CHW::ImplBySimd(Mat* mat) {
+  if (mat->layout != Layout::HWC) {
+    FDERROR << "HWC2CHW: The input data is not Layout::HWC format!"
+            << std::endl;
+    return false;
+  }
+  FDDataType type = mat->Type();
+  if (type != FDDataType::UINT8 && type != FDDataType::FP32) {
+    return ImplByOpenCV(mat);
+  }
+  const void* src = GetSimdInputData(mat);
+  FDTensor* output = GetSimdOutputCache(mat);
+  if (src == nullptr || output == nullptr) {
+    return ImplByOpenCV(mat);
+  }
+  int height = mat->Height();
+  int width = mat->Width();
+  int channels = mat->Channels();
+  output->Resize({channels, height, width}, type, "output_cache", Device::CPU);
+  if (type == FDDataType::UINT8) {
+    simd::HWC2CHW(static_cast<const uint8_t*>(src), height, width, channels,
+                  static_cast<uint8_t*>(output->MutableData()));
+  } else {
+    simd::HWC2CHW(static_cast<const float*>(src), height, width, channels,
+                  static_cast<float*>(output->MutableData()));
+  }
+  mat->layout = Layout::CHW;
+  SetSimdOutput(mat, output, height, width, channels);
+  return true;
+}
+
+bool HWC2CHW::CanWriteToBatch(Mat* mat) {
+  return (mat->mat_type == ProcLib::OPENCV ||
+          mat->mat_type == ProcLib::SIMD) &&
+         mat->device == Device::CPU &&
+         mat->layout == Layout::HWC && mat->Type() == FDDataType::FP32;
+}
+
+bool HWC2CHW::WriteToBatch(Mat* mat, float* dst, int dst_h, int dst_w) {
+  cv::Mat* im = mat->GetOpenCVMat();
+  size_t plane_size = static_cast<size_t>(dst_h) * dst_w;
+  for (int i = 0; i < im->channels(); ++i) {
+    // Extract into the plane of the slot directly, its row pitch is dst_w
+    cv::extractChannel(*im,
+                       cv::Mat(im->rows, im->cols, CV_32FC1,
+                               dst + i * plane_size, dst_w * sizeof(float)),
+                       i);
+  }
+  return true;
+}
+
 #ifdef ENABLE_FLYCV
 bool HWC2CHW::ImplByFlyCV(Mat* mat) {
   if (mat->layout != Layout::HWC) {
@@ -22,6 +22,9 @@ namespace vision {
 class FASTDEPLOY_DECL HWC2CHW : public Processor {
  public:
   bool ImplByOpenCV(Mat* mat);
+  bool ImplBySimd(Mat* mat);
+  bool CanWriteToBatch(Mat* mat);
+  bool WriteToBatch(Mat* mat, float* dst, int dst_h, int dst_w);
 #ifdef ENABLE_FLYCV
   bool ImplByFlyCV(Mat* mat);
 #endif
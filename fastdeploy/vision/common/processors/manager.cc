@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #include "fastdeploy/vision/common/processors/manager.h"
+#include "fastdeploy/core/arena_allocator.h"
+
+#include "fastdeploy/vision/common/processors/simd_kernels.h"
 
 namespace fastdeploy {
 namespace vision {
@@ -31,23 +34,135 @@ void ProcessorManager::UseCuda(bool enable_cv_cuda, int gpu_id) {
   }
   FDASSERT(cudaStreamCreate(&stream_) == cudaSuccess,
            "[ERROR] Error occurs while creating cuda stream.");
-  DefaultProcLib::default_lib = ProcLib::CUDA;
+  proc_lib_config_.lib = ProcLib::CUDA;
 #else
   FDASSERT(false, "FastDeploy didn't compile with WITH_GPU.");
 #endif
 
   if (enable_cv_cuda) {
 #ifdef ENABLE_CVCUDA
-    DefaultProcLib::default_lib = ProcLib::CVCUDA;
+    proc_lib_config_.lib = ProcLib::CVCUDA;
 #else
     FDASSERT(false, "FastDeploy didn't compile with CV-CUDA.");
 #endif
   }
+  PlanProcLibs();
 }
 
 bool ProcessorManager::CudaUsed() {
-  return (DefaultProcLib::default_lib == ProcLib::CUDA ||
-          DefaultProcLib::default_lib == ProcLib::CVCUDA);
+  if (proc_lib_config_.lib == ProcLib::DEFAULT) {
+    return (DefaultProcLib::default_lib == ProcLib::CUDA ||
+            DefaultProcLib::default_lib == ProcLib::CVCUDA);
+  }
+  return proc_lib_config_.UseGpu();
+}
+
+void ProcessorManager::SetProcLib(ProcLib lib) {
+  FDASSERT(lib != ProcLib::CUDA && lib != ProcLib::CVCUDA,
+           "Please call UseCuda() to use CUDA or CV-CUDA.");
+  proc_lib_config_.lib = lib;
+  PlanProcLibs();
+}
+
+void ProcessorManager::SetProcLibForOp(const std::string& op_name,
+                                       ProcLib lib) {
+  FDASSERT(!IsGpuProcLib(lib) || IsGpuProcLib(proc_lib_config_.lib),
+           "Please call UseCuda() before running %s with CUDA.",
+           op_name.c_str());
+  enable_auto_proc_lib_ = false;
+  proc_lib_config_.op_libs[op_name] = lib;
+}
+
+void ProcessorManager::EnableAutoProcLib(bool enable) {
+  enable_auto_proc_lib_ = enable;
+  if (!enable) {
+    proc_lib_config_.op_libs.clear();
+  }
+  PlanProcLibs();
+}
+
+void ProcessorManager::SetProcessorChain(
+    const std::vector<std::shared_ptr<Processor>>& processors) {
+  op_names_.clear();
+  for (const auto& processor : processors) {
+    op_names_.push_back(processor->Name());
+  }
+  PlanProcLibs();
+}
+
+void ProcessorManager::PlanProcLibs() {
+  if (!enable_auto_proc_lib_) {
+    return;
+  }
+  std::vector<ProcLib> candidates;
+#ifdef ENABLE_FLYCV
+  candidates.push_back(ProcLib::FLYCV);
+#endif
+  if (simd::Avx2Enabled()) {
+    candidates.push_back(ProcLib::SIMD);
+  }
+  // The GPU libraries are only available after UseCuda() creates the stream
+  if (IsGpuProcLib(proc_lib_config_.lib)) {
+    candidates.push_back(proc_lib_config_.lib);
+  }
+  proc_lib_config_.op_libs = ChooseProcLibsByCost(op_names_, candidates);
+}
+
+void ProcessorManager::SetThreadNum(int thread_num) {
+  FDASSERT(thread_num > 0, "The thread_num should be > 0, but now it's %d.",
+           thread_num);
+  if (thread_num == 1) {
+    task_pool_.reset();
+  } else if (thread_num != ThreadNum()) {
+    task_pool_ = std::make_shared<TaskPool>(thread_num);
+  }
+}
+
+bool ProcessorManager::ParallelFor(size_t n,
+                                   const std::function<bool(size_t)>& func) {
+  if (task_pool_ != nullptr && !CudaUsed()) {
+    // The workers follow the ProcLibConfig of the calling thread
+    const ProcLibConfig* config = ProcLibScope::Current();
+    return task_pool_->ParallelFor(n, [&func, config](size_t i) {
+      ProcLibScope scope(config);
+      return func(i);
+    });
+  }
+  for (size_t i = 0; i < n; ++i) {
+    if (!func(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ProcessorManager::CompileFusedPipeline(
+    const std::vector<std::shared_ptr<Processor>>& processors) {
+  auto pipeline = std::make_shared<FusedPipeline>();
+  if (pipeline->Compile(processors)) {
+    fused_pipeline_ = pipeline;
+  } else {
+    fused_pipeline_.reset();
+  }
+}
+
+void ProcessorManager::SetPlan(
+    const std::shared_ptr<const PreprocessPlan>& plan) {
+  plan_ = plan;
+  fused_pipeline_ = plan->GetFusedPipeline();
+  SetProcessorChain(plan->Processors());
+}
+
+bool ProcessorManager::UseFusedPipeline(FDMatBatch* image_batch) {
+  if (!FusedPipelineEnabled() || CudaUsed()) {
+    return false;
+  }
+  for (size_t i = 0; i < image_batch->mats->size(); ++i) {
+    if (!fused_pipeline_->Supported(&((*(image_batch->mats))[i]))) {
+      return false;
+    }
+  }
+  return true;
 }
 
 bool ProcessorManager::Run(std::vector<FDMat>* images,
@@ -62,6 +177,16 @@ bool ProcessorManager::Run(std::vector<FDMat>* images,
     return false;
   }
 
+  // The processors run on this thread follow the config of this manager
+  ProcLibScope scope(&proc_lib_config_);
+
+  // The caches are kept by the manager across the requests, so the ones
+  // allocated inside a request arena are moved out, or they would pin its
+  // chunks. It can't be done after Apply(), the outputs may share the caches
+  MoveOutOfArena(&input_caches_);
+  MoveOutOfArena(&output_caches_);
+  MoveOutOfArena(&batch_input_cache_);
+  MoveOutOfArena(&batch_output_cache_);
   if (images->size() > input_caches_.size()) {
     input_caches_.resize(images->size());
     output_caches_.resize(images->size());
@@ -70,6 +195,9 @@ bool ProcessorManager::Run(std::vector<FDMat>* images,
   FDMatBatch image_batch(images);
   image_batch.input_cache = &batch_input_cache_;
   image_batch.output_cache = &batch_output_cache_;
+  if (task_pool_ != nullptr && !CudaUsed()) {
+    image_batch.task_pool = task_pool_.get();
+  }
 
   for (size_t i = 0; i < images->size(); ++i) {
     if (CudaUsed()) {
@@ -14,9 +14,12 @@
 
 #pragma once
 
+#include "fastdeploy/utils/task_pool.h"
 #include "fastdeploy/utils/utils.h"
+#include "fastdeploy/vision/common/processors/fused_pipeline.h"
 #include "fastdeploy/vision/common/processors/mat.h"
 #include "fastdeploy/vision/common/processors/mat_batch.h"
+#include "fastdeploy/vision/common/processors/preprocess_plan.h"
 
 namespace fastdeploy {
 namespace vision {
@@ -35,6 +38,31 @@ class FASTDEPLOY_DECL ProcessorManager {
 
   bool CudaUsed();
 
+  /** \brief Set the image processing library of this manager, which only affects the processors run by this manager instead of the whole process like EnableFlyCV()
+   *
+   * \param[in] lib OPENCV, FLYCV or SIMD, DEFAULT means following the process-wide library. Call UseCuda() for CUDA and CV-CUDA
+   */
+  void SetProcLib(ProcLib lib);
+
+  /// Get the image processing library of this manager
+  ProcLib GetProcLib() const { return proc_lib_config_.lib; }
+
+  /** \brief Set the image processing library of a single processor, which overrides SetProcLib() and disables EnableAutoProcLib()
+   *
+   * \param[in] op_name The name of the processor, e.g. "Resize"
+   * \param[in] lib The library of the processor, CUDA and CV-CUDA are only allowed after UseCuda()
+   */
+  void SetProcLibForOp(const std::string& op_name, ProcLib lib);
+
+  /** \brief Choose the image processing library of every processor from the built-in per-op cost table, among OpenCV, FlyCV(if compiled), SIMD(if the CPU supports AVX2) and the library of UseCuda()(if called)
+   *
+   * \param[in] enable true to enable the automatic choice
+   */
+  void EnableAutoProcLib(bool enable = true);
+
+  /// Get the library setting of this manager, the libraries chosen for every processor are in op_libs
+  const ProcLibConfig& GetProcLibConfig() const { return proc_lib_config_; }
+
   void SetStream(FDMat* mat) {
 #ifdef WITH_GPU
     mat->SetStream(stream_);
@@ -56,6 +84,43 @@ class FASTDEPLOY_DECL ProcessorManager {
 
   int DeviceId() { return device_id_; }
 
+  /** \brief Run the CPU preprocessing in a single fused pass, which samples, swaps the channels, normalizes and writes the planar data directly into the output tensor. It only takes effect while the processors(after fusion) are [Resize/ResizeByShort] -> [CenterCrop] -> NormalizeAndPermute, and the images are uint8 HWC images on CPU, otherwise the processors still run one by one. The bilinear resize is computed in float, so the result may differ from the OpenCV processors by 1 level of the pixel value
+   *
+   * \param[in] enable true to enable the fused pipeline
+   */
+  void EnableFusedPipeline(bool enable = true) {
+    enable_fused_pipeline_ = enable;
+  }
+
+  /// Whether the fused pipeline is enabled and the processors can be fused
+  bool FusedPipelineEnabled() const {
+    return enable_fused_pipeline_ && fused_pipeline_ != nullptr;
+  }
+
+  /** \brief Set the number of threads processing the images of a batch in parallel on CPU, which is separate from the cpu_thread_num of the runtime. The calling thread is one of the threads, so 1 means processing the images one by one. Better to call SetProcLibCpuNumThreads(1) as well to avoid oversubscribing the cores by the threads inside OpenCV
+   *
+   * \param[in] thread_num The number of threads, should be > 0
+   */
+  void SetThreadNum(int thread_num);
+
+  /// Get the preprocess plan shared with the other preprocessors of the same config, nullptr if the derived class doesn't build one
+  std::shared_ptr<const PreprocessPlan> GetPlan() const { return plan_; }
+
+  /** \brief Precompute the resize coefficients of the fused pipeline for an input resolution, e.g. the resolution of a video, so the first frame doesn't pay for them
+   *
+   * \param[in] width Width of the input image
+   * \param[in] height Height of the input image
+   * \return true if the coefficients are computed, false if the processors aren't fused or the size is not supported
+   */
+  bool PrepareInputSize(int width, int height) const {
+    return plan_ != nullptr && plan_->Prepare(width, height);
+  }
+
+  /// Get the number of threads processing the images of a batch
+  int ThreadNum() const {
+    return task_pool_ == nullptr ? 1 : task_pool_->NumThreads();
+  }
+
   /** \brief Process the input image and prepare input tensors for runtime
    *
    * \param[in] images The input image data list, all the elements are returned by cv::imread()
@@ -74,13 +139,56 @@ class FASTDEPLOY_DECL ProcessorManager {
                      std::vector<FDTensor>* outputs) = 0;
 
  protected:
+  /** \brief Compile the processors into the fused pipeline, the derived class should call it after the processors are built
+   *
+   * \param[in] processors The processors after fusion
+   */
+  void CompileFusedPipeline(
+      const std::vector<std::shared_ptr<Processor>>& processors);
+
+  /** \brief Record the processor chain for EnableAutoProcLib(), the derived class should call it after the processors are built
+   *
+   * \param[in] processors The processors after fusion
+   */
+  void SetProcessorChain(
+      const std::vector<std::shared_ptr<Processor>>& processors);
+
+  /** \brief Use a plan built by GetPreprocessPlan(), which sets the fused pipeline and the processor chain, the derived class should call it instead of CompileFusedPipeline() and SetProcessorChain()
+   *
+   * \param[in] plan The preprocess plan
+   */
+  void SetPlan(const std::shared_ptr<const PreprocessPlan>& plan);
+
+  /// Whether the fused pipeline should process the images
+  bool UseFusedPipeline(FDMatBatch* image_batch);
+
+  /// Run func(i) for the i-th image of a batch, in parallel if SetThreadNum() > 1
+  bool ParallelFor(size_t n, const std::function<bool(size_t)>& func);
+
   bool initialized_ = false;
+  // Immutable, shared by the cloned preprocessors and the preprocessors
+  // loaded from the same config
+  std::shared_ptr<const PreprocessPlan> plan_;
+  // Immutable after compiled, so it's shared by the cloned preprocessors
+  std::shared_ptr<FusedPipeline> fused_pipeline_;
+  // Shared by the cloned preprocessors as well, TaskPool allows concurrent
+  // ParallelFor() calls
+  std::shared_ptr<TaskPool> task_pool_;
 
  private:
 #ifdef WITH_GPU
   cudaStream_t stream_ = nullptr;
 #endif
   int device_id_ = -1;
+  bool enable_fused_pipeline_ = false;
+
+  void PlanProcLibs();
+
+  // Consulted by the processors through ProcLibScope while Run() is running,
+  // instead of the process-wide DefaultProcLib::default_lib
+  ProcLibConfig proc_lib_config_;
+  bool enable_auto_proc_lib_ = false;
+  std::vector<std::string> op_names_;
 
   std::vector<FDTensor> input_caches_;
   std::vector<FDTensor> output_caches_;
@@ -34,6 +34,13 @@ void BindProcessorManager(pybind11::module& m) {
              }
              return outputs;
            })
+      .def("enable_fused_pipeline",
+           &vision::ProcessorManager::EnableFusedPipeline)
+      .def("set_thread_num", &vision::ProcessorManager::SetThreadNum)
+      .def("prepare_input_size",
+           &vision::ProcessorManager::PrepareInputSize)
+      .def("enable_auto_proc_lib",
+           &vision::ProcessorManager::EnableAutoProcLib)
       .def("use_cuda",
            [](vision::ProcessorManager& self, bool enable_cv_cuda = false,
               int gpu_id = -1) { self.UseCuda(enable_cv_cuda, gpu_id); });
@@ -13,14 +13,18 @@
 // limitations under the License.
 #include "fastdeploy/vision/common/processors/mat.h"
 
+#include <cstdint>
+
 #include "fastdeploy/utils/utils.h"
 #include "fastdeploy/vision/common/processors/utils.h"
+#include "opencv2/imgproc/imgproc.hpp"
 
 namespace fastdeploy {
 namespace vision {
 
 cv::Mat* Mat::GetOpenCVMat() {
   if (mat_type == ProcLib::OPENCV) {
+    ConvertYuv();
     return &cpu_mat;
   } else if (mat_type == ProcLib::FLYCV) {
 #ifdef ENABLE_FLYCV
@@ -33,6 +37,13 @@ cv::Mat* Mat::GetOpenCVMat() {
 #else
     FDASSERT(false, "FastDeploy didn't compiled with FlyCV!");
 #endif
+  } else if (mat_type == ProcLib::SIMD) {
+    // Just a reference to fd_tensor, zero copy. A CHW mat is wrapped as HWC
+    // with planar data, same as HWC2CHW::ImplByOpenCV()
+    cpu_mat = CreateZeroCopyOpenCVMatFromBuffer(
+        Height(), Width(), Channels(), fd_tensor.Dtype(), fd_tensor.Data());
+    mat_type = ProcLib::OPENCV;
+    return &cpu_mat;
   } else if (mat_type == ProcLib::CUDA || mat_type == ProcLib::CVCUDA) {
 #ifdef WITH_GPU
     FDASSERT(cudaStreamSynchronize(stream) == cudaSuccess,
@@ -58,14 +69,33 @@ void* Mat::Data() {
              "FastDeploy didn't compile with FlyCV, but met data type with "
              "fcv::Mat.");
 #endif
-  } else if (device == Device::GPU) {
+  } else if (device == Device::GPU || mat_type == ProcLib::SIMD) {
     return fd_tensor.Data();
   }
+  ConvertYuv();
   return cpu_mat.ptr();
 }
 
+void Mat::ConvertYuv(bool to_rgb) {
+  if (yuv_format == YuvFormat::NONE) {
+    return;
+  }
+  int code = 0;
+  if (yuv_format == YuvFormat::NV12) {
+    code = to_rgb ? cv::COLOR_YUV2RGB_NV12 : cv::COLOR_YUV2BGR_NV12;
+  } else if (yuv_format == YuvFormat::NV21) {
+    code = to_rgb ? cv::COLOR_YUV2RGB_NV21 : cv::COLOR_YUV2BGR_NV21;
+  } else {
+    code = to_rgb ? cv::COLOR_YUV2RGB_I420 : cv::COLOR_YUV2BGR_I420;
+  }
+  cv::Mat new_im;
+  cv::cvtColor(cpu_mat, new_im, code);
+  cpu_mat = new_im;
+  yuv_format = YuvFormat::NONE;
+}
+
 FDTensor* Mat::Tensor() {
-  if (mat_type == ProcLib::OPENCV) {
+  if (mat_type == ProcLib::OPENCV || mat_type == ProcLib::SIMD) {
     ShareWithTensor(&fd_tensor);
   } else if (mat_type == ProcLib::FLYCV) {
 #ifdef ENABLE_FLYCV
@@ -124,8 +154,8 @@ void Mat::PrintInfo(const std::string& flag) {
              "FastDeploy didn't compile with FlyCV, but met data type with "
              "fcv::Mat.");
 #endif
-  } else if (mat_type == ProcLib::OPENCV) {
-    cv::Scalar mean = cv::mean(cpu_mat);
+  } else if (mat_type == ProcLib::OPENCV || mat_type == ProcLib::SIMD) {
+    cv::Scalar mean = cv::mean(*GetOpenCVMat());
     for (int i = 0; i < Channels(); ++i) {
       std::cout << mean[i] << " ";
     }
@@ -156,14 +186,15 @@ FDDataType Mat::Type() {
              "FastDeploy didn't compile with FlyCV, but met data type with "
              "fcv::Mat.");
 #endif
-  } else if (mat_type == ProcLib::CUDA || mat_type == ProcLib::CVCUDA) {
+  } else if (mat_type == ProcLib::CUDA || mat_type == ProcLib::CVCUDA ||
+             mat_type == ProcLib::SIMD) {
     return fd_tensor.Dtype();
   }
   return OpenCVDataTypeToFD(cpu_mat.type());
 }
 
 Mat Mat::Create(const FDTensor& tensor) {
-  if (DefaultProcLib::default_lib == ProcLib::FLYCV) {
+  if (ResolveProcLib("") == ProcLib::FLYCV) {
 #ifdef ENABLE_FLYCV
     fcv::Mat tmp_fcv_mat = CreateZeroCopyFlyCVMatFromTensor(tensor);
     Mat mat = Mat(tmp_fcv_mat);
@@ -197,7 +228,7 @@ Mat Mat::Create(const FDTensor& tensor, ProcLib lib) {
 
 Mat Mat::Create(int height, int width, int channels, FDDataType type,
                 void* data) {
-  if (DefaultProcLib::default_lib == ProcLib::FLYCV) {
+  if (ResolveProcLib("") == ProcLib::FLYCV) {
 #ifdef ENABLE_FLYCV
     fcv::Mat tmp_fcv_mat =
         CreateZeroCopyFlyCVMatFromBuffer(height, width, channels, type, data);
@@ -234,6 +265,35 @@ Mat Mat::Create(int height, int width, int channels, FDDataType type,
   return mat;
 }
 
+Mat Mat::CreateFromYuv(int height, int width, YuvFormat format,
+                       void* data) {
+  FDASSERT(format != YuvFormat::NONE, "The YUV format should not be NONE.");
+  FDASSERT(height % 2 == 0 && width % 2 == 0,
+           "The size of a YUV 4:2:0 image should be even, but now it's %dx%d.",
+           height, width);
+  // Zero copy, the whole frame is wrapped as a single channel image
+  Mat mat(cv::Mat(height * 3 / 2, width, CV_8UC1, data));
+  mat.SetHeight(height);
+  mat.SetWidth(width);
+  mat.SetChannels(3);
+  mat.yuv_format = format;
+  return mat;
+}
+
+Mat Mat::CreateFromYuv(const FDTensor& tensor, YuvFormat format) {
+  FDASSERT(tensor.Shape().size() == 3 && tensor.Shape()[2] == 1 &&
+               tensor.Dtype() == FDDataType::UINT8,
+           "The YUV tensor should be uint8 in shape of {height * 3 / 2, "
+           "width, 1}.");
+  FDASSERT(tensor.Shape()[0] % 3 == 0,
+           "The rows of the YUV tensor should be height * 3 / 2, but now "
+           "it's %lld.",
+           tensor.Shape()[0]);
+  return CreateFromYuv(static_cast<int>(tensor.Shape()[0] * 2 / 3),
+                       static_cast<int>(tensor.Shape()[1]), format,
+                       const_cast<void*>(tensor.CpuData()));
+}
+
 FDMat WrapMat(const cv::Mat& image) {
   FDMat mat(image);
   return mat;
@@ -282,5 +342,45 @@ FDTensor* CreateCachedGpuInputTensor(Mat* mat) {
   return nullptr;
 }
 
+const void* GetSimdInputData(Mat* mat) {
+  if (mat->device != Device::CPU) {
+    return nullptr;
+  }
+  if (mat->mat_type == ProcLib::OPENCV) {
+    cv::Mat* im = mat->GetOpenCVMat();
+    if (!im->isContinuous()) {
+      *im = im->clone();
+    }
+  }
+  return mat->Data();
+}
+
+FDTensor* GetSimdOutputCache(Mat* mat) {
+  if (mat->input_cache == nullptr || mat->output_cache == nullptr) {
+    return nullptr;
+  }
+  // The data of a SIMD mat is one of its caches, or a ROI inside it, e.g. a
+  // mat cropped by rows without a copy
+  const FDTensor* cache = mat->output_cache;
+  if (cache->Nbytes() > 0) {
+    uintptr_t begin = reinterpret_cast<uintptr_t>(cache->Data());
+    uintptr_t data = reinterpret_cast<uintptr_t>(mat->Data());
+    if (data >= begin && data < begin + cache->Nbytes()) {
+      std::swap(mat->input_cache, mat->output_cache);
+    }
+  }
+  return mat->output_cache;
+}
+
+void SetSimdOutput(Mat* mat, FDTensor* output, int height, int width,
+                   int channels) {
+  mat->SetTensor(output);
+  mat->SetHeight(height);
+  mat->SetWidth(width);
+  mat->SetChannels(channels);
+  mat->device = Device::CPU;
+  mat->mat_type = ProcLib::SIMD;
+}
+
 }  // namespace vision
 }  // namespace fastdeploy
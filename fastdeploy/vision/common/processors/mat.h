@@ -26,6 +26,13 @@ namespace vision {
 
 enum Layout { HWC, CHW };
 
+/*! @brief The YUV 4:2:0 formats of the decoded video frames, the full resolution Y plane is followed by the 2x2 subsampled chroma
+ *
+ * NV12: Y plane and an interleaved UV plane, NV21: Y plane and an interleaved
+ * VU plane, I420: Y plane, U plane and V plane.
+ */
+enum class FASTDEPLOY_DECL YuvFormat { NONE, NV12, NV21, I420 };
+
 struct FASTDEPLOY_DECL Mat {
   Mat() = default;
   explicit Mat(const cv::Mat& mat) {
@@ -62,6 +69,7 @@ struct FASTDEPLOY_DECL Mat {
   void SetMat(const cv::Mat& mat) {
     cpu_mat = mat;
     mat_type = ProcLib::OPENCV;
+    yuv_format = YuvFormat::NONE;
   }
 
   cv::Mat* GetOpenCVMat();
@@ -70,16 +78,17 @@ struct FASTDEPLOY_DECL Mat {
   void SetMat(const fcv::Mat& mat) {
     fcv_mat = mat;
     mat_type = ProcLib::FLYCV;
+    yuv_format = YuvFormat::NONE;
   }
 
   fcv::Mat* GetFlyCVMat() {
     if (mat_type == ProcLib::FLYCV) {
       return &fcv_mat;
-    } else if (mat_type == ProcLib::OPENCV) {
+    } else if (mat_type == ProcLib::OPENCV || mat_type == ProcLib::SIMD) {
       // Just a reference to cpu_mat, zero copy. After you
       // call this method, fcv_mat and cpu_mat will point
       // to the same memory buffer.
-      fcv_mat = ConvertOpenCVMatToFlyCV(cpu_mat);
+      fcv_mat = ConvertOpenCVMatToFlyCV(*GetOpenCVMat());
       mat_type = ProcLib::FLYCV;
       return &fcv_mat;
     } else {
@@ -90,6 +99,16 @@ struct FASTDEPLOY_DECL Mat {
 
   void* Data();
 
+  /** \brief Convert a YUV mat to a 3 channels image in place, GetOpenCVMat(), Data() and Tensor() convert it to BGR implicitly
+   *
+   * \param[in] to_rgb true to convert to RGB, otherwise BGR
+   */
+  void ConvertYuv(bool to_rgb = false);
+
+  // The raw buffer of a YUV mat, which has Height() * 3 / 2 rows of Width()
+  // bytes
+  const uint8_t* YuvData() const { return cpu_mat.ptr<uint8_t>(); }
+
   // Get fd_tensor
   FDTensor* Tensor();
 
@@ -107,7 +126,7 @@ struct FASTDEPLOY_DECL Mat {
 #ifdef WITH_GPU
   cudaStream_t stream = nullptr;
 #endif
-  // Currently, fd_tensor is only used by CUDA and CV-CUDA,
+  // Currently, fd_tensor is only used by CUDA, CV-CUDA and SIMD,
   // OpenCV and FlyCV are not using it.
   FDTensor fd_tensor;
 
@@ -120,7 +139,7 @@ struct FASTDEPLOY_DECL Mat {
   void SetWidth(int w) { width = w; }
   void SetHeight(int h) { height = h; }
 
-  // When using CV-CUDA/CUDA, please set input/output cache,
+  // When using CV-CUDA/CUDA/SIMD, please set input/output cache,
   // refer to manager.cc
   FDTensor* input_cache = nullptr;
   FDTensor* output_cache = nullptr;
@@ -144,6 +163,9 @@ struct FASTDEPLOY_DECL Mat {
   ProcLib mat_type = ProcLib::OPENCV;
   Layout layout = Layout::HWC;
   Device device = Device::CPU;
+  // Not NONE if the mat holds a YUV frame, its Channels() is still 3 and
+  // the YUV data is only used by the processors supporting it directly
+  YuvFormat yuv_format = YuvFormat::NONE;
 
   // Create FD Mat from FD Tensor. This method only create a
   // new FD Mat with zero copy and it's data pointer is reference
@@ -158,6 +180,13 @@ struct FASTDEPLOY_DECL Mat {
                     FDDataType type, void* data);
   static Mat Create(int height, int width, int channels,
                     FDDataType type, void* data, ProcLib lib);
+  // Create FD Mat from a YUV frame with zero copy, `height` and `width` are
+  // the size of the image and should be even.
+  static Mat CreateFromYuv(int height, int width, YuvFormat format,
+                           void* data);
+  // The tensor holds a YUV frame in shape of {height * 3 / 2, width, 1}, e.g.
+  // the I420 frames pulled from the streamer.
+  static Mat CreateFromYuv(const FDTensor& tensor, YuvFormat format);
 };
 
 typedef Mat FDMat;
@@ -177,5 +206,19 @@ bool CheckShapeConsistency(std::vector<Mat>* mats);
 // If the Mat is on CPU, then update the input cache tensor and copy the mat's
 // CPU tensor to this new GPU input cache tensor.
 FDTensor* CreateCachedGpuInputTensor(Mat* mat);
+
+// Get the continuous data of a mat on CPU for the SIMD processors, a
+// non-continuous cv::Mat is cloned first. Return nullptr if the mat is on GPU.
+const void* GetSimdInputData(Mat* mat);
+
+// Get the output tensor of a SIMD processor, which never shares the buffer
+// with the current data of the mat, the input and output caches are swapped
+// if needed. Return nullptr if the mat has no caches.
+FDTensor* GetSimdOutputCache(Mat* mat);
+
+// Make the output tensor of a SIMD processor the data of the mat, the tensor
+// should be HWC or CHW according to the layout of the mat.
+void SetSimdOutput(Mat* mat, FDTensor* output, int height, int width,
+                   int channels);
 }  // namespace vision
 }  // namespace fastdeploy
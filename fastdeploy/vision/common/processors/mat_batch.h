@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #pragma once
+#include "fastdeploy/utils/task_pool.h"
 #include "fastdeploy/vision/common/processors/mat.h"
 
 #ifdef WITH_GPU
@@ -61,6 +62,10 @@ struct FASTDEPLOY_DECL FDMatBatch {
   FDMatBatchLayout layout = FDMatBatchLayout::NHWC;
   Device device = Device::CPU;
 
+  // If set, the CPU processors process the mats in parallel by the pool,
+  // refer to ProcessorManager::SetThreadNum()
+  TaskPool* task_pool = nullptr;
+
   // False: the data is stored in the mats separately
   // True: the data is stored in the fd_tensor continuously in 4 dimensions
   bool has_batched_tensor = false;
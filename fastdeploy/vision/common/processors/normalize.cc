@@ -14,6 +14,8 @@
 
 #include "fastdeploy/vision/common/processors/normalize.h"
 
+#include "fastdeploy/vision/common/processors/simd_kernels.h"
+
 namespace fastdeploy {
 namespace vision {
 Normalize::Normalize(const std::vector<float>& mean,
@@ -66,6 +68,35 @@ bool Normalize::ImplByOpenCV(Mat* mat) {
   return true;
 }
 
+bool Normalize::ImplBySimd(Mat* mat) {
+  FDDataType type = mat->Type();
+  int channels = mat->Channels();
+  if (swap_rb_ || channels > static_cast<int>(alpha_.size()) ||
+      (type != FDDataType::UINT8 && type != FDDataType::FP32)) {
+    return ImplByOpenCV(mat);
+  }
+  const void* src = GetSimdInputData(mat);
+  FDTensor* output = GetSimdOutputCache(mat);
+  if (src == nullptr || output == nullptr) {
+    return ImplByOpenCV(mat);
+  }
+  int height = mat->Height();
+  int width = mat->Width();
+  output->Resize({height, width, channels}, FDDataType::FP32, "output_cache",
+                 Device::CPU);
+  size_t num_pixels = static_cast<size_t>(height) * width;
+  float* dst = static_cast<float*>(output->MutableData());
+  if (type == FDDataType::UINT8) {
+    simd::Normalize(static_cast<const uint8_t*>(src), num_pixels, channels,
+                    alpha_.data(), beta_.data(), dst);
+  } else {
+    simd::Normalize(static_cast<const float*>(src), num_pixels, channels,
+                    alpha_.data(), beta_.data(), dst);
+  }
+  SetSimdOutput(mat, output, height, width, channels);
+  return true;
+}
+
 #ifdef ENABLE_FLYCV
 bool Normalize::ImplByFlyCV(Mat* mat) {
   fcv::Mat* im = mat->GetFlyCVMat();
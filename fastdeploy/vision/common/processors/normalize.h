@@ -29,6 +29,7 @@ class FASTDEPLOY_DECL Normalize : public Processor {
 #ifdef ENABLE_FLYCV
   bool ImplByFlyCV(Mat* mat);
 #endif
+  bool ImplBySimd(Mat* mat);
   std::string Name() { return "Normalize"; }
 
   // While use normalize, it is more recommend not use this function
@@ -26,6 +26,8 @@ class FASTDEPLOY_DECL NormalizeAndPermute : public Processor {
                       const std::vector<float>& max = std::vector<float>(),
                       bool swap_rb = false);
   bool ImplByOpenCV(FDMat* mat);
+  bool CanWriteToBatch(FDMat* mat);
+  bool WriteToBatch(FDMat* mat, float* dst, int dst_h, int dst_w);
 #ifdef ENABLE_FLYCV
   bool ImplByFlyCV(FDMat* mat);
 #endif
@@ -55,12 +57,16 @@ class FASTDEPLOY_DECL NormalizeAndPermute : public Processor {
                   const std::vector<float>& max = std::vector<float>(),
                   ProcLib lib = ProcLib::DEFAULT, bool swap_rb = false);
 
+  std::vector<float> GetAlpha() const { return alpha_; }
+
   void SetAlpha(const std::vector<float>& alpha) {
     alpha_.clear();
     std::vector<float>().swap(alpha_);
     alpha_.assign(alpha.begin(), alpha.end());
   }
 
+  std::vector<float> GetBeta() const { return beta_; }
+
   void SetBeta(const std::vector<float>& beta) {
     beta_.clear();
     std::vector<float>().swap(beta_);
@@ -14,6 +14,8 @@
 
 #include "fastdeploy/vision/common/processors/pad.h"
 
+#include "fastdeploy/vision/common/processors/simd_kernels.h"
+
 namespace fastdeploy {
 namespace vision {
 
@@ -52,6 +54,53 @@ bool Pad::ImplByOpenCV(Mat* mat) {
   return true;
 }
 
+bool Pad::ImplBySimd(Mat* mat) {
+  if (mat->layout != Layout::HWC) {
+    FDERROR << "Pad: The input data must be Layout::HWC format!" << std::endl;
+    return false;
+  }
+  if (mat->Channels() > 4) {
+    FDERROR << "Pad: Only support channels <= 4." << std::endl;
+    return false;
+  }
+  if (mat->Channels() != value_.size()) {
+    FDERROR << "Pad: Require input channels equals to size of padding value, "
+               "but now channels = "
+            << mat->Channels()
+            << ", the size of padding values = " << value_.size() << "."
+            << std::endl;
+    return false;
+  }
+  FDDataType type = mat->Type();
+  if (type != FDDataType::UINT8 && type != FDDataType::FP32) {
+    return ImplByOpenCV(mat);
+  }
+  const void* src = GetSimdInputData(mat);
+  FDTensor* output = GetSimdOutputCache(mat);
+  if (src == nullptr || output == nullptr) {
+    return ImplByOpenCV(mat);
+  }
+  // The padding pixel in the data type of the mat, saturated like
+  // cv::copyMakeBorder
+  int channels = mat->Channels();
+  uint8_t pad_pixel[4 * sizeof(float)];
+  for (int c = 0; c < channels; ++c) {
+    if (type == FDDataType::UINT8) {
+      pad_pixel[c] = cv::saturate_cast<uint8_t>(value_[c]);
+    } else {
+      reinterpret_cast<float*>(pad_pixel)[c] = value_[c];
+    }
+  }
+  int height = mat->Height() + top_ + bottom_;
+  int width = mat->Width() + left_ + right_;
+  output->Resize({height, width, channels}, type, "output_cache", Device::CPU);
+  simd::Pad(static_cast<const uint8_t*>(src), mat->Height(), mat->Width(),
+            channels * FDDataTypeSize(type), top_, bottom_, left_, right_,
+            pad_pixel, static_cast<uint8_t*>(output->MutableData()));
+  SetSimdOutput(mat, output, height, width, channels);
+  return true;
+}
+
 #ifdef ENABLE_FLYCV
 bool Pad::ImplByFlyCV(Mat* mat) {
   if (mat->layout != Layout::HWC) {
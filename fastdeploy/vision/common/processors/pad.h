@@ -33,6 +33,7 @@ class FASTDEPLOY_DECL Pad : public Processor {
 #ifdef ENABLE_FLYCV
   bool ImplByFlyCV(Mat* mat);
 #endif
+  bool ImplBySimd(Mat* mat);
   std::string Name() { return "Pad"; }
 
   static bool Run(Mat* mat, const int& top, const int& bottom, const int& left,
@@ -0,0 +1,117 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fastdeploy/vision/common/processors/preprocess_plan.h"
+
+#include <mutex>
+#include <unordered_map>
+
+#include "fastdeploy/vision/common/processors/transform.h"
+
+namespace fastdeploy {
+namespace vision {
+
+PreprocessPlan::PreprocessPlan(
+    std::vector<std::shared_ptr<Processor>> processors)
+    : processors_(std::move(processors)) {
+  // Fusion will improve performance
+  FuseTransforms(&processors_);
+  auto pipeline = std::make_shared<FusedPipeline>();
+  if (pipeline->Compile(processors_)) {
+    fused_pipeline_ = pipeline;
+  }
+}
+
+bool PreprocessPlan::HasProcessor(const std::string& name) const {
+  for (const auto& processor : processors_) {
+    if (processor->Name() == name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool PreprocessPlan::Prepare(int width, int height) const {
+  return fused_pipeline_ != nullptr && fused_pipeline_->Prepare(width, height);
+}
+
+std::string PreprocessPlan::Str() const {
+  std::string str;
+  for (size_t i = 0; i < processors_.size(); ++i) {
+    if (i > 0) {
+      str += " -> ";
+    }
+    str += processors_[i]->Name();
+  }
+  if (fused_pipeline_ != nullptr) {
+    str += "(fused)";
+  }
+  return str;
+}
+
+std::shared_ptr<const PreprocessPlan> GetPreprocessPlan(
+    const std::string& config_file, const std::string& options,
+    const std::function<bool(std::vector<std::shared_ptr<Processor>>*)>&
+        build) {
+  // The plans are only kept alive by the preprocessors holding them
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::weak_ptr<const PreprocessPlan>>
+      plans;
+
+  std::string contents;
+  if (!ReadBinaryFromFile(config_file, &contents)) {
+    FDERROR << "Failed to load yaml file " << config_file
+            << ", maybe you should check this file." << std::endl;
+    return nullptr;
+  }
+  std::string key = options + '\n' + contents;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto iter = plans.find(key);
+    if (iter != plans.end()) {
+      auto plan = iter->second.lock();
+      if (plan != nullptr) {
+        return plan;
+      }
+    }
+  }
+
+  // Parse outside the lock, the plan built first is kept if several threads
+  // load the same config at the same time
+  std::vector<std::shared_ptr<Processor>> processors;
+  if (!build(&processors)) {
+    return nullptr;
+  }
+  std::shared_ptr<const PreprocessPlan> plan =
+      std::make_shared<PreprocessPlan>(std::move(processors));
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& cached = plans[key];
+  auto existing = cached.lock();
+  if (existing != nullptr) {
+    return existing;
+  }
+  cached = plan;
+  // Drop the expired plans, so the map doesn't grow with the loaded configs
+  for (auto iter = plans.begin(); iter != plans.end();) {
+    if (iter->second.expired()) {
+      iter = plans.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  return plan;
+}
+
+}  // namespace vision
+}  // namespace fastdeploy
@@ -0,0 +1,82 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+
+#include "fastdeploy/vision/common/processors/fused_pipeline.h"
+
+namespace fastdeploy {
+namespace vision {
+
+/*! @brief Preprocessing compiled from the deployment config of a model
+ *
+ * The plan holds the processor chain after FuseTransforms, with the alpha and
+ * beta of the normalization folded in, and the fused pipeline if the chain
+ * can be fused. It's immutable after built, so the preprocessors of all the
+ * models loaded from the same config, and their clones, share one plan
+ * through GetPreprocessPlan() instead of parsing the config again.
+ */
+class FASTDEPLOY_DECL PreprocessPlan {
+ public:
+  /** \brief Build the plan from a processor chain
+   *
+   * \param[in] processors The processors parsed from the config, which are fused by the plan
+   */
+  explicit PreprocessPlan(std::vector<std::shared_ptr<Processor>> processors);
+
+  /// The processors after fusion, which should not be modified
+  const std::vector<std::shared_ptr<Processor>>& Processors() const {
+    return processors_;
+  }
+
+  /// The fused pipeline, nullptr if the processors can't be fused
+  std::shared_ptr<FusedPipeline> GetFusedPipeline() const {
+    return fused_pipeline_;
+  }
+
+  /// Whether there is a processor named `name` in the plan
+  bool HasProcessor(const std::string& name) const;
+
+  /** \brief Precompute the resize coefficients of the fused pipeline for an input resolution, e.g. the resolution of a camera
+   *
+   * \param[in] width Width of the input image
+   * \param[in] height Height of the input image
+   * \return true if the coefficients are computed, false if the plan has no fused pipeline or the size is not supported
+   */
+  bool Prepare(int width, int height) const;
+
+  /// The processors of the plan in a line, e.g. "BGR2RGB -> Resize -> NormalizeAndPermute(fused)"
+  std::string Str() const;
+
+ private:
+  std::vector<std::shared_ptr<Processor>> processors_;
+  std::shared_ptr<FusedPipeline> fused_pipeline_;
+};
+
+/** \brief Get the plan of a deployment config, the plan is shared by all the callers with the same config content and options while any of them holds it
+ *
+ * \param[in] config_file Path of the configuration file, the content of the file is a part of the key, so a modified file builds a new plan
+ * \param[in] options The options affecting the processors, e.g. the model type and whether normalize is disabled
+ * \param[in] build Parse the config into the processors, only called when the plan isn't cached
+ * \return The plan, nullptr if the config can't be read or parsed
+ */
+FASTDEPLOY_DECL std::shared_ptr<const PreprocessPlan> GetPreprocessPlan(
+    const std::string& config_file, const std::string& options,
+    const std::function<bool(std::vector<std::shared_ptr<Processor>>*)>&
+        build);
+
+}  // namespace vision
+}  // namespace fastdeploy
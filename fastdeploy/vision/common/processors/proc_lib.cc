@@ -14,11 +14,188 @@
 
 #include "fastdeploy/vision/common/processors/proc_lib.h"
 
+#include <array>
+#include <limits>
+
 namespace fastdeploy {
 namespace vision {
 
 ProcLib DefaultProcLib::default_lib = ProcLib::DEFAULT;
 
+namespace {
+
+thread_local const ProcLibConfig* current_proc_lib_config = nullptr;
+
+// Libraries in the order of the columns of the cost table
+const ProcLib kCostTableLibs[] = {ProcLib::OPENCV, ProcLib::FLYCV,
+                                  ProcLib::CUDA, ProcLib::CVCUDA,
+                                  ProcLib::SIMD};
+const size_t kNumCostTableLibs = 5;
+typedef std::array<float, kNumCostTableLibs> LibCosts;
+// Not implemented natively
+const float kNoImpl = -1.0f;
+// The cost of synchronizing and copying an image between host and device
+const float kTransferCost = 1.0f;
+
+// Rough relative cost of every processor on a 640x640x3 image, an OpenCV
+// bilinear Resize is taken as 1.0
+const std::map<std::string, LibCosts>& CostTable() {
+  static const std::map<std::string, LibCosts> table = {
+      {"BGR2RGB", {{0.3f, 0.2f, kNoImpl, kNoImpl, kNoImpl}}},
+      {"RGB2BGR", {{0.3f, 0.2f, kNoImpl, kNoImpl, kNoImpl}}},
+      {"BGR2GRAY", {{0.3f, 0.2f, kNoImpl, kNoImpl, kNoImpl}}},
+      {"RGB2GRAY", {{0.3f, 0.2f, kNoImpl, kNoImpl, kNoImpl}}},
+      {"Cast", {{0.4f, 0.3f, kNoImpl, kNoImpl, 0.2f}}},
+      {"CenterCrop", {{0.1f, 0.1f, kNoImpl, 0.1f, 0.1f}}},
+      {"Crop", {{0.1f, 0.1f, kNoImpl, kNoImpl, kNoImpl}}},
+      {"Convert", {{0.8f, 0.5f, kNoImpl, kNoImpl, kNoImpl}}},
+      {"ConvertAndPermute", {{1.2f, 0.7f, kNoImpl, kNoImpl, kNoImpl}}},
+      {"HWC2CHW", {{0.8f, 0.5f, kNoImpl, kNoImpl, 0.5f}}},
+      {"LimitByStride", {{1.0f, 0.7f, kNoImpl, kNoImpl, kNoImpl}}},
+      {"LimitShort", {{1.0f, 0.7f, kNoImpl, kNoImpl, kNoImpl}}},
+      {"Normalize", {{1.0f, 0.6f, kNoImpl, kNoImpl, 0.4f}}},
+      {"NormalizeAndPermute", {{1.5f, 0.8f, 0.2f, 0.2f, kNoImpl}}},
+      {"Pad", {{0.4f, 0.3f, kNoImpl, kNoImpl, 0.3f}}},
+      {"PadToSize", {{0.4f, 0.3f, kNoImpl, kNoImpl, kNoImpl}}},
+      {"Resize", {{1.0f, 0.7f, kNoImpl, 0.2f, 0.6f}}},
+      {"ResizeByShort", {{1.0f, 0.7f, kNoImpl, 0.2f, 0.6f}}},
+      {"StridePad", {{0.4f, 0.3f, kNoImpl, kNoImpl, kNoImpl}}},
+      {"WarpAffine", {{1.0f, kNoImpl, kNoImpl, kNoImpl, 0.9f}}},
+  };
+  return table;
+}
+
+}  // namespace
+
+bool IsGpuProcLib(ProcLib lib) {
+  return lib == ProcLib::CUDA || lib == ProcLib::CVCUDA;
+}
+
+ProcLib ProcLibConfig::Get(const std::string& op_name) const {
+  if (!op_libs.empty()) {
+    auto iter = op_libs.find(op_name);
+    if (iter != op_libs.end()) {
+      return iter->second;
+    }
+  }
+  return lib;
+}
+
+bool ProcLibConfig::UseGpu() const {
+  if (IsGpuProcLib(lib)) {
+    return true;
+  }
+  for (const auto& op_lib : op_libs) {
+    if (IsGpuProcLib(op_lib.second)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+ProcLibScope::ProcLibScope(const ProcLibConfig* config)
+    : prev_(current_proc_lib_config) {
+  current_proc_lib_config = config;
+}
+
+ProcLibScope::~ProcLibScope() { current_proc_lib_config = prev_; }
+
+const ProcLibConfig* ProcLibScope::Current() {
+  return current_proc_lib_config;
+}
+
+ProcLib ResolveProcLib(const std::string& op_name, ProcLib lib) {
+  if (lib != ProcLib::DEFAULT) {
+    return lib;
+  }
+  if (current_proc_lib_config != nullptr) {
+    ProcLib target = current_proc_lib_config->Get(op_name);
+    if (target != ProcLib::DEFAULT) {
+      return target;
+    }
+  }
+  return DefaultProcLib::default_lib;
+}
+
+std::map<std::string, ProcLib> ChooseProcLibsByCost(
+    const std::vector<std::string>& op_names,
+    const std::vector<ProcLib>& candidates) {
+  const size_t num_libs = kNumCostTableLibs;
+  std::array<bool, kNumCostTableLibs> available = {
+      {true, false, false, false, false}};
+  for (auto candidate : candidates) {
+    for (size_t k = 0; k < num_libs; ++k) {
+      if (kCostTableLibs[k] == candidate) {
+        available[k] = true;
+      }
+    }
+  }
+
+  // cost[i][k] is the min cost of the first i + 1 processors while the i-th
+  // runs in the k-th lib, and prev[i][k] is the lib of the (i - 1)-th then
+  const float kInf = std::numeric_limits<float>::max();
+  size_t n = op_names.size();
+  std::vector<LibCosts> cost(n);
+  std::vector<std::array<size_t, kNumCostTableLibs>> prev(n);
+  for (size_t i = 0; i < n; ++i) {
+    auto iter = CostTable().find(op_names[i]);
+    for (size_t k = 0; k < num_libs; ++k) {
+      cost[i][k] = kInf;
+      prev[i][k] = 0;
+      float op_cost = kNoImpl;
+      if (iter != CostTable().end()) {
+        op_cost = iter->second[k];
+      } else if (kCostTableLibs[k] == ProcLib::OPENCV) {
+        // The processors out of the table run in OpenCV
+        op_cost = 1.0f;
+      }
+      if (!available[k] || op_cost == kNoImpl) {
+        continue;
+      }
+      if (i == 0) {
+        // The input images are on the host
+        cost[i][k] =
+            op_cost + (IsGpuProcLib(kCostTableLibs[k]) ? kTransferCost : 0);
+        continue;
+      }
+      for (size_t j = 0; j < num_libs; ++j) {
+        if (cost[i - 1][j] == kInf) {
+          continue;
+        }
+        float transfer =
+            IsGpuProcLib(kCostTableLibs[j]) != IsGpuProcLib(kCostTableLibs[k])
+                ? kTransferCost
+                : 0;
+        if (cost[i - 1][j] + transfer + op_cost < cost[i][k]) {
+          cost[i][k] = cost[i - 1][j] + transfer + op_cost;
+          prev[i][k] = j;
+        }
+      }
+    }
+  }
+
+  std::map<std::string, ProcLib> op_libs;
+  if (n == 0) {
+    return op_libs;
+  }
+  size_t best = 0;
+  for (size_t k = 1; k < num_libs; ++k) {
+    if (cost[n - 1][k] < cost[n - 1][best]) {
+      best = k;
+    }
+  }
+  std::vector<size_t> chosen(n);
+  for (size_t i = n; i > 0; --i) {
+    chosen[i - 1] = best;
+    best = prev[i - 1][best];
+  }
+  for (size_t i = 0; i < n; ++i) {
+    // std::map::insert keeps the first appearance
+    op_libs.insert(std::make_pair(op_names[i], kCostTableLibs[chosen[i]]));
+  }
+  return op_libs;
+}
+
 std::ostream& operator<<(std::ostream& out, const ProcLib& p) {
   switch (p) {
     case ProcLib::DEFAULT:
@@ -33,6 +210,12 @@ std::ostream& operator<<(std::ostream& out, const ProcLib& p) {
     case ProcLib::CUDA:
       out << "ProcLib::CUDA";
       break;
+    case ProcLib::CVCUDA:
+      out << "ProcLib::CVCUDA";
+      break;
+    case ProcLib::SIMD:
+      out << "ProcLib::SIMD";
+      break;
     default:
       FDASSERT(false, "Unknow type of ProcLib.");
   }
@@ -13,15 +13,31 @@
 // limitations under the License.
 
 #pragma once
+#include <map>
+#include <string>
+#include <vector>
+
 #include "fastdeploy/utils/utils.h"
 
 namespace fastdeploy {
 namespace vision {
 
-enum class FASTDEPLOY_DECL ProcLib { DEFAULT, OPENCV, FLYCV, CUDA, CVCUDA };
+// SIMD: the built-in CPU kernels hand-vectorized with AVX2, refer to
+// simd_kernels.h
+enum class FASTDEPLOY_DECL ProcLib {
+  DEFAULT,
+  OPENCV,
+  FLYCV,
+  CUDA,
+  CVCUDA,
+  SIMD
+};
 
 FASTDEPLOY_DECL std::ostream& operator<<(std::ostream& out, const ProcLib& p);
 
+/// Whether the library processes the images on GPU
+FASTDEPLOY_DECL bool IsGpuProcLib(ProcLib lib);
+
 struct FASTDEPLOY_DECL DefaultProcLib {
   // default_lib has the highest priority
   // all the function in `processor` will force to use
@@ -30,5 +46,68 @@ struct FASTDEPLOY_DECL DefaultProcLib {
   static ProcLib default_lib;
 };
 
+/*! @brief The processing library setting of a ProcessorManager
+ */
+struct FASTDEPLOY_DECL ProcLibConfig {
+  // The library of all the processors, DEFAULT means following
+  // DefaultProcLib::default_lib
+  ProcLib lib = ProcLib::DEFAULT;
+  // The libraries of the single processors keyed by Processor::Name(),
+  // which override `lib`
+  std::map<std::string, ProcLib> op_libs;
+
+  /// Get the library of the processor named `op_name`, DEFAULT if it's not set
+  ProcLib Get(const std::string& op_name) const;
+
+  /// Whether any processor runs on CUDA or CV-CUDA
+  bool UseGpu() const;
+};
+
+/*! @brief Make the processors run on the current thread follow a ProcLibConfig until the scope exits
+ *
+ * The config is stored in a thread local variable, so the managers running
+ * on different threads don't affect each other. Scopes can be nested, and
+ * a nullptr config restores the process-wide DefaultProcLib::default_lib.
+ */
+class FASTDEPLOY_DECL ProcLibScope {
+ public:
+  explicit ProcLibScope(const ProcLibConfig* config);
+  ~ProcLibScope();
+
+  ProcLibScope(const ProcLibScope&) = delete;
+  ProcLibScope& operator=(const ProcLibScope&) = delete;
+
+  /// The config of the current thread, nullptr if there is no scope
+  static const ProcLibConfig* Current();
+
+ private:
+  const ProcLibConfig* prev_;
+};
+
+/** \brief Resolve the library of a processor on the current thread
+ *
+ * \param[in] op_name The name of the processor
+ * \param[in] lib The library requested by the caller, which has the highest priority unless it's DEFAULT
+ * \return The library requested, or the one of the current ProcLibScope, or DefaultProcLib::default_lib
+ */
+FASTDEPLOY_DECL ProcLib ResolveProcLib(const std::string& op_name,
+                                       ProcLib lib = ProcLib::DEFAULT);
+
+/** \brief Choose the library of every processor in a chain from the built-in per-op cost table
+ *
+ * The table holds the rough relative cost of the native implementation of
+ * every processor in each library, and the cost of moving the image between
+ * the host and the device. The chain starts with the images on the host, and
+ * the cheapest assignment over the whole chain is chosen. A processor can
+ * only be assigned to a library it's natively implemented in.
+ *
+ * \param[in] op_names The names of the processors in order
+ * \param[in] candidates The available libraries, OPENCV is always available
+ * \return The library of every processor, a name appearing several times gets the library of its first appearance
+ */
+FASTDEPLOY_DECL std::map<std::string, ProcLib> ChooseProcLibsByCost(
+    const std::vector<std::string>& op_names,
+    const std::vector<ProcLib>& candidates);
+
 }  // namespace vision
 }  // namespace fastdeploy
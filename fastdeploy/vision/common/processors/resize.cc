@@ -14,6 +14,8 @@
 
 #include "fastdeploy/vision/common/processors/resize.h"
 
+#include "fastdeploy/vision/common/processors/simd_kernels.h"
+
 #ifdef ENABLE_CVCUDA
 #include <cvcuda/OpResize.hpp>
 
@@ -165,6 +167,103 @@ bool Resize::ImplByCvCuda(FDMat* mat) {
 }
 #endif
 
+bool Resize::ImplBySimd(FDMat* mat) {
+  if (mat->layout != Layout::HWC) {
+    FDERROR << "Resize: The format of input is not HWC." << std::endl;
+    return false;
+  }
+  int width = 0;
+  int height = 0;
+  double inv_scale_w = 1.0;
+  double inv_scale_h = 1.0;
+  if (!GetResizedShape(mat->Width(), mat->Height(), &width, &height,
+                       &inv_scale_w, &inv_scale_h)) {
+    FDERROR << "Resize: the parameters must satisfy (width > 0 && height > 0) "
+               "or (scale_w > 0 && scale_h > 0)."
+            << std::endl;
+    return false;
+  }
+  if (inv_scale_w == 1.0 && inv_scale_h == 1.0 && width == mat->Width() &&
+      height == mat->Height()) {
+    return true;
+  }
+  if (!simd::ResizeSupported(interp_) ||
+      !SimdResize(mat, width, height, inv_scale_w, inv_scale_h, interp_)) {
+    return ImplByOpenCV(mat);
+  }
+  return true;
+}
+
+bool SimdResize(FDMat* mat, int width, int height, double inv_scale_w,
+                double inv_scale_h, int interp) {
+  FDDataType type = mat->Type();
+  if (mat->layout != Layout::HWC ||
+      (type != FDDataType::UINT8 && type != FDDataType::FP32)) {
+    return false;
+  }
+  const void* src = GetSimdInputData(mat);
+  FDTensor* output = GetSimdOutputCache(mat);
+  if (src == nullptr || output == nullptr) {
+    return false;
+  }
+  int channels = mat->Channels();
+  // The tables are only computed by the first frame of a resolution
+  auto tables =
+      simd::GetResizeTables(mat->Height(), mat->Width(), channels, inv_scale_h,
+                            inv_scale_w, height, width, interp);
+  output->Resize({height, width, channels}, type, "output_cache", Device::CPU);
+  if (type == FDDataType::UINT8) {
+    simd::ResizeByTables(*tables, static_cast<const uint8_t*>(src),
+                         static_cast<uint8_t*>(output->MutableData()));
+  } else {
+    simd::ResizeByTables(*tables, static_cast<const float*>(src),
+                         static_cast<float*>(output->MutableData()));
+  }
+  SetSimdOutput(mat, output, height, width, channels);
+  return true;
+}
+
+bool Resize::GetResizedShape(int origin_w, int origin_h, int* width,
+                             int* height, double* inv_scale_w,
+                             double* inv_scale_h) const {
+  *width = origin_w;
+  *height = origin_h;
+  *inv_scale_w = 1.0;
+  *inv_scale_h = 1.0;
+  if (width_ == origin_w && height_ == origin_h) {
+    return true;
+  }
+  if (fabs(scale_w_ - 1.0) < 1e-06 && fabs(scale_h_ - 1.0) < 1e-06) {
+    return true;
+  }
+  // Same as cv::resize, the interpolation uses the inverse of the scale
+  // factors if they're given, otherwise the ratio of the sizes
+  if (width_ > 0 && height_ > 0) {
+    if (use_scale_) {
+      float scale_w = width_ * 1.0 / origin_w;
+      float scale_h = height_ * 1.0 / origin_h;
+      *width = static_cast<int>(round(origin_w * static_cast<double>(scale_w)));
+      *height =
+          static_cast<int>(round(origin_h * static_cast<double>(scale_h)));
+      *inv_scale_w = 1.0 / scale_w;
+      *inv_scale_h = 1.0 / scale_h;
+    } else {
+      *width = width_;
+      *height = height_;
+      *inv_scale_w = static_cast<double>(origin_w) / width_;
+      *inv_scale_h = static_cast<double>(origin_h) / height_;
+    }
+  } else if (scale_w_ > 0 && scale_h_ > 0) {
+    *width = static_cast<int>(round(origin_w * static_cast<double>(scale_w_)));
+    *height = static_cast<int>(round(origin_h * static_cast<double>(scale_h_)));
+    *inv_scale_w = 1.0 / scale_w_;
+    *inv_scale_h = 1.0 / scale_h_;
+  } else {
+    return false;
+  }
+  return true;
+}
+
 bool Resize::Run(FDMat* mat, int width, int height, float scale_w,
                  float scale_h, int interp, bool use_scale, ProcLib lib) {
   if (mat->Height() == height && mat->Width() == width) {
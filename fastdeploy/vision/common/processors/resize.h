@@ -35,6 +35,7 @@ class FASTDEPLOY_DECL Resize : public Processor {
 #ifdef ENABLE_FLYCV
   bool ImplByFlyCV(FDMat* mat);
 #endif
+  bool ImplBySimd(FDMat* mat);
 #ifdef ENABLE_CVCUDA
   bool ImplByCvCuda(FDMat* mat);
 #endif
@@ -54,6 +55,21 @@ class FASTDEPLOY_DECL Resize : public Processor {
     return std::make_tuple(width_, height_);
   }
 
+  int GetInterp() const { return interp_; }
+
+  /** \brief Compute the size of the resized image as ImplByOpenCV() without resizing it
+   *
+   * \param[in] origin_w Width of the input image
+   * \param[in] origin_h Height of the input image
+   * \param[out] width Width of the resized image
+   * \param[out] height Height of the resized image
+   * \param[out] inv_scale_w Ratio of the input width to the resized width used by the interpolation
+   * \param[out] inv_scale_h Ratio of the input height to the resized height used by the interpolation
+   * \return false if the parameters of Resize are invalid
+   */
+  bool GetResizedShape(int origin_w, int origin_h, int* width, int* height,
+                       double* inv_scale_w, double* inv_scale_h) const;
+
  private:
   int width_;
   int height_;
@@ -62,5 +78,14 @@ class FASTDEPLOY_DECL Resize : public Processor {
   int interp_ = 1;
   bool use_scale_ = false;
 };
+
+/** \brief Resize a HWC uint8/float mat by the cached tables of the SIMD resize engine, the geometry is given by Resize::GetResizedShape() or ResizeByShort::GetResizedShape()
+ *
+ * \param[in] interp The interpolation, should be supported by simd::ResizeSupported()
+ * \return false if the mat is not supported by the kernels, the mat is left unchanged then and should be resized by OpenCV
+ */
+bool SimdResize(FDMat* mat, int width, int height, double inv_scale_w,
+                double inv_scale_h, int interp);
+
 }  // namespace vision
 }  // namespace fastdeploy
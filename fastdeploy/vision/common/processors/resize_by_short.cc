@@ -14,6 +14,9 @@
 
 #include "fastdeploy/vision/common/processors/resize_by_short.h"
 
+#include "fastdeploy/vision/common/processors/resize.h"
+#include "fastdeploy/vision/common/processors/simd_kernels.h"
+
 #ifdef ENABLE_CVCUDA
 #include <cvcuda/OpResize.hpp>
 
@@ -162,7 +165,47 @@ bool ResizeByShort::ImplByCvCuda(FDMatBatch* mat_batch) {
 }
 #endif
 
-double ResizeByShort::GenerateScale(const int origin_w, const int origin_h) {
+bool ResizeByShort::ImplBySimd(FDMat* mat) {
+  int width = 0;
+  int height = 0;
+  double inv_scale_w = 1.0;
+  double inv_scale_h = 1.0;
+  if (!GetResizedShape(mat->Width(), mat->Height(), &width, &height,
+                       &inv_scale_w, &inv_scale_h) ||
+      !simd::ResizeSupported(interp_)) {
+    return ImplByOpenCV(mat);
+  }
+  if (inv_scale_w == 1.0 && inv_scale_h == 1.0 && width == mat->Width() &&
+      height == mat->Height()) {
+    return true;
+  }
+  if (!SimdResize(mat, width, height, inv_scale_w, inv_scale_h, interp_)) {
+    return ImplByOpenCV(mat);
+  }
+  return true;
+}
+
+bool ResizeByShort::GetResizedShape(int origin_w, int origin_h, int* width,
+                                    int* height, double* inv_scale_w,
+                                    double* inv_scale_h) const {
+  double scale = GenerateScale(origin_w, origin_h);
+  *width = static_cast<int>(round(scale * origin_w));
+  *height = static_cast<int>(round(scale * origin_h));
+  if (use_scale_ && fabs(scale - 1.0) >= 1e-06) {
+    *inv_scale_w = 1.0 / scale;
+    *inv_scale_h = 1.0 / scale;
+  } else if (*width != origin_w || *height != origin_h) {
+    *inv_scale_w = static_cast<double>(origin_w) / *width;
+    *inv_scale_h = static_cast<double>(origin_h) / *height;
+  } else {
+    *inv_scale_w = 1.0;
+    *inv_scale_h = 1.0;
+  }
+  return *width > 0 && *height > 0;
+}
+
+double ResizeByShort::GenerateScale(const int origin_w,
+                                    const int origin_h) const {
   int im_size_max = std::max(origin_w, origin_h);
   int im_size_min = std::min(origin_w, origin_h);
   double scale =
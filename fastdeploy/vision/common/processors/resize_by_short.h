@@ -32,19 +32,35 @@ class FASTDEPLOY_DECL ResizeByShort : public Processor {
 #ifdef ENABLE_FLYCV
   bool ImplByFlyCV(FDMat* mat);
 #endif
+  bool ImplBySimd(FDMat* mat);
 #ifdef ENABLE_CVCUDA
   bool ImplByCvCuda(FDMat* mat);
   bool ImplByCvCuda(FDMatBatch* mat_batch);
 #endif
   std::string Name() { return "ResizeByShort"; }
 
+  int GetInterp() const { return interp_; }
+
+  /** \brief Compute the size of the resized image as ImplByOpenCV() without resizing it
+   *
+   * \param[in] origin_w Width of the input image
+   * \param[in] origin_h Height of the input image
+   * \param[out] width Width of the resized image
+   * \param[out] height Height of the resized image
+   * \param[out] inv_scale_w Ratio of the input width to the resized width used by the interpolation
+   * \param[out] inv_scale_h Ratio of the input height to the resized height used by the interpolation
+   * \return false if the parameters of ResizeByShort are invalid
+   */
+  bool GetResizedShape(int origin_w, int origin_h, int* width, int* height,
+                       double* inv_scale_w, double* inv_scale_h) const;
+
   static bool Run(FDMat* mat, int target_size, int interp = 1,
                   bool use_scale = true,
                   const std::vector<int>& max_hw = std::vector<int>(),
                   ProcLib lib = ProcLib::DEFAULT);
 
  private:
-  double GenerateScale(const int origin_w, const int origin_h);
+  double GenerateScale(const int origin_w, const int origin_h) const;
   int target_size_;
   std::vector<int> max_hw_;
   int interp_;
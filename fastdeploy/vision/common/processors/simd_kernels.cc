@@ -0,0 +1,637 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fastdeploy/vision/common/processors/simd_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+// The AVX2 kernels are compiled by the target attribute, so the library
+// doesn't require -mavx2 and still runs on the CPUs without AVX2
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define FD_SIMD_KERNELS_AVX2
+#define FD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace fastdeploy {
+namespace vision {
+namespace simd {
+
+namespace {
+
+const int kInterNearest = 0;
+const int kInterLinear = 1;
+const int kInterArea = 3;
+// Keep the cache small when the input resolution keeps changing
+const size_t kMaxCachedResizeTables = 64;
+
+// Taps of the output coordinates along an axis in CSR layout, the source
+// indices are multiplied by `step`
+struct AxisTaps {
+  std::vector<int> begin;
+  std::vector<int> index;
+  std::vector<float> weight;
+
+  void Add(int src, float w, int step) {
+    index.push_back(src * step);
+    weight.push_back(w);
+  }
+};
+
+// INTER_NEAREST of cv::resize
+void ComputeNearestTaps(int src_size, int dst_size, double inv_scale,
+                        int step, AxisTaps* taps) {
+  for (int i = 0; i < dst_size; ++i) {
+    taps->begin.push_back(static_cast<int>(taps->index.size()));
+    int s = static_cast<int>(std::floor(i * inv_scale));
+    taps->Add(std::min(s, src_size - 1), 1.0f, step);
+  }
+  taps->begin.push_back(static_cast<int>(taps->index.size()));
+}
+
+// INTER_LINEAR of cv::resize, `area_mode` takes the coefficients of
+// INTER_AREA while upscaling
+void ComputeLinearTaps(int src_size, int dst_size, double inv_scale,
+                       bool area_mode, int step, AxisTaps* taps) {
+  double scale = 1.0 / inv_scale;
+  for (int i = 0; i < dst_size; ++i) {
+    taps->begin.push_back(static_cast<int>(taps->index.size()));
+    int s = 0;
+    float w = 0.0f;
+    if (!area_mode) {
+      double f = (i + 0.5) * inv_scale - 0.5;
+      s = static_cast<int>(std::floor(f));
+      w = static_cast<float>(f - s);
+    } else {
+      s = static_cast<int>(std::floor(i * inv_scale));
+      w = static_cast<float>((i + 1) - (s + 1) * scale);
+      w = w <= 0 ? 0.0f : w - std::floor(w);
+    }
+    if (s < 0) {
+      s = 0;
+      w = 0.0f;
+    }
+    if (s >= src_size - 1) {
+      s = src_size - 1;
+      w = 0.0f;
+    }
+    taps->Add(s, 1.0f - w, step);
+    taps->Add(std::min(s + 1, src_size - 1), w, step);
+  }
+  taps->begin.push_back(static_cast<int>(taps->index.size()));
+}
+
+// INTER_AREA of cv::resize while downscaling, every output pixel averages the
+// source pixels it covers
+void ComputeAreaTaps(int src_size, int dst_size, double inv_scale, int step,
+                     AxisTaps* taps) {
+  for (int i = 0; i < dst_size; ++i) {
+    taps->begin.push_back(static_cast<int>(taps->index.size()));
+    double fs1 = i * inv_scale;
+    double fs2 = fs1 + inv_scale;
+    double cell = std::min(inv_scale, src_size - fs1);
+    int s1 = static_cast<int>(std::ceil(fs1));
+    int s2 = static_cast<int>(std::floor(fs2));
+    s2 = std::min(s2, src_size - 1);
+    s1 = std::min(s1, s2);
+    if (s1 - fs1 > 1e-3) {
+      taps->Add(s1 - 1, static_cast<float>((s1 - fs1) / cell), step);
+    }
+    for (int s = s1; s < s2; ++s) {
+      taps->Add(s, static_cast<float>(1.0 / cell), step);
+    }
+    if (fs2 - s2 > 1e-3) {
+      taps->Add(s2,
+                static_cast<float>(std::min(std::min(fs2 - s2, 1.0), cell) /
+                                   cell),
+                step);
+    }
+  }
+  taps->begin.push_back(static_cast<int>(taps->index.size()));
+}
+
+// Interpolate a source row horizontally into a float HWC row
+template <typename T>
+void HorizontalRow(const T* src_row, const ResizeTables& tables, float* dst) {
+  int channels = tables.channels;
+  const int* index = tables.x_index.data();
+  const float* weight = tables.x_weight.data();
+  if (tables.x_fixed_taps == 2) {
+    for (int x = 0; x < tables.dst_w; ++x) {
+      const T* p0 = src_row + index[2 * x];
+      const T* p1 = src_row + index[2 * x + 1];
+      float w = weight[2 * x + 1];
+      for (int c = 0; c < channels; ++c) {
+        float v0 = p0[c];
+        dst[c] = v0 + (p1[c] - v0) * w;
+      }
+      dst += channels;
+    }
+    return;
+  }
+  const int* begin = tables.x_begin.data();
+  for (int x = 0; x < tables.dst_w; ++x) {
+    for (int c = 0; c < channels; ++c) {
+      float sum = 0.0f;
+      for (int k = begin[x]; k < begin[x + 1]; ++k) {
+        sum += src_row[index[k] + c] * weight[k];
+      }
+      dst[c] = sum;
+    }
+    dst += channels;
+  }
+}
+
+uint8_t SaturateU8(float v) {
+  int i = static_cast<int>(std::lrint(v));
+  return static_cast<uint8_t>(std::min(std::max(i, 0), 255));
+}
+
+#ifdef FD_SIMD_KERNELS_AVX2
+FD_TARGET_AVX2 void BlendRowAvx2(const float* row0, const float* row1,
+                                 float w, int n, uint8_t* dst) {
+  __m256 vw = _mm256_set1_ps(w);
+  int x = 0;
+  for (; x + 8 <= n; x += 8) {
+    __m256 v0 = _mm256_loadu_ps(row0 + x);
+    __m256 v1 = _mm256_loadu_ps(row1 + x);
+    __m256 v = _mm256_add_ps(v0, _mm256_mul_ps(_mm256_sub_ps(v1, v0), vw));
+    __m256i i32 = _mm256_cvtps_epi32(v);
+    __m128i i16 = _mm_packs_epi32(_mm256_castsi256_si128(i32),
+                                  _mm256_extracti128_si256(i32, 1));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + x),
+                     _mm_packus_epi16(i16, i16));
+  }
+  for (; x < n; ++x) {
+    dst[x] = SaturateU8(row0[x] + (row1[x] - row0[x]) * w);
+  }
+}
+
+FD_TARGET_AVX2 void BlendRowAvx2(const float* row0, const float* row1,
+                                 float w, int n, float* dst) {
+  __m256 vw = _mm256_set1_ps(w);
+  int x = 0;
+  for (; x + 8 <= n; x += 8) {
+    __m256 v0 = _mm256_loadu_ps(row0 + x);
+    __m256 v1 = _mm256_loadu_ps(row1 + x);
+    _mm256_storeu_ps(
+        dst + x, _mm256_add_ps(v0, _mm256_mul_ps(_mm256_sub_ps(v1, v0), vw)));
+  }
+  for (; x < n; ++x) {
+    dst[x] = row0[x] + (row1[x] - row0[x]) * w;
+  }
+}
+
+FD_TARGET_AVX2 __m256 LoadAsFloatAvx2(const uint8_t* src) {
+  __m128i u8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+  return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(u8));
+}
+
+FD_TARGET_AVX2 __m256 LoadAsFloatAvx2(const float* src) {
+  return _mm256_loadu_ps(src);
+}
+
+// Every 8 pixels are c vectors of 8 elements, the k-th vector takes the k-th
+// vector of the repeated alpha/beta pattern
+template <typename T>
+FD_TARGET_AVX2 size_t NormalizeAvx2(const T* src, size_t num_pixels,
+                                    int channels, const float* alpha,
+                                    const float* beta, float* dst) {
+  float alpha_pattern[32];
+  float beta_pattern[32];
+  for (int i = 0; i < 8 * channels; ++i) {
+    alpha_pattern[i] = alpha[i % channels];
+    beta_pattern[i] = beta[i % channels];
+  }
+  __m256 va[4];
+  __m256 vb[4];
+  for (int k = 0; k < channels; ++k) {
+    va[k] = _mm256_loadu_ps(alpha_pattern + 8 * k);
+    vb[k] = _mm256_loadu_ps(beta_pattern + 8 * k);
+  }
+  size_t block = 8 * static_cast<size_t>(channels);
+  size_t num = num_pixels * channels;
+  size_t i = 0;
+  for (; i + block <= num; i += block) {
+    for (int k = 0; k < channels; ++k) {
+      __m256 v = LoadAsFloatAvx2(src + i + 8 * k);
+      _mm256_storeu_ps(dst + i + 8 * k,
+                       _mm256_add_ps(_mm256_mul_ps(v, va[k]), vb[k]));
+    }
+  }
+  return i / channels;
+}
+
+FD_TARGET_AVX2 size_t CastAvx2(const uint8_t* src, size_t num, float* dst) {
+  size_t i = 0;
+  for (; i + 8 <= num; i += 8) {
+    _mm256_storeu_ps(dst + i, LoadAsFloatAvx2(src + i));
+  }
+  return i;
+}
+#endif
+
+void BlendRow(const float* row0, const float* row1, float w, int n,
+              uint8_t* dst) {
+#ifdef FD_SIMD_KERNELS_AVX2
+  if (Avx2Enabled()) {
+    BlendRowAvx2(row0, row1, w, n, dst);
+    return;
+  }
+#endif
+  for (int x = 0; x < n; ++x) {
+    dst[x] = SaturateU8(row0[x] + (row1[x] - row0[x]) * w);
+  }
+}
+
+void BlendRow(const float* row0, const float* row1, float w, int n,
+              float* dst) {
+#ifdef FD_SIMD_KERNELS_AVX2
+  if (Avx2Enabled()) {
+    BlendRowAvx2(row0, row1, w, n, dst);
+    return;
+  }
+#endif
+  for (int x = 0; x < n; ++x) {
+    dst[x] = row0[x] + (row1[x] - row0[x]) * w;
+  }
+}
+
+void StoreRow(const float* row, int n, uint8_t* dst) {
+  for (int x = 0; x < n; ++x) {
+    dst[x] = SaturateU8(row[x]);
+  }
+}
+
+void StoreRow(const float* row, int n, float* dst) {
+  std::copy(row, row + n, dst);
+}
+
+template <typename T>
+void ResizeByTablesImpl(const ResizeTables& tables, const T* src, T* dst) {
+  int channels = tables.channels;
+  size_t src_stride = static_cast<size_t>(tables.src_w) * channels;
+  int row_size = tables.dst_w * channels;
+  if (tables.interp == kInterNearest) {
+    for (int y = 0; y < tables.dst_h; ++y) {
+      const T* src_row = src + tables.y_index[y] * src_stride;
+      T* out = dst + static_cast<size_t>(y) * row_size;
+      for (int x = 0; x < tables.dst_w; ++x) {
+        const T* p = src_row + tables.x_index[x];
+        std::copy(p, p + channels, out + x * channels);
+      }
+    }
+    return;
+  }
+
+  // The horizontally interpolated rows are cached in a ring, the taps of an
+  // output row are adjacent source rows, so they never share a slot
+  int num_slots = tables.max_y_taps + 1;
+  std::vector<float> buffer(static_cast<size_t>(num_slots) * row_size);
+  std::vector<int> cached(num_slots, -1);
+  auto get_row = [&](int sy) -> const float* {
+    int slot = sy % num_slots;
+    float* row = buffer.data() + static_cast<size_t>(slot) * row_size;
+    if (cached[slot] != sy) {
+      HorizontalRow(src + sy * src_stride, tables, row);
+      cached[slot] = sy;
+    }
+    return row;
+  };
+  std::vector<float> sum(row_size);
+  for (int y = 0; y < tables.dst_h; ++y) {
+    int begin = tables.y_begin[y];
+    int end = tables.y_begin[y + 1];
+    T* out = dst + static_cast<size_t>(y) * row_size;
+    if (end - begin == 2) {
+      const float* row0 = get_row(tables.y_index[begin]);
+      const float* row1 = get_row(tables.y_index[begin + 1]);
+      BlendRow(row0, row1, tables.y_weight[begin + 1], row_size, out);
+      continue;
+    }
+    std::fill(sum.begin(), sum.end(), 0.0f);
+    for (int k = begin; k < end; ++k) {
+      const float* row = get_row(tables.y_index[k]);
+      float w = tables.y_weight[k];
+      for (int x = 0; x < row_size; ++x) {
+        sum[x] += row[x] * w;
+      }
+    }
+    StoreRow(sum.data(), row_size, out);
+  }
+}
+
+std::shared_ptr<const ResizeTables> ComputeResizeTables(
+    int src_h, int src_w, int channels, double inv_scale_h,
+    double inv_scale_w, int dst_h, int dst_w, int interp) {
+  auto tables = std::make_shared<ResizeTables>();
+  tables->src_w = src_w;
+  tables->src_h = src_h;
+  tables->dst_w = dst_w;
+  tables->dst_h = dst_h;
+  tables->channels = channels;
+  tables->interp = interp;
+  AxisTaps x_taps;
+  AxisTaps y_taps;
+  if (interp == kInterNearest) {
+    ComputeNearestTaps(src_w, dst_w, inv_scale_w, channels, &x_taps);
+    ComputeNearestTaps(src_h, dst_h, inv_scale_h, 1, &y_taps);
+  } else if (interp == kInterArea && inv_scale_w >= 1 && inv_scale_h >= 1) {
+    ComputeAreaTaps(src_w, dst_w, inv_scale_w, channels, &x_taps);
+    ComputeAreaTaps(src_h, dst_h, inv_scale_h, 1, &y_taps);
+  } else {
+    bool area_mode = interp == kInterArea;
+    ComputeLinearTaps(src_w, dst_w, inv_scale_w, area_mode, channels,
+                      &x_taps);
+    ComputeLinearTaps(src_h, dst_h, inv_scale_h, area_mode, 1, &y_taps);
+    tables->x_fixed_taps = 2;
+  }
+  tables->x_begin = std::move(x_taps.begin);
+  tables->x_index = std::move(x_taps.index);
+  tables->x_weight = std::move(x_taps.weight);
+  tables->y_begin = std::move(y_taps.begin);
+  tables->y_index = std::move(y_taps.index);
+  tables->y_weight = std::move(y_taps.weight);
+  for (int y = 0; y < dst_h; ++y) {
+    tables->max_y_taps = std::max(
+        tables->max_y_taps, tables->y_begin[y + 1] - tables->y_begin[y]);
+  }
+  return tables;
+}
+
+typedef std::tuple<int, int, int, int, int, int, double, double>
+    ResizeTablesKey;
+
+std::mutex& ResizeTablesMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::map<ResizeTablesKey, std::shared_ptr<const ResizeTables>>&
+ResizeTablesCache() {
+  static std::map<ResizeTablesKey, std::shared_ptr<const ResizeTables>> cache;
+  return cache;
+}
+
+template <typename T>
+void NormalizeImpl(const T* src, size_t num_pixels, int channels,
+                   const float* alpha, const float* beta, float* dst) {
+  size_t i = 0;
+#ifdef FD_SIMD_KERNELS_AVX2
+  if (Avx2Enabled() && channels <= 4) {
+    i = NormalizeAvx2(src, num_pixels, channels, alpha, beta, dst);
+  }
+#endif
+  for (; i < num_pixels; ++i) {
+    for (int c = 0; c < channels; ++c) {
+      size_t k = i * channels + c;
+      dst[k] = src[k] * alpha[c] + beta[c];
+    }
+  }
+}
+
+template <typename T>
+void HWC2CHWImpl(const T* src, int height, int width, int channels, T* dst) {
+  size_t plane_size = static_cast<size_t>(height) * width;
+  for (int c = 0; c < channels; ++c) {
+    const T* p = src + c;
+    T* plane = dst + c * plane_size;
+    for (size_t i = 0; i < plane_size; ++i) {
+      plane[i] = p[i * channels];
+    }
+  }
+}
+
+}  // namespace
+
+bool Avx2Enabled() {
+#ifdef FD_SIMD_KERNELS_AVX2
+  static const bool enabled = __builtin_cpu_supports("avx2");
+  return enabled;
+#else
+  return false;
+#endif
+}
+
+bool ResizeSupported(int interp) {
+  return interp == kInterNearest || interp == kInterLinear ||
+         interp == kInterArea;
+}
+
+std::shared_ptr<const ResizeTables> GetResizeTables(
+    int src_h, int src_w, int channels, double inv_scale_h,
+    double inv_scale_w, int dst_h, int dst_w, int interp) {
+  FDASSERT(ResizeSupported(interp),
+           "The interpolation %d is not supported by the resize engine.",
+           interp);
+  ResizeTablesKey key(src_w, src_h, dst_w, dst_h, channels, interp,
+                      inv_scale_w, inv_scale_h);
+  // A thread mostly resizes the frames of the same resolution, so the last
+  // tables are checked before locking the cache
+  thread_local ResizeTablesKey last_key;
+  thread_local std::shared_ptr<const ResizeTables> last_tables;
+  if (last_tables != nullptr && last_key == key) {
+    return last_tables;
+  }
+
+  std::shared_ptr<const ResizeTables> tables;
+  {
+    std::lock_guard<std::mutex> lock(ResizeTablesMutex());
+    auto& cache = ResizeTablesCache();
+    auto iter = cache.find(key);
+    if (iter != cache.end()) {
+      tables = iter->second;
+    }
+  }
+  if (tables == nullptr) {
+    tables = ComputeResizeTables(src_h, src_w, channels, inv_scale_h,
+                                 inv_scale_w, dst_h, dst_w, interp);
+    std::lock_guard<std::mutex> lock(ResizeTablesMutex());
+    auto& cache = ResizeTablesCache();
+    if (cache.size() >= kMaxCachedResizeTables) {
+      cache.clear();
+    }
+    cache[key] = tables;
+  }
+  last_key = key;
+  last_tables = tables;
+  return tables;
+}
+
+size_t NumCachedResizeTables() {
+  std::lock_guard<std::mutex> lock(ResizeTablesMutex());
+  return ResizeTablesCache().size();
+}
+
+void ResizeByTables(const ResizeTables& tables, const uint8_t* src,
+                    uint8_t* dst) {
+  ResizeByTablesImpl(tables, src, dst);
+}
+
+void ResizeByTables(const ResizeTables& tables, const float* src,
+                    float* dst) {
+  ResizeByTablesImpl(tables, src, dst);
+}
+
+void ResizeBilinear(const uint8_t* src, int src_h, int src_w, int channels,
+                    double inv_scale_h, double inv_scale_w, uint8_t* dst,
+                    int dst_h, int dst_w) {
+  ResizeByTables(*GetResizeTables(src_h, src_w, channels, inv_scale_h,
+                                  inv_scale_w, dst_h, dst_w, kInterLinear),
+                 src, dst);
+}
+
+void ResizeBilinear(const float* src, int src_h, int src_w, int channels,
+                    double inv_scale_h, double inv_scale_w, float* dst,
+                    int dst_h, int dst_w) {
+  ResizeByTables(*GetResizeTables(src_h, src_w, channels, inv_scale_h,
+                                  inv_scale_w, dst_h, dst_w, kInterLinear),
+                 src, dst);
+}
+
+void Normalize(const uint8_t* src, size_t num_pixels, int channels,
+               const float* alpha, const float* beta, float* dst) {
+  NormalizeImpl(src, num_pixels, channels, alpha, beta, dst);
+}
+
+void Normalize(const float* src, size_t num_pixels, int channels,
+               const float* alpha, const float* beta, float* dst) {
+  NormalizeImpl(src, num_pixels, channels, alpha, beta, dst);
+}
+
+void Cast(const uint8_t* src, size_t num, float* dst) {
+  size_t i = 0;
+#ifdef FD_SIMD_KERNELS_AVX2
+  if (Avx2Enabled()) {
+    i = CastAvx2(src, num, dst);
+  }
+#endif
+  for (; i < num; ++i) {
+    dst[i] = src[i];
+  }
+}
+
+void HWC2CHW(const uint8_t* src, int height, int width, int channels,
+             uint8_t* dst) {
+  HWC2CHWImpl(src, height, width, channels, dst);
+}
+
+void HWC2CHW(const float* src, int height, int width, int channels,
+             float* dst) {
+  HWC2CHWImpl(src, height, width, channels, dst);
+}
+
+void Crop(const uint8_t* src, int src_w, size_t pixel_bytes, int x, int y,
+          int width, int height, uint8_t* dst) {
+  size_t src_stride = src_w * pixel_bytes;
+  size_t row_bytes = width * pixel_bytes;
+  const uint8_t* p = src + y * src_stride + x * pixel_bytes;
+  for (int i = 0; i < height; ++i) {
+    std::memcpy(dst + i * row_bytes, p + i * src_stride, row_bytes);
+  }
+}
+
+void Pad(const uint8_t* src, int height, int width, size_t pixel_bytes,
+         int top, int bottom, int left, int right, const uint8_t* pad_pixel,
+         uint8_t* dst) {
+  int out_w = width + left + right;
+  size_t row_bytes = width * pixel_bytes;
+  size_t out_row_bytes = out_w * pixel_bytes;
+  // Build a padded row once, the border rows and the margins copy from it
+  std::vector<uint8_t> pad_row(out_row_bytes);
+  for (int x = 0; x < out_w; ++x) {
+    std::memcpy(pad_row.data() + x * pixel_bytes, pad_pixel, pixel_bytes);
+  }
+  int out_h = height + top + bottom;
+  for (int y = 0; y < out_h; ++y) {
+    uint8_t* row = dst + y * out_row_bytes;
+    if (y < top || y >= top + height) {
+      std::memcpy(row, pad_row.data(), out_row_bytes);
+      continue;
+    }
+    std::memcpy(row, pad_row.data(), left * pixel_bytes);
+    std::memcpy(row + left * pixel_bytes, src + (y - top) * row_bytes,
+                row_bytes);
+    std::memcpy(row + left * pixel_bytes + row_bytes, pad_row.data(),
+                right * pixel_bytes);
+  }
+}
+
+bool WarpAffineBilinear(const uint8_t* src, int src_h, int src_w,
+                        int channels, const double* matrix, uint8_t* dst,
+                        int dst_h, int dst_w, const float* border_value) {
+  // Map the output coordinates back to the source by the inverse matrix
+  double det = matrix[0] * matrix[4] - matrix[1] * matrix[3];
+  if (std::fabs(det) < 1e-12) {
+    return false;
+  }
+  double a11 = matrix[4] / det;
+  double a12 = -matrix[1] / det;
+  double a21 = -matrix[3] / det;
+  double a22 = matrix[0] / det;
+  double b1 = -a11 * matrix[2] - a12 * matrix[5];
+  double b2 = -a21 * matrix[2] - a22 * matrix[5];
+
+  size_t src_stride = static_cast<size_t>(src_w) * channels;
+  std::vector<float> corners(4 * channels);
+  for (int y = 0; y < dst_h; ++y) {
+    uint8_t* out = dst + static_cast<size_t>(y) * dst_w * channels;
+    for (int x = 0; x < dst_w; ++x) {
+      // Clamped so far away samples stay out of the image without overflow
+      double sx = std::min(std::max(a11 * x + a12 * y + b1, -2.0),
+                           static_cast<double>(src_w) + 1);
+      double sy = std::min(std::max(a21 * x + a22 * y + b2, -2.0),
+                           static_cast<double>(src_h) + 1);
+      // Quantize the position to 1/32 pixel like cv::warpAffine
+      sx = std::round(sx * 32) / 32;
+      sy = std::round(sy * 32) / 32;
+      int x0 = static_cast<int>(std::floor(sx));
+      int y0 = static_cast<int>(std::floor(sy));
+      float fx = static_cast<float>(sx - x0);
+      float fy = static_cast<float>(sy - y0);
+      // Neighbours out of the image take the border value
+      for (int k = 0; k < 4; ++k) {
+        int px = x0 + (k & 1);
+        int py = y0 + (k >> 1);
+        if (px >= 0 && px < src_w && py >= 0 && py < src_h) {
+          const uint8_t* p = src + py * src_stride + px * channels;
+          std::copy(p, p + channels, corners.begin() + k * channels);
+        } else {
+          std::copy(border_value, border_value + channels,
+                    corners.begin() + k * channels);
+        }
+      }
+      for (int c = 0; c < channels; ++c) {
+        float top = corners[c] + (corners[channels + c] - corners[c]) * fx;
+        float bottom = corners[2 * channels + c] +
+                       (corners[3 * channels + c] - corners[2 * channels + c]) *
+                           fx;
+        out[c] = SaturateU8(top + (bottom - top) * fy);
+      }
+      out += channels;
+    }
+  }
+  return true;
+}
+
+}  // namespace simd
+}  // namespace vision
+}  // namespace fastdeploy
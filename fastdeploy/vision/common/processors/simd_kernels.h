@@ -0,0 +1,141 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "fastdeploy/utils/utils.h"
+
+namespace fastdeploy {
+namespace vision {
+/*! @brief The image kernels of ProcLib::SIMD
+ *
+ * The kernels work on raw continuous buffers. The hot loops are compiled
+ * for AVX2 on x86 with GCC/Clang and chosen at runtime by the CPU features,
+ * other CPUs and compilers run the portable code.
+ */
+namespace simd {
+
+/// Whether the AVX2 kernels are used on this CPU
+FASTDEPLOY_DECL bool Avx2Enabled();
+
+/*! @brief The separable interpolation tables of a resize
+ *
+ * Every output column(row) is a weighted sum of the taps of some source
+ * columns(rows). The tables only depend on the sizes, the scales and the
+ * interpolation, so GetResizeTables() computes them once and all the frames
+ * of the same resolution reuse them.
+ */
+struct FASTDEPLOY_DECL ResizeTables {
+  int src_w = 0;
+  int src_h = 0;
+  int dst_w = 0;
+  int dst_h = 0;
+  int channels = 0;
+  int interp = 1;
+  // The taps of the output column x are [x_begin[x], x_begin[x + 1]), the
+  // indices are the element offsets in a source row
+  std::vector<int> x_begin;
+  std::vector<int> x_index;
+  std::vector<float> x_weight;
+  // The taps of the output row y, the indices are the source rows
+  std::vector<int> y_begin;
+  std::vector<int> y_index;
+  std::vector<float> y_weight;
+  // The number of taps of every output column if it's the same, otherwise 0
+  int x_fixed_taps = 0;
+  // The most taps of an output row
+  int max_y_taps = 0;
+};
+
+/// Whether the resize engine supports the interpolation of cv::InterpolationFlags, INTER_NEAREST, INTER_LINEAR and INTER_AREA are supported
+FASTDEPLOY_DECL bool ResizeSupported(int interp);
+
+/** \brief Get the tables of a resize with the same sampling geometry as cv::resize, the tables are cached per (source size, destination size, scales, interpolation) and shared by all the threads
+ *
+ * \param[in] inv_scale_h Ratio of the input height to the output height used by the interpolation
+ * \param[in] inv_scale_w Ratio of the input width to the output width used by the interpolation
+ * \param[in] interp The interpolation, should be supported by ResizeSupported()
+ */
+FASTDEPLOY_DECL std::shared_ptr<const ResizeTables> GetResizeTables(
+    int src_h, int src_w, int channels, double inv_scale_h,
+    double inv_scale_w, int dst_h, int dst_w, int interp);
+
+/// Number of the tables in the cache of GetResizeTables()
+FASTDEPLOY_DECL size_t NumCachedResizeTables();
+
+/// Resize a HWC image by the tables, the output is dst_h x dst_w of the tables
+FASTDEPLOY_DECL void ResizeByTables(const ResizeTables& tables,
+                                    const uint8_t* src, uint8_t* dst);
+FASTDEPLOY_DECL void ResizeByTables(const ResizeTables& tables,
+                                    const float* src, float* dst);
+
+/** \brief Bilinear resize of a HWC image, with the same sampling geometry as cv::resize
+ *
+ * \param[in] inv_scale_w Ratio of the input width to the output width used by the interpolation
+ * \param[in] inv_scale_h Ratio of the input height to the output height used by the interpolation
+ */
+FASTDEPLOY_DECL void ResizeBilinear(const uint8_t* src, int src_h, int src_w,
+                                    int channels, double inv_scale_h,
+                                    double inv_scale_w, uint8_t* dst,
+                                    int dst_h, int dst_w);
+FASTDEPLOY_DECL void ResizeBilinear(const float* src, int src_h, int src_w,
+                                    int channels, double inv_scale_h,
+                                    double inv_scale_w, float* dst, int dst_h,
+                                    int dst_w);
+
+/// dst[i] = src[i] * alpha[i % channels] + beta[i % channels] for the HWC data
+FASTDEPLOY_DECL void Normalize(const uint8_t* src, size_t num_pixels,
+                               int channels, const float* alpha,
+                               const float* beta, float* dst);
+FASTDEPLOY_DECL void Normalize(const float* src, size_t num_pixels,
+                               int channels, const float* alpha,
+                               const float* beta, float* dst);
+
+/// Convert the uint8 data to float
+FASTDEPLOY_DECL void Cast(const uint8_t* src, size_t num, float* dst);
+
+/// Permute the HWC data to CHW
+FASTDEPLOY_DECL void HWC2CHW(const uint8_t* src, int height, int width,
+                             int channels, uint8_t* dst);
+FASTDEPLOY_DECL void HWC2CHW(const float* src, int height, int width,
+                             int channels, float* dst);
+
+/// Copy the rectangle of the HWC image at (x, y), `pixel_bytes` is the size of a pixel
+FASTDEPLOY_DECL void Crop(const uint8_t* src, int src_w, size_t pixel_bytes,
+                          int x, int y, int width, int height, uint8_t* dst);
+
+/// Pad the HWC image with `pad_pixel`, whose size is `pixel_bytes`
+FASTDEPLOY_DECL void Pad(const uint8_t* src, int height, int width,
+                         size_t pixel_bytes, int top, int bottom, int left,
+                         int right, const uint8_t* pad_pixel, uint8_t* dst);
+
+/** \brief Bilinear affine warp of a uint8 HWC image, the samples outside the image take `border_value` like cv::BORDER_CONSTANT
+ *
+ * \param[in] matrix The 2x3 matrix mapping the source to the destination, same as cv::warpAffine without WARP_INVERSE_MAP
+ * \return false if the matrix is not invertible
+ */
+FASTDEPLOY_DECL bool WarpAffineBilinear(const uint8_t* src, int src_h,
+                                        int src_w, int channels,
+                                        const double* matrix, uint8_t* dst,
+                                        int dst_h, int dst_w,
+                                        const float* border_value);
+
+}  // namespace simd
+}  // namespace vision
+}  // namespace fastdeploy
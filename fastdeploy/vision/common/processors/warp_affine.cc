@@ -14,6 +14,8 @@
 
 #include "fastdeploy/vision/common/processors/warp_affine.h"
 
+#include "fastdeploy/vision/common/processors/simd_kernels.h"
+
 namespace fastdeploy {
 namespace vision {
 
@@ -36,6 +38,52 @@ bool WarpAffine::ImplByOpenCV(Mat* mat) {
   return true;
 }
 
+bool WarpAffine::ImplBySimd(Mat* mat) {
+  if (mat->layout != Layout::HWC) {
+    FDERROR << "WarpAffine: The format of input is not HWC." << std::endl;
+    return false;
+  }
+  if (width_ <= 0 || height_ <= 0) {
+    FDERROR << "WarpAffine: the parameters must satisfy (width > 0 && height > 0) ."
+            << std::endl;
+    return false;
+  }
+  // Only the bilinear warp of uint8 images with a constant border is
+  // implemented
+  if (interp_ != cv::INTER_LINEAR || border_mode_ != cv::BORDER_CONSTANT ||
+      mat->Type() != FDDataType::UINT8 || mat->Channels() > 4 ||
+      trans_matrix_.rows != 2 || trans_matrix_.cols != 3 ||
+      (trans_matrix_.depth() != CV_32F && trans_matrix_.depth() != CV_64F)) {
+    return ImplByOpenCV(mat);
+  }
+  const void* src = GetSimdInputData(mat);
+  FDTensor* output = GetSimdOutputCache(mat);
+  if (src == nullptr || output == nullptr) {
+    return ImplByOpenCV(mat);
+  }
+  double matrix[6];
+  for (int i = 0; i < 6; ++i) {
+    matrix[i] = trans_matrix_.depth() == CV_32F
+                    ? trans_matrix_.at<float>(i / 3, i % 3)
+                    : trans_matrix_.at<double>(i / 3, i % 3);
+  }
+  float border_value[4];
+  for (int c = 0; c < 4; ++c) {
+    border_value[c] = static_cast<float>(borderValue_[c]);
+  }
+  int channels = mat->Channels();
+  output->Resize({height_, width_, channels}, FDDataType::UINT8,
+                 "output_cache", Device::CPU);
+  if (!simd::WarpAffineBilinear(static_cast<const uint8_t*>(src),
+                                mat->Height(), mat->Width(), channels, matrix,
+                                static_cast<uint8_t*>(output->MutableData()),
+                                height_, width_, border_value)) {
+    return ImplByOpenCV(mat);
+  }
+  SetSimdOutput(mat, output, height_, width_, channels);
+  return true;
+}
+
 bool WarpAffine::Run(Mat* mat,
                      const cv::Mat& trans_matrix,
                      int width, int height, 
@@ -33,6 +33,7 @@ class WarpAffine : public Processor {
   }
 
   bool ImplByOpenCV(Mat* mat);
+  bool ImplBySimd(Mat* mat);
   std::string Name() { return "WarpAffine"; }
 
   bool SetTransformMatrix(const cv::Mat& trans_matrix) {
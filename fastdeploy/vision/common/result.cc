@@ -13,6 +13,9 @@
 // limitations under the License.
 #include "fastdeploy/vision/common/result.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace fastdeploy {
 namespace vision {
 
@@ -55,11 +58,63 @@ void Mask::Resize(int size) { data.resize(size); }
 void Mask::Free() {
   std::vector<uint8_t>().swap(data);
   std::vector<int64_t>().swap(shape);
+  std::vector<uint32_t>().swap(rle);
+  is_rle = false;
 }
 
 void Mask::Clear() {
   data.clear();
   shape.clear();
+  rle.clear();
+  is_rle = false;
+}
+
+void Mask::EncodeRLE() {
+  if (is_rle) {
+    return;
+  }
+  FDASSERT(shape.size() == 2,
+           "Only the mask in shape of (H, W) can be encoded, but now the "
+           "dimension of shape is %zu.",
+           shape.size());
+  std::vector<uint8_t> dense;
+  dense.swap(data);
+  EncodeRLE(dense.data(), static_cast<int>(shape[0]),
+            static_cast<int>(shape[1]), shape[1]);
+}
+
+void Mask::DecodeRLE() {
+  if (!is_rle) {
+    return;
+  }
+  std::vector<uint8_t> dense(shape[0] * shape[1]);
+  DecodeTo(dense.data());
+  data.swap(dense);
+  std::vector<uint32_t>().swap(rle);
+  is_rle = false;
+}
+
+void Mask::DecodeTo(uint8_t* dense) const {
+  if (!is_rle) {
+    std::memcpy(dense, data.data(), data.size());
+    return;
+  }
+  int64_t height = shape[0];
+  int64_t width = shape[1];
+  int64_t numel = height * width;
+  // Write the runs of 1 to the transposed positions, as the runs are counted
+  // over the pixels in column-major order
+  std::memset(dense, 0, numel);
+  int64_t index = 0;
+  for (size_t i = 0; i < rle.size() && index < numel; ++i) {
+    int64_t end = std::min(index + static_cast<int64_t>(rle[i]), numel);
+    if (i % 2 == 1) {
+      for (int64_t j = index; j < end; ++j) {
+        dense[(j % height) * width + j / height] = 1;
+      }
+    }
+    index = end;
+  }
 }
 
 std::string Mask::Str() {
@@ -72,6 +127,9 @@ std::string Mask::Str() {
       out += std::to_string(shape[i]);
     }
   }
+  if (is_rle) {
+    out += ", rle: " + std::to_string(rle.size());
+  }
   out += ")\n";
   return out;
 }
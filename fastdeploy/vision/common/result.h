@@ -73,6 +73,12 @@ struct FASTDEPLOY_DECL Mask : public BaseResult {
   std::vector<uint8_t> data;
   /// Shape of mask
   std::vector<int64_t> shape;  // (H,W) ...
+  /** \brief Whether the mask is run-length encoded in `rle`, the `data` is empty if true
+   */
+  bool is_rle = false;
+  /** \brief Run-length encoding of the mask compatible with the `counts` of COCO RLE, the lengths of the alternate runs of 0 and 1 over the pixels in column-major order, starting with a run of 0. It's decoded to 1 for the pixels of the mask, while the dense data keeps the values of the model, e.g 255 of YOLOv5Seg
+   */
+  std::vector<uint32_t> rle;
   ResultType type = ResultType::MASK;
 
   /// clear Mask result
@@ -93,6 +99,49 @@ struct FASTDEPLOY_DECL Mask : public BaseResult {
   /// Resize the mask data buffer
   void Resize(int size);
 
+  /** \brief Run-length encode a region of a mask map, without copying the region to the dense data
+   *
+   * \param[in] ptr Pointer to the top left pixel of the region
+   * \param[in] height Height of the region
+   * \param[in] width Width of the region
+   * \param[in] row_stride Number of elements between two rows of the map
+   * \param[in] threshold The pixels greater than threshold belong to the mask
+   */
+  template <typename T>
+  void EncodeRLE(const T* ptr, int height, int width, int64_t row_stride,
+                 T threshold = T(0)) {
+    std::vector<uint8_t>().swap(data);
+    shape = {height, width};
+    is_rle = true;
+    rle.clear();
+    bool value = false;
+    uint32_t count = 0;
+    for (int x = 0; x < width; ++x) {
+      const T* col = ptr + x;
+      for (int y = 0; y < height; ++y) {
+        if ((col[y * row_stride] > threshold) != value) {
+          rle.push_back(count);
+          value = !value;
+          count = 0;
+        }
+        ++count;
+      }
+    }
+    rle.push_back(count);
+  }
+
+  /// Convert the dense mask data to RLE and free the data
+  void EncodeRLE();
+
+  /// Convert the RLE mask to dense data
+  void DecodeRLE();
+
+  /** \brief Decode the mask to a buffer of shape[0] * shape[1] bytes in row-major order, works for both the dense and the RLE masks
+   *
+   * \param[in] dense The output buffer, 1 for the pixels of the mask and 0 for the others if the mask is RLE, otherwise the copy of the data
+   */
+  void DecodeTo(uint8_t* dense) const;
+
   /// Debug function, convert the result to string to print
   std::string Str();
 };
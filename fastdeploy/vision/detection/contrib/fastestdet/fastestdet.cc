@@ -53,6 +53,7 @@ bool FastestDet::Predict(const cv::Mat& im, DetectionResult* result) {
 }
 
 bool FastestDet::BatchPredict(const std::vector<cv::Mat>& images, std::vector<DetectionResult>* results) {
+  PredictScope predict_scope(this);
   std::vector<std::map<std::string, std::array<float, 2>>> ims_info;
   std::vector<FDMat> fd_images = WrapMat(images);
 
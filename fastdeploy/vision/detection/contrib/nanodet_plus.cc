@@ -302,6 +302,7 @@ bool NanoDetPlus::Postprocess(
 
 bool NanoDetPlus::Predict(cv::Mat* im, DetectionResult* result,
                           float conf_threshold, float nms_iou_threshold) {
+  PredictScope predict_scope(this);
   Mat mat(*im);
   std::vector<FDTensor> input_tensors(1);
 
@@ -54,6 +54,7 @@ bool RKYOLO::Predict(const cv::Mat& im, DetectionResult* result) {
 
 bool RKYOLO::BatchPredict(const std::vector<cv::Mat>& images,
                           std::vector<DetectionResult>* results) {
+  PredictScope predict_scope(this);
   std::vector<FDMat> fd_images = WrapMat(images);
 
   if (!preprocessor_.Run(&fd_images, &reused_input_tensors_)) {
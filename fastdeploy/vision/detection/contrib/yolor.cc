@@ -217,6 +217,7 @@ bool YOLOR::Postprocess(
 
 bool YOLOR::Predict(cv::Mat* im, DetectionResult* result, float conf_threshold,
                     float nms_iou_threshold) {
+  PredictScope predict_scope(this);
   Mat mat(*im);
 
   std::map<std::string, std::array<float, 2>> im_info;
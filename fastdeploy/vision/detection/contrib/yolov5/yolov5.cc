@@ -67,6 +67,7 @@ bool YOLOv5::Predict(const cv::Mat& im, DetectionResult* result) {
 }
 
 bool YOLOv5::BatchPredict(const std::vector<cv::Mat>& images, std::vector<DetectionResult>* results) {
+  PredictScope predict_scope(this);
   std::vector<std::map<std::string, std::array<float, 2>>> ims_info;
   std::vector<FDMat> fd_images = WrapMat(images);
 
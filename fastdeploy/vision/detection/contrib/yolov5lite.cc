@@ -422,6 +422,7 @@ bool YOLOv5Lite::Postprocess(
 
 bool YOLOv5Lite::Predict(cv::Mat* im, DetectionResult* result,
                          float conf_threshold, float nms_iou_threshold) {
+  PredictScope predict_scope(this);
   Mat mat(*im);
 
   std::map<std::string, std::array<float, 2>> im_info;
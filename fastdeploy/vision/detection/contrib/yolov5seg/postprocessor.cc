@@ -24,6 +24,7 @@ YOLOv5SegPostprocessor::YOLOv5SegPostprocessor() {
   nms_threshold_ = 0.5;
   mask_threshold_ = 0.5;
   multi_label_ = true;
+  mask_rle_ = false;
   max_wh_ = 7680.0;
   mask_nums_ = 32;
 }
@@ -195,6 +196,14 @@ bool YOLOv5SegPostprocessor::Run(
       int x2_src = static_cast<int>(round((*results)[bs].boxes[i][2]));
       int y2_src = static_cast<int>(round((*results)[bs].boxes[i][3]));
       cv::Rect roi_src(x1_src, y1_src, x2_src - x1_src, y2_src - y1_src);
+      if (mask_rle_) {
+        // Encode from the mask map, no dense mask is kept
+        int64_t row_stride = static_cast<int64_t>(mask.step1());
+        (*results)[bs].masks[i].EncodeRLE(
+            mask.ptr<float>() + y1_src * row_stride + x1_src,
+            y2_src - y1_src, x2_src - x1_src, row_stride, mask_threshold_);
+        continue;
+      }
       mask = mask(roi_src);
       mask = mask > mask_threshold_;
       // save mask in DetectionResult
@@ -63,10 +63,19 @@ class FASTDEPLOY_DECL YOLOv5SegPostprocessor {
   /// Get multi_label, default true
   bool GetMultiLabel() const { return multi_label_; }
 
+  /// Set whether to output the masks in RLE, which are encoded from the mask map without the dense mask, default false. The RLE masks decode to 0/1 rather than the 0/255 of the dense masks
+  void SetMaskRLE(bool mask_rle) {
+    mask_rle_ = mask_rle;
+  }
+
+  /// Get whether to output the masks in RLE, default false
+  bool GetMaskRLE() const { return mask_rle_; }
+
  protected:
   float conf_threshold_;
   float nms_threshold_;
   bool multi_label_;
+  bool mask_rle_;
   float max_wh_;
   // channel nums of masks
   int mask_nums_;
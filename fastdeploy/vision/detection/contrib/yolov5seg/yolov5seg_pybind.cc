@@ -63,7 +63,8 @@ void BindYOLOv5Seg(pybind11::module& m) {
       })
       .def_property("conf_threshold", &vision::detection::YOLOv5SegPostprocessor::GetConfThreshold, &vision::detection::YOLOv5SegPostprocessor::SetConfThreshold)
       .def_property("nms_threshold", &vision::detection::YOLOv5SegPostprocessor::GetNMSThreshold, &vision::detection::YOLOv5SegPostprocessor::SetNMSThreshold)
-      .def_property("multi_label", &vision::detection::YOLOv5SegPostprocessor::GetMultiLabel, &vision::detection::YOLOv5SegPostprocessor::SetMultiLabel);
+      .def_property("multi_label", &vision::detection::YOLOv5SegPostprocessor::GetMultiLabel, &vision::detection::YOLOv5SegPostprocessor::SetMultiLabel)
+      .def_property("mask_rle", &vision::detection::YOLOv5SegPostprocessor::GetMaskRLE, &vision::detection::YOLOv5SegPostprocessor::SetMaskRLE);
 
   pybind11::class_<vision::detection::YOLOv5Seg, FastDeployModel>(m, "YOLOv5Seg")
       .def(pybind11::init<std::string, std::string, RuntimeOption,
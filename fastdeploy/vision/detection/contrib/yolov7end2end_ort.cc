@@ -214,6 +214,7 @@ bool YOLOv7End2EndORT::Postprocess(
 
 bool YOLOv7End2EndORT::Predict(cv::Mat* im, DetectionResult* result,
                                float conf_threshold) {
+  PredictScope predict_scope(this);
   Mat mat(*im);
 
   std::map<std::string, std::array<float, 2>> im_info;
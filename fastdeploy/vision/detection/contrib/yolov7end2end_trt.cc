@@ -316,6 +316,7 @@ bool YOLOv7End2EndTRT::Postprocess(
 
 bool YOLOv7End2EndTRT::Predict(cv::Mat* im, DetectionResult* result,
                                float conf_threshold) {
+  PredictScope predict_scope(this);
   Mat mat(*im);
 
   std::map<std::string, std::array<float, 2>> im_info;
@@ -54,6 +54,7 @@ bool YOLOv8::Predict(const cv::Mat& im, DetectionResult* result) {
 
 bool YOLOv8::BatchPredict(const std::vector<cv::Mat>& images,
                           std::vector<DetectionResult>* results) {
+  PredictScope predict_scope(this);
   std::vector<std::map<std::string, std::array<float, 2>>> ims_info;
   std::vector<FDMat> fd_images = WrapMat(images);
 
@@ -280,6 +280,7 @@ bool YOLOX::PostprocessWithDecode(
 
 bool YOLOX::Predict(cv::Mat* im, DetectionResult* result, float conf_threshold,
                     float nms_iou_threshold) {
+  PredictScope predict_scope(this);
   Mat mat(*im);
 
   std::map<std::string, std::array<float, 2>> im_info;
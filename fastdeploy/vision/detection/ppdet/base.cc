@@ -51,7 +51,14 @@ bool PPDetBase::Predict(const cv::Mat& im, DetectionResult* result) {
 bool PPDetBase::BatchPredict(const std::vector<cv::Mat>& imgs,
                              std::vector<DetectionResult>* results) {
   std::vector<FDMat> fd_images = WrapMat(imgs);
-  if (!preprocessor_.Run(&fd_images, &reused_input_tensors_)) {
+  return BatchPredict(&fd_images, results);
+}
+
+bool PPDetBase::BatchPredict(std::vector<FDMat>* imgs,
+                             std::vector<DetectionResult>* results) {
+  RequestArenaScope arena_scope(this);
+  PredictScope predict_scope(this);
+  if (!preprocessor_.Run(imgs, &reused_input_tensors_)) {
     FDERROR << "Failed to preprocess the input image." << std::endl;
     return false;
   }
@@ -77,6 +77,14 @@ class FASTDEPLOY_DECL PPDetBase : public FastDeployModel {
   virtual bool BatchPredict(const std::vector<cv::Mat>& imgs,
                             std::vector<DetectionResult>* results);
 
+  /** \brief Predict the detection result for a list of FDMat, e.g. the NV12 frames created by FDMat::CreateFromYuv()
+   * \param[in] imgs The input image list, the frames are preprocessed without copy when the preprocessing can be fused
+   * \param[in] results The output detection result list
+   * \return true if the prediction successed, otherwise false
+   */
+  virtual bool BatchPredict(std::vector<FDMat>* imgs,
+                            std::vector<DetectionResult>* results);
+
   PaddleDetPreprocessor& GetPreprocessor() {
     return preprocessor_;
   }
@@ -14,9 +14,12 @@
 
 #pragma once
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "fastdeploy/function/nms.h"
+
 namespace fastdeploy {
 namespace vision {
 namespace detection {
@@ -28,6 +31,7 @@ namespace detection {
    * \param[in] nms_top_k if there are more than max_num bboxes after NMS, only top max_num will be kept.
    * \param[in] normalized Determine whether normalized is required
    * \param[in] score_threshold bbox threshold, bboxes with scores lower than it will not be considered.
+   * \param[in] thread_num the number of threads running the NMS of the classes in parallel
    */
 struct NMSOption{
   NMSOption() = default;
@@ -38,6 +42,7 @@ struct NMSOption{
   int64_t nms_top_k = 1000;
   bool normalized = true;
   float score_threshold = 0.3;
+  int thread_num = 1;
 };
 
 struct PaddleMultiClassNMS {
@@ -49,6 +54,8 @@ struct PaddleMultiClassNMS {
   bool normalized;
   float score_threshold;
 
+  std::shared_ptr<TaskPool> task_pool;
+
   std::vector<int32_t> out_num_rois_data;
   std::vector<int32_t> out_index_data;
   std::vector<float> out_box_data;
@@ -69,7 +76,14 @@ struct PaddleMultiClassNMS {
     nms_top_k = nms_option.nms_top_k;
     normalized = nms_option.normalized;
     score_threshold = nms_option.score_threshold;
+    task_pool = nullptr;
+    if (nms_option.thread_num > 1) {
+      task_pool = std::make_shared<TaskPool>(nms_option.thread_num);
+    }
   }
+
+  // The parameters of the NMS of a class
+  function::NMSParams GetNMSParams() const;
 };
 }  // namespace detection
 }  // namespace vision
@@ -28,10 +28,9 @@ bool PaddleDetPostprocessor::ProcessMask(
             << tensor.Dtype() << std::endl;
     return false;
   }
-  int64_t out_mask_h = shape[1];
   int64_t out_mask_w = shape[2];
   int64_t out_mask_numel = shape[1] * shape[2];
-  const auto* data = reinterpret_cast<const uint8_t*>(tensor.CpuData());
+  const auto* data = reinterpret_cast<const int32_t*>(tensor.CpuData());
   int index = 0;
 
   for (int i = 0; i < results->size(); ++i) {
@@ -44,18 +43,25 @@ bool PaddleDetPostprocessor::ProcessMask(
       int y2 = static_cast<int>(round((*results)[i].boxes[j][3]));
       int keep_mask_h = y2 - y1;
       int keep_mask_w = x2 - x1;
+      const int32_t* current_ptr =
+          data + index * out_mask_numel + y1 * out_mask_w + x1;
+      if (mask_rle_) {
+        // Encode from the output tensor, no dense mask is kept
+        (*results)[i].masks[j].EncodeRLE(current_ptr, keep_mask_h,
+                                         keep_mask_w, out_mask_w);
+        index += 1;
+        continue;
+      }
       int keep_mask_numel = keep_mask_h * keep_mask_w;
       (*results)[i].masks[j].Resize(keep_mask_numel);
       (*results)[i].masks[j].shape = {keep_mask_h, keep_mask_w};
-      const uint8_t* current_ptr = data + index * out_mask_numel;
 
       auto* keep_mask_ptr =
           reinterpret_cast<uint8_t*>((*results)[i].masks[j].Data());
-      for (int row = y1; row < y2; ++row) {
-        size_t keep_nbytes_in_col = keep_mask_w * sizeof(uint8_t);
-        const uint8_t* out_row_start_ptr = current_ptr + row * out_mask_w + x1;
-        uint8_t* keep_row_start_ptr = keep_mask_ptr + (row - y1) * keep_mask_w;
-        std::memcpy(keep_row_start_ptr, out_row_start_ptr, keep_nbytes_in_col);
+      for (int row = 0; row < keep_mask_h; ++row) {
+        const int32_t* out_row_start_ptr = current_ptr + row * out_mask_w;
+        std::copy(out_row_start_ptr, out_row_start_ptr + keep_mask_w,
+                  keep_mask_ptr + row * keep_mask_w);
       }
       index += 1;
     }
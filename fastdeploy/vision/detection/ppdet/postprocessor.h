@@ -56,6 +56,15 @@ class FASTDEPLOY_DECL PaddleDetPostprocessor {
     scale_factor_ = scale_factor_value;
   }
 
+  /** \brief Set whether to output the masks of instance segmentation models in RLE, which are encoded from the output tensor without the dense mask, default false
+   *
+   * \param[in] mask_rle Whether to output the masks in RLE
+   */
+  void SetMaskRLE(bool mask_rle) { mask_rle_ = mask_rle; }
+
+  /// Get whether to output the masks in RLE, default false
+  bool GetMaskRLE() const { return mask_rle_; }
+
  private:
   // for model without decode and nms.
   bool apply_decode_and_nms_ = false;
@@ -64,6 +73,7 @@ class FASTDEPLOY_DECL PaddleDetPostprocessor {
                               std::vector<DetectionResult>* results);
   PPDetDecode ppdet_decoder_;
   std::vector<float> scale_factor_{0.0, 0.0};
+  bool mask_rle_ = false;
   std::vector<float> GetScaleFactor() { return scale_factor_; }
   // Process mask tensor for MaskRCNN
   bool ProcessMask(const FDTensor& tensor,
@@ -43,7 +43,13 @@ void BindPPDet(pybind11::module& m) {
       .def("disable_permute",
            [](vision::detection::PaddleDetPreprocessor& self) {
              self.DisablePermute();
-           });
+           })
+      .def("enable_fused_pipeline",
+           &vision::detection::PaddleDetPreprocessor::EnableFusedPipeline)
+      .def("set_thread_num",
+           &vision::detection::PaddleDetPreprocessor::SetThreadNum)
+      .def("enable_auto_proc_lib",
+           &vision::detection::PaddleDetPreprocessor::EnableAutoProcLib);
 
   pybind11::class_<vision::detection::NMSOption>(m, "NMSOption")
       .def(pybind11::init())
@@ -56,7 +62,8 @@ void BindPPDet(pybind11::module& m) {
       .def_readwrite("nms_top_k", &vision::detection::NMSOption::nms_top_k)
       .def_readwrite("normalized", &vision::detection::NMSOption::normalized)
       .def_readwrite("score_threshold",
-                     &vision::detection::NMSOption::score_threshold);
+                     &vision::detection::NMSOption::score_threshold)
+      .def_readwrite("thread_num", &vision::detection::NMSOption::thread_num);
 
   pybind11::class_<vision::detection::PaddleDetPostprocessor>(
       m, "PaddleDetPostprocessor")
@@ -81,6 +88,9 @@ void BindPPDet(pybind11::module& m) {
           },
           "A function which adds two numbers",
           pybind11::arg("option") = vision::detection::NMSOption())
+      .def_property("mask_rle",
+                    &vision::detection::PaddleDetPostprocessor::GetMaskRLE,
+                    &vision::detection::PaddleDetPostprocessor::SetMaskRLE)
       .def("run", [](vision::detection::PaddleDetPostprocessor& self,
                      std::vector<pybind11::array>& input_array) {
         std::vector<vision::DetectionResult> results;
@@ -30,7 +30,29 @@ PaddleDetPreprocessor::PaddleDetPreprocessor(const std::string& config_file) {
 }
 
 bool PaddleDetPreprocessor::BuildPreprocessPipelineFromConfig() {
-  processors_.clear();
+  std::string options = "PaddleDetection";
+  if (disable_normalize_) {
+    options += " DisableNormalize";
+  }
+  if (disable_permute_) {
+    options += " DisablePermute";
+  }
+  // The config is only parsed by the first preprocessor of the same config
+  auto plan = GetPreprocessPlan(
+      config_file_, options,
+      [this](std::vector<std::shared_ptr<Processor>>* processors) {
+        return ParseConfig(processors);
+      });
+  if (plan == nullptr) {
+    return false;
+  }
+  processors_ = plan->Processors();
+  SetPlan(plan);
+  return true;
+}
+
+bool PaddleDetPreprocessor::ParseConfig(
+    std::vector<std::shared_ptr<Processor>>* processors) const {
   YAML::Node cfg;
   try {
     cfg = YAML::LoadFile(config_file_);
@@ -40,7 +62,7 @@ bool PaddleDetPreprocessor::BuildPreprocessPipelineFromConfig() {
     return false;
   }
 
-  processors_.push_back(std::make_shared<BGR2RGB>());
+  processors->push_back(std::make_shared<BGR2RGB>());
 
   bool has_permute = false;
   for (const auto& op : cfg["Preprocess"]) {
@@ -61,7 +83,7 @@ bool PaddleDetPreprocessor::BuildPreprocessPipelineFromConfig() {
           std::fill(mean.begin(), mean.end(), 0.0);
           std::fill(std.begin(), std.end(), 1.0);
         }
-        processors_.push_back(std::make_shared<Normalize>(mean, std, is_scale));
+        processors->push_back(std::make_shared<Normalize>(mean, std, is_scale));
       }
     } else if (op_name == "Resize") {
       bool keep_ratio = op["keep_ratio"].as<bool>();
@@ -73,7 +95,7 @@ bool PaddleDetPreprocessor::BuildPreprocessPipelineFromConfig() {
       if (!keep_ratio) {
         int width = target_size[1];
         int height = target_size[0];
-        processors_.push_back(
+        processors->push_back(
             std::make_shared<Resize>(width, height, -1.0, -1.0, interp, false));
       } else {
         int min_target_size = std::min(target_size[0], target_size[1]);
@@ -83,7 +105,7 @@ bool PaddleDetPreprocessor::BuildPreprocessPipelineFromConfig() {
           max_size.push_back(max_target_size);
           max_size.push_back(max_target_size);
         }
-        processors_.push_back(std::make_shared<ResizeByShort>(
+        processors->push_back(std::make_shared<ResizeByShort>(
             min_target_size, interp, true, max_size));
       }
     } else if (op_name == "Permute") {
@@ -93,11 +115,11 @@ bool PaddleDetPreprocessor::BuildPreprocessPipelineFromConfig() {
     } else if (op_name == "Pad") {
       auto size = op["size"].as<std::vector<int>>();
       auto value = op["fill_value"].as<std::vector<float>>();
-      processors_.push_back(
+      processors->push_back(
           std::make_shared<PadToSize>(size[1], size[0], value));
     } else if (op_name == "PadStride") {
       auto stride = op["stride"].as<int>();
-      processors_.push_back(
+      processors->push_back(
           std::make_shared<StridePad>(stride, std::vector<float>(3, 0)));
     } else {
       FDERROR << "Unexcepted preprocess operator: " << op_name << "."
@@ -108,28 +130,16 @@ bool PaddleDetPreprocessor::BuildPreprocessPipelineFromConfig() {
   if (!disable_permute_) {
     if (has_permute) {
       // permute = cast<float> + HWC2CHW
-      processors_.push_back(std::make_shared<Cast>("float"));
-      processors_.push_back(std::make_shared<HWC2CHW>());
+      processors->push_back(std::make_shared<Cast>("float"));
+      processors->push_back(std::make_shared<HWC2CHW>());
     }
   }
-
-  // Fusion will improve performance
-  FuseTransforms(&processors_);
-
   return true;
 }
 
-bool PaddleDetPreprocessor::Run(std::vector<FDMat>* images,
-                                std::vector<FDTensor>* outputs) {
-  if (!initialized_) {
-    FDERROR << "The preprocessor is not initialized." << std::endl;
-    return false;
-  }
-  if (images->empty()) {
-    FDERROR << "The size of input images should be greater than 0."
-            << std::endl;
-    return false;
-  }
+bool PaddleDetPreprocessor::Apply(FDMatBatch* image_batch,
+                                  std::vector<FDTensor>* outputs) {
+  std::vector<FDMat>* images = image_batch->mats;
 
   // There are 3 outputs, image, scale_factor, im_shape
   // But im_shape is not used for all the PaddleDetection models
@@ -148,31 +158,68 @@ bool PaddleDetPreprocessor::Run(std::vector<FDMat>* images,
   auto* scale_factor_ptr =
       reinterpret_cast<float*>((*outputs)[1].MutableData());
   auto* im_shape_ptr = reinterpret_cast<float*>((*outputs)[2].MutableData());
+  if (UseFusedPipeline(image_batch)) {
+    return RunFusedPipeline(images, outputs);
+  }
+  // The images are processed in parallel through the chain, the last
+  // processor is held back so that it may write into the batch tensor
+  std::vector<std::array<int, 2>> origin_hw(images->size());
   for (size_t i = 0; i < images->size(); ++i) {
-    int origin_w = (*images)[i].Width();
-    int origin_h = (*images)[i].Height();
+    origin_hw[i] = {(*images)[i].Height(), (*images)[i].Width()};
     scale_factor_ptr[2 * i] = 1.0;
     scale_factor_ptr[2 * i + 1] = 1.0;
-    for (size_t j = 0; j < processors_.size(); ++j) {
-      if (!(*(processors_[j].get()))(&((*images)[i]))) {
-        FDERROR << "Failed to processs image:" << i << " in "
-                << processors_[i]->Name() << "." << std::endl;
-        return false;
+  }
+  auto run_processors = [&](size_t begin, size_t end) {
+    return ParallelFor(images->size(), [&](size_t i) {
+      for (size_t j = begin; j < end; ++j) {
+        if (!(*(processors_[j].get()))(&((*images)[i]))) {
+          FDERROR << "Failed to processs image:" << i << " in "
+                  << processors_[j]->Name() << "." << std::endl;
+          return false;
+        }
+        if (processors_[j]->Name().find("Resize") != std::string::npos) {
+          scale_factor_ptr[2 * i] =
+              (*images)[i].Height() * 1.0 / origin_hw[i][0];
+          scale_factor_ptr[2 * i + 1] =
+              (*images)[i].Width() * 1.0 / origin_hw[i][1];
+        }
+      }
+      return true;
+    });
+  };
+  size_t num_processors = processors_.size();
+  size_t num_held = num_processors > 0 ? 1 : 0;
+  if (!run_processors(0, num_processors - num_held)) {
+    return false;
+  }
+  auto update_im_shape = [&]() {
+    max_hw = {-1, -1};
+    for (size_t i = 0; i < images->size(); ++i) {
+      if ((*images)[i].Height() > max_hw[0]) {
+        max_hw[0] = (*images)[i].Height();
       }
-      if (processors_[j]->Name().find("Resize") != std::string::npos) {
-        scale_factor_ptr[2 * i] = (*images)[i].Height() * 1.0 / origin_h;
-        scale_factor_ptr[2 * i + 1] = (*images)[i].Width() * 1.0 / origin_w;
+      if ((*images)[i].Width() > max_hw[1]) {
+        max_hw[1] = (*images)[i].Width();
       }
+      im_shape_ptr[2 * i] = max_hw[0];
+      im_shape_ptr[2 * i + 1] = max_hw[1];
     }
-    if ((*images)[i].Height() > max_hw[0]) {
-      max_hw[0] = (*images)[i].Height();
+  };
+  if (num_held > 0) {
+    // The permute processor keeps the size of the images, and writes them
+    // into their slots of the batch tensor with the padding filled in place
+    update_im_shape();
+    int channels = (*images)[0].Channels();
+    if (WriteToBatchTensor(processors_.back().get(), image_batch, max_hw[0],
+                           max_hw[1], std::vector<float>(channels, 0.0f),
+                           &((*outputs)[0]))) {
+      return true;
     }
-    if ((*images)[i].Width() > max_hw[1]) {
-      max_hw[1] = (*images)[i].Width();
+    if (!run_processors(num_processors - 1, num_processors)) {
+      return false;
     }
-    im_shape_ptr[2 * i] = max_hw[0];
-    im_shape_ptr[2 * i + 1] = max_hw[1];
   }
+  update_im_shape();
 
   // Concat all the preprocessed data to a batch tensor
   std::vector<FDTensor> im_tensors(images->size());
@@ -205,6 +252,55 @@ bool PaddleDetPreprocessor::Run(std::vector<FDMat>* images,
 
   return true;
 }
+bool PaddleDetPreprocessor::RunFusedPipeline(std::vector<FDMat>* images,
+                                             std::vector<FDTensor>* outputs) {
+  auto* scale_factor_ptr =
+      reinterpret_cast<float*>((*outputs)[1].MutableData());
+  auto* im_shape_ptr = reinterpret_cast<float*>((*outputs)[2].MutableData());
+  std::vector<int> max_hw({-1, -1});
+  std::vector<std::array<int, 2>> out_hw(images->size());
+  for (size_t i = 0; i < images->size(); ++i) {
+    int origin_w = (*images)[i].Width();
+    int origin_h = (*images)[i].Height();
+    int resized_w = 0;
+    int resized_h = 0;
+    if (!fused_pipeline_->InferShape(origin_w, origin_h, &resized_w,
+                                     &resized_h, &out_hw[i][1],
+                                     &out_hw[i][0])) {
+      FDERROR << "Failed to processs image:" << i << " in fused pipeline."
+              << std::endl;
+      return false;
+    }
+    scale_factor_ptr[2 * i] = resized_h * 1.0 / origin_h;
+    scale_factor_ptr[2 * i + 1] = resized_w * 1.0 / origin_w;
+    max_hw[0] = std::max(max_hw[0], out_hw[i][0]);
+    max_hw[1] = std::max(max_hw[1], out_hw[i][1]);
+    im_shape_ptr[2 * i] = max_hw[0];
+    im_shape_ptr[2 * i + 1] = max_hw[1];
+  }
+
+  // Write every image into its slot of the batch tensor, the images smaller
+  // than max_hw are padded with 0
+  int channels = fused_pipeline_->Channels();
+  int batch = static_cast<int>(images->size());
+  (*outputs)[0].Resize({batch, channels, max_hw[0], max_hw[1]},
+                       FDDataType::FP32, (*outputs)[0].name, Device::CPU);
+  float* data = reinterpret_cast<float*>((*outputs)[0].MutableData());
+  size_t image_size = static_cast<size_t>(channels) * max_hw[0] * max_hw[1];
+  return ParallelFor(images->size(), [&](size_t i) {
+    float* dst = data + i * image_size;
+    if (out_hw[i][0] < max_hw[0] || out_hw[i][1] < max_hw[1]) {
+      std::fill(dst, dst + image_size, 0.0f);
+    }
+    if (!fused_pipeline_->Run(&((*images)[i]), dst, max_hw[0], max_hw[1])) {
+      FDERROR << "Failed to processs image:" << i << " in fused pipeline."
+              << std::endl;
+      return false;
+    }
+    return true;
+  });
+}
+
 void PaddleDetPreprocessor::DisableNormalize() {
   this->disable_normalize_ = true;
   // the DisableNormalize function will be invalid if the configuration file is
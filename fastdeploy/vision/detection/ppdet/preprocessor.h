@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include "fastdeploy/vision/common/processors/manager.h"
 #include "fastdeploy/vision/common/processors/transform.h"
 #include "fastdeploy/vision/common/result.h"
 
@@ -22,7 +23,7 @@ namespace vision {
 namespace detection {
 /*! @brief Preprocessor object for PaddleDet serials model.
  */
-class FASTDEPLOY_DECL PaddleDetPreprocessor {
+class FASTDEPLOY_DECL PaddleDetPreprocessor : public ProcessorManager {
  public:
   PaddleDetPreprocessor() = default;
   /** \brief Create a preprocessor instance for PaddleDet serials model
@@ -33,11 +34,11 @@ class FASTDEPLOY_DECL PaddleDetPreprocessor {
 
   /** \brief Process the input image and prepare input tensors for runtime
    *
-   * \param[in] images The input image data list, all the elements are returned by cv::imread()
+   * \param[in] image_batch The input image batch
    * \param[in] outputs The output tensors which will feed in runtime, include image, scale_factor, im_shape
    * \return true if the preprocess successed, otherwise false
    */
-  bool Run(std::vector<FDMat>* images, std::vector<FDTensor>* outputs);
+  virtual bool Apply(FDMatBatch* image_batch, std::vector<FDTensor>* outputs);
 
   /// This function will disable normalize in preprocessing step.
   void DisableNormalize();
@@ -46,8 +47,12 @@ class FASTDEPLOY_DECL PaddleDetPreprocessor {
 
  private:
   bool BuildPreprocessPipelineFromConfig();
+  // Parse the processors of the config, before fusion
+  bool ParseConfig(std::vector<std::shared_ptr<Processor>>* processors) const;
+  bool RunFusedPipeline(std::vector<FDMat>* images,
+                        std::vector<FDTensor>* outputs);
+  // The processors of the plan, shared with the other preprocessors
   std::vector<std::shared_ptr<Processor>> processors_;
-  bool initialized_ = false;
   // for recording the switch of hwc2chw
   bool disable_permute_ = false;
   // for recording the switch of normalize
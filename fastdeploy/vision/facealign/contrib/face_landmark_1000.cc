@@ -103,6 +103,7 @@ bool FaceLandmark1000::Postprocess(
 }
 
 bool FaceLandmark1000::Predict(cv::Mat* im, FaceAlignmentResult* result) {
+  PredictScope predict_scope(this);
   Mat mat(*im);
   std::vector<FDTensor> input_tensors(1);
 
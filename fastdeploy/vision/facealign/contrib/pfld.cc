@@ -105,6 +105,7 @@ bool PFLD::Postprocess(FDTensor& infer_result, FaceAlignmentResult* result,
 }
 
 bool PFLD::Predict(cv::Mat* im, FaceAlignmentResult* result) {
+  PredictScope predict_scope(this);
   Mat mat(*im);
   std::vector<FDTensor> input_tensors(1);
 
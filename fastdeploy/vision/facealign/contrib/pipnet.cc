@@ -655,6 +655,7 @@ bool PIPNet::Postprocess(
 }
 
 bool PIPNet::Predict(cv::Mat* im, FaceAlignmentResult* result) {
+  PredictScope predict_scope(this);
   Mat mat(*im);
   std::vector<FDTensor> input_tensors(1);
 
@@ -257,6 +257,7 @@ bool RetinaFace::Postprocess(
 
 bool RetinaFace::Predict(cv::Mat* im, FaceDetectionResult* result,
                          float conf_threshold, float nms_iou_threshold) {
+  PredictScope predict_scope(this);
   Mat mat(*im);
   std::vector<FDTensor> input_tensors(1);
 
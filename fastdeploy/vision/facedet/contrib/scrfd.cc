@@ -340,6 +340,7 @@ bool SCRFD::Postprocess(
 
 bool SCRFD::Predict(cv::Mat* im, FaceDetectionResult* result,
                     float conf_threshold, float nms_iou_threshold) {
+  PredictScope predict_scope(this);
   Mat mat(*im);
   std::vector<FDTensor> input_tensors(1);
 
@@ -168,6 +168,7 @@ bool UltraFace::Postprocess(
 
 bool UltraFace::Predict(cv::Mat* im, FaceDetectionResult* result,
                         float conf_threshold, float nms_iou_threshold) {
+  PredictScope predict_scope(this);
   Mat mat(*im);
   std::vector<FDTensor> input_tensors(1);
 
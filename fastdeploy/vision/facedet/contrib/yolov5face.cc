@@ -250,6 +250,7 @@ bool YOLOv5Face::Postprocess(
 
 bool YOLOv5Face::Predict(cv::Mat* im, FaceDetectionResult* result,
                          float conf_threshold, float nms_iou_threshold) {
+  PredictScope predict_scope(this);
   Mat mat(*im);
   std::vector<FDTensor> input_tensors(1);
 
@@ -59,6 +59,7 @@ bool YOLOv7Face::Predict(const cv::Mat& im, FaceDetectionResult* result){
 
 bool YOLOv7Face::BatchPredict(const std::vector<cv::Mat>& images,
                               std::vector<FaceDetectionResult>* results){
+  PredictScope predict_scope(this);
   std::vector<FDMat> fd_images = WrapMat(images);
   FDASSERT(images.size() == 1, "Only support batch = 1 now.");
   std::vector<std::map<std::string, std::array<float, 2>>> ims_info;
@@ -56,6 +56,7 @@ bool BlazeFace::Predict(const cv::Mat& im, FaceDetectionResult* result){
 
 bool BlazeFace::BatchPredict(const std::vector<cv::Mat>& images,
                               std::vector<FaceDetectionResult>* results){
+  PredictScope predict_scope(this);
   std::vector<FDMat> fd_images = WrapMat(images);
   FDASSERT(images.size() == 1, "Only support batch = 1 now.");
   std::vector<std::map<std::string, std::array<float, 2>>> ims_info;
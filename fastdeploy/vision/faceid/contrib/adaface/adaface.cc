@@ -59,6 +59,7 @@ bool AdaFace::Predict(const cv::Mat& im,
 
 bool AdaFace::BatchPredict(const std::vector<cv::Mat>& images,
                            std::vector<FaceRecognitionResult>* results){
+  PredictScope predict_scope(this);
   std::vector<FDMat> fd_images = WrapMat(images);
   FDASSERT(images.size() == 1, "Only support batch = 1 now.");
   if (!preprocessor_.Run(&fd_images, &reused_input_tensors_)) {
@@ -58,6 +58,7 @@ bool InsightFaceRecognitionBase::Predict(const cv::Mat& im,
 bool InsightFaceRecognitionBase::BatchPredict(
     const std::vector<cv::Mat>& images,
     std::vector<FaceRecognitionResult>* results) {
+  PredictScope predict_scope(this);
   std::vector<FDMat> fd_images = WrapMat(images);
   FDASSERT(images.size() == 1, "Only support batch = 1 now.");
   if (!preprocessor_.Run(&fd_images, &reused_input_tensors_)) {
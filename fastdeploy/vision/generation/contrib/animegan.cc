@@ -53,6 +53,7 @@ bool AnimeGAN::Predict(cv::Mat& img, cv::Mat* result) {
 }
 
 bool AnimeGAN::BatchPredict(const std::vector<cv::Mat>& images, std::vector<cv::Mat>* results) {
+  PredictScope predict_scope(this);
   std::vector<FDMat> fd_images = WrapMat(images);
   std::vector<FDTensor> processed_data(1);
   if (!preprocessor_.Run(fd_images, &(processed_data))) {
@@ -100,6 +100,7 @@ bool FSANet::Postprocess(FDTensor& infer_result, HeadPoseResult* result,
 }
 
 bool FSANet::Predict(cv::Mat* im, HeadPoseResult* result) {
+  PredictScope predict_scope(this);
   Mat mat(*im);
   std::vector<FDTensor> input_tensors(1);
 
@@ -179,6 +179,7 @@ bool PPTinyPose::Postprocess(std::vector<FDTensor>& infer_result,
 }
 
 bool PPTinyPose::Predict(cv::Mat* im, KeyPointDetectionResult* result) {
+  PredictScope predict_scope(this);
   std::vector<float> center = {round(im->cols / 2.0f), round(im->rows / 2.0f)};
   std::vector<float> scale = {static_cast<float>(im->cols),
                               static_cast<float>(im->rows)};
@@ -206,6 +207,7 @@ bool PPTinyPose::Predict(cv::Mat* im, KeyPointDetectionResult* result) {
 
 bool PPTinyPose::Predict(cv::Mat* im, KeyPointDetectionResult* result,
                          const DetectionResult& detection_result) {
+  PredictScope predict_scope(this);
   std::vector<Mat> crop_imgs;
   std::vector<std::vector<float>> center_bs;
   std::vector<std::vector<float>> scale_bs;
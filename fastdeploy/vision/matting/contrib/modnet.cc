@@ -124,6 +124,7 @@ bool MODNet::Postprocess(
 }
 
 bool MODNet::Predict(cv::Mat* im, MattingResult* result) {
+  PredictScope predict_scope(this);
   Mat mat(*im);
   std::vector<FDTensor> input_tensors(1);
 
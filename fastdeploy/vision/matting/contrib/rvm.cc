@@ -144,6 +144,7 @@ bool RobustVideoMatting::Postprocess(
 }
 
 bool RobustVideoMatting::Predict(cv::Mat* im, MattingResult* result) {
+  PredictScope predict_scope(this);
   Mat mat(*im);
   int inputs_nums = NumInputsOfRuntime();
   std::vector<FDTensor> input_tensors(inputs_nums);
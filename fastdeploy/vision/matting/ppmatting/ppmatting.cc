@@ -205,6 +205,7 @@ bool PPMatting::Postprocess(
 }
 
 bool PPMatting::Predict(cv::Mat* im, MattingResult* result) {
+  PredictScope predict_scope(this);
   Mat mat(*im);
   std::vector<FDTensor> processed_data(1);
 
@@ -79,6 +79,7 @@ bool Classifier::BatchPredict(const std::vector<cv::Mat>& images,
 bool Classifier::BatchPredict(const std::vector<cv::Mat>& images,
                               std::vector<int32_t>* cls_labels, std::vector<float>* cls_scores,
                               size_t start_index, size_t end_index) {
+  PredictScope predict_scope(this);
   size_t total_size = images.size();
   std::vector<FDMat> fd_images = WrapMat(images);
   if (!preprocessor_.Run(&fd_images, &reused_input_tensors_, start_index, end_index)) {
@@ -71,6 +71,7 @@ bool DBDetector::Predict(const cv::Mat& img,
 
 bool DBDetector::BatchPredict(const std::vector<cv::Mat>& images,
                               std::vector<std::vector<std::array<int, 8>>>* det_results) {
+  PredictScope predict_scope(this);
   std::vector<FDMat> fd_images = WrapMat(images);
   std::vector<std::array<int, 4>> batch_det_img_info;
   if (!preprocessor_.Run(&fd_images, &reused_input_tensors_, &batch_det_img_info)) {
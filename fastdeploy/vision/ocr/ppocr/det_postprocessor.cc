@@ -14,16 +14,39 @@
 
 #include "fastdeploy/vision/ocr/ppocr/det_postprocessor.h"
 #include "fastdeploy/utils/perf.h"
+#include "fastdeploy/vision/ocr/ppocr/utils/db_postprocess.h"
 #include "fastdeploy/vision/ocr/ppocr/utils/ocr_utils.h"
 
 namespace fastdeploy {
 namespace vision {
 namespace ocr {
 
+void DBDetectorPostprocessor::SetThreadNum(int thread_num) {
+  FDASSERT(thread_num > 0, "The thread_num should be > 0, but now it's %d.",
+           thread_num);
+  if (thread_num == 1) {
+    task_pool_.reset();
+  } else if (thread_num != GetThreadNum()) {
+    task_pool_ = std::make_shared<TaskPool>(thread_num);
+  }
+}
+
 bool DBDetectorPostprocessor::SingleBatchPostprocessor(
     const float* out_data, int n2, int n3,
     const std::array<int, 4>& det_img_info,
     std::vector<std::array<int, 8>>* boxes_result) {
+  if (use_fast_postprocess_) {
+    DBPostprocessParams params;
+    params.thresh = det_db_thresh_;
+    params.box_thresh = det_db_box_thresh_;
+    params.unclip_ratio = det_db_unclip_ratio_;
+    params.slow_score = det_db_score_mode_ == "slow";
+    params.use_dilation = use_dilation_;
+    DBPostprocess(out_data, n2, n3, params, det_img_info, boxes_result,
+                  task_pool_.get());
+    return true;
+  }
+
   int n = n2 * n3;
 
   // prepare bitmap
@@ -84,11 +107,19 @@ bool DBDetectorPostprocessor::Run(
   const float* tensor_data = reinterpret_cast<const float*>(tensor.Data());
 
   results->resize(batch);
-  for (int i_batch = 0; i_batch < batch; ++i_batch) {
-    SingleBatchPostprocessor(tensor_data, tensor.shape[2], tensor.shape[3],
-                             batch_det_img_info[i_batch],
-                             &results->at(i_batch));
-    tensor_data = tensor_data + length;
+  auto process = [&](size_t i_batch) {
+    results->at(i_batch).clear();
+    return SingleBatchPostprocessor(
+        tensor_data + i_batch * length, tensor.shape[2], tensor.shape[3],
+        batch_det_img_info[i_batch], &results->at(i_batch));
+  };
+  if (task_pool_ != nullptr && batch > 1) {
+    return task_pool_->ParallelFor(batch, process);
+  }
+  for (size_t i_batch = 0; i_batch < batch; ++i_batch) {
+    if (!process(i_batch)) {
+      return false;
+    }
   }
   return true;
 }
@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #pragma once
+#include <memory>
+
+#include "fastdeploy/utils/task_pool.h"
 #include "fastdeploy/vision/common/processors/transform.h"
 #include "fastdeploy/vision/common/result.h"
 #include "fastdeploy/vision/ocr/ppocr/utils/ocr_postprocess_op.h"
@@ -67,6 +70,28 @@ class FASTDEPLOY_DECL DBDetectorPostprocessor {
   /// Get use_dilation of the detection postprocess
   int GetUseDilation() const { return use_dilation_; }
 
+  /** \brief Set whether to use the fast engine of the detection postprocess, default is false
+   *
+   * The fast engine labels the regions of the bitmap by runs in a single scan, scores them by the prefix sums of the rows and expands the boxes analytically, see DBPostprocess() for the differences from the OpenCV contours
+   *
+   * \param[in] use_fast_postprocess Whether to use the fast engine
+   */
+  void SetUseFastPostprocess(bool use_fast_postprocess) {
+    use_fast_postprocess_ = use_fast_postprocess;
+  }
+  /// Get use_fast_postprocess of the detection postprocess
+  bool GetUseFastPostprocess() const { return use_fast_postprocess_; }
+
+  /** \brief Set the number of threads processing the images of a batch in parallel, the regions of an image are processed in parallel as well by the fast engine
+   *
+   * \param[in] thread_num The number of threads, should be > 0
+   */
+  void SetThreadNum(int thread_num);
+
+  /// Get the number of threads of the detection postprocess
+  int GetThreadNum() const {
+    return task_pool_ == nullptr ? 1 : task_pool_->NumThreads();
+  }
 
  private:
   double det_db_thresh_ = 0.3;
@@ -74,7 +99,11 @@ class FASTDEPLOY_DECL DBDetectorPostprocessor {
   double det_db_unclip_ratio_ = 1.5;
   std::string det_db_score_mode_ = "slow";
   bool use_dilation_ = false;
+  bool use_fast_postprocess_ = false;
   PostProcessor util_post_processor_;
+  // Shared by the cloned postprocessors as well, TaskPool allows concurrent
+  // ParallelFor() calls
+  std::shared_ptr<TaskPool> task_pool_;
   bool SingleBatchPostprocessor(const float* out_data, int n2, int n3,
                                 const std::array<int, 4>& det_img_info,
                                 std::vector<std::array<int, 8>>* boxes_result);
@@ -49,6 +49,8 @@ void BindPPOCRModel(pybind11::module& m) {
       .def_property("det_db_unclip_ratio", &vision::ocr::DBDetectorPostprocessor::GetDetDBUnclipRatio, &vision::ocr::DBDetectorPostprocessor::SetDetDBUnclipRatio) 
       .def_property("det_db_score_mode", &vision::ocr::DBDetectorPostprocessor::GetDetDBScoreMode, &vision::ocr::DBDetectorPostprocessor::SetDetDBScoreMode) 
       .def_property("use_dilation", &vision::ocr::DBDetectorPostprocessor::GetUseDilation, &vision::ocr::DBDetectorPostprocessor::SetUseDilation) 
+      .def_property("use_fast_postprocess", &vision::ocr::DBDetectorPostprocessor::GetUseFastPostprocess, &vision::ocr::DBDetectorPostprocessor::SetUseFastPostprocess)
+      .def_property("thread_num", &vision::ocr::DBDetectorPostprocessor::GetThreadNum, &vision::ocr::DBDetectorPostprocessor::SetThreadNum)
 
       .def("run", [](vision::ocr::DBDetectorPostprocessor& self,
                      std::vector<FDTensor>& inputs,
@@ -174,6 +176,7 @@ void BindPPOCRModel(pybind11::module& m) {
     .def_property("mean", &vision::ocr::RecognizerPreprocessor::GetMean, &vision::ocr::RecognizerPreprocessor::SetMean)
     .def_property("scale", &vision::ocr::RecognizerPreprocessor::GetScale, &vision::ocr::RecognizerPreprocessor::SetScale)
     .def_property("is_scale", &vision::ocr::RecognizerPreprocessor::GetIsScale, &vision::ocr::RecognizerPreprocessor::SetIsScale)
+    .def_property("thread_num", &vision::ocr::RecognizerPreprocessor::GetThreadNum, &vision::ocr::RecognizerPreprocessor::SetThreadNum)
     .def("run", [](vision::ocr::RecognizerPreprocessor& self, std::vector<pybind11::array>& im_list) {
       std::vector<vision::FDMat> images;
       for (size_t i = 0; i < im_list.size(); ++i) {
@@ -191,6 +194,10 @@ void BindPPOCRModel(pybind11::module& m) {
 
   pybind11::class_<vision::ocr::RecognizerPostprocessor>(m, "RecognizerPostprocessor")
       .def(pybind11::init<std::string>())
+      .def_property("thread_num", &vision::ocr::RecognizerPostprocessor::GetThreadNum,
+                    &vision::ocr::RecognizerPostprocessor::SetThreadNum)
+      .def_property("beam_size", &vision::ocr::RecognizerPostprocessor::GetBeamSize,
+                    &vision::ocr::RecognizerPostprocessor::SetBeamSize)
       .def("run", [](vision::ocr::RecognizerPostprocessor& self,
                      std::vector<FDTensor>& inputs) {
         std::vector<std::string> texts;
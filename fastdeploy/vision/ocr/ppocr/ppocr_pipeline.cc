@@ -0,0 +1,328 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fastdeploy/vision/ocr/ppocr/ppocr_pipeline.h"
+
+#include <algorithm>
+
+#include "fastdeploy/vision/ocr/ppocr/utils/ocr_utils.h"
+
+namespace fastdeploy {
+namespace pipeline {
+
+PPOCRPipeline::PPOCRPipeline(const PPOCRv2& ocr,
+                             const PPOCRPipelineOption& option)
+    : option_(option),
+      det_queue_(option.queue_capacity),
+      crop_queue_(option.queue_capacity),
+      cls_queue_(option.queue_capacity),
+      rec_queue_(option.queue_capacity) {
+  option_.det_batch_size = std::max(option_.det_batch_size, 1);
+  option_.max_delay_us = std::max(option_.max_delay_us, 0);
+  // The batch size -1 runs all the boxes of an image in one batch, it's
+  // bounded by the queue in the pipeline
+  cls_batch_size_ = ocr.cls_batch_size_ > 0
+                        ? static_cast<size_t>(ocr.cls_batch_size_)
+                        : cls_queue_.Capacity();
+  rec_batch_size_ = ocr.rec_batch_size_ > 0
+                        ? static_cast<size_t>(ocr.rec_batch_size_)
+                        : rec_queue_.Capacity();
+  rec_padding_budget_ = ocr.rec_padding_budget_;
+  use_fused_rec_crop_ = ocr.use_fused_rec_crop_;
+  detector_ = ocr.detector_->Clone();
+  if (ocr.classifier_ != nullptr) {
+    classifier_ = ocr.classifier_->Clone();
+  }
+  recognizer_ = ocr.recognizer_->Clone();
+  if (!Initialized()) {
+    FDERROR << "Failed to clone the models of PPOCR for the pipeline."
+            << std::endl;
+    return;
+  }
+  workers_.emplace_back(&PPOCRPipeline::DetectLoop, this);
+  workers_.emplace_back(&PPOCRPipeline::CropLoop, this);
+  if (classifier_ != nullptr) {
+    workers_.emplace_back(&PPOCRPipeline::ClassifyLoop, this);
+  }
+  workers_.emplace_back(&PPOCRPipeline::RecognizeLoop, this);
+}
+
+PPOCRPipeline::~PPOCRPipeline() {
+  // Every stage closes the queue of the next stage once it's drained
+  det_queue_.Close();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+bool PPOCRPipeline::Initialized() const {
+  if (detector_ == nullptr || !detector_->Initialized()) {
+    return false;
+  }
+  if (classifier_ != nullptr && !classifier_->Initialized()) {
+    return false;
+  }
+  if (recognizer_ == nullptr || !recognizer_->Initialized()) {
+    return false;
+  }
+  return true;
+}
+
+std::future<bool> PPOCRPipeline::PredictAsync(
+    const cv::Mat& img, fastdeploy::vision::OCRResult* result) {
+  auto request = std::make_shared<Request>();
+  request->image = img;
+  request->result = result;
+  std::future<bool> future = request->promise.get_future();
+  if (workers_.empty()) {
+    FDERROR << "The pipeline is not initialized." << std::endl;
+    request->promise.set_value(false);
+    return future;
+  }
+  result->Clear();
+  if (!det_queue_.Push(std::move(request))) {
+    FDERROR << "The pipeline is stopped." << std::endl;
+    request->promise.set_value(false);
+  }
+  return future;
+}
+
+bool PPOCRPipeline::Predict(const cv::Mat& img,
+                            fastdeploy::vision::OCRResult* result) {
+  return PredictAsync(img, result).get();
+}
+
+bool PPOCRPipeline::BatchPredict(
+    const std::vector<cv::Mat>& images,
+    std::vector<fastdeploy::vision::OCRResult>* batch_result) {
+  batch_result->clear();
+  batch_result->resize(images.size());
+  std::vector<std::future<bool>> futures;
+  futures.reserve(images.size());
+  for (size_t i = 0; i < images.size(); ++i) {
+    futures.push_back(PredictAsync(images[i], &(*batch_result)[i]));
+  }
+  bool success = true;
+  for (auto& future : futures) {
+    success = future.get() && success;
+  }
+  return success;
+}
+
+PPOCRPipelineStats PPOCRPipeline::GetStats() const {
+  PPOCRPipelineStats stats;
+  stats.num_images = num_images_.load();
+  stats.num_boxes = num_boxes_.load();
+  stats.num_cls_batches = num_cls_batches_.load();
+  stats.num_rec_batches = num_rec_batches_.load();
+  return stats;
+}
+
+void PPOCRPipeline::FinishBox(const Box& box, bool success) {
+  if (!success) {
+    box.request->failed = true;
+  }
+  if (box.request->remaining.fetch_sub(1) == 1) {
+    box.request->promise.set_value(!box.request->failed);
+  }
+}
+
+void PPOCRPipeline::DetectLoop() {
+  std::vector<std::shared_ptr<Request>> requests;
+  std::vector<cv::Mat> images;
+  std::vector<std::vector<std::array<int, 8>>> batch_boxes;
+  // The images are detected as soon as they arrive, only the queued ones
+  // are batched
+  while (det_queue_.PopBatch(&requests, option_.det_batch_size,
+                             std::chrono::microseconds(0)) > 0) {
+    for (auto& request : requests) {
+      images.push_back(request->image);
+    }
+    batch_boxes.clear();
+    if (!detector_->BatchPredict(images, &batch_boxes)) {
+      FDERROR << "There's error while detecting image in PPOCR." << std::endl;
+      for (auto& request : requests) {
+        request->promise.set_value(false);
+      }
+    } else {
+      for (size_t i = 0; i < requests.size(); ++i) {
+        vision::ocr::SortBoxes(&batch_boxes[i]);
+        requests[i]->result->boxes = std::move(batch_boxes[i]);
+        crop_queue_.Push(std::move(requests[i]));
+      }
+    }
+    num_images_ += requests.size();
+    requests.clear();
+    images.clear();
+  }
+  crop_queue_.Close();
+}
+
+void PPOCRPipeline::CropLoop() {
+  auto& next_queue = classifier_ != nullptr ? cls_queue_ : rec_queue_;
+  std::shared_ptr<Request> request;
+  while (crop_queue_.Pop(&request)) {
+    fastdeploy::vision::OCRResult* result = request->result;
+    const std::vector<std::array<int, 8>>& boxes = result->boxes;
+    // The whole image is recognized if there's no box, as PPOCRv2
+    size_t num_boxes = std::max<size_t>(boxes.size(), 1);
+    if (classifier_ != nullptr) {
+      result->cls_labels.resize(num_boxes);
+      result->cls_scores.resize(num_boxes);
+    }
+    result->text.resize(num_boxes);
+    result->rec_scores.resize(num_boxes);
+    request->remaining = static_cast<int>(num_boxes);
+    num_boxes_ += num_boxes;
+    for (size_t i = 0; i < num_boxes; ++i) {
+      Box box;
+      box.request = request;
+      box.index = i;
+      if (!use_fused_rec_crop_ || classifier_ != nullptr) {
+        box.image = boxes.empty()
+                        ? request->image
+                        : vision::ocr::GetRotateCropImage(request->image,
+                                                          boxes[i]);
+      }
+      if (use_fused_rec_crop_) {
+        if (boxes.empty()) {
+          box.crop.image = &request->image;
+          box.crop.width = request->image.cols;
+          box.crop.height = request->image.rows;
+        } else {
+          box.crop = vision::ocr::GetRotateCrop(request->image, boxes[i]);
+        }
+      }
+      next_queue.Push(std::move(box));
+    }
+    request.reset();
+  }
+  next_queue.Close();
+}
+
+void PPOCRPipeline::ClassifyLoop() {
+  std::vector<Box> boxes;
+  std::vector<cv::Mat> images;
+  std::vector<int32_t> cls_labels;
+  std::vector<float> cls_scores;
+  float cls_thresh = classifier_->GetPostprocessor().GetClsThresh();
+  while (cls_queue_.PopBatch(&boxes, cls_batch_size_,
+                             std::chrono::microseconds(option_.max_delay_us)) >
+         0) {
+    for (auto& box : boxes) {
+      images.push_back(box.image);
+    }
+    if (!classifier_->BatchPredict(images, &cls_labels, &cls_scores)) {
+      FDERROR << "There's error while classifying image in PPOCR."
+              << std::endl;
+      for (auto& box : boxes) {
+        FinishBox(box, false);
+      }
+    } else {
+      for (size_t i = 0; i < boxes.size(); ++i) {
+        fastdeploy::vision::OCRResult* result = boxes[i].request->result;
+        result->cls_labels[boxes[i].index] = cls_labels[i];
+        result->cls_scores[boxes[i].index] = cls_scores[i];
+        if (cls_labels[i] % 2 == 1 && cls_scores[i] > cls_thresh) {
+          if (use_fused_rec_crop_) {
+            boxes[i].crop.Rotate180();
+          } else {
+            // Not rotated in place, the image without boxes is the input
+            cv::Mat rotated;
+            cv::rotate(boxes[i].image, rotated, 1);
+            boxes[i].image = rotated;
+          }
+        }
+        rec_queue_.Push(std::move(boxes[i]));
+      }
+    }
+    num_cls_batches_ += 1;
+    boxes.clear();
+    images.clear();
+  }
+  rec_queue_.Close();
+}
+
+void PPOCRPipeline::RecognizeLoop() {
+  std::vector<Box> boxes;
+  std::vector<cv::Mat> images;
+  std::vector<vision::ocr::RotateCrop> crops;
+  std::vector<float> wh_ratios;
+  std::vector<std::vector<int>> batches;
+  std::vector<std::string> texts;
+  std::vector<float> rec_scores;
+  std::vector<int> rec_image_shape =
+      recognizer_->GetPreprocessor().GetRecImageShape();
+  float min_wh_ratio = float(rec_image_shape[2]) / rec_image_shape[1];
+  // With the width buckets, a window of the queued boxes is popped and
+  // grouped into the batches of similar widths
+  bool width_buckets = rec_padding_budget_ >= 0;
+  size_t window = width_buckets ? rec_queue_.Capacity() : rec_batch_size_;
+  while (rec_queue_.PopBatch(&boxes, window,
+                             std::chrono::microseconds(option_.max_delay_us)) >
+         0) {
+    batches.clear();
+    if (width_buckets) {
+      wh_ratios.clear();
+      for (auto& box : boxes) {
+        wh_ratios.push_back(
+            use_fused_rec_crop_
+                ? float(box.crop.width) / box.crop.height
+                : float(box.image.cols) / box.image.rows);
+      }
+      batches = vision::ocr::BucketByWidth(wh_ratios, min_wh_ratio,
+                                           static_cast<int>(rec_batch_size_),
+                                           rec_padding_budget_);
+    } else {
+      batches.emplace_back(boxes.size());
+      for (size_t i = 0; i < boxes.size(); ++i) {
+        batches[0][i] = static_cast<int>(i);
+      }
+    }
+    for (const auto& batch : batches) {
+      images.clear();
+      crops.clear();
+      for (int index : batch) {
+        if (use_fused_rec_crop_) {
+          crops.push_back(boxes[index].crop);
+        } else {
+          images.push_back(boxes[index].image);
+        }
+      }
+      bool success =
+          use_fused_rec_crop_
+              ? recognizer_->BatchPredict(crops, &texts, &rec_scores, 0,
+                                          crops.size(), {})
+              : recognizer_->BatchPredict(images, &texts, &rec_scores);
+      if (!success) {
+        FDERROR << "There's error while recognizing image in PPOCR."
+                << std::endl;
+      }
+      for (size_t i = 0; i < batch.size(); ++i) {
+        const Box& box = boxes[batch[i]];
+        if (success) {
+          fastdeploy::vision::OCRResult* result = box.request->result;
+          result->text[box.index] = std::move(texts[i]);
+          result->rec_scores[box.index] = rec_scores[i];
+        }
+        FinishBox(box, success);
+      }
+      num_rec_batches_ += 1;
+    }
+    boxes.clear();
+  }
+}
+
+}  // namespace pipeline
+}  // namespace fastdeploy
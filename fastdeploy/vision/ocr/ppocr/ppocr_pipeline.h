@@ -0,0 +1,159 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "fastdeploy/utils/blocking_queue.h"
+#include "fastdeploy/vision/ocr/ppocr/ppocr_v2.h"
+
+namespace fastdeploy {
+namespace pipeline {
+
+/*! @brief Option of PPOCRPipeline
+ */
+struct FASTDEPLOY_DECL PPOCRPipelineOption {
+  /// Max number of the images or boxes waiting between two stages, the upstream stage is blocked while the queue is full
+  int queue_capacity = 64;
+  /// Max number of the images detected in one batch
+  int det_batch_size = 1;
+  /// Max time in microseconds the classification and recognition stages wait for the boxes to fill a batch
+  int max_delay_us = 1000;
+};
+
+/*! @brief Statistics of the images run by PPOCRPipeline
+ */
+struct FASTDEPLOY_DECL PPOCRPipelineStats {
+  uint64_t num_images = 0;
+  uint64_t num_boxes = 0;
+  uint64_t num_cls_batches = 0;
+  uint64_t num_rec_batches = 0;
+
+  double AverageRecBatchSize() const {
+    return num_rec_batches == 0
+               ? 0.0
+               : static_cast<double>(num_boxes) / num_rec_batches;
+  }
+};
+
+/*! @brief Streaming executor of the PP-OCR models, running detection, cropping, classification and recognition as pipelined stages
+ *
+ * Every stage has its own worker thread and clone of the model, and the stages are connected by bounded queues, so the detection of an image overlaps with the cropping, classification and recognition of the former images. The classification and recognition batches are formed by the boxes of different images, so the throughput of a stream of images approaches the one of the slowest stage rather than the sum of all the stages. If the recognition padding budget of the PP-OCR models is set, the recognition stage groups the queued boxes into the batches of similar widths as well, and the fused rec crop of the PP-OCR models is followed too.
+ *
+ * example code @code
+ * fastdeploy::pipeline::PPOCRv3 ocr(&det_model, &cls_model, &rec_model);
+ * fastdeploy::pipeline::PPOCRPipeline pipeline(ocr);
+ * // Called from any number of threads
+ * fastdeploy::vision::OCRResult result;
+ * pipeline.Predict(image, &result);
+ * @endcode
+ */
+class FASTDEPLOY_DECL PPOCRPipeline {
+ public:
+  /** \brief Create the pipeline from the clones of the models of `ocr`
+   *
+   * \param[in] ocr The PP-OCR models, the classification and recognition batch sizes are taken from it as well
+   * \param[in] option Option of the pipeline
+   */
+  explicit PPOCRPipeline(const PPOCRv2& ocr,
+                         const PPOCRPipelineOption& option =
+                             PPOCRPipelineOption());
+
+  /// Finish all the queued images, then stop the stages
+  ~PPOCRPipeline();
+
+  PPOCRPipeline(const PPOCRPipeline&) = delete;
+  PPOCRPipeline& operator=(const PPOCRPipeline&) = delete;
+
+  /// Check if all the models are cloned successfully
+  bool Initialized() const;
+
+  /** \brief Queue an image and return the future of its result, blocked while the detection queue is full
+   *
+   * \param[in] img The input image data, the pixels are shared rather than copied, so they must not be modified until the result is done
+   * \param[in] result The output OCR result, must be kept alive until the result is done
+   * \return The future of the image, true if the prediction successed
+   */
+  std::future<bool> PredictAsync(const cv::Mat& img,
+                                 fastdeploy::vision::OCRResult* result);
+
+  /// Queue an image and wait for its result, can be called from multiple threads
+  bool Predict(const cv::Mat& img, fastdeploy::vision::OCRResult* result);
+
+  /** \brief Queue a list of images and wait for all the results
+   *
+   * \param[in] images The list of input image data, comes from cv::imread(), is a 3-D array with layout HWC, BGR format.
+   * \param[in] batch_result The output list of OCR result will be writen to this structure.
+   * \return true if the prediction of all the images successed, otherwise false.
+   */
+  bool BatchPredict(const std::vector<cv::Mat>& images,
+                    std::vector<fastdeploy::vision::OCRResult>* batch_result);
+
+  /// Get statistics of the images run by the pipeline
+  PPOCRPipelineStats GetStats() const;
+
+ private:
+  struct Request {
+    cv::Mat image;
+    fastdeploy::vision::OCRResult* result = nullptr;
+    std::promise<bool> promise;
+    // Number of the boxes not recognized yet
+    std::atomic<int> remaining{0};
+    std::atomic<bool> failed{false};
+  };
+  // A cropped box of an image
+  struct Box {
+    std::shared_ptr<Request> request;
+    size_t index = 0;
+    // The cropped image, it's only for classifier with the fused rec crop
+    cv::Mat image;
+    // Points to the image of the request, only with the fused rec crop
+    vision::ocr::RotateCrop crop;
+  };
+
+  void DetectLoop();
+  void CropLoop();
+  void ClassifyLoop();
+  void RecognizeLoop();
+  // Done with a box, the request is finished with its last box
+  static void FinishBox(const Box& box, bool success);
+
+  std::unique_ptr<fastdeploy::vision::ocr::DBDetector> detector_;
+  std::unique_ptr<fastdeploy::vision::ocr::Classifier> classifier_;
+  std::unique_ptr<fastdeploy::vision::ocr::Recognizer> recognizer_;
+  PPOCRPipelineOption option_;
+  size_t cls_batch_size_;
+  size_t rec_batch_size_;
+  float rec_padding_budget_;
+  bool use_fused_rec_crop_;
+
+  BlockingQueue<std::shared_ptr<Request>> det_queue_;
+  BlockingQueue<std::shared_ptr<Request>> crop_queue_;
+  BlockingQueue<Box> cls_queue_;
+  BlockingQueue<Box> rec_queue_;
+
+  std::atomic<uint64_t> num_images_{0};
+  std::atomic<uint64_t> num_boxes_{0};
+  std::atomic<uint64_t> num_cls_batches_{0};
+  std::atomic<uint64_t> num_rec_batches_{0};
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace pipeline
+}  // namespace fastdeploy
@@ -27,6 +27,8 @@ void BindPPOCRv3(pybind11::module& m) {
                           fastdeploy::vision::ocr::Recognizer*>())
       .def_property("cls_batch_size", &pipeline::PPOCRv3::GetClsBatchSize, &pipeline::PPOCRv3::SetClsBatchSize)
       .def_property("rec_batch_size", &pipeline::PPOCRv3::GetRecBatchSize, &pipeline::PPOCRv3::SetRecBatchSize)
+      .def_property("rec_padding_budget", &pipeline::PPOCRv3::GetRecPaddingBudget, &pipeline::PPOCRv3::SetRecPaddingBudget)
+      .def_property("use_fused_rec_crop", &pipeline::PPOCRv3::GetUseFusedRecCrop, &pipeline::PPOCRv3::SetUseFusedRecCrop)
       .def("clone", [](pipeline::PPOCRv3& self) {
         return self.Clone();
       })
@@ -59,6 +61,8 @@ void BindPPOCRv2(pybind11::module& m) {
                           fastdeploy::vision::ocr::Recognizer*>())
       .def_property("cls_batch_size", &pipeline::PPOCRv2::GetClsBatchSize, &pipeline::PPOCRv2::SetClsBatchSize)
       .def_property("rec_batch_size", &pipeline::PPOCRv2::GetRecBatchSize, &pipeline::PPOCRv2::SetRecBatchSize)
+      .def_property("rec_padding_budget", &pipeline::PPOCRv2::GetRecPaddingBudget, &pipeline::PPOCRv2::SetRecPaddingBudget)
+      .def_property("use_fused_rec_crop", &pipeline::PPOCRv2::GetUseFusedRecCrop, &pipeline::PPOCRv2::SetUseFusedRecCrop)
       .def("clone", [](pipeline::PPOCRv2& self) {
         return self.Clone();
       })
@@ -80,4 +84,58 @@ void BindPPOCRv2(pybind11::module& m) {
       });
 }
 
+void BindPPOCRPipeline(pybind11::module& m) {
+  pybind11::class_<pipeline::PPOCRPipelineOption>(m, "PPOCRPipelineOption")
+      .def(pybind11::init())
+      .def_readwrite("queue_capacity",
+                     &pipeline::PPOCRPipelineOption::queue_capacity)
+      .def_readwrite("det_batch_size",
+                     &pipeline::PPOCRPipelineOption::det_batch_size)
+      .def_readwrite("max_delay_us",
+                     &pipeline::PPOCRPipelineOption::max_delay_us);
+
+  pybind11::class_<pipeline::PPOCRPipelineStats>(m, "PPOCRPipelineStats")
+      .def_readonly("num_images", &pipeline::PPOCRPipelineStats::num_images)
+      .def_readonly("num_boxes", &pipeline::PPOCRPipelineStats::num_boxes)
+      .def_readonly("num_cls_batches",
+                    &pipeline::PPOCRPipelineStats::num_cls_batches)
+      .def_readonly("num_rec_batches",
+                    &pipeline::PPOCRPipelineStats::num_rec_batches)
+      .def("average_rec_batch_size",
+           &pipeline::PPOCRPipelineStats::AverageRecBatchSize);
+
+  pybind11::class_<pipeline::PPOCRPipeline>(m, "PPOCRPipeline")
+      .def(pybind11::init<const pipeline::PPOCRv2&,
+                          const pipeline::PPOCRPipelineOption&>())
+      .def(pybind11::init<const pipeline::PPOCRv3&,
+                          const pipeline::PPOCRPipelineOption&>())
+      .def("initialized", &pipeline::PPOCRPipeline::Initialized)
+      .def("predict",
+           [](pipeline::PPOCRPipeline& self, pybind11::array& data) {
+             auto mat = PyArrayToCvMat(data);
+             vision::OCRResult res;
+             {
+               // Let the other python threads feed the pipeline meanwhile
+               pybind11::gil_scoped_release release;
+               self.Predict(mat, &res);
+             }
+             return res;
+           })
+      .def("batch_predict",
+           [](pipeline::PPOCRPipeline& self,
+              std::vector<pybind11::array>& data) {
+             std::vector<cv::Mat> images;
+             for (size_t i = 0; i < data.size(); ++i) {
+               images.push_back(PyArrayToCvMat(data[i]));
+             }
+             std::vector<vision::OCRResult> results;
+             {
+               pybind11::gil_scoped_release release;
+               self.BatchPredict(images, &results);
+             }
+             return results;
+           })
+      .def("get_stats", &pipeline::PPOCRPipeline::GetStats);
+}
+
 }  // namespace fastdeploy
@@ -18,6 +18,18 @@
 
 namespace fastdeploy {
 namespace pipeline {
+namespace {
+
+float WidthHeightRatio(const cv::Mat& image) {
+  return float(image.cols) / image.rows;
+}
+
+float WidthHeightRatio(const vision::ocr::RotateCrop& crop) {
+  return float(crop.width) / crop.height;
+}
+
+}  // namespace
+
 PPOCRv2::PPOCRv2(fastdeploy::vision::ocr::DBDetector* det_model,
                              fastdeploy::vision::ocr::Classifier* cls_model,
                              fastdeploy::vision::ocr::Recognizer* rec_model)
@@ -63,6 +75,28 @@ int PPOCRv2::GetRecBatchSize() {
   return rec_batch_size_;
 }
 
+bool PPOCRv2::SetRecPaddingBudget(float padding_budget) {
+  if (padding_budget > 1.0f) {
+    FDERROR << "padding_budget <= 1.0, or padding_budget < 0 to disable "
+               "the width buckets." << std::endl;
+    return false;
+  }
+  rec_padding_budget_ = padding_budget;
+  return true;
+}
+
+float PPOCRv2::GetRecPaddingBudget() {
+  return rec_padding_budget_;
+}
+
+void PPOCRv2::SetUseFusedRecCrop(bool use_fused_rec_crop) {
+  use_fused_rec_crop_ = use_fused_rec_crop;
+}
+
+bool PPOCRv2::GetUseFusedRecCrop() {
+  return use_fused_rec_crop_;
+}
+
 bool PPOCRv2::Initialized() const {
   
   if (detector_ != nullptr && !detector_->Initialized()) {
@@ -110,6 +144,11 @@ bool PPOCRv2::BatchPredict(const std::vector<cv::Mat>& images,
   batch_result->clear();
   batch_result->resize(images.size());
   std::vector<std::vector<std::array<int, 8>>> batch_boxes(images.size());
+  // The crops of all the images are recognized together by width buckets
+  bool width_buckets = rec_padding_budget_ >= 0;
+  std::vector<cv::Mat> all_images;
+  std::vector<vision::ocr::RotateCrop> all_crops;
+  std::vector<std::pair<size_t, size_t>> crop_owners;
 
   if (!detector_->BatchPredict(images, &batch_boxes)) {
     FDERROR << "There's error while detecting image in PPOCR." << std::endl;
@@ -123,18 +162,38 @@ bool PPOCRv2::BatchPredict(const std::vector<cv::Mat>& images,
   
   for(int i_batch = 0; i_batch < images.size(); ++i_batch) {
     fastdeploy::vision::OCRResult& ocr_result = (*batch_result)[i_batch];
-    // Get croped images by detection result
+    // Get croped images by detection result. With the fused rec crop, the
+    // recognizer warps the boxes into its input tensor directly, so the
+    // images are only cropped for classifier
     const std::vector<std::array<int, 8>>& boxes = ocr_result.boxes;
     const cv::Mat& img = images[i_batch];
     std::vector<cv::Mat> image_list;
-    if (boxes.size() == 0) {
-      image_list.emplace_back(img);
-    }else{
-      image_list.resize(boxes.size());
-      for (size_t i_box = 0; i_box < boxes.size(); ++i_box) {
-        image_list[i_box] = vision::ocr::GetRotateCropImage(img, boxes[i_box]);
+    std::vector<vision::ocr::RotateCrop> crops;
+    if (!use_fused_rec_crop_ || nullptr != classifier_) {
+      if (boxes.size() == 0) {
+        image_list.emplace_back(img);
+      }else{
+        image_list.resize(boxes.size());
+        for (size_t i_box = 0; i_box < boxes.size(); ++i_box) {
+          image_list[i_box] = vision::ocr::GetRotateCropImage(img, boxes[i_box]);
+        }
+      }
+    }
+    if (use_fused_rec_crop_) {
+      if (boxes.size() == 0) {
+        vision::ocr::RotateCrop crop;
+        crop.image = &img;
+        crop.width = img.cols;
+        crop.height = img.rows;
+        crops.push_back(crop);
+      }else{
+        crops.resize(boxes.size());
+        for (size_t i_box = 0; i_box < boxes.size(); ++i_box) {
+          crops[i_box] = vision::ocr::GetRotateCrop(img, boxes[i_box]);
+        }
       }
     }
+    size_t num_crops = std::max<size_t>(boxes.size(), 1);
     std::vector<int32_t>* cls_labels_ptr = &ocr_result.cls_labels;
     std::vector<float>* cls_scores_ptr = &ocr_result.cls_scores;
 
@@ -150,25 +209,101 @@ bool PPOCRv2::BatchPredict(const std::vector<cv::Mat>& images,
         }else{
           for (size_t i_img = start_index; i_img < end_index; ++i_img) {
             if(cls_labels_ptr->at(i_img) % 2 == 1 && cls_scores_ptr->at(i_img) > classifier_->GetPostprocessor().GetClsThresh()) {
-              cv::rotate(image_list[i_img], image_list[i_img], 1);
+              if (use_fused_rec_crop_) {
+                crops[i_img].Rotate180();
+              } else {
+                cv::rotate(image_list[i_img], image_list[i_img], 1);
+              }
             }
           }
         }
       }
     }
 
-    std::vector<float> width_list;
-    for (int i = 0; i < image_list.size(); i++) {
-      width_list.push_back(float(image_list[i].cols) / image_list[i].rows);
+    if (width_buckets) {
+      text_ptr->resize(num_crops);
+      rec_scores_ptr->resize(num_crops);
+      for (size_t i_img = 0; i_img < num_crops; ++i_img) {
+        if (use_fused_rec_crop_) {
+          all_crops.push_back(crops[i_img]);
+        } else {
+          all_images.push_back(std::move(image_list[i_img]));
+        }
+        crop_owners.emplace_back(i_batch, i_img);
+      }
+      continue;
     }
-    std::vector<int> indices = vision::ocr::ArgSort(width_list);
 
-    for(size_t start_index = 0; start_index < image_list.size(); start_index+=rec_batch_size_) {
-      size_t end_index = std::min(start_index + rec_batch_size_, image_list.size());
-      if (!recognizer_->BatchPredict(image_list, text_ptr, rec_scores_ptr, start_index, end_index, indices)) {
-        FDERROR << "There's error while recognizing image in PPOCR." << std::endl;
-        return false;
-      }
+    bool success = use_fused_rec_crop_
+                       ? Recognize(crops, text_ptr, rec_scores_ptr)
+                       : Recognize(image_list, text_ptr, rec_scores_ptr);
+    if (!success) {
+      FDERROR << "There's error while recognizing image in PPOCR." << std::endl;
+      return false;
+    }
+  }
+  if (width_buckets) {
+    return use_fused_rec_crop_
+               ? RecognizeByWidthBuckets(all_crops, crop_owners, batch_result)
+               : RecognizeByWidthBuckets(all_images, crop_owners,
+                                         batch_result);
+  }
+  return true;
+}
+
+template <typename T>
+bool PPOCRv2::Recognize(const std::vector<T>& crops,
+                        std::vector<std::string>* texts,
+                        std::vector<float>* rec_scores) {
+  std::vector<float> width_list;
+  for (size_t i = 0; i < crops.size(); i++) {
+    width_list.push_back(WidthHeightRatio(crops[i]));
+  }
+  std::vector<int> indices = vision::ocr::ArgSort(width_list);
+
+  for(size_t start_index = 0; start_index < crops.size(); start_index+=rec_batch_size_) {
+    size_t end_index = std::min(start_index + rec_batch_size_, crops.size());
+    if (!recognizer_->BatchPredict(crops, texts, rec_scores, start_index, end_index, indices)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool PPOCRv2::RecognizeByWidthBuckets(
+    const std::vector<T>& crops,
+    const std::vector<std::pair<size_t, size_t>>& crop_owners,
+    std::vector<fastdeploy::vision::OCRResult>* batch_result) {
+  std::vector<float> wh_ratios(crops.size());
+  for (size_t i = 0; i < crops.size(); ++i) {
+    wh_ratios[i] = WidthHeightRatio(crops[i]);
+  }
+  std::vector<int> rec_image_shape =
+      recognizer_->GetPreprocessor().GetRecImageShape();
+  float min_wh_ratio = float(rec_image_shape[2]) / rec_image_shape[1];
+  std::vector<std::vector<int>> buckets = vision::ocr::BucketByWidth(
+      wh_ratios, min_wh_ratio, rec_batch_size_, rec_padding_budget_);
+
+  std::vector<T> bucket_crops;
+  std::vector<std::string> texts;
+  std::vector<float> rec_scores;
+  for (const auto& bucket : buckets) {
+    bucket_crops.clear();
+    for (int index : bucket) {
+      bucket_crops.push_back(crops[index]);
+    }
+    if (!recognizer_->BatchPredict(bucket_crops, &texts, &rec_scores, 0,
+                                   bucket_crops.size(), {})) {
+      FDERROR << "There's error while recognizing image in PPOCR." << std::endl;
+      return false;
+    }
+    // Scatter the texts back to the results of their images
+    for (size_t i = 0; i < bucket.size(); ++i) {
+      const auto& owner = crop_owners[bucket[i]];
+      fastdeploy::vision::OCRResult& ocr_result = (*batch_result)[owner.first];
+      ocr_result.text[owner.second] = std::move(texts[i]);
+      ocr_result.rec_scores[owner.second] = rec_scores[i];
     }
   }
   return true;
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <utility>
 #include <vector>
 
 #include "fastdeploy/fastdeploy_model.h"
@@ -31,6 +32,8 @@ namespace fastdeploy {
  *
  */
 namespace pipeline {
+class PPOCRPipeline;
+
 /*! @brief PPOCRv2 is used to load PP-OCRv2 series models provided by PaddleOCR.
  */
 class FASTDEPLOY_DECL PPOCRv2 : public FastDeployModel {
@@ -82,6 +85,23 @@ class FASTDEPLOY_DECL PPOCRv2 : public FastDeployModel {
   int GetClsBatchSize();
   bool SetRecBatchSize(int rec_batch_size);
   int GetRecBatchSize();
+  /** \brief Recognize the crops of all the images of BatchPredict() together, grouped into the batches of similar widths
+   *
+   * The recognizer pads all the crops of a batch to the widest one, so a long text line wastes the computation of the short ones in its batch. With the width buckets, the crops of all the images are sorted by width, and a new batch is started once the padded fraction of the batch would exceed the budget, or the batch is full of rec_batch_size crops.
+   *
+   * \param[in] padding_budget Max fraction of the padded area of a recognition batch in [0, 1], e.g 0.2, negative to disable the width buckets, default -1
+   * \return true if the budget is valid
+   */
+  bool SetRecPaddingBudget(float padding_budget);
+  float GetRecPaddingBudget();
+  /** \brief Warp the text boxes straight into the input tensor of the recognizer, instead of cropping, rotating and resizing them as images
+   *
+   * The default path interpolates a box twice, by the perspective warp and then cv::resize(), while the fused path samples the original image once, so the input of the recognizer is close to but not the same as the default one. The classifier still takes the cropped images
+   *
+   * \param[in] use_fused_rec_crop Whether to warp the boxes into the input tensor of the recognizer, default false
+   */
+  void SetUseFusedRecCrop(bool use_fused_rec_crop);
+  bool GetUseFusedRecCrop();
 
  protected:
   fastdeploy::vision::ocr::DBDetector* detector_ = nullptr;
@@ -89,8 +109,24 @@ class FASTDEPLOY_DECL PPOCRv2 : public FastDeployModel {
   fastdeploy::vision::ocr::Recognizer* recognizer_ = nullptr;
 
  private:
+  friend class PPOCRPipeline;
+  // Recognize the crops of an image in the batches of rec_batch_size, the
+  // crops are the cropped images or the RotateCrops
+  template <typename T>
+  bool Recognize(const std::vector<T>& crops, std::vector<std::string>* texts,
+                 std::vector<float>* rec_scores);
+  // Recognize the crops of all the images by width buckets, crop_owners are
+  // the image index and box index of every crop
+  template <typename T>
+  bool RecognizeByWidthBuckets(
+      const std::vector<T>& crops,
+      const std::vector<std::pair<size_t, size_t>>& crop_owners,
+      std::vector<fastdeploy::vision::OCRResult>* batch_result);
+
   int cls_batch_size_ = 1;
   int rec_batch_size_ = 6;
+  float rec_padding_budget_ = -1.0f;
+  bool use_fused_rec_crop_ = false;
 };
 
 namespace application {
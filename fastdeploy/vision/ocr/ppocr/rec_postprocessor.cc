@@ -13,6 +13,13 @@
 // limitations under the License.
 
 #include "fastdeploy/vision/ocr/ppocr/rec_postprocessor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+#include "fastdeploy/function/argmax.h"
 #include "fastdeploy/utils/perf.h"
 #include "fastdeploy/vision/ocr/ppocr/utils/ocr_utils.h"
 
@@ -40,38 +47,60 @@ RecognizerPostprocessor::RecognizerPostprocessor(){
 RecognizerPostprocessor::RecognizerPostprocessor(const std::string& label_path) {
   // init label_lsit
   label_list_ = ReadDict(label_path);
+  label_offsets_.reserve(label_list_.size() + 1);
+  label_offsets_.push_back(0);
+  for (const auto& label : label_list_) {
+    label_table_ += label;
+    label_offsets_.push_back(label_table_.size());
+    max_label_size_ = std::max(max_label_size_, label.size());
+  }
   initialized_ = true;
 }
 
-bool RecognizerPostprocessor::SingleBatchPostprocessor(const float* out_data,
-                              const std::vector<int64_t>& output_shape,
-                              std::string* text, float* rec_score) {
+void RecognizerPostprocessor::SetThreadNum(int thread_num) {
+  FDASSERT(thread_num > 0, "The thread_num should be > 0, but now it's %d.",
+           thread_num);
+  if (thread_num == 1) {
+    task_pool_.reset();
+  } else if (thread_num != GetThreadNum()) {
+    task_pool_ = std::make_shared<TaskPool>(thread_num);
+  }
+}
+
+void RecognizerPostprocessor::SetBeamSize(int beam_size) {
+  FDASSERT(beam_size > 0, "The beam_size should be > 0, but now it's %d.",
+           beam_size);
+  beam_size_ = beam_size;
+}
+
+void RecognizerPostprocessor::AppendLabel(int label, std::string* text) const {
+  text->append(label_table_, label_offsets_[label],
+               label_offsets_[label + 1] - label_offsets_[label]);
+}
+
+bool RecognizerPostprocessor::GreedyDecode(const int32_t* max_indices,
+                                           const float* max_values,
+                                           size_t length, std::string* text,
+                                           float* rec_score) const {
   std::string& str_res = *text;
   float& score = *rec_score;
+  str_res.clear();
+  str_res.reserve(length * max_label_size_);
   score = 0.f;
-  int argmax_idx;
   int last_index = 0;
   int count = 0;
-  float max_value = 0.0f;
-
-  for (int n = 0; n < output_shape[1]; n++) {
-    argmax_idx = int(
-        std::distance(&out_data[n * output_shape[2]],
-                      std::max_element(&out_data[n * output_shape[2]],
-                                       &out_data[(n + 1) * output_shape[2]])));
-
-    max_value = float(*std::max_element(&out_data[n * output_shape[2]],
-                                        &out_data[(n + 1) * output_shape[2]]));
 
+  for (size_t n = 0; n < length; n++) {
+    int argmax_idx = max_indices[n];
     if (argmax_idx > 0 && (!(n > 0 && argmax_idx == last_index))) {
-      score += max_value;
+      score += max_values[n];
       count += 1;
-      if(argmax_idx > label_list_.size()) {
+      if (argmax_idx >= static_cast<int>(label_list_.size())) {
         FDERROR << "The output index: " << argmax_idx << " is larger than the size of label_list: "
         << label_list_.size() << ". Please check the label file!" << std::endl;
-        return false; 
+        return false;
       }
-      str_res += label_list_[argmax_idx];
+      AppendLabel(argmax_idx, &str_res);
     }
     last_index = argmax_idx;
   }
@@ -82,6 +111,150 @@ bool RecognizerPostprocessor::SingleBatchPostprocessor(const float* out_data,
   return true;
 }
 
+namespace {
+
+float LogSumExp(float a, float b) {
+  if (a < b) {
+    std::swap(a, b);
+  }
+  if (b == -std::numeric_limits<float>::infinity()) {
+    return a;
+  }
+  return a + std::log1p(std::exp(b - a));
+}
+
+// A prefix of the beam search, stored as a node of the prefix tree
+struct PrefixNode {
+  int parent;
+  int label;
+  // Sum and number of the probabilities of the labels on the path, the
+  // score of the text is the mean as the greedy decoding
+  float prob_sum;
+  int count;
+};
+
+struct Beam {
+  int node;
+  // Log probabilities of the prefix ending with blank and with its label
+  float blank;
+  float non_blank;
+
+  float Total() const { return LogSumExp(blank, non_blank); }
+};
+
+}  // namespace
+
+bool RecognizerPostprocessor::BeamSearchDecode(const float* probs,
+                                               size_t length,
+                                               size_t num_classes,
+                                               std::string* text,
+                                               float* rec_score) const {
+  const float kLogZero = -std::numeric_limits<float>::infinity();
+  size_t beam_size = static_cast<size_t>(beam_size_);
+  size_t num_labels = std::min(num_classes, label_list_.size());
+  // The prefix tree is preallocated for the prefixes extended at every step
+  std::vector<PrefixNode> nodes;
+  nodes.reserve(length * beam_size * beam_size + 1);
+  nodes.push_back({-1, 0, 0.0f, 0});
+  std::unordered_map<int64_t, int> children;
+  children.reserve(nodes.capacity());
+  auto extend = [&](int parent, int label, float prob) {
+    int64_t key = static_cast<int64_t>(parent) * num_classes + label;
+    auto iter = children.find(key);
+    if (iter != children.end()) {
+      return iter->second;
+    }
+    const PrefixNode& node = nodes[parent];
+    nodes.push_back({parent, label, node.prob_sum + prob, node.count + 1});
+    children.emplace(key, static_cast<int>(nodes.size() - 1));
+    return static_cast<int>(nodes.size() - 1);
+  };
+
+  std::vector<Beam> beams = {{0, 0.0f, kLogZero}};
+  std::vector<Beam> next_beams;
+  // Index of the beams of the prefixes in next_beams
+  std::unordered_map<int, size_t> next_index;
+  auto next_beam = [&](int node) -> Beam& {
+    auto iter = next_index.find(node);
+    if (iter == next_index.end()) {
+      iter = next_index.emplace(node, next_beams.size()).first;
+      next_beams.push_back({node, kLogZero, kLogZero});
+    }
+    return next_beams[iter->second];
+  };
+  std::vector<int> candidates;
+  auto by_prob = [](const std::pair<float, int>& a,
+                    const std::pair<float, int>& b) {
+    return a.first > b.first;
+  };
+  std::vector<std::pair<float, int>> top;
+  for (size_t t = 0; t < length; ++t) {
+    const float* row = probs + t * num_classes;
+    // The most probable labels, kept in a min-heap of beam_size
+    top.clear();
+    for (size_t c = 1; c < num_labels; ++c) {
+      if (top.size() < beam_size) {
+        top.emplace_back(row[c], static_cast<int>(c));
+        std::push_heap(top.begin(), top.end(), by_prob);
+      } else if (row[c] > top.front().first) {
+        std::pop_heap(top.begin(), top.end(), by_prob);
+        top.back() = std::make_pair(row[c], static_cast<int>(c));
+        std::push_heap(top.begin(), top.end(), by_prob);
+      }
+    }
+
+    next_beams.clear();
+    next_index.clear();
+    float log_blank = std::log(row[0]);
+    for (const Beam& beam : beams) {
+      float total = beam.Total();
+      Beam& same = next_beam(beam.node);
+      same.blank = LogSumExp(same.blank, total + log_blank);
+      int last_label = nodes[beam.node].label;
+      for (const auto& item : top) {
+        float log_prob = std::log(item.first);
+        int child = extend(beam.node, item.second, item.first);
+        if (beam.node != 0 && item.second == last_label) {
+          // The repeated label is merged unless separated by blank
+          Beam& merged = next_beam(beam.node);
+          merged.non_blank =
+              LogSumExp(merged.non_blank, beam.non_blank + log_prob);
+          Beam& extended = next_beam(child);
+          extended.non_blank =
+              LogSumExp(extended.non_blank, beam.blank + log_prob);
+        } else {
+          Beam& extended = next_beam(child);
+          extended.non_blank = LogSumExp(extended.non_blank, total + log_prob);
+        }
+      }
+    }
+    size_t keep = std::min(beam_size, next_beams.size());
+    std::partial_sort(next_beams.begin(), next_beams.begin() + keep,
+                      next_beams.end(), [](const Beam& a, const Beam& b) {
+                        return a.Total() > b.Total();
+                      });
+    next_beams.resize(keep);
+    beams.swap(next_beams);
+  }
+
+  const PrefixNode* best = &nodes[beams[0].node];
+  std::vector<int> labels;
+  labels.reserve(best->count);
+  for (int node = beams[0].node; node > 0; node = nodes[node].parent) {
+    labels.push_back(nodes[node].label);
+  }
+  text->clear();
+  text->reserve(labels.size() * max_label_size_);
+  for (auto iter = labels.rbegin(); iter != labels.rend(); ++iter) {
+    AppendLabel(*iter, text);
+  }
+  *rec_score = best->count == 0 ? 0.0f : best->prob_sum / best->count;
+  if (std::isnan(*rec_score)) {
+    *rec_score = 0.0f;
+  }
+  return true;
+}
+
 bool RecognizerPostprocessor::Run(const std::vector<FDTensor>& tensors,
                                   std::vector<std::string>* texts, std::vector<float>* rec_scores) {
   // Recognizer have only 1 output tensor.
@@ -119,16 +292,41 @@ bool RecognizerPostprocessor::Run(const std::vector<FDTensor>& tensors,
   texts->resize(total_size);
   rec_scores->resize(total_size);
   
+  if (tensor.shape.size() != 3) {
+    FDERROR << "The output tensor of Recognizer should be 3-D, but now it's "
+            << tensor.shape.size() << "-D." << std::endl;
+    return false;
+  }
+  size_t seq_len = tensor.shape[1];
+  size_t num_classes = tensor.shape[2];
   const float* tensor_data = reinterpret_cast<const float*>(tensor.Data());
-  for (int i_batch = 0; i_batch < batch; ++i_batch) {
-    size_t real_index = i_batch+start_index;
+  // The samples are decoded in parallel, the argmax of every time step is
+  // computed by the fused argmax and max kernel
+  auto decode = [&](size_t i_batch) {
+    size_t real_index = i_batch + start_index;
     if (indices.size() != 0) {
-      real_index = indices[i_batch+start_index];
+      real_index = indices[i_batch + start_index];
+    }
+    const float* probs = tensor_data + i_batch * length;
+    std::string* text = &texts->at(real_index);
+    float* rec_score = &rec_scores->at(real_index);
+    if (beam_size_ > 1) {
+      return BeamSearchDecode(probs, seq_len, num_classes, text, rec_score);
     }
-    if(!SingleBatchPostprocessor(tensor_data + i_batch * length,
-                                 tensor.shape,
-                                 &texts->at(real_index),
-                                 &rec_scores->at(real_index))) {
+    std::vector<int32_t> max_indices(seq_len);
+    std::vector<float> max_values(seq_len);
+    if (seq_len > 0) {
+      function::ArgMaxAndMax(probs, seq_len, num_classes, max_indices.data(),
+                             max_values.data());
+    }
+    return GreedyDecode(max_indices.data(), max_values.data(), seq_len, text,
+                        rec_score);
+  };
+  if (task_pool_ != nullptr && batch > 1) {
+    return task_pool_->ParallelFor(batch, decode);
+  }
+  for (size_t i_batch = 0; i_batch < batch; ++i_batch) {
+    if (!decode(i_batch)) {
       return false;
     }
   }
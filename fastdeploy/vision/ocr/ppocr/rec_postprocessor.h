@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #pragma once
+#include <memory>
+
+#include "fastdeploy/utils/task_pool.h"
 #include "fastdeploy/vision/common/processors/transform.h"
 #include "fastdeploy/vision/common/result.h"
 #include "fastdeploy/vision/ocr/ppocr/utils/ocr_postprocess_op.h"
@@ -47,12 +50,49 @@ class FASTDEPLOY_DECL RecognizerPostprocessor {
            size_t start_index, size_t total_size,
            const std::vector<int>& indices);
 
+  /** \brief Set the number of threads decoding the samples of a batch in parallel, the calling thread is one of the threads, so 1 means decoding the samples one by one
+   *
+   * \param[in] thread_num The number of threads, should be > 0
+   */
+  void SetThreadNum(int thread_num);
+
+  /// Get the number of threads decoding the samples of a batch
+  int GetThreadNum() const {
+    return task_pool_ == nullptr ? 1 : task_pool_->NumThreads();
+  }
+
+  /** \brief Set the beam size of CTC decoding, 1 is the greedy decoding, and the prefix beam search keeps `beam_size` prefixes extended by the `beam_size` most probable labels of every time step otherwise
+   *
+   * The beam search requires the output of the model to be the probabilities, which is true for the PP-OCR recognition models
+   *
+   * \param[in] beam_size The beam size, should be > 0, default 1
+   */
+  void SetBeamSize(int beam_size);
+
+  /// Get the beam size of CTC decoding
+  int GetBeamSize() const { return beam_size_; }
+
  private:
-  bool SingleBatchPostprocessor(const float* out_data,
-                              const std::vector<int64_t>& output_shape,
-                              std::string* text, float* rec_score);
+  // Greedy decoding of a sample, with the max label and probability of
+  // every time step
+  bool GreedyDecode(const int32_t* max_indices, const float* max_values,
+                    size_t length, std::string* text, float* rec_score) const;
+  bool BeamSearchDecode(const float* probs, size_t length, size_t num_classes,
+                        std::string* text, float* rec_score) const;
+  // Append the label to the text from the contiguous label table
+  void AppendLabel(int label, std::string* text) const;
+
   bool initialized_ = false;
   std::vector<std::string> label_list_;
+  // All the labels in one string, the label i is
+  // [label_offsets_[i], label_offsets_[i + 1])
+  std::string label_table_;
+  std::vector<size_t> label_offsets_;
+  size_t max_label_size_ = 0;
+  int beam_size_ = 1;
+  // Shared by the cloned postprocessors as well, TaskPool allows concurrent
+  // ParallelFor() calls
+  std::shared_ptr<TaskPool> task_pool_;
 };
 
 }  // namespace ocr
@@ -21,8 +21,11 @@ namespace fastdeploy {
 namespace vision {
 namespace ocr {
 
-void OcrRecognizerResizeImage(FDMat* mat, float max_wh_ratio,
-                              const std::vector<int>& rec_image_shape, bool static_shape_infer) {
+// Get the width the image of width x height is resized to, and the width
+// it should be padded to
+static int GetRecResizeWidth(int width, int height, float max_wh_ratio,
+                             const std::vector<int>& rec_image_shape,
+                             bool static_shape_infer, int* pad_width) {
   int img_h, img_w;
   img_h = rec_image_shape[1];
   img_w = rec_image_shape[2];
@@ -30,25 +33,38 @@ void OcrRecognizerResizeImage(FDMat* mat, float max_wh_ratio,
   if (!static_shape_infer) {
 
     img_w = int(img_h * max_wh_ratio);
-    float ratio = float(mat->Width()) / float(mat->Height());
+    float ratio = float(width) / float(height);
 
-    int resize_w;
+    *pad_width = img_w;
     if (ceilf(img_h * ratio) > img_w) {
-      resize_w = img_w;
-    } else {
-      resize_w = int(ceilf(img_h * ratio));
+      return img_w;
     }
-    Resize::Run(mat, resize_w, img_h);
-    Pad::Run(mat, 0, 0, 0, int(img_w - mat->Width()), {127, 127, 127});
+    return int(ceilf(img_h * ratio));
+  }
+  *pad_width = img_w;
+  // Reszie W to 320
+  return width >= img_w ? img_w : width;
+}
 
-  } else {
-    if (mat->Width() >= img_w) {
-      Resize::Run(mat, img_w, img_h); // Reszie W to 320
-    } else {
-      Resize::Run(mat, mat->Width(), img_h);
-      Pad::Run(mat, 0, 0, 0, int(img_w - mat->Width()), {127, 127, 127});
-      // Pad to 320
-    } 
+// Resize the image to the height of rec_image_shape, and return the width
+// the image should be padded to
+int OcrRecognizerResize(FDMat* mat, float max_wh_ratio,
+                        const std::vector<int>& rec_image_shape, bool static_shape_infer) {
+  int pad_width;
+  int resize_w = GetRecResizeWidth(mat->Width(), mat->Height(), max_wh_ratio,
+                                   rec_image_shape, static_shape_infer,
+                                   &pad_width);
+  Resize::Run(mat, resize_w, rec_image_shape[1]);
+  return pad_width;
+}
+
+void RecognizerPreprocessor::SetThreadNum(int thread_num) {
+  FDASSERT(thread_num > 0, "The thread_num should be > 0, but now it's %d.",
+           thread_num);
+  if (thread_num == 1) {
+    task_pool_.reset();
+  } else if (thread_num != GetThreadNum()) {
+    task_pool_ = std::make_shared<TaskPool>(thread_num);
   }
 }
 
@@ -78,27 +94,46 @@ bool RecognizerPreprocessor::Run(std::vector<FDMat>* images, std::vector<FDTenso
     max_wh_ratio = std::max(max_wh_ratio, ori_wh_ratio);
   }
 
+  // The images are only resized here, NormalizeAndPermute writes them into
+  // their slots of the batch tensor directly, with the padding filled by the
+  // normalized value of the pad pixel 127
+  int batch_w = 0;
+  std::vector<FDMat> mats;
+  mats.reserve(end_index - start_index);
   for (size_t i = start_index; i < end_index; ++i) {
     size_t real_index = i;
     if (indices.size() != 0) {
       real_index = indices[i];
     }
     FDMat* mat = &(images->at(real_index));
-    OcrRecognizerResizeImage(mat, max_wh_ratio, rec_image_shape_, static_shape_infer_);
-    NormalizeAndPermute::Run(mat, mean_, scale_, is_scale_);
+    batch_w = OcrRecognizerResize(mat, max_wh_ratio, rec_image_shape_, static_shape_infer_);
+    mats.push_back(*mat);
+  }
+  NormalizeAndPermute normalize_permute(mean_, scale_, is_scale_);
+  std::vector<float> alpha = normalize_permute.GetAlpha();
+  std::vector<float> beta = normalize_permute.GetBeta();
+  std::vector<float> pad_values(alpha.size());
+  for (size_t c = 0; c < alpha.size(); ++c) {
+    pad_values[c] = 127 * alpha[c] + beta[c];
   }
   // Only have 1 output Tensor.
   outputs->resize(1);
-  size_t tensor_size = end_index-start_index;
-  // Concat all the preprocessed data to a batch tensor
-  std::vector<FDTensor> tensors(tensor_size); 
-  for (size_t i = 0; i < tensor_size; ++i) {
-    size_t real_index = i + start_index;
-    if (indices.size() != 0) {
-      real_index = indices[i + start_index];
+  FDMatBatch mat_batch(&mats);
+  if (WriteToBatchTensor(&normalize_permute, &mat_batch, img_h, batch_w,
+                         pad_values, &((*outputs)[0]))) {
+    return true;
+  }
+
+  for (size_t i = 0; i < mats.size(); ++i) {
+    if (mats[i].Width() < batch_w) {
+      Pad::Run(&mats[i], 0, 0, 0, batch_w - mats[i].Width(), {127, 127, 127});
     }
-    
-    (*images)[real_index].ShareWithTensor(&(tensors[i]));
+    normalize_permute(&mats[i]);
+  }
+  // Concat all the preprocessed data to a batch tensor
+  std::vector<FDTensor> tensors(mats.size());
+  for (size_t i = 0; i < mats.size(); ++i) {
+    mats[i].ShareWithTensor(&(tensors[i]));
     tensors[i].ExpandDim(0);
   }
   if (tensors.size() == 1) {
@@ -109,6 +144,77 @@ bool RecognizerPreprocessor::Run(std::vector<FDMat>* images, std::vector<FDTenso
   return true;
 }
 
+bool RecognizerPreprocessor::Run(const std::vector<RotateCrop>& crops,
+                                 std::vector<FDTensor>* outputs,
+                                 size_t start_index, size_t end_index,
+                                 const std::vector<int>& indices) {
+  if (crops.size() == 0 || end_index <= start_index ||
+      end_index > crops.size()) {
+    FDERROR << "crops.size() or index error. Correct is: 0 <= start_index < "
+               "end_index <= crops.size()" << std::endl;
+    return false;
+  }
+  auto real_index = [&](size_t i) {
+    return indices.size() != 0 ? static_cast<size_t>(indices[i]) : i;
+  };
+
+  int img_h = rec_image_shape_[1];
+  int img_w = rec_image_shape_[2];
+  float max_wh_ratio = img_w * 1.0 / img_h;
+  int channels = crops[real_index(start_index)].image->channels();
+  for (size_t i = start_index; i < end_index; ++i) {
+    const RotateCrop& crop = crops[real_index(i)];
+    if (crop.image->channels() != channels) {
+      FDERROR << "The images of the crops of a batch should have the same "
+                 "channels." << std::endl;
+      return false;
+    }
+    max_wh_ratio = std::max(max_wh_ratio,
+                            float(crop.width * 1.0 / std::max(crop.height, 1)));
+  }
+
+  size_t batch = end_index - start_index;
+  int batch_w = 0;
+  std::vector<int> resize_widths(batch);
+  for (size_t i = 0; i < batch; ++i) {
+    const RotateCrop& crop = crops[real_index(start_index + i)];
+    resize_widths[i] = std::max(
+        GetRecResizeWidth(std::max(crop.width, 1), std::max(crop.height, 1),
+                          max_wh_ratio, rec_image_shape_, static_shape_infer_,
+                          &batch_w),
+        1);
+  }
+  NormalizeAndPermute normalize_permute(mean_, scale_, is_scale_);
+  std::vector<float> alpha = normalize_permute.GetAlpha();
+  std::vector<float> beta = normalize_permute.GetBeta();
+  std::vector<float> pad_values(alpha.size());
+  for (size_t c = 0; c < alpha.size(); ++c) {
+    pad_values[c] = 127 * alpha[c] + beta[c];
+  }
+
+  // Only have 1 output Tensor.
+  outputs->resize(1);
+  FDTensor* output = &((*outputs)[0]);
+  output->Resize({static_cast<int64_t>(batch), channels, img_h, batch_w},
+                 FDDataType::FP32, output->name, Device::CPU);
+  float* data = reinterpret_cast<float*>(output->MutableData());
+  size_t crop_size = static_cast<size_t>(channels) * img_h * batch_w;
+  auto write = [&](size_t i) {
+    return WarpRotateCropToCHW(crops[real_index(start_index + i)],
+                               resize_widths[i], img_h, batch_w, alpha, beta,
+                               pad_values, data + i * crop_size);
+  };
+  if (task_pool_ != nullptr && batch > 1) {
+    return task_pool_->ParallelFor(batch, write);
+  }
+  for (size_t i = 0; i < batch; ++i) {
+    if (!write(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace ocr
 }  // namespace vision
 }  // namespace fastdeploy
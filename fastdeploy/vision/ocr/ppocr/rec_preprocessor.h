@@ -13,8 +13,12 @@
 // limitations under the License.
 
 #pragma once
+#include <memory>
+
+#include "fastdeploy/utils/task_pool.h"
 #include "fastdeploy/vision/common/processors/transform.h"
 #include "fastdeploy/vision/common/result.h"
+#include "fastdeploy/vision/ocr/ppocr/utils/ocr_utils.h"
 
 namespace fastdeploy {
 namespace vision {
@@ -35,6 +39,19 @@ class FASTDEPLOY_DECL RecognizerPreprocessor {
            size_t start_index, size_t end_index,
            const std::vector<int>& indices);
 
+  /** \brief Crop the text boxes and write them into the input tensor directly, every crop is warped and resized by a single perspective transform without the intermediate images, and the crops are processed in parallel
+   *
+   * \param[in] crops The crops of the text boxes, see GetRotateCrop()
+   * \param[in] outputs The output tensors which will be fed into runtime
+   * \param[in] start_index The start of the crops of the batch
+   * \param[in] end_index The end of the crops of the batch
+   * \param[in] indices The order of the crops, empty for the original order
+   * \return true if the preprocess successed, otherwise false
+   */
+  bool Run(const std::vector<RotateCrop>& crops,
+           std::vector<FDTensor>* outputs, size_t start_index,
+           size_t end_index, const std::vector<int>& indices);
+
   /// Set static_shape_infer is true or not. When deploy PP-OCR
   /// on hardware which can not support dynamic input shape very well,
   /// like Huawei Ascned, static_shape_infer needs to to be true.
@@ -66,12 +83,26 @@ class FASTDEPLOY_DECL RecognizerPreprocessor {
   /// Get rec_image_shape for the recognition preprocess
   std::vector<int> GetRecImageShape() { return rec_image_shape_; }
 
+  /** \brief Set the number of threads writing the crops of a batch in parallel, the calling thread is one of the threads
+   *
+   * \param[in] thread_num The number of threads, should be > 0
+   */
+  void SetThreadNum(int thread_num);
+
+  /// Get the number of threads writing the crops of a batch
+  int GetThreadNum() const {
+    return task_pool_ == nullptr ? 1 : task_pool_->NumThreads();
+  }
+
  private:
   std::vector<int> rec_image_shape_ = {3, 48, 320};
   std::vector<float> mean_ = {0.5f, 0.5f, 0.5f};
   std::vector<float> scale_ = {0.5f, 0.5f, 0.5f};
   bool is_scale_ = true;
   bool static_shape_infer_ = false;
+  // Shared by the cloned preprocessors as well, TaskPool allows concurrent
+  // ParallelFor() calls
+  std::shared_ptr<TaskPool> task_pool_;
 };
 
 }  // namespace ocr
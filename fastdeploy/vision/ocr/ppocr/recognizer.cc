@@ -82,6 +82,7 @@ bool Recognizer::BatchPredict(const std::vector<cv::Mat>& images,
 bool Recognizer::BatchPredict(const std::vector<cv::Mat>& images,
                               std::vector<std::string>* texts, std::vector<float>* rec_scores,
                               size_t start_index, size_t end_index, const std::vector<int>& indices) {
+  PredictScope predict_scope(this);
   size_t total_size = images.size();
   if (indices.size() != 0 && indices.size() != total_size) {
     FDERROR << "indices.size() should be 0 or images.size()." << std::endl;
@@ -106,6 +107,33 @@ bool Recognizer::BatchPredict(const std::vector<cv::Mat>& images,
   return true;
 }
 
+bool Recognizer::BatchPredict(const std::vector<RotateCrop>& crops,
+                              std::vector<std::string>* texts, std::vector<float>* rec_scores,
+                              size_t start_index, size_t end_index, const std::vector<int>& indices) {
+  PredictScope predict_scope(this);
+  size_t total_size = crops.size();
+  if (indices.size() != 0 && indices.size() != total_size) {
+    FDERROR << "indices.size() should be 0 or crops.size()." << std::endl;
+    return false;
+  }
+  if (!preprocessor_.Run(crops, &reused_input_tensors_, start_index, end_index, indices)) {
+    FDERROR << "Failed to preprocess the input crops." << std::endl;
+    return false;
+  }
+
+  reused_input_tensors_[0].name = InputInfoOfRuntime(0).name;
+  if (!Infer(reused_input_tensors_, &reused_output_tensors_)) {
+    FDERROR << "Failed to inference by runtime." << std::endl;
+    return false;
+  }
+
+  if (!postprocessor_.Run(reused_output_tensors_, texts, rec_scores, start_index, total_size, indices)) {
+    FDERROR << "Failed to postprocess the inference cls_results by runtime." << std::endl;
+    return false;
+  }
+  return true;
+}
+
 }  // namesapce ocr
 }  // namespace vision
 }  // namespace fastdeploy
\ No newline at end of file
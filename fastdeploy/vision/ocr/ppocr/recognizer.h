@@ -78,6 +78,21 @@ class FASTDEPLOY_DECL Recognizer : public FastDeployModel {
                size_t start_index, size_t end_index,
                const std::vector<int>& indices);
 
+  /** \brief BatchPredict the crops of the text boxes, the crops are warped straight into the input tensor, see RecognizerPreprocessor::Run()
+   *
+   * \param[in] crops The list of crops of the text boxes, comes from GetRotateCrop().
+   * \param[in] texts The list of text results of rec model will be written into this vector.
+   * \param[in] rec_scores The list of sccore result of rec model will be written into this vector.
+   * \param[in] start_index The start of the crops of the batch.
+   * \param[in] end_index The end of the crops of the batch.
+   * \param[in] indices The order of the crops, empty for the original order.
+   * \return true if the prediction is successed, otherwise false.
+   */
+  virtual bool BatchPredict(const std::vector<RotateCrop>& crops,
+               std::vector<std::string>* texts, std::vector<float>* rec_scores,
+               size_t start_index, size_t end_index,
+               const std::vector<int>& indices);
+
   /// Get preprocessor reference of DBDetectorPreprocessor
   virtual RecognizerPreprocessor& GetPreprocessor() {
     return preprocessor_;
@@ -0,0 +1,463 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fastdeploy/vision/ocr/ppocr/utils/db_postprocess.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace fastdeploy {
+namespace vision {
+namespace ocr {
+
+namespace {
+
+// A horizontal run of the foreground pixels [x0, x1] in row y
+struct Run {
+  int y;
+  int x0;
+  int x1;
+};
+
+struct Point {
+  double x;
+  double y;
+};
+
+// The rotated rectangle centered at (cx, cy), with the side of `width` along
+// the unit vector (ux, uy)
+struct Rect {
+  double cx;
+  double cy;
+  double ux;
+  double uy;
+  double width;
+  double height;
+};
+
+int FindRoot(std::vector<int>* parents, int i) {
+  auto& p = *parents;
+  while (p[i] != i) {
+    p[i] = p[p[i]];
+    i = p[i];
+  }
+  return i;
+}
+
+// The root is always the first run of a region in raster order
+void Union(std::vector<int>* parents, int a, int b) {
+  a = FindRoot(parents, a);
+  b = FindRoot(parents, b);
+  if (a < b) {
+    (*parents)[b] = a;
+  } else if (b < a) {
+    (*parents)[a] = b;
+  }
+}
+
+std::vector<unsigned char> Threshold(const float* prob, int height, int width,
+                                     const DBPostprocessParams& params) {
+  // Same as the original postprocess, which truncates the probability map to
+  // uint8 by a cast(not rounded like cv::Mat::convertTo) before thresholding
+  const double threshold = params.thresh * 255;
+  std::vector<unsigned char> bitmap(height * width);
+  for (int i = 0; i < height * width; ++i) {
+    bitmap[i] = static_cast<int>(prob[i] * 255) > threshold;
+  }
+  if (!params.use_dilation) {
+    return bitmap;
+  }
+  // Dilation by the 2x2 kernel anchored at its bottom right pixel
+  std::vector<unsigned char> dilated(height * width);
+  for (int y = 0; y < height; ++y) {
+    const unsigned char* row = bitmap.data() + y * width;
+    const unsigned char* prev = y > 0 ? row - width : row;
+    unsigned char* out = dilated.data() + y * width;
+    out[0] = row[0] | prev[0];
+    for (int x = 1; x < width; ++x) {
+      out[x] = row[x] | row[x - 1] | prev[x] | prev[x - 1];
+    }
+  }
+  return dilated;
+}
+
+// Label the 8-connected regions in a single raster scan, every run is merged
+// with the overlapping runs of the previous row. The runs of the regions are
+// returned in raster order, and the regions are ordered by their first runs
+void LabelRegions(const std::vector<unsigned char>& bitmap, int height,
+                  int width, std::vector<Run>* runs,
+                  std::vector<int>* region_offsets) {
+  std::vector<int> parents;
+  int prev_begin = 0;
+  int prev_end = 0;
+  for (int y = 0; y < height; ++y) {
+    const unsigned char* row = bitmap.data() + y * width;
+    int row_begin = static_cast<int>(runs->size());
+    int k = prev_begin;
+    int x = 0;
+    while (x < width) {
+      if (!row[x]) {
+        ++x;
+        continue;
+      }
+      int x0 = x;
+      while (x < width && row[x]) {
+        ++x;
+      }
+      int id = static_cast<int>(runs->size());
+      runs->push_back({y, x0, x - 1});
+      parents.push_back(id);
+      // Skip the runs of the previous row on the left, the last one of them
+      // may still touch the next run of this row
+      while (k < prev_end && (*runs)[k].x1 < x0 - 1) {
+        ++k;
+      }
+      for (int j = k; j < prev_end && (*runs)[j].x0 <= x; ++j) {
+        Union(&parents, id, j);
+      }
+    }
+    prev_begin = row_begin;
+    prev_end = static_cast<int>(runs->size());
+  }
+
+  // Group the runs by the regions
+  int num_runs = static_cast<int>(runs->size());
+  std::vector<int> region_ids(num_runs);
+  std::vector<int> counts;
+  for (int i = 0; i < num_runs; ++i) {
+    int root = FindRoot(&parents, i);
+    if (root == i) {
+      region_ids[i] = static_cast<int>(counts.size());
+      counts.push_back(0);
+    } else {
+      region_ids[i] = region_ids[root];
+    }
+    counts[region_ids[i]] += 1;
+  }
+  region_offsets->assign(counts.size() + 1, 0);
+  for (size_t i = 0; i < counts.size(); ++i) {
+    (*region_offsets)[i + 1] = (*region_offsets)[i] + counts[i];
+  }
+  std::vector<int> positions(region_offsets->begin(),
+                             region_offsets->end() - 1);
+  std::vector<Run> grouped(num_runs);
+  for (int i = 0; i < num_runs; ++i) {
+    grouped[positions[region_ids[i]]++] = (*runs)[i];
+  }
+  runs->swap(grouped);
+}
+
+double Cross(const Point& o, const Point& a, const Point& b) {
+  return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+// The convex hull by the monotone chain algorithm, without collinear points
+std::vector<Point> ConvexHull(std::vector<Point> points) {
+  std::sort(points.begin(), points.end(), [](const Point& a, const Point& b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+  });
+  std::vector<Point> hull(2 * points.size());
+  size_t k = 0;
+  for (size_t i = 0; i < points.size(); ++i) {
+    while (k >= 2 && Cross(hull[k - 2], hull[k - 1], points[i]) <= 0) {
+      --k;
+    }
+    hull[k++] = points[i];
+  }
+  for (size_t i = points.size() - 1, t = k + 1; i > 0; --i) {
+    while (k >= t && Cross(hull[k - 2], hull[k - 1], points[i - 1]) <= 0) {
+      --k;
+    }
+    hull[k++] = points[i - 1];
+  }
+  hull.resize(k > 1 ? k - 1 : k);
+  return hull;
+}
+
+// The minimum area rectangle has a side collinear with an edge of the hull
+Rect MinAreaRect(const std::vector<Point>& hull) {
+  Rect best = {0, 0, 1, 0, 0, 0};
+  double best_area = -1;
+  size_t n = hull.size();
+  for (size_t i = 0; i < n; ++i) {
+    const Point& p = hull[i];
+    const Point& q = hull[(i + 1) % n];
+    double length = std::hypot(q.x - p.x, q.y - p.y);
+    double ux = (q.x - p.x) / length;
+    double uy = (q.y - p.y) / length;
+    double min_u = 0, max_u = 0, min_v = 0, max_v = 0;
+    for (size_t j = 0; j < n; ++j) {
+      double u = hull[j].x * ux + hull[j].y * uy;
+      double v = hull[j].y * ux - hull[j].x * uy;
+      if (j == 0 || u < min_u) min_u = u;
+      if (j == 0 || u > max_u) max_u = u;
+      if (j == 0 || v < min_v) min_v = v;
+      if (j == 0 || v > max_v) max_v = v;
+    }
+    double area = (max_u - min_u) * (max_v - min_v);
+    if (best_area < 0 || area < best_area) {
+      double cu = (min_u + max_u) / 2;
+      double cv = (min_v + max_v) / 2;
+      best = {cu * ux - cv * uy, cu * uy + cv * ux, ux, uy, max_u - min_u,
+              max_v - min_v};
+      best_area = area;
+    }
+  }
+  return best;
+}
+
+// The corners of the rectangle in the order of GetMiniBoxes()
+std::array<Point, 4> GetMiniBox(const Rect& rect) {
+  double wx = rect.ux * rect.width / 2, wy = rect.uy * rect.width / 2;
+  double hx = -rect.uy * rect.height / 2, hy = rect.ux * rect.height / 2;
+  std::array<Point, 4> points = {{{rect.cx - wx - hx, rect.cy - wy - hy},
+                                  {rect.cx + wx - hx, rect.cy + wy - hy},
+                                  {rect.cx + wx + hx, rect.cy + wy + hy},
+                                  {rect.cx - wx + hx, rect.cy - wy + hy}}};
+  std::sort(points.begin(), points.end(),
+            [](const Point& a, const Point& b) { return a.x < b.x; });
+  std::array<Point, 4> box;
+  if (points[3].y <= points[2].y) {
+    box[1] = points[3];
+    box[2] = points[2];
+  } else {
+    box[1] = points[2];
+    box[2] = points[3];
+  }
+  if (points[1].y <= points[0].y) {
+    box[0] = points[1];
+    box[3] = points[0];
+  } else {
+    box[0] = points[0];
+    box[3] = points[1];
+  }
+  return box;
+}
+
+// Mean of the probabilities inside the box, every row of the box is summed
+// by the prefix sums of the row
+double BoxScore(const std::array<Point, 4>& box,
+                const std::vector<double>& prefix_sums, int height,
+                int width) {
+  double min_x = box[0].x, max_x = box[0].x;
+  double min_y = box[0].y, max_y = box[0].y;
+  for (const auto& p : box) {
+    min_x = std::min(min_x, p.x);
+    max_x = std::max(max_x, p.x);
+    min_y = std::min(min_y, p.y);
+    max_y = std::max(max_y, p.y);
+  }
+  int xmin = std::min(std::max(static_cast<int>(std::floor(min_x)), 0),
+                      width - 1);
+  int xmax = std::min(std::max(static_cast<int>(std::ceil(max_x)), 0),
+                      width - 1);
+  int ymin = std::min(std::max(static_cast<int>(std::floor(min_y)), 0),
+                      height - 1);
+  int ymax = std::min(std::max(static_cast<int>(std::ceil(max_y)), 0),
+                      height - 1);
+  double sum = 0;
+  int count = 0;
+  for (int y = ymin; y <= ymax; ++y) {
+    double left = 0, right = -1;
+    bool found = false;
+    for (int i = 0; i < 4; ++i) {
+      const Point& p = box[i];
+      const Point& q = box[(i + 1) % 4];
+      if ((p.y > y && q.y > y) || (p.y < y && q.y < y)) {
+        continue;
+      }
+      double xs[2] = {p.x, q.x};
+      int num_xs = 2;
+      if (p.y != q.y) {
+        xs[0] = p.x + (y - p.y) * (q.x - p.x) / (q.y - p.y);
+        num_xs = 1;
+      }
+      for (int j = 0; j < num_xs; ++j) {
+        left = found ? std::min(left, xs[j]) : xs[j];
+        right = found ? std::max(right, xs[j]) : xs[j];
+        found = true;
+      }
+    }
+    if (!found) {
+      continue;
+    }
+    int x0 = std::max(static_cast<int>(std::lround(left)), xmin);
+    int x1 = std::min(static_cast<int>(std::lround(right)), xmax);
+    if (x0 > x1) {
+      continue;
+    }
+    const double* row = prefix_sums.data() + y * (width + 1);
+    sum += row[x1 + 1] - row[x0];
+    count += x1 - x0 + 1;
+  }
+  return count == 0 ? 0.0 : sum / count;
+}
+
+// Get the box of a region, return false if the region is dropped
+bool RegionToBox(const Run* runs, int num_runs,
+                 const std::vector<double>& prefix_sums, int height,
+                 int width, const DBPostprocessParams& params,
+                 std::array<int, 8>* result) {
+  // The hull of the region is the one of the ends of its rows
+  std::vector<Point> points;
+  for (int i = 0; i < num_runs; ++i) {
+    if (i == 0 || runs[i].y != runs[i - 1].y) {
+      points.push_back({static_cast<double>(runs[i].x0),
+                        static_cast<double>(runs[i].y)});
+    }
+    if (i + 1 == num_runs || runs[i + 1].y != runs[i].y) {
+      points.push_back({static_cast<double>(runs[i].x1),
+                        static_cast<double>(runs[i].y)});
+    }
+  }
+  std::vector<Point> hull = ConvexHull(points);
+  // The pixels of the region are collinear
+  if (hull.size() <= 2) {
+    return false;
+  }
+  Rect rect = MinAreaRect(hull);
+  if (std::max(rect.width, rect.height) < params.min_size) {
+    return false;
+  }
+
+  double score;
+  if (params.slow_score) {
+    double sum = 0;
+    int count = 0;
+    for (int i = 0; i < num_runs; ++i) {
+      const double* row = prefix_sums.data() + runs[i].y * (width + 1);
+      sum += row[runs[i].x1 + 1] - row[runs[i].x0];
+      count += runs[i].x1 - runs[i].x0 + 1;
+    }
+    score = sum / count;
+  } else {
+    score = BoxScore(GetMiniBox(rect), prefix_sums, height, width);
+  }
+  if (score < params.box_thresh) {
+    return false;
+  }
+
+  // Offsetting a rectangle by the round joins, its minimum area rectangle is
+  // the rectangle expanded by the distance on every side
+  double distance = rect.width * rect.height * params.unclip_ratio /
+                    (2 * (rect.width + rect.height));
+  rect.width += 2 * distance;
+  rect.height += 2 * distance;
+  if (rect.width < 1.001 && rect.height < 1.001) {
+    return false;
+  }
+  if (std::max(rect.width, rect.height) < params.min_size + 2) {
+    return false;
+  }
+
+  std::array<Point, 4> box = GetMiniBox(rect);
+  std::array<std::array<int, 2>, 4> int_box;
+  for (int i = 0; i < 4; ++i) {
+    int_box[i][0] = static_cast<int>(
+        std::min(std::max(std::round(box[i].x), 0.0), double(width)));
+    int_box[i][1] = static_cast<int>(
+        std::min(std::max(std::round(box[i].y), 0.0), double(height)));
+  }
+  // Clockwise from the top left point, same as OrderPointsClockwise()
+  std::sort(int_box.begin(), int_box.end(),
+            [](const std::array<int, 2>& a, const std::array<int, 2>& b) {
+              return a[0] < b[0];
+            });
+  if (int_box[0][1] > int_box[1][1]) std::swap(int_box[0], int_box[1]);
+  if (int_box[2][1] > int_box[3][1]) std::swap(int_box[2], int_box[3]);
+  int order[4] = {0, 2, 3, 1};
+  for (int i = 0; i < 4; ++i) {
+    (*result)[2 * i] = int_box[order[i]][0];
+    (*result)[2 * i + 1] = int_box[order[i]][1];
+  }
+  return true;
+}
+
+}  // namespace
+
+void DBPostprocess(const float* prob, int height, int width,
+                   const DBPostprocessParams& params,
+                   const std::array<int, 4>& det_img_info,
+                   std::vector<std::array<int, 8>>* boxes, TaskPool* pool) {
+  boxes->clear();
+  if (height <= 0 || width <= 0) {
+    return;
+  }
+  std::vector<unsigned char> bitmap = Threshold(prob, height, width, params);
+  std::vector<Run> runs;
+  std::vector<int> region_offsets;
+  LabelRegions(bitmap, height, width, &runs, &region_offsets);
+  int num_regions = std::min(static_cast<int>(region_offsets.size()) - 1,
+                             params.max_candidates);
+  if (num_regions <= 0) {
+    return;
+  }
+
+  std::vector<double> prefix_sums(static_cast<size_t>(height) * (width + 1));
+  for (int y = 0; y < height; ++y) {
+    const float* row = prob + y * width;
+    double* sums = prefix_sums.data() + y * (width + 1);
+    sums[0] = 0;
+    for (int x = 0; x < width; ++x) {
+      sums[x + 1] = sums[x] + row[x];
+    }
+  }
+
+  std::vector<std::array<int, 8>> region_boxes(num_regions);
+  std::vector<char> valid(num_regions, 0);
+  auto process = [&](size_t i) {
+    int begin = region_offsets[i];
+    valid[i] = RegionToBox(runs.data() + begin, region_offsets[i + 1] - begin,
+                           prefix_sums, height, width, params,
+                           &region_boxes[i]);
+    return true;
+  };
+  if (pool != nullptr && num_regions > 1) {
+    pool->ParallelFor(num_regions, process);
+  } else {
+    for (int i = 0; i < num_regions; ++i) {
+      process(i);
+    }
+  }
+
+  // Map the boxes to the original image, same as FilterTagDetRes()
+  int ori_w = det_img_info[0];
+  int ori_h = det_img_info[1];
+  float ratio_w = float(det_img_info[2]) / float(ori_w);
+  float ratio_h = float(det_img_info[3]) / float(ori_h);
+  for (int i = 0; i < num_regions; ++i) {
+    if (!valid[i]) {
+      continue;
+    }
+    std::array<int, 8> box = region_boxes[i];
+    for (int j = 0; j < 4; ++j) {
+      int x = static_cast<int>(box[2 * j] / ratio_w);
+      int y = static_cast<int>(box[2 * j + 1] / ratio_h);
+      box[2 * j] = std::min(std::max(x, 0), ori_w - 1);
+      box[2 * j + 1] = std::min(std::max(y, 0), ori_h - 1);
+    }
+    int rect_width = static_cast<int>(
+        std::hypot(box[0] - box[2], box[1] - box[3]));
+    int rect_height = static_cast<int>(
+        std::hypot(box[0] - box[6], box[1] - box[7]));
+    if (rect_width <= 4 || rect_height <= 4) {
+      continue;
+    }
+    boxes->push_back(box);
+  }
+}
+
+}  // namespace ocr
+}  // namespace vision
+}  // namespace fastdeploy
@@ -0,0 +1,68 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "fastdeploy/utils/task_pool.h"
+#include "fastdeploy/utils/utils.h"
+
+namespace fastdeploy {
+namespace vision {
+namespace ocr {
+
+/*! @brief Parameters of the DB postprocess, same as the ones of DBDetectorPostprocessor
+ */
+struct FASTDEPLOY_DECL DBPostprocessParams {
+  /// The pixels with probability greater than it are text
+  double thresh = 0.3;
+  /// The regions with score less than it are dropped
+  double box_thresh = 0.6;
+  /// The ratio of the distance the box is expanded by to its area / perimeter
+  double unclip_ratio = 1.5;
+  /// Score the region by its pixels if true, otherwise by its minimum bounding box
+  bool slow_score = true;
+  /// Dilate the bitmap by a 2x2 kernel
+  bool use_dilation = false;
+  /// Max number of the regions of an image
+  int max_candidates = 1000;
+  /// The regions with the longer side of the box less than it are dropped
+  int min_size = 3;
+};
+
+/** \brief Get the text boxes from the probability map of DB
+ *
+ * The thresholded bitmap is labeled by runs of pixels in a single raster scan, and the minimum bounding box of a region is computed from the convex hull of the ends of its runs. The scores are computed by the prefix sums of the rows of the probability map, and the boxes are rectangles, so they are expanded analytically instead of by polygon offsetting. The regions are processed in parallel if `pool` isn't nullptr.
+ *
+ * Different from the contours of OpenCV, the holes of a region are neither regions nor scored, and the expanded box may differ from the polygon offsetting by a pixel.
+ *
+ * \param[in] prob The probability map in shape [height, width]
+ * \param[in] height The height of the map
+ * \param[in] width The width of the map
+ * \param[in] params The parameters of the postprocess
+ * \param[in] det_img_info [width, height] of the original image and [width, height] of the resized image
+ * \param[out] boxes The boxes in the original image, 4 points in clockwise order from the top left one
+ * \param[in] pool Process the regions in parallel if not nullptr
+ */
+FASTDEPLOY_DECL void DBPostprocess(const float* prob, int height, int width,
+                                   const DBPostprocessParams& params,
+                                   const std::array<int, 4>& det_img_info,
+                                   std::vector<std::array<int, 8>>* boxes,
+                                   TaskPool* pool = nullptr);
+
+}  // namespace ocr
+}  // namespace vision
+}  // namespace fastdeploy
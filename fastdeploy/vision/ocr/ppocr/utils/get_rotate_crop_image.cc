@@ -80,6 +80,126 @@ cv::Mat GetRotateCropImage(const cv::Mat& srcimage,
   }
 }
 
+// The product of the 3x3 matrices a * b
+static std::array<double, 9> MatMul3x3(const std::array<double, 9>& a,
+                                       const std::array<double, 9>& b) {
+  std::array<double, 9> c;
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      c[i * 3 + j] = a[i * 3] * b[j] + a[i * 3 + 1] * b[3 + j] +
+                     a[i * 3 + 2] * b[6 + j];
+    }
+  }
+  return c;
+}
+
+void RotateCrop::Rotate180() {
+  std::array<double, 9> rotation = {
+      {-1, 0, width - 1.0, 0, -1, height - 1.0, 0, 0, 1}};
+  transform = MatMul3x3(transform, rotation);
+}
+
+RotateCrop GetRotateCrop(const cv::Mat& image, const std::array<int, 8>& box) {
+  RotateCrop crop;
+  crop.image = &image;
+  int crop_width = int(sqrt(pow(box[0] - box[2], 2) +
+                            pow(box[1] - box[3], 2)));
+  int crop_height = int(sqrt(pow(box[0] - box[6], 2) +
+                             pow(box[1] - box[7], 2)));
+
+  cv::Point2f pts_std[4];
+  pts_std[0] = cv::Point2f(0., 0.);
+  pts_std[1] = cv::Point2f(crop_width, 0.);
+  pts_std[2] = cv::Point2f(crop_width, crop_height);
+  pts_std[3] = cv::Point2f(0.f, crop_height);
+  cv::Point2f pointsf[4];
+  for (int i = 0; i < 4; ++i) {
+    pointsf[i] = cv::Point2f(box[2 * i], box[2 * i + 1]);
+  }
+  // The inverse of the transform warping the image to the crop
+  cv::Mat M = cv::getPerspectiveTransform(pts_std, pointsf);
+  for (int i = 0; i < 9; ++i) {
+    crop.transform[i] = M.at<double>(i / 3, i % 3);
+  }
+  crop.width = crop_width;
+  crop.height = crop_height;
+
+  // Same as the transpose and flip of the tall crops by GetRotateCropImage(),
+  // the pixel (x, y) is the pixel (crop_width - 1 - y, x) of the crop
+  if (float(crop_height) >= float(crop_width) * 1.5) {
+    std::array<double, 9> rotation = {
+        {0, -1, crop_width - 1.0, 1, 0, 0, 0, 0, 1}};
+    crop.transform = MatMul3x3(crop.transform, rotation);
+    crop.width = crop_height;
+    crop.height = crop_width;
+  }
+  return crop;
+}
+
+bool WarpRotateCropToCHW(const RotateCrop& crop, int width, int height,
+                         int stride, const std::vector<float>& alpha,
+                         const std::vector<float>& beta,
+                         const std::vector<float>& pad_values,
+                         float* output) {
+  const cv::Mat& image = *crop.image;
+  if (image.empty() || image.depth() != CV_8U) {
+    FDERROR << "WarpRotateCropToCHW only supports the non-empty images of "
+               "uint8." << std::endl;
+    return false;
+  }
+  int channels = image.channels();
+  size_t num_values = static_cast<size_t>(channels);
+  if (alpha.size() < num_values || beta.size() < num_values ||
+      pad_values.size() < num_values) {
+    FDERROR << "The size of alpha, beta and pad_values should be >= the "
+               "channels of the image " << channels << "." << std::endl;
+    return false;
+  }
+  const double* t = crop.transform.data();
+  // Same sampling positions as cv::resize() by INTER_LINEAR
+  double scale_x = double(std::max(crop.width, 1)) / width;
+  double scale_y = double(std::max(crop.height, 1)) / height;
+  double max_cx = std::max(crop.width - 1, 0);
+  double max_cy = std::max(crop.height - 1, 0);
+  double max_x = image.cols - 1;
+  double max_y = image.rows - 1;
+  size_t plane = size_t(height) * stride;
+  for (int oy = 0; oy < height; ++oy) {
+    double cy = std::min(std::max((oy + 0.5) * scale_y - 0.5, 0.0), max_cy);
+    float* out = output + size_t(oy) * stride;
+    for (int ox = 0; ox < width; ++ox) {
+      double cx = std::min(std::max((ox + 0.5) * scale_x - 0.5, 0.0), max_cx);
+      double w = t[6] * cx + t[7] * cy + t[8];
+      double x = (t[0] * cx + t[1] * cy + t[2]) / w;
+      double y = (t[3] * cx + t[4] * cy + t[5]) / w;
+      // Replicate the border, NaN is mapped to 0 as well
+      x = x > 0 ? (x < max_x ? x : max_x) : 0;
+      y = y > 0 ? (y < max_y ? y : max_y) : 0;
+      int x0 = int(x);
+      int y0 = int(y);
+      int x1 = std::min(x0 + 1, image.cols - 1);
+      int y1 = std::min(y0 + 1, image.rows - 1);
+      float fx = float(x - x0);
+      float fy = float(y - y0);
+      const uchar* row0 = image.ptr<uchar>(y0);
+      const uchar* row1 = image.ptr<uchar>(y1);
+      for (int c = 0; c < channels; ++c) {
+        float top = row0[x0 * channels + c] * (1 - fx) +
+                    row0[x1 * channels + c] * fx;
+        float bottom = row1[x0 * channels + c] * (1 - fx) +
+                       row1[x1 * channels + c] * fx;
+        out[c * plane + ox] = (top * (1 - fy) + bottom * fy) * alpha[c] +
+                              beta[c];
+      }
+    }
+    for (int c = 0; c < channels; ++c) {
+      std::fill(out + c * plane + width, out + c * plane + stride,
+                pad_values[c]);
+    }
+  }
+  return true;
+}
+
 }  // namesoace ocr
 }  // namespace vision
 }  // namespace fastdeploy
@@ -31,10 +31,68 @@ namespace ocr {
 FASTDEPLOY_DECL cv::Mat GetRotateCropImage(const cv::Mat& srcimage,
                            const std::array<int, 8>& box);
 
+/*! @brief The crop of an image for recognition, which is not warped until it's written into the input tensor
+ */
+struct FASTDEPLOY_DECL RotateCrop {
+  /// The cropped image, should outlive the crop
+  const cv::Mat* image = nullptr;
+  /// The perspective transform mapping the pixel (x, y) of the crop to the image
+  std::array<double, 9> transform = {{1, 0, 0, 0, 1, 0, 0, 0, 1}};
+  /// The width of the crop
+  int width = 0;
+  /// The height of the crop
+  int height = 0;
+
+  /// Rotate the crop by 180 degrees, same as cv::rotate() by the classification result
+  void Rotate180();
+};
+
+/** \brief Get the crop of the box, the geometry is the same as GetRotateCropImage(), but the image is not warped
+ *
+ * \param[in] image The image, should outlive the crop
+ * \param[in] box The box of the text
+ * \return The crop of the box
+ */
+FASTDEPLOY_DECL RotateCrop GetRotateCrop(const cv::Mat& image,
+                                         const std::array<int, 8>& box);
+
+/** \brief Warp the crop to width x height by a single bilinear interpolation, without the intermediate images
+ *
+ * Every output pixel is mapped to the image through the position cv::resize() would sample in the warped crop, and the image is interpolated there. GetRotateCropImage() + cv::resize() interpolates twice instead, so the result is an approximation of it, which is close on smooth images but differs at sharp edges, and doesn't apply the area averaging of cv::resize() when shrinking.
+ *
+ * \param[in] crop The crop of an image of uint8
+ * \param[in] width The width of the warped crop
+ * \param[in] height The height of the warped crop
+ * \param[in] stride The width of a row of the output, the columns in [width, stride) are padded
+ * \param[in] alpha The pixel values of channel c are normalized by value * alpha[c] + beta[c]
+ * \param[in] beta The pixel values of channel c are normalized by value * alpha[c] + beta[c]
+ * \param[in] pad_values The normalized padding value of every channel
+ * \param[out] output The warped crop in CHW layout, the size is channels * height * stride
+ * \return true if the crop is warped, false if the image isn't uint8
+ */
+FASTDEPLOY_DECL bool WarpRotateCropToCHW(const RotateCrop& crop, int width,
+                                         int height, int stride,
+                                         const std::vector<float>& alpha,
+                                         const std::vector<float>& beta,
+                                         const std::vector<float>& pad_values,
+                                         float* output);
+
 FASTDEPLOY_DECL void SortBoxes(std::vector<std::array<int, 8>>* boxes);
 
 FASTDEPLOY_DECL std::vector<int> ArgSort(const std::vector<float> &array);
 
+/** \brief Group the images into the recognition batches of similar widths, the images of a batch are padded to the widest one
+ *
+ * \param[in] wh_ratios The width / height ratios of the images
+ * \param[in] min_wh_ratio The width / height ratio of the recognition input, the narrower images are always padded to it, so their padding is not counted
+ * \param[in] max_batch_size Max number of the images of a batch, -1 for unlimited
+ * \param[in] padding_budget Max fraction of the padded area of a batch, e.g 0.2 means at most 20% of the pixels of a batch are padding
+ * \return The indices of the images of every batch, in ascending order of the widths
+ */
+FASTDEPLOY_DECL std::vector<std::vector<int>> BucketByWidth(
+    const std::vector<float>& wh_ratios, float min_wh_ratio,
+    int max_batch_size, float padding_budget);
+
 }  // namespace ocr
 }  // namespace vision
 }  // namespace fastdeploy
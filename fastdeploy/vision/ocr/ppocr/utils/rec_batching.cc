@@ -0,0 +1,62 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+
+#include "fastdeploy/vision/ocr/ppocr/utils/ocr_utils.h"
+
+namespace fastdeploy {
+namespace vision {
+namespace ocr {
+
+std::vector<std::vector<int>> BucketByWidth(const std::vector<float>& wh_ratios,
+                                            float min_wh_ratio,
+                                            int max_batch_size,
+                                            float padding_budget) {
+  std::vector<int> indices(wh_ratios.size());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    indices[i] = static_cast<int>(i);
+  }
+  std::stable_sort(indices.begin(), indices.end(), [&wh_ratios](int a, int b) {
+    return wh_ratios[a] < wh_ratios[b];
+  });
+
+  std::vector<std::vector<int>> batches;
+  std::vector<int> batch;
+  // Sum of the widths of the images in the batch, in the unit of height
+  float sum_width = 0.0f;
+  for (int index : indices) {
+    // The images are in ascending order, so the new one is the widest
+    float width = std::max(wh_ratios[index], min_wh_ratio);
+    size_t size = batch.size() + 1;
+    float padding = 1.0f - (sum_width + width) / (size * width);
+    bool full = max_batch_size > 0 &&
+                batch.size() >= static_cast<size_t>(max_batch_size);
+    if (!batch.empty() && (full || padding > padding_budget)) {
+      batches.push_back(std::move(batch));
+      batch.clear();
+      sum_width = 0.0f;
+    }
+    batch.push_back(index);
+    sum_width += width;
+  }
+  if (!batch.empty()) {
+    batches.push_back(std::move(batch));
+  }
+  return batches;
+}
+
+}  // namespace ocr
+}  // namespace vision
+}  // namespace fastdeploy
@@ -73,6 +73,8 @@ bool PaddleSegModel::Predict(const cv::Mat& im, SegmentationResult* result) {
 
 bool PaddleSegModel::BatchPredict(const std::vector<cv::Mat>& imgs,
                                   std::vector<SegmentationResult>* results) {
+  RequestArenaScope arena_scope(this);
+  PredictScope predict_scope(this);
   std::vector<FDMat> fd_images = WrapMat(imgs);
   // Record the shape of input images
   std::map<std::string, std::vector<std::array<int, 2>>> imgs_info;
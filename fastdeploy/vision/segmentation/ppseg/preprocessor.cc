@@ -26,9 +26,32 @@ PaddleSegPreprocessor::PaddleSegPreprocessor(const std::string& config_file) {
 }
 
 bool PaddleSegPreprocessor::BuildPreprocessPipelineFromConfig() {
-  processors_.clear();
+  std::string options = "PaddleSeg";
+  if (disable_normalize_) {
+    options += " DisableNormalize";
+  }
+  if (disable_permute_) {
+    options += " DisablePermute";
+  }
+  // The config is only parsed by the first preprocessor of the same config
+  plan_ = GetPreprocessPlan(
+      config_file_, options,
+      [this](std::vector<std::shared_ptr<Processor>>* processors) {
+        return ParseConfig(processors);
+      });
+  if (plan_ == nullptr) {
+    return false;
+  }
+  processors_ = plan_->Processors();
+  is_contain_resize_op_ = plan_->HasProcessor("Resize");
+  return true;
+}
+
+bool PaddleSegPreprocessor::ParseConfig(
+    std::vector<std::shared_ptr<Processor>>* processors) const {
   YAML::Node cfg;
-  processors_.push_back(std::make_shared<BGR2RGB>());
+  bool is_contain_resize_op = false;
+  processors->push_back(std::make_shared<BGR2RGB>());
   try {
     cfg = YAML::LoadFile(config_file_);
   } catch (YAML::BadFile& e) {
@@ -52,14 +75,14 @@ bool PaddleSegPreprocessor::BuildPreprocessPipelineFromConfig() {
           if (op["std"]) {
             std = op["std"].as<std::vector<float>>();
           }
-          processors_.push_back(std::make_shared<Normalize>(mean, std));
+          processors->push_back(std::make_shared<Normalize>(mean, std));
         }
       } else if (op["type"].as<std::string>() == "Resize") {
-        is_contain_resize_op_ = true;
+        is_contain_resize_op = true;
         const auto& target_size = op["target_size"];
         int resize_width = target_size[0].as<int>();
         int resize_height = target_size[1].as<int>();
-        processors_.push_back(
+        processors->push_back(
             std::make_shared<Resize>(resize_width, resize_height));
       } else {
         std::string op_name = op["type"].as<std::string>();
@@ -73,18 +96,15 @@ bool PaddleSegPreprocessor::BuildPreprocessPipelineFromConfig() {
     auto input_shape = cfg["Deploy"]["input_shape"];
     int input_height = input_shape[2].as<int>();
     int input_width = input_shape[3].as<int>();
-    if (input_height != -1 && input_width != -1 && !is_contain_resize_op_) {
-      is_contain_resize_op_ = true;
-      processors_.insert(processors_.begin(),
+    if (input_height != -1 && input_width != -1 && !is_contain_resize_op) {
+      is_contain_resize_op = true;
+      processors->insert(processors->begin(),
           std::make_shared<Resize>(input_width, input_height));
     }
   }
   if (!disable_permute_) {
-    processors_.push_back(std::make_shared<HWC2CHW>());
+    processors->push_back(std::make_shared<HWC2CHW>());
   }
-
-  // Fusion will improve performance
-  FuseTransforms(&processors_);
   return true;
 }
 
@@ -104,17 +124,22 @@ bool PaddleSegPreprocessor::Run(std::vector<FDMat>* images, std::vector<FDTensor
                           static_cast<int>(image.Width())});
   }
   (*imgs_info)["shape_info"] = shape_info;
-  for (size_t i = 0; i < processors_.size(); ++i) {
-    if (processors_[i]->Name() == "Resize") {
-      auto processor = dynamic_cast<Resize*>(processors_[i].get());
+  // The processors are shared with the other preprocessors of the config, so
+  // the vertical screen swaps the size of a copy of Resize
+  std::vector<std::shared_ptr<Processor>> processors = processors_;
+  for (size_t i = 0; i < processors.size(); ++i) {
+    if (processors[i]->Name() == "Resize") {
+      auto resize = dynamic_cast<Resize*>(processors[i].get());
       int resize_width = -1;
       int resize_height = -1;
-      std::tie(resize_width, resize_height) = processor->GetWidthAndHeight();
+      std::tie(resize_width, resize_height) = resize->GetWidthAndHeight();
       if (is_vertical_screen_ && (resize_width > resize_height)) {
+        auto processor = std::make_shared<Resize>(*resize);
         if (!(processor->SetWidthAndHeight(resize_height, resize_width))) {
           FDERROR << "Failed to set width and height of "
-                  << processors_[i]->Name() << " processor." << std::endl;
+                  << processors[i]->Name() << " processor." << std::endl;
         }
+        processors[i] = processor;
       }
       break;
     }
@@ -132,16 +157,36 @@ bool PaddleSegPreprocessor::Run(std::vector<FDMat>* images, std::vector<FDTensor
       Resize::Run(&(*images)[i], max_width, max_height);
     }
   }
+  // The last processor is held back so that it may write the images into
+  // their slots of the batch tensor directly
+  size_t num_held = processors.empty() ? 0 : 1;
   for (size_t i = 0; i < img_num; ++i) {
-    for (size_t j = 0; j < processors_.size(); ++j) {
-      if (!(*(processors_[j].get()))(&((*images)[i]))) {
-        FDERROR << "Failed to process image data in " << processors_[i]->Name()
+    for (size_t j = 0; j < processors.size() - num_held; ++j) {
+      if (!(*(processors[j].get()))(&((*images)[i]))) {
+        FDERROR << "Failed to process image data in " << processors[j]->Name()
                 << "." << std::endl;
         return false;
       }
     }
   }
   outputs->resize(1);
+  if (num_held > 0) {
+    FDMatBatch image_batch(images);
+    if (CheckShapeConsistency(images) &&
+        WriteToBatchTensor(processors.back().get(), &image_batch,
+                           (*images)[0].Height(), (*images)[0].Width(),
+                           std::vector<float>((*images)[0].Channels(), 0.0f),
+                           &((*outputs)[0]))) {
+      return true;
+    }
+    for (size_t i = 0; i < img_num; ++i) {
+      if (!(*(processors.back().get()))(&((*images)[i]))) {
+        FDERROR << "Failed to process image data in "
+                << processors.back()->Name() << "." << std::endl;
+        return false;
+      }
+    }
+  }
   // Concat all the preprocessed data to a batch tensor
   std::vector<FDTensor> tensors(img_num);
   for (size_t i = 0; i < img_num; ++i) {
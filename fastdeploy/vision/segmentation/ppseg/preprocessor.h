@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #pragma once
+#include "fastdeploy/vision/common/processors/preprocess_plan.h"
 #include "fastdeploy/vision/common/processors/transform.h"
 #include "fastdeploy/vision/common/result.h"
 
@@ -57,6 +58,11 @@ class FASTDEPLOY_DECL PaddleSegPreprocessor {
 
  private:
   virtual bool BuildPreprocessPipelineFromConfig();
+  // Parse the processors of the config, before fusion
+  bool ParseConfig(std::vector<std::shared_ptr<Processor>>* processors) const;
+  // Shared with the other preprocessors of the same config
+  std::shared_ptr<const PreprocessPlan> plan_;
+  // The processors of the plan, which should not be modified
   std::vector<std::shared_ptr<Processor>> processors_;
   std::string config_file_;
 
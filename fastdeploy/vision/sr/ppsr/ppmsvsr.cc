@@ -56,6 +56,7 @@ bool PPMSVSR::Preprocess(Mat* mat, std::vector<float>& output) {
 
 bool PPMSVSR::Predict(std::vector<cv::Mat>& imgs,
                       std::vector<cv::Mat>& results) {
+  PredictScope predict_scope(this);
   // Theoretically, the more frame nums there are, the better the result will
   // be, but it will lead to a significant increase in memory
   int frame_num = imgs.size();
@@ -169,6 +169,7 @@ bool PPTracking::Initialize() {
 }
 
 bool PPTracking::Predict(cv::Mat *img, MOTResult *result) {
+  PredictScope predict_scope(this);
   Mat mat(*img);
   std::vector<FDTensor> input_tensors;
 
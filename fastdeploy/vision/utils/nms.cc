@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "fastdeploy/function/nms.h"
 #include "fastdeploy/utils/perf.h"
 #include "fastdeploy/vision/utils/utils.h"
 
@@ -19,120 +20,58 @@ namespace fastdeploy {
 namespace vision {
 namespace utils {
 
+// The boxes of the results are the contiguous std::array<float, 4>
+static void HardNMS(const std::vector<std::array<float, 4>>& boxes,
+                    const std::vector<float>& scores, float iou_threshold,
+                    std::vector<int>* keep) {
+  function::NMSParams params;
+  params.iou_threshold = iou_threshold;
+  function::NMS(boxes.empty() ? nullptr : boxes[0].data(), scores.data(),
+                static_cast<int>(scores.size()), params, keep);
+}
+
 // The implementation refers to
 // https://github.com/PaddlePaddle/PaddleDetection/blob/release/2.4/deploy/cpp/src/utils.cc
 void NMS(DetectionResult* result, float iou_threshold,
          std::vector<int>* index) {
-  // get sorted score indices
-  std::vector<int> sorted_indices;
-  if (index != nullptr) {
-    std::map<float, int, std::greater<float>> score_map;
-    for (size_t i = 0; i < result->scores.size(); ++i) {
-      score_map.insert(std::pair<float, int>(result->scores[i], i));
-    }
-    for (auto iter : score_map) {
-      sorted_indices.push_back(iter.second);
-    }
-  }
-  utils::SortDetectionResult(result);
-
-  std::vector<float> area_of_boxes(result->boxes.size());
-  std::vector<int> suppressed(result->boxes.size(), 0);
-  for (size_t i = 0; i < result->boxes.size(); ++i) {
-    area_of_boxes[i] = (result->boxes[i][2] - result->boxes[i][0]) *
-                       (result->boxes[i][3] - result->boxes[i][1]);
-  }
-
-  for (size_t i = 0; i < result->boxes.size(); ++i) {
-    if (suppressed[i] == 1) {
-      continue;
-    }
-    for (size_t j = i + 1; j < result->boxes.size(); ++j) {
-      if (suppressed[j] == 1) {
-        continue;
-      }
-      float xmin = std::max(result->boxes[i][0], result->boxes[j][0]);
-      float ymin = std::max(result->boxes[i][1], result->boxes[j][1]);
-      float xmax = std::min(result->boxes[i][2], result->boxes[j][2]);
-      float ymax = std::min(result->boxes[i][3], result->boxes[j][3]);
-      float overlap_w = std::max(0.0f, xmax - xmin);
-      float overlap_h = std::max(0.0f, ymax - ymin);
-      float overlap_area = overlap_w * overlap_h;
-      float overlap_ratio =
-          overlap_area / (area_of_boxes[i] + area_of_boxes[j] - overlap_area);
-      if (overlap_ratio > iou_threshold) {
-        suppressed[j] = 1;
-      }
-    }
-  }
+  std::vector<int> keep;
+  HardNMS(result->boxes, result->scores, iou_threshold, &keep);
   DetectionResult backup(*result);
   result->Clear();
-  result->Reserve(suppressed.size());
-  for (size_t i = 0; i < suppressed.size(); ++i) {
-    if (suppressed[i] == 1) {
-      continue;
-    }
-    result->boxes.emplace_back(backup.boxes[i]);
-    result->scores.push_back(backup.scores[i]);
-    result->label_ids.push_back(backup.label_ids[i]);
-    if (index != nullptr) {
-      index->push_back(sorted_indices[i]);
-    }
+  result->Reserve(keep.size());
+  for (size_t i = 0; i < keep.size(); ++i) {
+    result->boxes.emplace_back(backup.boxes[keep[i]]);
+    result->scores.push_back(backup.scores[keep[i]]);
+    result->label_ids.push_back(backup.label_ids[keep[i]]);
+  }
+  if (index != nullptr) {
+    index->insert(index->end(), keep.begin(), keep.end());
   }
 }
 
 void NMS(FaceDetectionResult* result, float iou_threshold) {
-  utils::SortDetectionResult(result);
-
-  std::vector<float> area_of_boxes(result->boxes.size());
-  std::vector<int> suppressed(result->boxes.size(), 0);
-  for (size_t i = 0; i < result->boxes.size(); ++i) {
-    area_of_boxes[i] = (result->boxes[i][2] - result->boxes[i][0]) *
-                       (result->boxes[i][3] - result->boxes[i][1]);
-  }
-
-  for (size_t i = 0; i < result->boxes.size(); ++i) {
-    if (suppressed[i] == 1) {
-      continue;
-    }
-    for (size_t j = i + 1; j < result->boxes.size(); ++j) {
-      if (suppressed[j] == 1) {
-        continue;
-      }
-      float xmin = std::max(result->boxes[i][0], result->boxes[j][0]);
-      float ymin = std::max(result->boxes[i][1], result->boxes[j][1]);
-      float xmax = std::min(result->boxes[i][2], result->boxes[j][2]);
-      float ymax = std::min(result->boxes[i][3], result->boxes[j][3]);
-      float overlap_w = std::max(0.0f, xmax - xmin);
-      float overlap_h = std::max(0.0f, ymax - ymin);
-      float overlap_area = overlap_w * overlap_h;
-      float overlap_ratio =
-          overlap_area / (area_of_boxes[i] + area_of_boxes[j] - overlap_area);
-      if (overlap_ratio > iou_threshold) {
-        suppressed[j] = 1;
-      }
-    }
+  int landmarks_per_face = result->landmarks_per_face;
+  if (landmarks_per_face > 0) {
+    FDASSERT(
+        (result->landmarks.size() == result->boxes.size() * landmarks_per_face),
+        "The size of landmarks != boxes.size * landmarks_per_face.");
   }
+  std::vector<int> keep;
+  HardNMS(result->boxes, result->scores, iou_threshold, &keep);
   FaceDetectionResult backup(*result);
-  int landmarks_per_face = result->landmarks_per_face;
 
   result->Clear();
   // don't forget to reset the landmarks_per_face
   // before apply Reserve method.
   result->landmarks_per_face = landmarks_per_face;
-  result->Reserve(suppressed.size());
-  for (size_t i = 0; i < suppressed.size(); ++i) {
-    if (suppressed[i] == 1) {
-      continue;
-    }
-    result->boxes.emplace_back(backup.boxes[i]);
-    result->scores.push_back(backup.scores[i]);
+  result->Reserve(keep.size());
+  for (size_t i = 0; i < keep.size(); ++i) {
+    result->boxes.emplace_back(backup.boxes[keep[i]]);
+    result->scores.push_back(backup.scores[keep[i]]);
     // landmarks (if have)
-    if (result->landmarks_per_face > 0) {
-      for (size_t j = 0; j < result->landmarks_per_face; ++j) {
-        result->landmarks.emplace_back(
-            backup.landmarks[i * result->landmarks_per_face + j]);
-      }
+    for (int j = 0; j < landmarks_per_face; ++j) {
+      result->landmarks.emplace_back(
+          backup.landmarks[keep[i] * landmarks_per_face + j]);
     }
   }
 }
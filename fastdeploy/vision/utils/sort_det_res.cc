@@ -12,68 +12,36 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+
 #include "fastdeploy/vision/utils/utils.h"
 
 namespace fastdeploy {
 namespace vision {
 namespace utils {
 
-void Merge(DetectionResult* result, size_t low, size_t mid, size_t high) {
-  std::vector<std::array<float, 4>>& boxes = result->boxes;
-  std::vector<float>& scores = result->scores;
-  std::vector<int32_t>& label_ids = result->label_ids;
-  std::vector<std::array<float, 4>> temp_boxes(boxes);
-  std::vector<float> temp_scores(scores);
-  std::vector<int32_t> temp_label_ids(label_ids);
-  size_t i = low;
-  size_t j = mid + 1;
-  size_t k = i;
-  for (; i <= mid && j <= high; k++) {
-    if (temp_scores[i] >= temp_scores[j]) {
-      scores[k] = temp_scores[i];
-      label_ids[k] = temp_label_ids[i];
-      boxes[k] = temp_boxes[i];
-      i++;
-    } else {
-      scores[k] = temp_scores[j];
-      label_ids[k] = temp_label_ids[j];
-      boxes[k] = temp_boxes[j];
-      j++;
-    }
-  }
-  while (i <= mid) {
-    scores[k] = temp_scores[i];
-    label_ids[k] = temp_label_ids[i];
-    boxes[k] = temp_boxes[i];
-    k++;
-    i++;
-  }
-  while (j <= high) {
-    scores[k] = temp_scores[j];
-    label_ids[k] = temp_label_ids[j];
-    boxes[k] = temp_boxes[j];
-    k++;
-    j++;
-  }
-}
-
-void MergeSort(DetectionResult* result, size_t low, size_t high) {
-  if (low < high) {
-    size_t mid = (high - low) / 2 + low;
-    MergeSort(result, low, mid);
-    MergeSort(result, mid + 1, high);
-    Merge(result, low, mid, high);
+void SortDetectionResult(DetectionResult* result) {
+  // A stable argsort, the boxes of the same score keep their order
+  std::vector<size_t> indices(result->scores.size());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    indices[i] = i;
   }
-}
+  const std::vector<float>& scores = result->scores;
+  std::stable_sort(
+      indices.begin(), indices.end(),
+      [&scores](size_t a, size_t b) { return scores[a] > scores[b]; });
 
-void SortDetectionResult(DetectionResult* result) {
-  size_t low = 0;
-  size_t high = result->scores.size();
-  if (high == 0) {
-      return;
+  std::vector<std::array<float, 4>> boxes(indices.size());
+  std::vector<float> sorted_scores(indices.size());
+  std::vector<int32_t> label_ids(indices.size());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    boxes[i] = result->boxes[indices[i]];
+    sorted_scores[i] = result->scores[indices[i]];
+    label_ids[i] = result->label_ids[indices[i]];
   }
-  high = high - 1;
-  MergeSort(result, low, high);
+  result->boxes.swap(boxes);
+  result->scores.swap(sorted_scores);
+  result->label_ids.swap(label_ids);
 }
 
 }  // namespace utils
@@ -37,8 +37,9 @@ void SortDetectionResult(FaceDetectionResult* result) {
     indices[i] = i;
   }
   std::vector<float>& scores = result->scores;
-  std::sort(indices.begin(), indices.end(),
-            [&scores](size_t a, size_t b) { return scores[a] > scores[b]; });
+  std::stable_sort(
+      indices.begin(), indices.end(),
+      [&scores](size_t a, size_t b) { return scores[a] > scores[b]; });
 
   // reorder boxes, scores, landmarks (if have).
   FaceDetectionResult backup(*result);
@@ -64,7 +64,7 @@ void NMS(DetectionResult* output, float iou_threshold = 0.5,
 
 void NMS(FaceDetectionResult* result, float iou_threshold = 0.5);
 
-// MergeSort
+// Stable sort by the scores in descending order
 void SortDetectionResult(DetectionResult* output);
 
 void SortDetectionResult(FaceDetectionResult* result);
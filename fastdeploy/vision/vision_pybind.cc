@@ -35,20 +35,44 @@ void BindVisualize(pybind11::module& m);
 void BindVision(pybind11::module& m) {
   pybind11::class_<vision::Mask>(m, "Mask")
       .def(pybind11::init())
-      .def_readwrite("data", &vision::Mask::data)
+      // The RLE mask is decoded only when its data is accessed
+      .def_property(
+          "data",
+          [](const vision::Mask& m) {
+            if (!m.is_rle) {
+              return m.data;
+            }
+            std::vector<uint8_t> data(m.shape[0] * m.shape[1]);
+            m.DecodeTo(data.data());
+            return data;
+          },
+          [](vision::Mask& m, const std::vector<uint8_t>& data) {
+            m.data = data;
+            m.rle.clear();
+            m.is_rle = false;
+          })
       .def_readwrite("shape", &vision::Mask::shape)
+      .def_readwrite("is_rle", &vision::Mask::is_rle)
+      .def_readwrite("rle", &vision::Mask::rle)
+      .def("encode_rle",
+           [](vision::Mask& m) { m.EncodeRLE(); })
+      .def("decode_rle", &vision::Mask::DecodeRLE)
       .def(pybind11::pickle(
           [](const vision::Mask& m) {
-            return pybind11::make_tuple(m.data, m.shape);
+            return pybind11::make_tuple(m.data, m.shape, m.is_rle, m.rle);
           },
           [](pybind11::tuple t) {
-            if (t.size() != 2)
+            if (t.size() != 2 && t.size() != 4)
               throw std::runtime_error(
                   "vision::Mask pickle with invalid state!");
 
             vision::Mask m;
             m.data = t[0].cast<std::vector<uint8_t>>();
             m.shape = t[1].cast<std::vector<int64_t>>();
+            if (t.size() == 4) {
+              m.is_rle = t[2].cast<bool>();
+              m.rle = t[3].cast<std::vector<uint32_t>>();
+            }
 
             return m;
           }))
@@ -20,6 +20,21 @@
 namespace fastdeploy {
 namespace vision {
 
+// Reference to the dense mask data, or decode the RLE mask to the buffer
+static cv::Mat GetMaskMat(const Mask& mask, std::vector<uint8_t>* buffer) {
+  int mask_h = static_cast<int>(mask.shape[0]);
+  int mask_w = static_cast<int>(mask.shape[1]);
+  if (mask.is_rle) {
+    buffer->resize(mask_h * mask_w);
+    mask.DecodeTo(buffer->data());
+    return cv::Mat(mask_h, mask_w, CV_8UC1, buffer->data());
+  }
+  // non-const pointer for cv:Mat constructor, only reference to mask data
+  // (zero copy)
+  return cv::Mat(mask_h, mask_w, CV_8UC1,
+                 const_cast<uint8_t*>(mask.data.data()));
+}
+
 cv::Mat VisDetection(const cv::Mat& im, const DetectionResult& result,
                      float score_threshold, int line_size, float font_size) {
   if (result.contain_masks) {
@@ -35,6 +50,7 @@ cv::Mat VisDetection(const cv::Mat& im, const DetectionResult& result,
   int h = im.rows;
   int w = im.cols;
   auto vis_im = im.clone();
+  std::vector<uint8_t> mask_buffer;
   for (size_t i = 0; i < result.boxes.size(); ++i) {
     if (result.scores[i] < score_threshold) {
       continue;
@@ -67,11 +83,7 @@ cv::Mat VisDetection(const cv::Mat& im, const DetectionResult& result,
     if (result.contain_masks) {
       int mask_h = static_cast<int>(result.masks[i].shape[0]);
       int mask_w = static_cast<int>(result.masks[i].shape[1]);
-      // non-const pointer for cv:Mat constructor
-      uint8_t* mask_raw_data = const_cast<uint8_t*>(
-          static_cast<const uint8_t*>(result.masks[i].Data()));
-      // only reference to mask data (zero copy)
-      cv::Mat mask(mask_h, mask_w, CV_8UC1, mask_raw_data);
+      cv::Mat mask = GetMaskMat(result.masks[i], &mask_buffer);
       if ((mask_h != box_h) || (mask_w != box_w)) {
         cv::resize(mask, mask, cv::Size(box_w, box_h));
       }
@@ -119,6 +131,7 @@ cv::Mat VisDetection(const cv::Mat& im, const DetectionResult& result,
   int h = im.rows;
   int w = im.cols;
   auto vis_im = im.clone();
+  std::vector<uint8_t> mask_buffer;
   for (size_t i = 0; i < result.boxes.size(); ++i) {
     if (result.scores[i] < score_threshold) {
       continue;
@@ -161,11 +174,7 @@ cv::Mat VisDetection(const cv::Mat& im, const DetectionResult& result,
     if (result.contain_masks) {
       int mask_h = static_cast<int>(result.masks[i].shape[0]);
       int mask_w = static_cast<int>(result.masks[i].shape[1]);
-      // non-const pointer for cv:Mat constructor
-      int32_t* mask_raw_data = const_cast<int32_t*>(
-          static_cast<const int32_t*>(result.masks[i].Data()));
-      // only reference to mask data (zero copy)
-      cv::Mat mask(mask_h, mask_w, CV_32SC1, mask_raw_data);
+      cv::Mat mask = GetMaskMat(result.masks[i], &mask_buffer);
       if ((mask_h != box_h) || (mask_w != box_w)) {
         cv::resize(mask, mask, cv::Size(box_w, box_h));
       }
@@ -173,7 +182,7 @@ cv::Mat VisDetection(const cv::Mat& im, const DetectionResult& result,
       int mc0 = 255 - c0 >= 127 ? 255 - c0 : 127;
       int mc1 = 255 - c1 >= 127 ? 255 - c1 : 127;
       int mc2 = 255 - c2 >= 127 ? 255 - c2 : 127;
-      int32_t* mask_data = reinterpret_cast<int32_t*>(mask.data);
+      uint8_t* mask_data = reinterpret_cast<uint8_t*>(mask.data);
       // inplace blending (zero copy)
       uchar* vis_im_data = static_cast<uchar*>(vis_im.data);
       for (size_t i = y1; i < y2; ++i) {
@@ -215,6 +224,7 @@ cv::Mat Visualize::VisDetection(const cv::Mat& im,
   int h = im.rows;
   int w = im.cols;
   auto vis_im = im.clone();
+  std::vector<uint8_t> mask_buffer;
   for (size_t i = 0; i < result.boxes.size(); ++i) {
     if (result.scores[i] < score_threshold) {
       continue;
@@ -247,11 +257,7 @@ cv::Mat Visualize::VisDetection(const cv::Mat& im,
     if (result.contain_masks) {
       int mask_h = static_cast<int>(result.masks[i].shape[0]);
       int mask_w = static_cast<int>(result.masks[i].shape[1]);
-      // non-const pointer for cv:Mat constructor
-      int32_t* mask_raw_data = const_cast<int32_t*>(
-          static_cast<const int32_t*>(result.masks[i].Data()));
-      // only reference to mask data (zero copy)
-      cv::Mat mask(mask_h, mask_w, CV_32SC1, mask_raw_data);
+      cv::Mat mask = GetMaskMat(result.masks[i], &mask_buffer);
       if ((mask_h != box_h) || (mask_w != box_w)) {
         cv::resize(mask, mask, cv::Size(box_w, box_h));
       }
@@ -259,7 +265,7 @@ cv::Mat Visualize::VisDetection(const cv::Mat& im,
       int mc0 = 255 - c0 >= 127 ? 255 - c0 : 127;
       int mc1 = 255 - c1 >= 127 ? 255 - c1 : 127;
       int mc2 = 255 - c2 >= 127 ? 255 - c2 : 127;
-      int32_t* mask_data = reinterpret_cast<int32_t*>(mask.data);
+      uint8_t* mask_data = reinterpret_cast<uint8_t*>(mask.data);
       // inplace blending (zero copy)
       uchar* vis_im_data = static_cast<uchar*>(vis_im.data);
       for (size_t i = y1; i < y2; ++i) {
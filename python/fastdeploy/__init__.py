@@ -23,14 +23,18 @@ from .c_lib_wrap import (
     FDDataType,
     TensorInfo,
     Device,
+    LatencyStage,
     is_built_with_gpu,
     is_built_with_ort,
     ModelFormat,
     is_built_with_paddle,
     is_built_with_trt,
-    get_default_cuda_directory, )
+    get_default_cuda_directory,
+    enable_host_memory_pool,
+    disable_host_memory_pool,
+    get_host_memory_pool_stats, )
 
-from .runtime import Runtime, RuntimeOption
+from .runtime import Runtime, RuntimePool, RuntimeOption
 from .model import FastDeployModel
 from . import c_lib_wrap as C
 from . import vision
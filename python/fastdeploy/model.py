@@ -54,6 +54,27 @@ class FastDeployModel:
     def print_statis_info_of_runtime(self):
         return self._model.print_statis_info_of_runtime()
 
+    def get_stage_latency(self, stage):
+        """Get the latency statistics of a stage over the recent 60 seconds, the time of runtime should be recorded by `enable_record_time_of_runtime()` first.
+
+        :param stage: (fastdeploy.LatencyStage)The stage, e.g fastdeploy.LatencyStage.PREPROCESS
+        :return: LatencyStats with count/mean/p50/p90/p99/max, all the time in milliseconds
+        """
+        return self._model.get_stage_latency(stage)
+
+    def enable_request_arena(self, chunk_size=4 * 1024 * 1024):
+        """Draw the host memory of the tensors created while predicting from a request-scoped arena, which is recycled after each request.
+
+        :param chunk_size: (int)Size of the memory chunk the arena carves tensors from
+        """
+        self._model.enable_request_arena(chunk_size)
+
+    def disable_request_arena(self):
+        self._model.disable_request_arena()
+
+    def get_request_arena_stats(self):
+        return self._model.get_request_arena_stats()
+
     def get_profile_time(self):
         """Get profile time of Runtime after the profile process is done.
         """
@@ -150,6 +150,53 @@ class Runtime:
         return self._runtime.get_profile_time()
 
 
+class RuntimePool:
+    """Pool of FastDeploy Runtime instances cloned from one model, dispatching the requests across them.
+    """
+
+    def __init__(self, runtime_option, num_instances, queue_capacity=1024):
+        """Initialize a FastDeploy RuntimePool object.
+
+        :param runtime_option: (fastdeploy.RuntimeOption)Options for FastDeploy Runtime
+        :param num_instances: (int)Number of the runtime instances
+        :param queue_capacity: (int)Max number of the requests waiting in queue, the requests submitted to a full queue fail
+        """
+
+        self._pool = C.RuntimePool()
+        self.runtime_option = runtime_option
+        assert self._pool.init(self.runtime_option._option, num_instances,
+                               queue_capacity), "Initialize RuntimePool Failed!"
+
+    def infer(self, data):
+        """Inference with input data by an idle instance, can be called from multiple python threads.
+
+        :param data: (dict[str : numpy.ndarray])The input data dict, key value must keep same with the loaded model
+        :return list of numpy.ndarray
+        """
+        assert isinstance(data, dict), "The input data should be type of dict."
+        return self._pool.infer(data)
+
+    def num_instances(self):
+        """Get number of the runtime instances
+        """
+        return self._pool.num_instances()
+
+    def queue_depth(self):
+        """Get number of the requests waiting in queue
+        """
+        return self._pool.queue_depth()
+
+    def get_stats(self):
+        """Get statistics(queue depth, requests and utilization of every instance) of the pool.
+        """
+        return self._pool.get_stats()
+
+    def reset_stats(self):
+        """Reset the statistics of requests and utilization.
+        """
+        self._pool.reset_stats()
+
+
 class RuntimeOption:
     """Options for FastDeploy Runtime.
     """
@@ -513,6 +560,49 @@ class RuntimeOption:
         """
         return self._option.disable_pinned_memory()
 
+    def enable_model_mmap(self):
+        """Map the model and parameter files into memory instead of reading them into heap, the pages are shared by all the processes loading the same model.
+        """
+        return self._option.enable_model_mmap()
+
+    def disable_model_mmap(self):
+        """Read the model and parameter files into heap while loading model.
+        """
+        return self._option.disable_model_mmap()
+
+    def set_paddle2onnx_cache_dir(self, cache_dir):
+        """Cache the ONNX model converted from Paddle model in a directory, ONNX Runtime and TensorRT backend will load the cached model directly while the same model is loaded next time.
+
+        :param cache_dir: (str)Directory of the cache, can be shared by multiple processes
+        """
+        return self._option.set_paddle2onnx_cache_dir(cache_dir)
+
+    def set_shape_buckets(self, input_name, shapes, pad_value=0.0):
+        """Round the shape of a dynamic input up to the smallest of several canonical shapes by padding, the outputs are cropped back by set_shape_bucket_crop(). The backend only sees a few shapes and keeps a prepared plan for each of them.
+
+        :param input_name: (str)Name of the input
+        :param shapes: (list of list of int)Canonical shapes of the input, -1 means the dimension is kept as is(e.g the batch size)
+        :param pad_value: (float)Value filled into the padded area
+        """
+        return self._option.set_shape_buckets(input_name, shapes, pad_value)
+
+    def set_shape_bucket_crop(self,
+                              output_name,
+                              output_axis,
+                              input_name,
+                              input_axis,
+                              scale=1.0):
+        """Crop an axis of an output back after the input it follows is padded by the shape buckets, the outputs are returned as is by default.
+
+        :param output_name: (str)Name of the output
+        :param output_axis: (int)Axis of the output to crop
+        :param input_name: (str)Name of the bucketed input
+        :param input_axis: (int)Axis of the input the output axis follows
+        :param scale: (float)The output axis is cropped to ceil(original size of the input axis * scale), e.g 0.25 for a feature map downsampled by 4
+        """
+        return self._option.set_shape_bucket_crop(
+            output_name, output_axis, input_name, input_axis, scale)
+
     def enable_paddle_to_trt(self):
         """While using TensorRT backend, enable_paddle_to_trt() will change to use Paddle Inference backend, and use its integrated TensorRT instead.
         """
@@ -34,3 +34,33 @@ class ProcessorManager:
         :param: gpu_id: GPU device id
         """
         return self._manager.use_cuda(enable_cv_cuda, gpu_id)
+
+    def enable_fused_pipeline(self, enable=True):
+        """Run the CPU preprocessing in a single fused pass, which only takes effect while the processors are Resize -> CenterCrop -> Normalize -> HWC2CHW like
+
+        :param: enable: True to enable the fused pipeline
+        """
+        return self._manager.enable_fused_pipeline(enable)
+
+    def set_thread_num(self, thread_num):
+        """Set the number of threads processing the images of a batch in parallel on CPU, which is separate from the cpu_thread_num of the runtime
+
+        :param: thread_num: (int) The number of threads, including the calling thread
+        """
+        return self._manager.set_thread_num(thread_num)
+
+    def prepare_input_size(self, width, height):
+        """Precompute the resize coefficients of the fused pipeline for an input resolution, e.g. the resolution of a video
+
+        :param: width: (int) Width of the input image
+        :param: height: (int) Height of the input image
+        :return: True if the coefficients are computed
+        """
+        return self._manager.prepare_input_size(width, height)
+
+    def enable_auto_proc_lib(self, enable=True):
+        """Choose the image processing library of every processor from the built-in per-op cost table. The library is only used by this manager instead of the whole process
+
+        :param: enable: True to enable the automatic choice
+        """
+        return self._manager.enable_auto_proc_lib(enable)
@@ -141,6 +141,13 @@ class YOLOv5SegPostprocessor:
         """
         return self._postprocessor.multi_label
 
+    @property
+    def mask_rle(self):
+        """
+        Whether to output the masks in RLE, default is False
+        """
+        return self._postprocessor.mask_rle
+
     @conf_threshold.setter
     def conf_threshold(self, conf_threshold):
         assert isinstance(conf_threshold, float),\
@@ -160,6 +167,12 @@ class YOLOv5SegPostprocessor:
             bool), "The value to set `multi_label` must be type of bool."
         self._postprocessor.multi_label = value
 
+    @mask_rle.setter
+    def mask_rle(self, value):
+        assert isinstance(
+            value, bool), "The value to set `mask_rle` must be type of bool."
+        self._postprocessor.mask_rle = value
+
 
 class YOLOv5Seg(FastDeployModel):
     def __init__(self,
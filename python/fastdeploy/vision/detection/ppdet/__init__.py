@@ -48,6 +48,30 @@ class PaddleDetPreprocessor:
         """
         self._preprocessor.disable_permute()
 
+    def enable_fused_pipeline(self, enable=True):
+        """
+        Run the CPU preprocessing in a single fused pass, which only takes effect while the processors are Resize -> Normalize -> Permute like.
+
+        :param: enable: True to enable the fused pipeline
+        """
+        self._preprocessor.enable_fused_pipeline(enable)
+
+    def set_thread_num(self, thread_num):
+        """
+        Set the number of threads processing the images of a batch in parallel on CPU, which is separate from the cpu_thread_num of the runtime.
+
+        :param: thread_num: (int) The number of threads, including the calling thread
+        """
+        self._preprocessor.set_thread_num(thread_num)
+
+    def enable_auto_proc_lib(self, enable=True):
+        """
+        Choose the image processing library of every processor from the built-in per-op cost table. The library is only used by this preprocessor instead of the whole process.
+
+        :param: enable: True to enable the automatic choice
+        """
+        self._preprocessor.enable_auto_proc_lib(enable)
+
 
 class NMSOption:
     def __init__(self):
@@ -80,6 +104,19 @@ class PaddleDetPostprocessor:
             nms_option = NMSOption()
         self._postprocessor.ApplyDecodeAndNMS(self, nms_option.nms_option)
 
+    @property
+    def mask_rle(self):
+        """
+        Whether to output the masks of instance segmentation models in RLE, default is False
+        """
+        return self._postprocessor.mask_rle
+
+    @mask_rle.setter
+    def mask_rle(self, value):
+        assert isinstance(
+            value, bool), "The value to set `mask_rle` must be type of bool."
+        self._postprocessor.mask_rle = value
+
 
 class PPYOLOE(FastDeployModel):
     def __init__(self,
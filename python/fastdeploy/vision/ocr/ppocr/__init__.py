@@ -145,6 +145,34 @@ class DBDetectorPostprocessor:
             bool), "The value to set `use_dilation` must be type of bool."
         self._postprocessor.use_dilation = value
 
+    @property
+    def use_fast_postprocess(self):
+        """
+        Whether to use the fast engine labeling the regions by runs and expanding the boxes analytically, default False
+        """
+        return self._postprocessor.use_fast_postprocess
+
+    @use_fast_postprocess.setter
+    def use_fast_postprocess(self, value):
+        assert isinstance(
+            value, bool
+        ), "The value to set `use_fast_postprocess` must be type of bool."
+        self._postprocessor.use_fast_postprocess = value
+
+    @property
+    def thread_num(self):
+        """
+        Number of threads processing the images of a batch and the regions of an image in parallel, default 1
+        """
+        return self._postprocessor.thread_num
+
+    @thread_num.setter
+    def thread_num(self, value):
+        assert isinstance(
+            value, int), "The value to set `thread_num` must be type of int."
+        assert value > 0, "The value to set `thread_num` must be > 0."
+        self._postprocessor.thread_num = value
+
 
 class DBDetector(FastDeployModel):
     def __init__(self,
@@ -582,6 +610,20 @@ class RecognizerPreprocessor:
             list), "The value to set `rec_image_shape` must be type of list."
         self._preprocessor.rec_image_shape = value
 
+    @property
+    def thread_num(self):
+        """
+        Number of threads writing the crops of a batch into the input tensor in parallel, default 1
+        """
+        return self._preprocessor.thread_num
+
+    @thread_num.setter
+    def thread_num(self, value):
+        assert isinstance(
+            value, int), "The value to set `thread_num` must be type of int."
+        assert value > 0, "The value to set `thread_num` must be > 0."
+        self._preprocessor.thread_num = value
+
 
 class RecognizerPostprocessor:
     def __init__(self, label_path):
@@ -597,6 +639,34 @@ class RecognizerPostprocessor:
         """
         return self._postprocessor.run(runtime_results)
 
+    @property
+    def thread_num(self):
+        """
+        Number of threads decoding the samples of a batch in parallel, default 1
+        """
+        return self._postprocessor.thread_num
+
+    @thread_num.setter
+    def thread_num(self, value):
+        assert isinstance(
+            value, int), "The value to set `thread_num` must be type of int."
+        assert value > 0, "The value to set `thread_num` must be > 0."
+        self._postprocessor.thread_num = value
+
+    @property
+    def beam_size(self):
+        """
+        Beam size of CTC decoding, 1 is the greedy decoding, default 1
+        """
+        return self._postprocessor.beam_size
+
+    @beam_size.setter
+    def beam_size(self, value):
+        assert isinstance(
+            value, int), "The value to set `beam_size` must be type of int."
+        assert value > 0, "The value to set `beam_size` must be > 0."
+        self._postprocessor.beam_size = value
+
 
 class Recognizer(FastDeployModel):
     def __init__(self,
@@ -786,6 +856,35 @@ class PPOCRv3(FastDeployModel):
             int), "The value to set `rec_batch_size` must be type of int."
         self.system_.rec_batch_size = value
 
+    @property
+    def rec_padding_budget(self):
+        """
+        Max fraction of the padded area of a recognition batch, the crops of all the images of batch_predict are grouped into the batches of similar widths if it's in [0, 1], negative to disable, default -1
+        """
+        return self.system_.rec_padding_budget
+
+    @rec_padding_budget.setter
+    def rec_padding_budget(self, value):
+        assert isinstance(
+            value, (int, float)
+        ), "The value to set `rec_padding_budget` must be type of float."
+        assert value <= 1.0, "The value to set `rec_padding_budget` must be <= 1.0."
+        self.system_.rec_padding_budget = value
+
+    @property
+    def use_fused_rec_crop(self):
+        """
+        Whether to warp the text boxes straight into the input tensor of the recognizer by a single interpolation, instead of cropping, rotating and resizing them as images, default False. The input of the recognizer is close to but not the same as the default one
+        """
+        return self.system_.use_fused_rec_crop
+
+    @use_fused_rec_crop.setter
+    def use_fused_rec_crop(self, value):
+        assert isinstance(
+            value,
+            bool), "The value to set `use_fused_rec_crop` must be type of bool."
+        self.system_.use_fused_rec_crop = value
+
 
 class PPOCRSystemv3(PPOCRv3):
     def __init__(self, det_model=None, cls_model=None, rec_model=None):
@@ -863,6 +962,35 @@ class PPOCRv2(FastDeployModel):
             int), "The value to set `rec_batch_size` must be type of int."
         self.system_.rec_batch_size = value
 
+    @property
+    def rec_padding_budget(self):
+        """
+        Max fraction of the padded area of a recognition batch, the crops of all the images of batch_predict are grouped into the batches of similar widths if it's in [0, 1], negative to disable, default -1
+        """
+        return self.system_.rec_padding_budget
+
+    @rec_padding_budget.setter
+    def rec_padding_budget(self, value):
+        assert isinstance(
+            value, (int, float)
+        ), "The value to set `rec_padding_budget` must be type of float."
+        assert value <= 1.0, "The value to set `rec_padding_budget` must be <= 1.0."
+        self.system_.rec_padding_budget = value
+
+    @property
+    def use_fused_rec_crop(self):
+        """
+        Whether to warp the text boxes straight into the input tensor of the recognizer by a single interpolation, instead of cropping, rotating and resizing them as images, default False. The input of the recognizer is close to but not the same as the default one
+        """
+        return self.system_.use_fused_rec_crop
+
+    @use_fused_rec_crop.setter
+    def use_fused_rec_crop(self, value):
+        assert isinstance(
+            value,
+            bool), "The value to set `use_fused_rec_crop` must be type of bool."
+        self.system_.use_fused_rec_crop = value
+
 
 class PPOCRSystemv2(PPOCRv2):
     def __init__(self, det_model=None, cls_model=None, rec_model=None):
@@ -873,3 +1001,40 @@ class PPOCRSystemv2(PPOCRv2):
 
     def predict(self, input_image):
         return super(PPOCRSystemv2, self).predict(input_image)
+
+
+class PPOCRPipeline:
+    def __init__(self, ocr, option=None):
+        """Construct a streaming executor of a PP-OCR pipeline, running detection, cropping, classification and recognition as pipelined stages on the clones of the models
+
+        :param ocr: (PPOCRv2 or PPOCRv3) The pipeline whose models and batch sizes are used
+        :param option: (fastdeploy.vision.ocr.PPOCRPipelineOption) Queue capacity, detection batch size and max delay of batching, None to use the default option
+        """
+        if option is None:
+            option = C.vision.ocr.PPOCRPipelineOption()
+        self._pipeline = C.vision.ocr.PPOCRPipeline(ocr.system_, option)
+        assert self._pipeline.initialized(
+        ), "Initialize PPOCRPipeline Failed!"
+
+    def predict(self, input_image):
+        """Predict an input image, can be called from multiple python threads
+
+        :param input_image: (numpy.ndarray)The input image data, 3-D array with layout HWC, BGR format
+        :return: OCRResult
+        """
+        return self._pipeline.predict(input_image)
+
+    def batch_predict(self, images):
+        """Predict a list of input images, the boxes of different images are recognized in the same batches
+        :param images: (list of numpy.ndarray) The input image list, each element is a 3-D array with layout HWC, BGR format
+        :return: OCRBatchResult
+        """
+        return self._pipeline.batch_predict(images)
+
+    def get_stats(self):
+        """Get statistics(number of images, boxes and batches) of the pipeline
+        """
+        return self._pipeline.get_stats()
+
+
+PPOCRPipelineOption = C.vision.ocr.PPOCRPipelineOption
@@ -17,10 +17,17 @@ from .. import c_lib_wrap as C
 
 
 def mask_to_json(result):
-    r_json = {
-        "data": result.data,
-        "shape": result.shape,
-    }
+    # Keep the RLE mask encoded
+    if result.is_rle:
+        r_json = {
+            "rle": result.rle,
+            "shape": result.shape,
+        }
+    else:
+        r_json = {
+            "data": result.data,
+            "shape": result.shape,
+        }
     return json.dumps(r_json)
 
 
@@ -159,7 +166,11 @@ def fd_result_to_json(result):
 
 def json_to_mask(result):
     mask = C.vision.Mask()
-    mask.data = result['data']
+    if 'rle' in result:
+        mask.rle = result['rle']
+        mask.is_rle = True
+    else:
+        mask.data = result['data']
     mask.shape = result['shape']
     return mask
 
@@ -22,6 +22,7 @@ namespace fastdeploy {
 namespace streamer {
 enum PixelFormat {
   I420,
+  NV12,
   BGR
 };
 
@@ -65,7 +65,7 @@ GstElement* CreatePipeline(const std::string& pipeline_desc) {
 }
 
 std::vector<int64_t> GetFrameShape(const Frame& frame) {
-  if (frame.format == PixelFormat::I420) {
+  if (frame.format == PixelFormat::I420 || frame.format == PixelFormat::NV12) {
     return { frame.height * 3 / 2, frame.width, 1 };
   } else if (frame.format == PixelFormat::BGR) {
     return { frame.height, frame.width, 3 };
@@ -77,6 +77,8 @@ std::vector<int64_t> GetFrameShape(const Frame& frame) {
 PixelFormat GetPixelFormat(const std::string& format) {
   if (format == "I420") {
     return PixelFormat::I420;
+  } else if (format == "NV12") {
+    return PixelFormat::NV12;
   } else if (format == "BGR") {
     return PixelFormat::BGR;
   } else {
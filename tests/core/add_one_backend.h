@@ -0,0 +1,122 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "fastdeploy/runtime/backends/backend.h"
+#include "fastdeploy/utils/unique_ptr.h"
+
+namespace fastdeploy {
+
+// A backend of the model y = x + 1 with FP32 input `x` and output `y`, used
+// to test Runtime without a real backend. With `support_async`, every
+// asynchronous request runs in its own thread like the requests of OpenVINO.
+class AddOneBackend : public BaseBackend {
+ public:
+  explicit AddOneBackend(bool support_async = false)
+      : support_async_(support_async) {
+    initialized_ = true;
+  }
+
+  // Waits for the asynchronous requests in flight
+  ~AddOneBackend() {
+    std::vector<std::thread> threads;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      threads.swap(threads_);
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  int NumInputs() const override { return 1; }
+  int NumOutputs() const override { return 1; }
+  TensorInfo GetInputInfo(int index) override {
+    TensorInfo info;
+    info.name = "x";
+    info.shape = {-1};
+    info.dtype = FDDataType::FP32;
+    return info;
+  }
+  TensorInfo GetOutputInfo(int index) override {
+    TensorInfo info;
+    info.name = "y";
+    info.shape = {-1};
+    info.dtype = FDDataType::FP32;
+    return info;
+  }
+  std::vector<TensorInfo> GetInputInfos() override { return {GetInputInfo(0)}; }
+  std::vector<TensorInfo> GetOutputInfos() override {
+    return {GetOutputInfo(0)};
+  }
+
+  bool Infer(std::vector<FDTensor>& inputs, std::vector<FDTensor>* outputs,
+             bool copy_to_fd = true) override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      input_shapes_.push_back(inputs[0].shape);
+    }
+    outputs->resize(1);
+    (*outputs)[0].Resize(inputs[0].shape, FDDataType::FP32, "y");
+    const float* x = reinterpret_cast<const float*>(inputs[0].Data());
+    float* y = reinterpret_cast<float*>((*outputs)[0].MutableData());
+    for (int i = 0; i < inputs[0].Numel(); ++i) {
+      y[i] = x[i] + 1;
+    }
+    num_infers_++;
+    return true;
+  }
+
+  bool SupportAsync() const override { return support_async_; }
+
+  bool InferAsync(std::vector<FDTensor>& inputs,
+                  std::vector<FDTensor>* outputs,
+                  const std::function<void(bool)>& callback) override {
+    std::vector<FDTensor>* inputs_ptr = &inputs;
+    std::lock_guard<std::mutex> lock(mutex_);
+    threads_.emplace_back([this, inputs_ptr, outputs, callback]() {
+      callback(Infer(*inputs_ptr, outputs));
+    });
+    return true;
+  }
+
+  std::unique_ptr<BaseBackend> Clone(RuntimeOption& runtime_option,
+                                     void* stream = nullptr,
+                                     int device_id = -1) override {
+    return utils::make_unique<AddOneBackend>(support_async_);
+  }
+
+  int NumInfers() const { return num_infers_.load(); }
+
+  // Shapes of the inputs the backend has seen
+  std::vector<std::vector<int64_t>> InputShapes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return input_shapes_;
+  }
+
+ private:
+  bool support_async_;
+  std::atomic<int> num_infers_{0};
+  std::mutex mutex_;
+  std::vector<std::vector<int64_t>> input_shapes_;
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace fastdeploy
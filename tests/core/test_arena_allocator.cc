@@ -0,0 +1,159 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fastdeploy/core/arena_allocator.h"
+#include "fastdeploy/core/fd_tensor.h"
+#include "fastdeploy/fastdeploy_model.h"
+#include "gtest_utils.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <vector>
+
+namespace fastdeploy {
+
+TEST(fastdeploy, arena_allocator) {
+  FDArenaAllocator arena(1024);
+  void* ptr0 = arena.Allocate(100);
+  void* ptr1 = arena.Allocate(100);
+  ASSERT_NE(ptr0, nullptr);
+  ASSERT_NE(ptr1, nullptr);
+  ASSERT_GE(arena.UsableSize(ptr0), 100);
+  // Blocks of the same chunk are contiguous
+  ASSERT_EQ(reinterpret_cast<char*>(ptr1) - reinterpret_cast<char*>(ptr0),
+            arena.UsableSize(ptr0) + 16);
+
+  // The chunk can't be rewound while some block is alive
+  arena.Free(ptr0);
+  arena.Reset();
+  void* ptr2 = arena.Allocate(100);
+  ASSERT_NE(ptr2, ptr0);
+
+  arena.Free(ptr1);
+  arena.Free(ptr2);
+  arena.Reset();
+  void* ptr3 = arena.Allocate(100);
+  ASSERT_EQ(ptr3, ptr0);
+  arena.Free(ptr3);
+
+  // Requests larger than a chunk get their own chunk
+  void* ptr4 = arena.Allocate(4096);
+  ASSERT_GE(arena.UsableSize(ptr4), 4096);
+  arena.Free(ptr4);
+  auto stats = arena.GetStats();
+  ASSERT_EQ(stats.bytes_in_use, 0);
+  ASSERT_EQ(stats.num_allocs, 5);
+  ASSERT_EQ(stats.num_hits, 3);
+}
+
+TEST(fastdeploy, arena_scope) {
+  auto arena = std::make_shared<FDArenaAllocator>(1024);
+  FDTensor persistent;
+  {
+    ArenaScope scope(arena);
+    FDTensor tensor;
+    tensor.Resize({16}, FDDataType::FP32);
+    ASSERT_EQ(tensor.host_allocator, arena);
+    persistent.Resize({16}, FDDataType::FP32);
+    {
+      // Nested scope of the same arena doesn't reset it
+      ArenaScope inner_scope(arena);
+    }
+    ASSERT_EQ(arena->GetStats().bytes_in_use, 128);
+  }
+  // The tensor allocated in the scope is still valid after the scope exits
+  ASSERT_EQ(persistent.host_allocator, arena);
+  ASSERT_EQ(arena->GetStats().bytes_in_use, 64);
+  ASSERT_EQ(GetCurrentHostAllocator(), GetDefaultHostAllocator());
+
+  FDTensor tensor;
+  tensor.Resize({16}, FDDataType::FP32);
+  ASSERT_EQ(tensor.host_allocator, nullptr);
+}
+
+TEST(fastdeploy, arena_allocator_free_last_block) {
+  FDArenaAllocator arena(1024);
+  void* ptr0 = arena.Allocate(100);
+  void* ptr1 = arena.Allocate(100);
+  // Freeing the last block moves the pointer back
+  arena.Free(ptr1);
+  void* ptr2 = arena.Allocate(100);
+  ASSERT_EQ(ptr2, ptr1);
+  // The chunk is rewound once all of its blocks are freed
+  arena.Free(ptr0);
+  arena.Free(ptr2);
+  void* ptr3 = arena.Allocate(100);
+  ASSERT_EQ(ptr3, ptr0);
+  arena.Free(ptr3);
+}
+
+TEST(fastdeploy, move_out_of_arena) {
+  auto arena = std::make_shared<FDArenaAllocator>(1024);
+  FDTensor tensor;
+  {
+    ArenaScope scope(arena);
+    tensor.Resize({16}, FDDataType::FP32);
+    for (int i = 0; i < 16; ++i) {
+      reinterpret_cast<float*>(tensor.MutableData())[i] = i;
+    }
+    MoveOutOfArena(&tensor);
+    ASSERT_EQ(tensor.host_allocator, GetDefaultHostAllocator());
+    ASSERT_EQ(arena->GetStats().bytes_in_use, 0);
+  }
+  CheckShape check_shape;
+  CheckData check_data;
+  check_shape(tensor.shape, {16});
+  std::vector<float> expected(16);
+  for (int i = 0; i < 16; ++i) {
+    expected[i] = i;
+  }
+  check_data(reinterpret_cast<const float*>(tensor.Data()), expected.data(),
+             16);
+}
+
+// Mimic the Predict() of the models, the preprocess output escapes the
+// request into the reused tensors of the model
+class ArenaTestModel : public FastDeployModel {
+ public:
+  std::string ModelName() const override { return "ArenaTestModel"; }
+
+  bool Predict(int height) {
+    RequestArenaScope arena_scope(this);
+    FDTensor image;
+    image.Resize({1, 3, height, 32}, FDDataType::FP32);
+    reused_input_tensors_.resize(1);
+    reused_input_tensors_[0] = std::move(image);
+    reused_output_tensors_.resize(1);
+    reused_output_tensors_[0].Resize({1, height}, FDDataType::FP32);
+    FDTensor result;
+    result.Resize({height}, FDDataType::FP32);
+    return true;
+  }
+};
+
+TEST(fastdeploy, request_arena_flat_over_requests) {
+  ArenaTestModel model;
+  model.EnableRequestArena(64 * 1024);
+  ASSERT_TRUE(model.Predict(32));
+  auto stats = model.GetRequestArenaStats();
+  size_t chunk_bytes = stats.bytes_in_use + stats.bytes_cached;
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(model.Predict(32 + i % 4));
+    stats = model.GetRequestArenaStats();
+    // Nothing of a request is left in the arena, and it doesn't grow
+    ASSERT_EQ(stats.bytes_in_use, 0);
+    ASSERT_EQ(stats.bytes_in_use + stats.bytes_cached, chunk_bytes);
+  }
+}
+
+}  // namespace fastdeploy
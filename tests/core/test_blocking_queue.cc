@@ -0,0 +1,73 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fastdeploy/utils/blocking_queue.h"
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+
+namespace fastdeploy {
+
+TEST(fastdeploy, blocking_queue) {
+  // The producer is blocked by the capacity, the items keep their order
+  BlockingQueue<int> queue(2);
+  std::thread producer([&queue]() {
+    for (int i = 0; i < 100; ++i) {
+      ASSERT_TRUE(queue.Push(int(i)));
+      ASSERT_LE(queue.Size(), 2u);
+    }
+    queue.Close();
+  });
+  int item = -1;
+  int expected = 0;
+  while (queue.Pop(&item)) {
+    ASSERT_EQ(item, expected++);
+  }
+  producer.join();
+  ASSERT_EQ(expected, 100);
+  ASSERT_FALSE(queue.Push(0));
+}
+
+TEST(fastdeploy, blocking_queue_pop_batch) {
+  BlockingQueue<int> queue(16);
+  std::vector<int> batch;
+  for (int i = 0; i < 5; ++i) {
+    queue.Push(int(i));
+  }
+  // A full batch is popped without waiting
+  ASSERT_EQ(queue.PopBatch(&batch, 3, std::chrono::seconds(10)), 3u);
+  // A partial batch is popped once the delay expires
+  ASSERT_EQ(queue.PopBatch(&batch, 3, std::chrono::milliseconds(10)), 2u);
+  ASSERT_EQ(batch, std::vector<int>({0, 1, 2, 3, 4}));
+
+  // The items pushed while waiting join the batch
+  batch.clear();
+  std::thread producer([&queue]() {
+    for (int i = 0; i < 4; ++i) {
+      queue.Push(int(i));
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+  ASSERT_EQ(queue.PopBatch(&batch, 4, std::chrono::seconds(10)), 4u);
+  producer.join();
+
+  // The closed queue is drained, then returns an empty batch
+  queue.Push(7);
+  queue.Close();
+  batch.clear();
+  ASSERT_EQ(queue.PopBatch(&batch, 4, std::chrono::seconds(10)), 1u);
+  ASSERT_EQ(queue.PopBatch(&batch, 4, std::chrono::seconds(10)), 0u);
+}
+
+}  // namespace fastdeploy
@@ -0,0 +1,85 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fastdeploy/utils/dynamic_batcher.h"
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+
+namespace fastdeploy {
+
+TEST(fastdeploy, dynamic_batcher) {
+  DynamicBatcherOption option;
+  option.max_batch_size = 4;
+  option.max_delay_us = 200000;
+  std::vector<size_t> batch_sizes;
+  DynamicBatcher<int, int> batcher(
+      [&](const std::vector<int>& inputs, std::vector<int>* results) {
+        batch_sizes.push_back(inputs.size());
+        for (auto input : inputs) {
+          results->push_back(input * 2);
+        }
+        return true;
+      },
+      option);
+
+  // Full batches are run without waiting for the delay
+  std::vector<int> results(8, 0);
+  std::vector<std::future<bool>> futures;
+  for (int i = 0; i < 8; ++i) {
+    futures.push_back(batcher.PredictAsync(i, &results[i]));
+  }
+  for (int i = 0; i < 8; ++i) {
+    ASSERT_TRUE(futures[i].get());
+    ASSERT_EQ(results[i], i * 2);
+  }
+  ASSERT_EQ(batch_sizes.size(), 2);
+  ASSERT_EQ(batch_sizes[0], 4);
+
+  // A partial batch is run once the delay expires
+  std::vector<std::thread> threads;
+  std::vector<int> partial(3, 0);
+  for (int i = 0; i < 3; ++i) {
+    threads.emplace_back(
+        [&, i]() { ASSERT_TRUE(batcher.Predict(i + 10, &partial[i])); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(partial[i], (i + 10) * 2);
+  }
+  auto stats = batcher.GetStats();
+  ASSERT_EQ(stats.num_requests, 11);
+  ASSERT_GE(stats.AverageBatchSize(), 1.0);
+  ASSERT_EQ(stats.num_failed_batches, 0);
+}
+
+TEST(fastdeploy, dynamic_batcher_failure) {
+  DynamicBatcherOption option;
+  option.max_batch_size = 2;
+  option.max_delay_us = 0;
+  // Returns fewer results than inputs
+  DynamicBatcher<int, int> batcher(
+      [](const std::vector<int>& inputs, std::vector<int>* results) {
+        results->resize(inputs.size() - 1);
+        return true;
+      },
+      option);
+  int result = 0;
+  ASSERT_FALSE(batcher.Predict(1, &result));
+  ASSERT_EQ(batcher.GetStats().num_failed_batches, 1);
+}
+
+}  // namespace fastdeploy
@@ -0,0 +1,126 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fastdeploy/core/fd_tensor.h"
+#include "fastdeploy/core/host_pool_allocator.h"
+#include "gtest_utils.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace fastdeploy {
+
+TEST(fastdeploy, host_pool_allocator) {
+  FDHostPoolAllocator allocator;
+  void* ptr0 = allocator.Allocate(1000);
+  ASSERT_NE(ptr0, nullptr);
+  ASSERT_GE(allocator.UsableSize(ptr0), 1000);
+  allocator.Free(ptr0);
+
+  // The freed block is reused by the request in the same bucket
+  void* ptr1 = allocator.Allocate(900);
+  ASSERT_EQ(ptr0, ptr1);
+  auto stats = allocator.GetStats();
+  ASSERT_EQ(stats.num_allocs, 2);
+  ASSERT_EQ(stats.num_hits, 1);
+  ASSERT_EQ(stats.bytes_in_use, allocator.UsableSize(ptr1));
+  allocator.Free(ptr1);
+  stats = allocator.GetStats();
+  ASSERT_EQ(stats.bytes_in_use, 0);
+  ASSERT_GT(stats.peak_bytes_in_use, 0);
+  ASSERT_GT(stats.bytes_cached, 0);
+
+  allocator.ReleaseCachedMemory();
+  ASSERT_EQ(allocator.GetStats().bytes_cached, 0);
+}
+
+TEST(fastdeploy, fd_tensor_host_allocator) {
+  CheckShape check_shape;
+  CheckData check_data;
+  auto allocator = std::make_shared<FDHostPoolAllocator>();
+  SetDefaultHostAllocator(allocator);
+
+  std::vector<int> inputs = {2, 4, 3, 7, 1, 5};
+  FDTensor tensor1;
+  tensor1.Resize({2, 3}, FDDataType::INT32);
+  std::memcpy(tensor1.Data(), inputs.data(), tensor1.Nbytes());
+  ASSERT_EQ(tensor1.host_allocator, allocator);
+
+  // Growing the buffer keeps the original data like realloc
+  tensor1.Resize({4, 3});
+  check_shape(tensor1.shape, {4, 3});
+  check_data(reinterpret_cast<int*>(tensor1.Data()), inputs.data(), 6);
+
+  FDTensor tensor2(tensor1);
+  FDTensor tensor3(std::move(tensor2));
+  ASSERT_EQ(tensor3.host_allocator, allocator);
+  check_data(reinterpret_cast<int*>(tensor3.Data()), inputs.data(), 6);
+
+  tensor1.FreeFn();
+  tensor3.FreeFn();
+  ASSERT_EQ(allocator->GetStats().bytes_in_use, 0);
+  SetDefaultHostAllocator(nullptr);
+
+  // Tensors allocated after resetting go back to malloc/free
+  FDTensor tensor4;
+  tensor4.Resize({2, 3}, FDDataType::INT32);
+  ASSERT_EQ(tensor4.host_allocator, nullptr);
+
+  // A freed tensor decides the allocator again by the next allocation, unless
+  // the allocator is set explicitly
+  tensor1.Resize({2, 3}, FDDataType::INT32);
+  ASSERT_EQ(tensor1.host_allocator, nullptr);
+  tensor3.SetHostAllocator(allocator);
+  tensor3.Resize({2, 3}, FDDataType::INT32);
+  tensor3.FreeFn();
+  tensor3.Resize({2, 3}, FDDataType::INT32);
+  ASSERT_EQ(tensor3.host_allocator, allocator);
+  ASSERT_GT(allocator->GetStats().bytes_in_use, 0);
+  tensor3.SetHostAllocator(nullptr);
+  ASSERT_EQ(allocator->GetStats().bytes_in_use, 0);
+  tensor3.Resize({2, 3}, FDDataType::INT32);
+  ASSERT_EQ(tensor3.host_allocator, nullptr);
+}
+
+TEST(fastdeploy, host_memory_pool_process_setting) {
+  ASSERT_EQ(GetHostMemoryPoolStats().num_allocs, 0);
+  HostPoolAllocatorOption option;
+  option.max_cached_bytes = 1024;
+  EnableHostMemoryPool(option);
+  FDTensor tensor;
+  tensor.Resize({2, 3}, FDDataType::INT32);
+  ASSERT_NE(tensor.host_allocator, nullptr);
+  ASSERT_EQ(GetHostMemoryPoolStats().num_allocs, 1);
+
+  // Enabling again replaces the pool, the old one lives with the tensor
+  EnableHostMemoryPool(option);
+  ASSERT_NE(GetDefaultHostAllocator(), tensor.host_allocator);
+  ASSERT_EQ(GetHostMemoryPoolStats().num_allocs, 0);
+
+  DisableHostMemoryPool();
+  ASSERT_EQ(GetDefaultHostAllocator(), nullptr);
+  FDTensor tensor2;
+  tensor2.Resize({2, 3}, FDDataType::INT32);
+  ASSERT_EQ(tensor2.host_allocator, nullptr);
+
+  // The allocators not installed by EnableHostMemoryPool() are kept
+  auto allocator = std::make_shared<FDHostPoolAllocator>();
+  SetDefaultHostAllocator(allocator);
+  DisableHostMemoryPool();
+  ASSERT_EQ(GetDefaultHostAllocator(), allocator);
+  SetDefaultHostAllocator(nullptr);
+}
+
+}  // namespace fastdeploy
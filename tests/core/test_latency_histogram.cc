@@ -0,0 +1,150 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <thread>
+#include <vector>
+#include "fastdeploy/benchmark/latency_histogram.h"
+#include "gtest/gtest.h"
+
+namespace fastdeploy {
+namespace benchmark {
+
+TEST(fastdeploy, latency_histogram_buckets) {
+  // Small values are counted exactly
+  for (uint64_t i = 0; i < 32; ++i) {
+    ASSERT_EQ(LatencyHistogram::BucketIndex(i), static_cast<int>(i));
+    ASSERT_EQ(LatencyHistogram::BucketUpperBound(static_cast<int>(i)), i);
+  }
+  // Every value lies in its bucket and the buckets are continuous
+  uint64_t lower = 0;
+  for (int index = 0; index < 400; ++index) {
+    uint64_t upper = LatencyHistogram::BucketUpperBound(index);
+    ASSERT_EQ(LatencyHistogram::BucketIndex(lower), index);
+    ASSERT_EQ(LatencyHistogram::BucketIndex(upper), index);
+    // Relative error within 1/16
+    ASSERT_LE((upper - lower) * 16, upper + 1);
+    lower = upper + 1;
+  }
+}
+
+TEST(fastdeploy, latency_histogram_percentiles) {
+  LatencyHistogram histogram;
+  LatencyStats empty = histogram.GetStats();
+  ASSERT_EQ(empty.count, 0u);
+  ASSERT_EQ(empty.p99, 0.0);
+
+  // 1ms ~ 100ms
+  for (int i = 1; i <= 100; ++i) {
+    histogram.Record(i / 1000.0);
+  }
+  LatencyStats stats = histogram.GetStats();
+  ASSERT_EQ(stats.count, 100u);
+  ASSERT_NEAR(stats.mean, 50.5, 1e-6);
+  ASSERT_NEAR(stats.p50, 50.0, 50.0 / 16);
+  ASSERT_NEAR(stats.p90, 90.0, 90.0 / 16);
+  ASSERT_NEAR(stats.p99, 99.0, 99.0 / 16);
+  ASSERT_NEAR(stats.max, 100.0, 1e-6);
+  ASSERT_LE(stats.p99, stats.max);
+
+  histogram.Reset();
+  ASSERT_EQ(histogram.GetStats().count, 0u);
+}
+
+TEST(fastdeploy, latency_histogram_concurrent) {
+  LatencyHistogram histogram;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&histogram]() {
+      for (int i = 0; i < 10000; ++i) {
+        histogram.Record(0.002);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  LatencyStats stats = histogram.GetStats();
+  ASSERT_EQ(stats.count, 40000u);
+  ASSERT_NEAR(stats.p50, 2.0, 2.0 / 16);
+}
+
+TEST(fastdeploy, stage_latency_recorder) {
+  StageLatencyRecorder recorder;
+  recorder.Record(LatencyStage::PREPROCESS, 0.003);
+  recorder.Record(LatencyStage::BACKEND, 0.010);
+  recorder.Record(LatencyStage::BACKEND, 0.020);
+  ASSERT_EQ(recorder.GetStats(LatencyStage::PREPROCESS).count, 1u);
+  ASSERT_EQ(recorder.GetStats(LatencyStage::BACKEND).count, 2u);
+  ASSERT_EQ(recorder.GetStats(LatencyStage::D2H).count, 0u);
+  ASSERT_NEAR(recorder.GetStats(LatencyStage::BACKEND).max, 20.0, 1e-6);
+  ASSERT_EQ(Str(LatencyStage::POSTPROCESS), "Postprocess");
+  recorder.Reset();
+  ASSERT_EQ(recorder.GetStats(LatencyStage::BACKEND).count, 0u);
+}
+
+TEST(fastdeploy, cumulative_latency) {
+  CumulativeLatency latency;
+  for (int i = 1; i <= 10; ++i) {
+    latency.Record(i);
+  }
+  CumulativeLatencyStats stats = latency.GetStats();
+  ASSERT_EQ(stats.count, 10u);
+  ASSERT_NEAR(stats.total, 55, 1e-6);
+  ASSERT_EQ(stats.warmup_count, 2u);
+  ASSERT_NEAR(stats.warmup_time, 3, 1e-6);
+
+  // Beyond 128 records a block holds several records, the warmup is still
+  // split exactly while the latencies in a block are the same
+  latency.Reset();
+  for (int i = 0; i < 5003; ++i) {
+    latency.Record(i < 1000 ? 0.01 : 0.001);
+  }
+  stats = latency.GetStats();
+  ASSERT_EQ(stats.count, 5003u);
+  ASSERT_EQ(stats.warmup_count, 1000u);
+  ASSERT_NEAR(stats.warmup_time, 10, 1e-6);
+  ASSERT_NEAR(stats.total, 10 + 4.003, 1e-6);
+
+  StageLatencyRecorder recorder;
+  recorder.Record(LatencyStage::RUNTIME, 0.01);
+  recorder.Record(LatencyStage::BACKEND, 0.01);
+  ASSERT_EQ(recorder.GetRuntimeTotal().count, 1u);
+  recorder.Reset();
+  ASSERT_EQ(recorder.GetRuntimeTotal().count, 0u);
+}
+
+TEST(fastdeploy, cumulative_latency_concurrent) {
+  CumulativeLatency latency;
+  const int num_threads = 4;
+  const int num_records = 10000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&latency]() {
+      for (int i = 0; i < num_records; ++i) {
+        latency.Record(0.001);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  CumulativeLatencyStats stats = latency.GetStats();
+  ASSERT_EQ(stats.count, static_cast<uint64_t>(num_threads * num_records));
+  ASSERT_NEAR(stats.total, 40, 1e-6);
+  ASSERT_EQ(stats.warmup_count, 8000u);
+  ASSERT_NEAR(stats.warmup_time, 8, 1e-6);
+}
+
+}  // namespace benchmark
+}  // namespace fastdeploy
@@ -0,0 +1,74 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fastdeploy/runtime/runtime_option.h"
+#include "fastdeploy/utils/model_source.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace fastdeploy {
+
+TEST(fastdeploy, model_source) {
+  std::string contents("model\0source", 12);
+  std::string file_path = "model_source_test.pdmodel";
+  {
+    std::ofstream fout(file_path, std::ios::out | std::ios::binary);
+    fout.write(contents.data(), contents.size());
+  }
+
+  ModelSource mapped;
+  ASSERT_TRUE(ModelSource::FromFile(file_path, &mapped));
+  ASSERT_TRUE(mapped.IsMapped());
+  ASSERT_EQ(mapped.ToString(), contents);
+
+  // Copies share the same bytes
+  ModelSource copied = mapped;
+  ASSERT_EQ(copied.Data(), mapped.Data());
+
+  ModelSource read;
+  ASSERT_TRUE(ModelSource::FromFile(file_path, &read, false));
+  ASSERT_FALSE(read.IsMapped());
+  ASSERT_EQ(read.ToString(), contents);
+  std::remove(file_path.c_str());
+
+  ModelSource missing;
+  ASSERT_FALSE(ModelSource::FromFile("not_exist.pdmodel", &missing));
+  ASSERT_TRUE(missing.Empty());
+
+  ModelSource view = ModelSource::View(contents);
+  ASSERT_EQ(view.Data(), contents.data());
+  ASSERT_EQ(view.Size(), contents.size());
+}
+
+TEST(fastdeploy, runtime_option_model_source) {
+  std::string model = "model";
+  std::string params = "params";
+  RuntimeOption option;
+  option.SetModelBuffer(ModelSource::View(model), ModelSource::View(params));
+  ModelSource model_buffer;
+  ModelSource params_buffer;
+  ASSERT_TRUE(option.GetModelSource(&model_buffer, &params_buffer));
+  ASSERT_EQ(model_buffer.Data(), model.data());
+  ASSERT_EQ(params_buffer.Data(), params.data());
+
+  // Setting the buffer in string drops the previous source
+  option.SetModelBuffer(model, params);
+  ASSERT_TRUE(option.GetModelSource(&model_buffer, &params_buffer));
+  ASSERT_EQ(model_buffer.ToString(), model);
+  ASSERT_EQ(model_buffer.Data(), option.model_file.data());
+}
+
+}  // namespace fastdeploy
@@ -0,0 +1,126 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fastdeploy/runtime/backends/common/paddle2onnx_cache.h"
+#include "fastdeploy/utils/path.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fastdeploy {
+
+TEST(fastdeploy, paddle2onnx_cache_key) {
+  std::string model_str = "model";
+  std::string params_str = "params";
+  auto model = ModelSource::View(model_str);
+  auto params = ModelSource::View(params_str);
+  Paddle2OnnxConvertInfo info;
+  info.deploy_backend = "onnxruntime";
+  info.custom_ops = {{"pool2d", "AdaptivePool2d"}};
+  std::string key = Paddle2OnnxCache::ComputeKey(model, params, info);
+  ASSERT_EQ(key.size(), 16);
+  ASSERT_EQ(key, Paddle2OnnxCache::ComputeKey(model, params, info));
+
+  // Any change of the model or conversion leads to another key
+  ASSERT_NE(key, Paddle2OnnxCache::ComputeKey(model, model, info));
+  ASSERT_NE(key, Paddle2OnnxCache::ComputeKey(
+                     ModelSource::View(model_str.data(), 6),
+                     ModelSource::View(params_str.data() + 1, 5), info));
+  Paddle2OnnxConvertInfo info2 = info;
+  info2.opset_version = 13;
+  ASSERT_NE(key, Paddle2OnnxCache::ComputeKey(model, params, info2));
+  info2 = info;
+  info2.deploy_backend = "tensorrt";
+  ASSERT_NE(key, Paddle2OnnxCache::ComputeKey(model, params, info2));
+  info2 = info;
+  info2.custom_ops.clear();
+  ASSERT_NE(key, Paddle2OnnxCache::ComputeKey(model, params, info2));
+
+  // Flipping the sign bits of two float weights at the top bit of 8-byte
+  // words, e.g negating two weights, still changes the key
+  std::vector<float> weights(64, 1.0f);
+  std::string weights_key = Paddle2OnnxCache::ComputeKey(
+      model, ModelSource::View(reinterpret_cast<const char*>(weights.data()),
+                               weights.size() * sizeof(float)),
+      info);
+  weights[1] = -weights[1];
+  weights[3] = -weights[3];
+  ASSERT_NE(weights_key,
+            Paddle2OnnxCache::ComputeKey(
+                model,
+                ModelSource::View(reinterpret_cast<const char*>(weights.data()),
+                                  weights.size() * sizeof(float)),
+                info));
+}
+
+TEST(fastdeploy, paddle2onnx_cache) {
+  Paddle2OnnxCache disabled("");
+  std::string onnx_model;
+  ASSERT_FALSE(disabled.Enabled());
+  ASSERT_FALSE(disabled.Save("key", "onnx"));
+  ASSERT_FALSE(disabled.Load("key", &onnx_model));
+
+  Paddle2OnnxCache cache("paddle2onnx_cache_test/nested");
+  std::string model_str = "model";
+  std::string key = Paddle2OnnxCache::ComputeKey(
+      ModelSource::View(model_str), ModelSource(), Paddle2OnnxConvertInfo());
+  std::remove(cache.ModelPath(key).c_str());
+  ASSERT_FALSE(cache.Load(key, &onnx_model));
+
+  std::string contents("onnx\0model", 10);
+  ASSERT_TRUE(cache.Save(key, contents, "calibration"));
+  std::string calibration;
+  ASSERT_TRUE(cache.Load(key, &onnx_model, &calibration));
+  ASSERT_EQ(onnx_model, contents);
+  ASSERT_EQ(calibration, "calibration");
+
+  // Saving the same entry again replaces it
+  ASSERT_TRUE(cache.Save(key, contents));
+  ASSERT_TRUE(cache.Load(key, &onnx_model));
+  ASSERT_EQ(onnx_model, contents);
+
+  // The model with external data is exported into a staging directory,
+  // which is moved into place as the entry
+  std::string model_path;
+  if (cache.LoadExternal(key, &model_path)) {
+    cache.DropStagingDir(GetDirFromPath(model_path));
+  }
+  ASSERT_FALSE(cache.LoadExternal(key, &model_path));
+  for (int i = 0; i < 2; ++i) {
+    std::string staging_dir;
+    ASSERT_TRUE(cache.CreateStagingDir(key, &staging_dir));
+    std::ofstream fout(Paddle2OnnxCache::ExternalDataPath(staging_dir));
+    fout << "weights";
+    fout.close();
+    // The second save finds the entry saved by the first one
+    ASSERT_TRUE(cache.SaveExternal(key, staging_dir, contents, "calibration",
+                                   &model_path));
+    ASSERT_FALSE(
+        CheckFileExists(Paddle2OnnxCache::ExternalDataPath(staging_dir)));
+  }
+  std::string loaded_path;
+  ASSERT_TRUE(cache.LoadExternal(key, &loaded_path, &calibration));
+  ASSERT_EQ(loaded_path, model_path);
+  ASSERT_EQ(calibration, "calibration");
+  std::string data;
+  ASSERT_TRUE(ReadBinaryFromFile(model_path, &onnx_model));
+  ASSERT_EQ(onnx_model, contents);
+  ASSERT_TRUE(ReadBinaryFromFile(
+      Paddle2OnnxCache::ExternalDataPath(GetDirFromPath(model_path)), &data));
+  ASSERT_EQ(data, "weights");
+}
+
+}  // namespace fastdeploy
@@ -0,0 +1,114 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fastdeploy/runtime/runtime.h"
+#include "core/add_one_backend.h"
+#include "gtest_utils.h"
+#include "gtest/gtest.h"
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace fastdeploy {
+
+static std::vector<FDTensor> MakeInputs(int size, float value) {
+  std::vector<FDTensor> inputs(1);
+  inputs[0].Resize({size}, FDDataType::FP32, "x");
+  float* data = reinterpret_cast<float*>(inputs[0].MutableData());
+  for (int i = 0; i < size; ++i) {
+    data[i] = value;
+  }
+  return inputs;
+}
+
+static void CheckOutputs(const std::vector<FDTensor>& outputs, int size,
+                         float value) {
+  ASSERT_EQ(outputs.size(), 1);
+  CheckShape check_shape;
+  CheckData check_data;
+  check_shape(outputs[0].shape, {size});
+  std::vector<float> expected(size, value);
+  check_data(reinterpret_cast<const float*>(outputs[0].Data()),
+             expected.data(), size);
+}
+
+static void RunAsyncRequests(bool support_async) {
+  Runtime runtime;
+  ASSERT_TRUE(runtime.Init(RuntimeOption(),
+                           utils::make_unique<AddOneBackend>(support_async)));
+
+  const int num_requests = 8;
+  std::vector<std::vector<FDTensor>> inputs(num_requests);
+  std::vector<std::vector<FDTensor>> outputs(num_requests);
+  std::vector<std::future<bool>> futures;
+  for (int i = 0; i < num_requests; ++i) {
+    inputs[i] = MakeInputs(4, i);
+    futures.push_back(runtime.InferAsync(inputs[i], &outputs[i]));
+  }
+  for (int i = 0; i < num_requests; ++i) {
+    ASSERT_TRUE(futures[i].get());
+    CheckOutputs(outputs[i], 4, i + 1);
+  }
+
+  // The callbacks are called out of the calling thread
+  std::vector<std::promise<bool>> promises(num_requests);
+  std::vector<std::thread::id> callback_threads(num_requests);
+  for (int i = 0; i < num_requests; ++i) {
+    outputs[i].clear();
+    runtime.InferAsync(inputs[i], &outputs[i],
+                       [&promises, &callback_threads, i](bool success) {
+                         callback_threads[i] = std::this_thread::get_id();
+                         promises[i].set_value(success);
+                       });
+  }
+  for (int i = 0; i < num_requests; ++i) {
+    ASSERT_TRUE(promises[i].get_future().get());
+    ASSERT_NE(callback_threads[i], std::this_thread::get_id());
+    CheckOutputs(outputs[i], 4, i + 1);
+  }
+}
+
+TEST(fastdeploy, runtime_infer_async) {
+  // Run by the worker thread of Runtime
+  RunAsyncRequests(false);
+  // Run by the backend
+  RunAsyncRequests(true);
+}
+
+TEST(fastdeploy, runtime_infer_async_shape_bucket) {
+  for (bool support_async : {false, true}) {
+    RuntimeOption option;
+    option.SetShapeBuckets("x", {{8}, {16}}, -1.0);
+    option.SetShapeBucketCrop("y", 0, "x", 0);
+    auto backend = utils::make_unique<AddOneBackend>(support_async);
+    AddOneBackend* backend_ptr = backend.get();
+    Runtime runtime;
+    ASSERT_TRUE(runtime.Init(option, std::move(backend)));
+
+    // Both paths pad the inputs and crop the outputs as Infer()
+    std::vector<FDTensor> inputs = MakeInputs(5, 1);
+    std::vector<FDTensor> outputs;
+    ASSERT_TRUE(runtime.InferAsync(inputs, &outputs).get());
+    CheckOutputs(outputs, 5, 2);
+    std::vector<FDTensor> sync_outputs;
+    ASSERT_TRUE(runtime.Infer(inputs, &sync_outputs));
+    CheckOutputs(sync_outputs, 5, 2);
+    auto shapes = backend_ptr->InputShapes();
+    ASSERT_EQ(shapes.size(), 2);
+    ASSERT_EQ(shapes[0][0], 8);
+    ASSERT_EQ(shapes[1][0], 8);
+  }
+}
+
+}  // namespace fastdeploy
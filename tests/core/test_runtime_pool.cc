@@ -0,0 +1,308 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fastdeploy/runtime/runtime_pool.h"
+#include "fastdeploy/model_pool.h"
+#include "core/add_one_backend.h"
+#include "gtest_utils.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace fastdeploy {
+
+TEST(fastdeploy, mpmc_queue) {
+  MPMCQueue<int> queue(3);
+  ASSERT_EQ(queue.Capacity(), 4);
+  int value = 0;
+  ASSERT_FALSE(queue.TryPop(&value));
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.TryPush(std::move(i)));
+  }
+  ASSERT_FALSE(queue.TryPush(4));
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.TryPop(&value));
+    ASSERT_EQ(value, i);
+  }
+  ASSERT_FALSE(queue.TryPop(&value));
+
+  // Every value pushed by the producers is popped exactly once
+  MPMCQueue<int> shared(64);
+  const int num_values = 10000;
+  std::atomic<int64_t> sum{0};
+  std::atomic<int> num_popped{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 2; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = t; i < num_values; i += 2) {
+        int v = i;
+        while (!shared.TryPush(std::move(v))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+    threads.emplace_back([&]() {
+      int v;
+      while (num_popped.load() < num_values) {
+        if (shared.TryPop(&v)) {
+          sum += v;
+          num_popped++;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(num_popped.load(), num_values);
+  ASSERT_EQ(sum.load(), int64_t(num_values) * (num_values - 1) / 2);
+}
+
+TEST(fastdeploy, instance_dispatcher) {
+  std::vector<std::atomic<int>> running(3);
+  std::atomic<int> done{0};
+  std::atomic<bool> overlapped{false};
+  {
+    InstanceDispatcher dispatcher(3, 1024);
+    ASSERT_EQ(dispatcher.NumInstances(), 3);
+    for (int i = 0; i < 300; ++i) {
+      ASSERT_TRUE(dispatcher.Submit([&](int index) {
+        // An instance never runs two tasks at the same time
+        if (running[index]++ != 0) {
+          overlapped = true;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        running[index]--;
+        done++;
+      }));
+    }
+  }
+  // The queued tasks are finished before the dispatcher is destroyed
+  ASSERT_EQ(done.load(), 300);
+  ASSERT_FALSE(overlapped.load());
+
+  InstanceDispatcher dispatcher(2, 16);
+  std::promise<void> release_promise;
+  std::shared_future<void> release = release_promise.get_future().share();
+  std::vector<std::promise<void>> started(2);
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_TRUE(dispatcher.Submit([&, i](int) {
+      started[i].set_value();
+      release.wait();
+    }));
+  }
+  for (auto& promise : started) {
+    promise.get_future().wait();
+  }
+  // Both instances are blocked, the queue fills up
+  int queued = 0;
+  while (dispatcher.Submit([](int) {})) {
+    ++queued;
+  }
+  ASSERT_EQ(queued, 16);
+  ASSERT_EQ(dispatcher.GetStats().queue_depth, 16);
+  release_promise.set_value();
+
+  // Every instance runs one of the fence tasks only after the tasks queued
+  // before are done and counted, and holds it until both are taken
+  std::atomic<int> num_fenced{0};
+  std::promise<void> fenced;
+  std::promise<void> open_fence_promise;
+  std::shared_future<void> open_fence = open_fence_promise.get_future().share();
+  InstanceDispatcher::Task fence = [&](int) {
+    if (++num_fenced == 2) {
+      fenced.set_value();
+    }
+    open_fence.wait();
+  };
+  for (int i = 0; i < 2; ++i) {
+    // The queue may be still full
+    while (!dispatcher.Submit(InstanceDispatcher::Task(fence))) {
+      std::this_thread::yield();
+    }
+  }
+  fenced.get_future().wait();
+  auto stats = dispatcher.GetStats();
+  dispatcher.ResetStats();
+  auto reset_stats = dispatcher.GetStats();
+  open_fence_promise.set_value();
+  ASSERT_EQ(stats.queue_depth, 0);
+  ASSERT_EQ(stats.num_requests.size(), 2);
+  ASSERT_EQ(stats.num_requests[0] + stats.num_requests[1], 18);
+  ASSERT_GT(stats.utilization[0], 0.0);
+  ASSERT_LE(stats.utilization[0], 1.0);
+  ASSERT_EQ(reset_stats.num_requests[0], 0);
+  ASSERT_EQ(reset_stats.num_requests[1], 0);
+}
+
+static std::vector<FDTensor> MakeInputs(int size, float value) {
+  std::vector<FDTensor> inputs(1);
+  inputs[0].Resize({size}, FDDataType::FP32, "x");
+  float* data = reinterpret_cast<float*>(inputs[0].MutableData());
+  for (int i = 0; i < size; ++i) {
+    data[i] = value;
+  }
+  return inputs;
+}
+
+static void CheckOutputs(const std::vector<FDTensor>& outputs, int size,
+                         float value) {
+  ASSERT_EQ(outputs.size(), 1);
+  CheckShape check_shape;
+  CheckData check_data;
+  check_shape(outputs[0].shape, {size});
+  std::vector<float> expected(size, value);
+  check_data(reinterpret_cast<const float*>(outputs[0].Data()),
+             expected.data(), size);
+}
+
+TEST(fastdeploy, runtime_pool) {
+  RuntimePool pool;
+  std::unique_ptr<Runtime> runtime(new Runtime());
+  ASSERT_TRUE(
+      runtime->Init(RuntimeOption(), utils::make_unique<AddOneBackend>()));
+  ASSERT_FALSE(pool.Init(std::move(runtime), 0));
+
+  runtime.reset(new Runtime());
+  ASSERT_TRUE(
+      runtime->Init(RuntimeOption(), utils::make_unique<AddOneBackend>()));
+  ASSERT_TRUE(pool.Init(std::move(runtime), 3));
+  ASSERT_EQ(pool.NumInstances(), 3);
+  // The instances are clones with their own backends
+  ASSERT_NE(pool.GetRuntime(0), pool.GetRuntime(1));
+  ASSERT_NE(pool.GetRuntime(1), pool.GetRuntime(2));
+
+  // Called from multiple threads
+  const int num_threads = 4;
+  const int num_requests = 50;
+  std::vector<std::thread> threads;
+  std::atomic<int> num_failed{0};
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < num_requests; ++i) {
+        std::vector<FDTensor> inputs = MakeInputs(4, t * num_requests + i);
+        std::vector<FDTensor> outputs;
+        if (!pool.Infer(inputs, &outputs) ||
+            reinterpret_cast<const float*>(outputs[0].Data())[3] !=
+                t * num_requests + i + 1) {
+          num_failed++;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(num_failed.load(), 0);
+
+  std::vector<std::vector<FDTensor>> inputs(8);
+  std::vector<std::vector<FDTensor>> outputs(8);
+  std::vector<std::future<bool>> futures;
+  for (int i = 0; i < 8; ++i) {
+    inputs[i] = MakeInputs(4, i);
+    futures.push_back(pool.InferAsync(inputs[i], &outputs[i]));
+  }
+  for (int i = 0; i < 8; ++i) {
+    ASSERT_TRUE(futures[i].get());
+    CheckOutputs(outputs[i], 4, i + 1);
+  }
+}
+
+// A backend which fails to clone
+class UncloneableBackend : public AddOneBackend {
+ public:
+  std::unique_ptr<BaseBackend> Clone(RuntimeOption& runtime_option,
+                                     void* stream = nullptr,
+                                     int device_id = -1) override {
+    return nullptr;
+  }
+};
+
+TEST(fastdeploy, runtime_pool_clone_failed) {
+  Runtime runtime;
+  ASSERT_TRUE(
+      runtime.Init(RuntimeOption(), utils::make_unique<UncloneableBackend>()));
+  ASSERT_EQ(runtime.Clone(), nullptr);
+
+  RuntimePool pool;
+  std::unique_ptr<Runtime> pooled(new Runtime());
+  ASSERT_TRUE(
+      pooled->Init(RuntimeOption(), utils::make_unique<UncloneableBackend>()));
+  ASSERT_FALSE(pool.Init(std::move(pooled), 2));
+  ASSERT_EQ(pool.NumInstances(), 0);
+}
+
+// A model without runtime, the tasks of the pool check which instance they
+// run on
+class PoolTestModel : public FastDeployModel {
+ public:
+  explicit PoolTestModel(int id) : id_(id) {}
+  std::string ModelName() const override { return "PoolTestModel"; }
+  bool Initialized() const override { return true; }
+  std::unique_ptr<PoolTestModel> Clone() const {
+    return utils::make_unique<PoolTestModel>(id_ + ++num_clones_);
+  }
+  int Id() const { return id_; }
+  // Number of the requests running on this instance
+  std::atomic<int> running{0};
+
+ private:
+  int id_;
+  mutable int num_clones_ = 0;
+};
+
+TEST(fastdeploy, model_pool) {
+  ModelPool<PoolTestModel> empty_pool(nullptr, 2);
+  ASSERT_FALSE(empty_pool.Initialized());
+  ASSERT_FALSE(empty_pool.Run([](PoolTestModel*) { return true; }));
+
+  ModelPool<PoolTestModel> pool(utils::make_unique<PoolTestModel>(0), 3);
+  ASSERT_TRUE(pool.Initialized());
+  ASSERT_EQ(pool.NumInstances(), 3);
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(pool.GetModel(i)->Id(), i);
+  }
+
+  // An instance never runs two requests at the same time
+  std::atomic<bool> overlapped{false};
+  auto task = [&overlapped](PoolTestModel* model) {
+    if (model->running++ != 0) {
+      overlapped = true;
+    }
+    std::this_thread::yield();
+    model->running--;
+    return true;
+  };
+  std::vector<std::future<bool>> futures;
+  for (int i = 0; i < 100; ++i) {
+    futures.push_back(pool.Submit(task));
+  }
+  for (auto& future : futures) {
+    ASSERT_TRUE(future.get());
+  }
+  ASSERT_FALSE(overlapped.load());
+
+  // The result of the task is passed to the callback
+  std::promise<bool> result;
+  pool.Submit([](PoolTestModel*) { return false; },
+              [&result](bool success) { result.set_value(success); });
+  ASSERT_FALSE(result.get_future().get());
+  ASSERT_TRUE(pool.Run([](PoolTestModel* model) { return model != nullptr; }));
+}
+
+}  // namespace fastdeploy
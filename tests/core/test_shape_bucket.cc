@@ -0,0 +1,108 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+#include "fastdeploy/core/fd_tensor.h"
+#include "fastdeploy/runtime/shape_bucket.h"
+#include "gtest/gtest.h"
+#include "gtest_utils.h"
+
+namespace fastdeploy {
+
+ShapeBucketCrop Crop(int output_axis, const std::string& input_name,
+                     int input_axis, float scale) {
+  ShapeBucketCrop crop;
+  crop.output_axis = output_axis;
+  crop.input_name = input_name;
+  crop.input_axis = input_axis;
+  crop.scale = scale;
+  return crop;
+}
+
+TEST(fastdeploy, shape_bucket_find) {
+  std::vector<std::vector<int64_t>> buckets = {
+      {-1, 3, 64, 64}, {-1, 3, 32, 128}, {-1, 3, 128, 128}};
+  ASSERT_EQ(ShapeBucketer::FindBucket({1, 3, 20, 30}, buckets), 0);
+  ASSERT_EQ(ShapeBucketer::FindBucket({8, 3, 20, 100}, buckets), 1);
+  ASSERT_EQ(ShapeBucketer::FindBucket({1, 3, 100, 64}, buckets), 2);
+  ASSERT_EQ(ShapeBucketer::FindBucket({1, 3, 200, 64}, buckets), -1);
+  ASSERT_EQ(ShapeBucketer::FindBucket({3, 64, 64}, buckets), -1);
+}
+
+TEST(fastdeploy, shape_bucket_pad_and_crop) {
+  CheckShape check_shape;
+  ShapeBucketOption option;
+  option.buckets["x"] = {{-1, 1, 4, 4}};
+  option.buckets["mask"] = {{-1, 4}};
+  option.pad_values["x"] = -1;
+  // Same size with x
+  option.crops["out"].push_back(Crop(2, "x", 2, 1.0f));
+  option.crops["out"].push_back(Crop(3, "x", 3, 1.0f));
+  // Downsampled by 2 in both axes
+  option.crops["feat"].push_back(Crop(2, "x", 2, 0.5f));
+  option.crops["feat"].push_back(Crop(3, "x", 3, 0.5f));
+  ShapeBucketer bucketer(option);
+
+  std::vector<FDTensor> inputs(3);
+  inputs[0].Allocate({1, 1, 2, 3}, FDDataType::FP32, "x");
+  float* data = reinterpret_cast<float*>(inputs[0].MutableData());
+  for (int i = 0; i < 6; ++i) {
+    data[i] = i;
+  }
+  inputs[1].Allocate({1, 2}, FDDataType::FP32, "scale");
+  inputs[2].Allocate({1, 3}, FDDataType::FP32, "mask");
+  float* mask = reinterpret_cast<float*>(inputs[2].MutableData());
+  for (int i = 0; i < 3; ++i) {
+    mask[i] = 1;
+  }
+
+  std::vector<FDTensor> padded;
+  ASSERT_TRUE(bucketer.PadInputs(inputs, &padded));
+  check_shape(padded[0].shape, {1, 1, 4, 4});
+  ASSERT_EQ(padded[0].name, "x");
+  const float* padded_data = reinterpret_cast<const float*>(padded[0].Data());
+  ASSERT_EQ(padded_data[4 + 2], 5);
+  ASSERT_EQ(padded_data[3], -1);
+  ASSERT_EQ(padded_data[12], -1);
+  // The inputs without buckets are shared
+  ASSERT_EQ(padded[1].Data(), inputs[1].Data());
+  ASSERT_EQ(bucketer.BucketHits("x")[0], 1);
+  // Every input has its own pad value
+  check_shape(padded[2].shape, {1, 4});
+  ASSERT_EQ(reinterpret_cast<const float*>(padded[2].Data())[3], 0);
+
+  // Only the outputs with crops are cropped
+  std::vector<FDTensor> outputs(3);
+  outputs[0] = padded[0];
+  outputs[0].name = "out";
+  outputs[1].Allocate({1, 8, 2, 2}, FDDataType::FP32, "feat");
+  outputs[2].Allocate({1, 1, 4, 4}, FDDataType::FP32, "logits");
+  bucketer.CropOutputs(&outputs);
+  check_shape(outputs[0].shape, {1, 1, 2, 3});
+  ASSERT_EQ(outputs[0].name, "out");
+  const float* cropped = reinterpret_cast<const float*>(outputs[0].Data());
+  for (int i = 0; i < 6; ++i) {
+    ASSERT_EQ(cropped[i], i);
+  }
+  check_shape(outputs[1].shape, {1, 8, 1, 2});
+  check_shape(outputs[2].shape, {1, 1, 4, 4});
+
+  // Input already in canonical shape is not padded
+  inputs[0].Allocate({1, 1, 4, 4}, FDDataType::FP32, "x");
+  inputs[2].Allocate({1, 4}, FDDataType::FP32, "mask");
+  ASSERT_FALSE(bucketer.PadInputs(inputs, &padded));
+  ASSERT_EQ(padded[0].Data(), inputs[0].Data());
+}
+
+}  // namespace fastdeploy
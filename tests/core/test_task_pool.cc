@@ -0,0 +1,77 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fastdeploy/utils/task_pool.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace fastdeploy {
+
+TEST(fastdeploy, task_pool) {
+  TaskPool pool(4);
+  ASSERT_EQ(pool.NumThreads(), 4);
+
+  // Every iteration runs exactly once
+  std::vector<int> counts(1000, 0);
+  for (int round = 0; round < 10; ++round) {
+    ASSERT_TRUE(pool.ParallelFor(counts.size(), [&](size_t i) {
+      counts[i] += 1;
+      return true;
+    }));
+  }
+  for (auto count : counts) {
+    ASSERT_EQ(count, 10);
+  }
+
+  // A failed iteration fails the loop, the others still run
+  std::atomic<int> num_runs(0);
+  ASSERT_FALSE(pool.ParallelFor(16, [&](size_t i) {
+    num_runs += 1;
+    return i != 3;
+  }));
+  ASSERT_EQ(num_runs.load(), 16);
+
+  // Nested and concurrent loops don't deadlock
+  std::atomic<int> num_inner(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 2; ++t) {
+    threads.emplace_back([&]() {
+      pool.ParallelFor(8, [&](size_t) {
+        return pool.ParallelFor(8, [&](size_t) {
+          num_inner += 1;
+          return true;
+        });
+      });
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(num_inner.load(), 128);
+}
+
+TEST(fastdeploy, task_pool_single_thread) {
+  TaskPool pool(1);
+  ASSERT_EQ(pool.NumThreads(), 1);
+  std::vector<size_t> order;
+  ASSERT_TRUE(pool.ParallelFor(4, [&](size_t i) {
+    order.push_back(i);
+    return true;
+  }));
+  ASSERT_EQ(order, std::vector<size_t>({0, 1, 2, 3}));
+}
+
+}  // namespace fastdeploy
@@ -0,0 +1,63 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "fastdeploy/core/fd_tensor.h"
+#include "fastdeploy/function/argmax.h"
+#include "gtest_utils.h"
+#include "gtest/gtest.h"
+
+namespace fastdeploy {
+namespace function {
+
+TEST(fastdeploy, argmax_and_max) {
+  std::mt19937 gen(3);
+  // Quantized values, so there are many ties of the max element
+  std::uniform_int_distribution<int> dist(0, 20);
+  for (size_t cols : {1, 7, 8, 9, 31, 6625}) {
+    size_t rows = 13;
+    std::vector<float> data(rows * cols);
+    for (auto& value : data) {
+      value = dist(gen) / 20.0f;
+    }
+    std::vector<int32_t> indices(rows);
+    std::vector<float> values(rows);
+    ArgMaxAndMax(data.data(), rows, cols, indices.data(), values.data());
+    for (size_t i = 0; i < rows; ++i) {
+      const float* row = data.data() + i * cols;
+      const float* max = std::max_element(row, row + cols);
+      ASSERT_EQ(indices[i], max - row);
+      ASSERT_EQ(values[i], *max);
+    }
+  }
+
+  CheckShape check_shape;
+  CheckData check_data;
+  std::vector<float> data = {0.1, 0.7, 0.2, 0.5, 0.5, 0.0};
+  FDTensor x, indices, values;
+  x.SetExternalData({2, 3}, FDDataType::FP32, data.data());
+  ArgMaxAndMax(x, &indices, &values);
+  check_shape(indices.shape, {2});
+  std::vector<int32_t> expected_indices = {1, 0};
+  std::vector<float> expected_values = {0.7, 0.5};
+  check_data(reinterpret_cast<const int32_t*>(indices.Data()),
+             expected_indices.data(), 2);
+  check_data(reinterpret_cast<const float*>(values.Data()),
+             expected_values.data(), 2);
+}
+
+}  // namespace function
+}  // namespace fastdeploy
@@ -0,0 +1,196 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "fastdeploy/core/fd_tensor.h"
+#include "fastdeploy/function/nms.h"
+#include "gtest_utils.h"
+#include "gtest/gtest.h"
+
+namespace fastdeploy {
+namespace function {
+
+// The NMS of one class as the former FastNMS of PaddleMultiClassNMS
+static std::vector<int> ReferenceNMS(const float* boxes, const float* scores,
+                                     int num_boxes, float threshold,
+                                     float score_threshold, bool normalized) {
+  auto area = [normalized](const float* box) {
+    if (box[2] < box[0] || box[3] < box[1]) {
+      return 0.0f;
+    }
+    float norm = normalized ? 0.0f : 1.0f;
+    return (box[2] - box[0] + norm) * (box[3] - box[1] + norm);
+  };
+  std::vector<std::pair<float, int>> sorted;
+  for (int i = 0; i < num_boxes; ++i) {
+    if (scores[i] > score_threshold) {
+      sorted.emplace_back(scores[i], i);
+    }
+  }
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const std::pair<float, int>& a,
+                      const std::pair<float, int>& b) {
+                     return a.first > b.first;
+                   });
+  std::vector<int> keep;
+  for (const auto& item : sorted) {
+    const float* box1 = boxes + item.second * 4;
+    bool kept = true;
+    for (int k : keep) {
+      const float* box2 = boxes + k * 4;
+      if (box2[0] > box1[2] || box2[2] < box1[0] || box2[1] > box1[3] ||
+          box2[3] < box1[1]) {
+        continue;
+      }
+      float norm = normalized ? 0.0f : 1.0f;
+      float w = std::min(box1[2], box2[2]) - std::max(box1[0], box2[0]) + norm;
+      float h = std::min(box1[3], box2[3]) - std::max(box1[1], box2[1]) + norm;
+      float inter = w * h;
+      if (inter / (area(box1) + area(box2) - inter) > threshold) {
+        kept = false;
+        break;
+      }
+    }
+    if (kept) {
+      keep.push_back(item.second);
+    }
+  }
+  return keep;
+}
+
+static void RandomBoxes(int num_boxes, int num_classes, std::mt19937* gen,
+                        std::vector<float>* boxes, std::vector<float>* scores) {
+  std::uniform_real_distribution<float> pos(0.0f, 100.0f);
+  std::uniform_real_distribution<float> size(5.0f, 40.0f);
+  std::uniform_int_distribution<int> score(0, 50);
+  for (int i = 0; i < num_boxes; ++i) {
+    float x = pos(*gen);
+    float y = pos(*gen);
+    boxes->insert(boxes->end(), {x, y, x + size(*gen), y + size(*gen)});
+  }
+  // Quantized scores, so there are many boxes of the same score
+  for (int i = 0; i < num_boxes * num_classes; ++i) {
+    scores->push_back(score(*gen) / 50.0f);
+  }
+}
+
+TEST(fastdeploy, nms) {
+  CheckShape check_shape;
+  std::mt19937 gen(7);
+  for (int normalized = 0; normalized < 2; ++normalized) {
+    std::vector<float> boxes;
+    std::vector<float> scores;
+    RandomBoxes(500, 1, &gen, &boxes, &scores);
+    NMSParams params;
+    params.iou_threshold = 0.45f;
+    params.score_threshold = 0.1f;
+    params.normalized = normalized;
+    std::vector<int> keep;
+    std::vector<float> keep_scores;
+    NMS(boxes.data(), scores.data(), 500, params, &keep, &keep_scores);
+    check_shape(keep, ReferenceNMS(boxes.data(), scores.data(), 500, 0.45f,
+                                   0.1f, normalized));
+    ASSERT_EQ(keep.size(), keep_scores.size());
+    ASSERT_TRUE(std::is_sorted(keep_scores.rbegin(), keep_scores.rend()));
+  }
+
+  // Two boxes with IoU 0.6 and a separated box
+  std::vector<float> boxes = {0, 0, 10, 10, 0, 2.5, 10, 12.5, 20, 20, 30, 30};
+  std::vector<float> scores = {0.9, 0.8, 0.7};
+  NMSParams params;
+  std::vector<int> keep;
+  std::vector<float> keep_scores;
+  NMS(boxes.data(), scores.data(), 3, params, &keep, &keep_scores);
+  check_shape(keep, std::vector<int>({0, 2}));
+
+  // Soft-NMS decays the overlapped box instead of removing it
+  params.type = NMSType::SOFT;
+  NMS(boxes.data(), scores.data(), 3, params, &keep, &keep_scores);
+  check_shape(keep, std::vector<int>({0, 2, 1}));
+  ASSERT_NEAR(keep_scores[2], 0.8f * 0.4f, 1e-5f);
+
+  // Matrix-NMS decays by the IoU with the higher scored boxes
+  params.type = NMSType::MATRIX;
+  params.post_threshold = 0.3f;
+  NMS(boxes.data(), scores.data(), 3, params, &keep, &keep_scores);
+  check_shape(keep, std::vector<int>({0, 2, 1}));
+  ASSERT_NEAR(keep_scores[2], 0.8f * 0.4f, 1e-5f);
+  params.post_threshold = 0.5f;
+  NMS(boxes.data(), scores.data(), 3, params, &keep, &keep_scores);
+  check_shape(keep, std::vector<int>({0, 2}));
+}
+
+TEST(fastdeploy, multiclass_nms) {
+  CheckShape check_shape;
+  std::mt19937 gen(11);
+  int batch = 3;
+  int num_boxes = 200;
+  int num_classes = 4;
+  std::vector<float> boxes;
+  std::vector<float> scores;
+  for (int i = 0; i < batch; ++i) {
+    std::vector<float> image_scores;
+    RandomBoxes(num_boxes, num_classes, &gen, &boxes, &image_scores);
+    scores.insert(scores.end(), image_scores.begin(), image_scores.end());
+  }
+  NMSParams params;
+  params.score_threshold = 0.3f;
+  std::vector<MultiClassNMSResult> results;
+  MultiClassNMS(boxes.data(), scores.data(), batch, num_boxes, num_classes,
+                params, 0, -1, &results);
+  ASSERT_EQ(results.size(), 3u);
+  for (int i = 0; i < batch; ++i) {
+    std::vector<int> expected_labels;
+    std::vector<int> expected_indices;
+    for (int label = 1; label < num_classes; ++label) {
+      auto keep = ReferenceNMS(
+          boxes.data() + i * num_boxes * 4,
+          scores.data() + (i * num_classes + label) * num_boxes, num_boxes,
+          0.5f, 0.3f, true);
+      expected_labels.insert(expected_labels.end(), keep.size(), label);
+      expected_indices.insert(expected_indices.end(), keep.begin(),
+                              keep.end());
+    }
+    check_shape(results[i].labels, expected_labels);
+    check_shape(results[i].indices, expected_indices);
+  }
+
+  // The parallel NMS and keep_top_k
+  TaskPool pool(4);
+  std::vector<MultiClassNMSResult> parallel_results;
+  MultiClassNMS(boxes.data(), scores.data(), batch, num_boxes, num_classes,
+                params, 0, -1, &parallel_results, &pool);
+  for (int i = 0; i < batch; ++i) {
+    check_shape(parallel_results[i].indices, results[i].indices);
+  }
+  MultiClassNMS(boxes.data(), scores.data(), batch, num_boxes, num_classes,
+                params, 0, 10, &parallel_results, &pool);
+  for (int i = 0; i < batch; ++i) {
+    ASSERT_EQ(parallel_results[i].Size(), 10u);
+    ASSERT_TRUE(std::is_sorted(parallel_results[i].labels.begin(),
+                               parallel_results[i].labels.end()));
+    std::vector<float> top_scores = results[i].scores;
+    std::sort(top_scores.rbegin(), top_scores.rend());
+    std::vector<float> kept_scores = parallel_results[i].scores;
+    std::sort(kept_scores.rbegin(), kept_scores.rend());
+    for (int j = 0; j < 10; ++j) {
+      ASSERT_EQ(kept_scores[j], top_scores[j]);
+    }
+  }
+}
+
+}  // namespace function
+}  // namespace fastdeploy
@@ -0,0 +1,90 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+#include "fastdeploy/vision.h"
+#include "gtest/gtest.h"
+#include "gtest_utils.h"
+
+namespace fastdeploy {
+
+TEST(fastdeploy, mask_rle) {
+  CheckShape check_shape;
+  CheckData check_data;
+
+  // The runs are counted in column-major order as COCO, 3x2 mask
+  // 0 1
+  // 1 1
+  // 0 0
+  vision::Mask mask;
+  mask.data = {0, 1, 1, 1, 0, 0};
+  mask.shape = {3, 2};
+  mask.EncodeRLE();
+  ASSERT_TRUE(mask.is_rle);
+  ASSERT_TRUE(mask.data.empty());
+  check_shape(mask.rle, std::vector<uint32_t>({1, 1, 1, 2, 1}));
+  std::vector<uint8_t> dense(6);
+  mask.DecodeTo(dense.data());
+  check_data(dense.data(), std::vector<uint8_t>({0, 1, 1, 1, 0, 0}).data(), 6);
+  mask.DecodeRLE();
+  ASSERT_FALSE(mask.is_rle);
+  check_data(mask.data.data(), dense.data(), 6);
+
+  // The mask starting with 1 has an empty run of 0
+  mask.EncodeRLE(std::vector<float>({0.9f, 0.2f, 0.7f, 0.6f}).data(), 2, 2, 2,
+                 0.5f);
+  check_shape(mask.rle, std::vector<uint32_t>({0, 2, 1, 1}));
+}
+
+TEST(fastdeploy, ppdet_mask_rle) {
+  CheckData check_data;
+
+  // Two boxes of one image and the masks of 20x30
+  std::vector<float> boxes = {0, 0.9, 2, 3, 17, 15, 1, 0.8, 10, 0, 30, 20};
+  std::vector<int32_t> num_boxes = {2};
+  std::vector<int32_t> masks(2 * 20 * 30);
+  for (size_t i = 0; i < masks.size(); ++i) {
+    masks[i] = (i * 7 + i / 13) % 5 < 2 ? 1 : 0;
+  }
+  std::vector<FDTensor> tensors(3);
+  tensors[0].SetExternalData({2, 6}, FDDataType::FP32, boxes.data());
+  tensors[1].SetExternalData({1}, FDDataType::INT32, num_boxes.data());
+  tensors[2].SetExternalData({2, 20, 30}, FDDataType::INT32, masks.data());
+
+  vision::detection::PaddleDetPostprocessor postprocessor;
+  std::vector<vision::DetectionResult> dense_results;
+  ASSERT_TRUE(postprocessor.Run(tensors, &dense_results));
+  postprocessor.SetMaskRLE(true);
+  std::vector<vision::DetectionResult> rle_results;
+  ASSERT_TRUE(postprocessor.Run(tensors, &rle_results));
+
+  ASSERT_EQ(rle_results[0].masks.size(), 2u);
+  for (size_t i = 0; i < 2; ++i) {
+    const auto& dense_mask = dense_results[0].masks[i];
+    const auto& rle_mask = rle_results[0].masks[i];
+    ASSERT_FALSE(dense_mask.is_rle);
+    ASSERT_TRUE(rle_mask.is_rle);
+    ASSERT_TRUE(rle_mask.data.empty());
+    ASSERT_EQ(dense_mask.shape, rle_mask.shape);
+    std::vector<uint8_t> decoded(dense_mask.data.size());
+    rle_mask.DecodeTo(decoded.data());
+    check_data(decoded.data(), dense_mask.data.data(), decoded.size());
+  }
+  // The copy of the result keeps the RLE masks
+  vision::DetectionResult copied(rle_results[0]);
+  ASSERT_TRUE(copied.masks[1].is_rle);
+  ASSERT_EQ(copied.masks[1].rle, rle_results[0].masks[1].rle);
+}
+
+}  // namespace fastdeploy
@@ -0,0 +1,148 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+#include "fastdeploy/core/fd_tensor.h"
+#include "fastdeploy/vision/ocr/ppocr/utils/db_postprocess.h"
+#include "gtest_utils.h"
+#include "gtest/gtest.h"
+
+namespace fastdeploy {
+namespace vision {
+namespace ocr {
+
+static void FillRect(std::vector<float>* prob, int width, int x0, int y0,
+                     int x1, int y1, float value) {
+  for (int y = y0; y <= y1; ++y) {
+    for (int x = x0; x <= x1; ++x) {
+      (*prob)[y * width + x] = value;
+    }
+  }
+}
+
+TEST(fastdeploy, ocr_db_postprocess) {
+  int height = 100;
+  int width = 100;
+  std::vector<float> prob(height * width, 0.0f);
+  FillRect(&prob, width, 20, 30, 59, 44, 0.9f);
+  // Scored less than box_thresh
+  FillRect(&prob, width, 70, 70, 90, 80, 0.5f);
+  // Too small
+  FillRect(&prob, width, 5, 5, 6, 6, 0.9f);
+
+  CheckData check_data;
+  DBPostprocessParams params;
+  std::vector<std::array<int, 8>> boxes;
+  // The 39x14 rectangle of the pixel centers is expanded by 7.73 pixels
+  std::array<int, 8> expected = {12, 22, 67, 22, 67, 52, 12, 52};
+  for (bool slow_score : {true, false}) {
+    params.slow_score = slow_score;
+    DBPostprocess(prob.data(), height, width, params, {100, 100, 100, 100},
+                  &boxes);
+    ASSERT_EQ(boxes.size(), 1u);
+    check_data(boxes[0].data(), expected.data(), 8);
+  }
+
+  // The boxes are mapped to the original image
+  DBPostprocess(prob.data(), height, width, params, {200, 300, 100, 100},
+                &boxes);
+  ASSERT_EQ(boxes.size(), 1u);
+  expected = {24, 66, 134, 66, 134, 156, 24, 156};
+  check_data(boxes[0].data(), expected.data(), 8);
+
+  // The dilation merges the rectangles 1 pixel apart
+  std::fill(prob.begin(), prob.end(), 0.0f);
+  FillRect(&prob, width, 20, 30, 39, 44, 0.9f);
+  FillRect(&prob, width, 41, 30, 59, 44, 0.9f);
+  DBPostprocess(prob.data(), height, width, params, {100, 100, 100, 100},
+                &boxes);
+  ASSERT_EQ(boxes.size(), 2u);
+  params.use_dilation = true;
+  DBPostprocess(prob.data(), height, width, params, {100, 100, 100, 100},
+                &boxes);
+  ASSERT_EQ(boxes.size(), 1u);
+
+  // The probability is truncated to uint8 before compared with thresh * 255,
+  // 0.3019 * 255 = 76.98 is truncated to 76, which isn't greater than 76.5
+  params.use_dilation = false;
+  params.box_thresh = 0.1;
+  std::fill(prob.begin(), prob.end(), 0.0f);
+  FillRect(&prob, width, 20, 30, 59, 44, 0.3019f);
+  DBPostprocess(prob.data(), height, width, params, {100, 100, 100, 100},
+                &boxes);
+  ASSERT_EQ(boxes.size(), 0u);
+  FillRect(&prob, width, 20, 30, 59, 44, 0.3022f);
+  DBPostprocess(prob.data(), height, width, params, {100, 100, 100, 100},
+                &boxes);
+  ASSERT_EQ(boxes.size(), 1u);
+}
+
+TEST(fastdeploy, ocr_db_postprocess_regions) {
+  int height = 120;
+  int width = 160;
+  std::vector<float> prob(height * width, 0.0f);
+  // A U shape and the diagonally connected squares are single regions
+  FillRect(&prob, width, 10, 10, 19, 49, 0.9f);
+  FillRect(&prob, width, 40, 10, 49, 49, 0.9f);
+  FillRect(&prob, width, 10, 40, 49, 49, 0.9f);
+  FillRect(&prob, width, 60, 10, 69, 19, 0.9f);
+  FillRect(&prob, width, 70, 20, 79, 29, 0.9f);
+  // A rotated rectangle of 60x12 pixels at 30 degrees
+  double angle = std::acos(-1.0) / 6;
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      double u = (x - 110) * std::cos(angle) + (y - 80) * std::sin(angle);
+      double v = -(x - 110) * std::sin(angle) + (y - 80) * std::cos(angle);
+      if (std::abs(u) <= 30 && std::abs(v) <= 6) {
+        prob[y * width + x] = 0.8f;
+      }
+    }
+  }
+
+  DBPostprocessParams params;
+  std::vector<std::array<int, 8>> boxes;
+  DBPostprocess(prob.data(), height, width, params, {160, 120, 160, 120},
+                &boxes);
+  ASSERT_EQ(boxes.size(), 3u);
+  // The regions are ordered by their first pixels in raster order, the box of
+  // the U shape is the 39x39 square expanded by 14.6 pixels and clamped
+  std::array<int, 8> expected = {0, 0, 64, 0, 64, 64, 0, 64};
+  CheckData check_data;
+  check_data(boxes[0].data(), expected.data(), 8);
+  // The box of the rotated rectangle is rotated, its long side is expanded
+  // by about 2 * 6.92 pixels
+  const auto& box = boxes[2];
+  double long_side = std::hypot(box[2] - box[0], box[3] - box[1]);
+  double short_side = std::hypot(box[6] - box[0], box[7] - box[1]);
+  ASSERT_NEAR(long_side, 60 + 2 * 6.92, 2.0);
+  ASSERT_NEAR(short_side, 12 + 2 * 6.92, 2.0);
+  ASSERT_NEAR(std::atan2(box[3] - box[1], box[2] - box[0]), angle, 0.05);
+
+  // The regions processed in parallel are in the same order
+  TaskPool pool(4);
+  std::vector<std::array<int, 8>> parallel_boxes;
+  DBPostprocess(prob.data(), height, width, params, {160, 120, 160, 120},
+                &parallel_boxes, &pool);
+  ASSERT_EQ(parallel_boxes.size(), boxes.size());
+  for (size_t i = 0; i < boxes.size(); ++i) {
+    check_data(parallel_boxes[i].data(), boxes[i].data(), 8);
+  }
+}
+
+}  // namespace ocr
+}  // namespace vision
+}  // namespace fastdeploy
@@ -0,0 +1,139 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include "fastdeploy/vision.h"
+#include "gtest/gtest.h"
+#include "gtest_utils.h"
+
+namespace fastdeploy {
+
+static std::string WriteLabels(const std::string& path,
+                               const std::vector<std::string>& labels) {
+  std::ofstream fout(path);
+  for (const auto& label : labels) {
+    fout << label << "\n";
+  }
+  return path;
+}
+
+// The greedy CTC decoding of one sample as the former postprocessor
+static void ReferenceDecode(const float* probs, int seq_len, int num_classes,
+                            const std::vector<std::string>& label_list,
+                            std::string* text, float* score) {
+  *score = 0.0f;
+  int count = 0;
+  int last_index = 0;
+  for (int n = 0; n < seq_len; ++n) {
+    const float* row = probs + n * num_classes;
+    int index = std::max_element(row, row + num_classes) - row;
+    if (index > 0 && !(n > 0 && index == last_index)) {
+      *score += row[index];
+      count += 1;
+      *text += label_list[index];
+    }
+    last_index = index;
+  }
+  *score /= (count + 1e-6);
+  if (count == 0) {
+    *score = 0.0f;
+  }
+}
+
+TEST(fastdeploy, ocr_rec_ctc_greedy) {
+  // 36 labels with the blank and the space, so the AVX2 kernel is used
+  std::vector<std::string> labels;
+  for (int i = 0; i < 34; ++i) {
+    labels.push_back(std::string(1 + i % 3, 'a' + i % 26));
+  }
+  std::string label_path = WriteLabels("ocr_rec_labels_test.txt", labels);
+  vision::ocr::RecognizerPostprocessor postprocessor(label_path);
+  std::vector<std::string> label_list = labels;
+  label_list.insert(label_list.begin(), "#");
+  label_list.push_back(" ");
+
+  int batch = 6;
+  int seq_len = 25;
+  int num_classes = static_cast<int>(label_list.size());
+  std::mt19937 gen(5);
+  // Quantized values, so there are ties of the max probability, and the
+  // blank and repeated labels are frequent
+  std::uniform_int_distribution<int> dist(0, 10);
+  std::vector<float> probs(batch * seq_len * num_classes);
+  for (auto& prob : probs) {
+    prob = dist(gen) / 10.0f;
+  }
+  std::vector<FDTensor> tensors(1);
+  tensors[0].SetExternalData({batch, seq_len, num_classes}, FDDataType::FP32,
+                             probs.data());
+
+  std::vector<std::string> texts;
+  std::vector<float> scores;
+  ASSERT_TRUE(postprocessor.Run(tensors, &texts, &scores));
+  ASSERT_EQ(texts.size(), 6u);
+  for (int i = 0; i < batch; ++i) {
+    std::string text;
+    float score;
+    ReferenceDecode(probs.data() + i * seq_len * num_classes, seq_len,
+                    num_classes, label_list, &text, &score);
+    ASSERT_EQ(texts[i], text);
+    ASSERT_NEAR(scores[i], score, 1e-5f);
+  }
+
+  // The parallel decoding scatters the samples by the indices
+  postprocessor.SetThreadNum(4);
+  std::vector<int> indices = {3, 7, 1, 0, 6, 2, 5, 4};
+  std::vector<std::string> parallel_texts;
+  std::vector<float> parallel_scores;
+  ASSERT_TRUE(postprocessor.Run(tensors, &parallel_texts, &parallel_scores, 2,
+                                8, indices));
+  for (int i = 0; i < batch; ++i) {
+    ASSERT_EQ(parallel_texts[indices[i + 2]], texts[i]);
+    ASSERT_EQ(parallel_scores[indices[i + 2]], scores[i]);
+  }
+  std::remove(label_path.c_str());
+}
+
+TEST(fastdeploy, ocr_rec_ctc_beam_search) {
+  std::string label_path = WriteLabels("ocr_rec_labels_test.txt", {"a"});
+  vision::ocr::RecognizerPostprocessor postprocessor(label_path);
+  // The labels are blank, "a" and space. The most probable path is blank at
+  // both steps, but "a" is more probable than the empty text by summing its
+  // paths: a-, -a and aa
+  std::vector<float> probs = {0.6, 0.4, 0.0, 0.6, 0.4, 0.0};
+  std::vector<FDTensor> tensors(1);
+  tensors[0].SetExternalData({1, 2, 3}, FDDataType::FP32, probs.data());
+  std::vector<std::string> texts;
+  std::vector<float> scores;
+  ASSERT_TRUE(postprocessor.Run(tensors, &texts, &scores));
+  ASSERT_EQ(texts[0], "");
+  postprocessor.SetBeamSize(2);
+  ASSERT_TRUE(postprocessor.Run(tensors, &texts, &scores));
+  ASSERT_EQ(texts[0], "a");
+  ASSERT_NEAR(scores[0], 0.4f, 1e-5f);
+
+  // "aa" needs a blank between the labels
+  probs = {0.1, 0.9, 0.0, 0.8, 0.2, 0.0, 0.1, 0.9, 0.0};
+  tensors[0].SetExternalData({1, 3, 3}, FDDataType::FP32, probs.data());
+  ASSERT_TRUE(postprocessor.Run(tensors, &texts, &scores));
+  ASSERT_EQ(texts[0], "aa");
+  std::remove(label_path.c_str());
+}
+
+}  // namespace fastdeploy
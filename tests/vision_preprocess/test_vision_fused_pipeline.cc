@@ -0,0 +1,172 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <vector>
+#include "fastdeploy/vision.h"
+#include "fastdeploy/vision/common/processors/fused_pipeline.h"
+#include "glog/logging.h"
+#include "gtest/gtest.h"
+#include "gtest_utils.h"
+
+namespace fastdeploy {
+
+void RunProcessorChain(
+    const std::vector<std::shared_ptr<vision::Processor>>& processors,
+    vision::Mat* mat, FDTensor* tensor) {
+  for (size_t i = 0; i < processors.size(); ++i) {
+    ASSERT_TRUE((*(processors[i].get()))(mat, vision::ProcLib::OPENCV));
+  }
+  mat->ShareWithTensor(tensor);
+}
+
+void CheckFusedPipeline(
+    std::vector<std::shared_ptr<vision::Processor>> processors, int height,
+    int width, float atol) {
+  CheckShape check_shape;
+  CheckData check_data;
+
+  cv::Mat mat(height, width, CV_8UC3);
+  cv::randu(mat, cv::Scalar::all(0), cv::Scalar::all(255));
+
+  vision::FuseTransforms(&processors);
+  vision::FusedPipeline pipeline;
+  ASSERT_TRUE(pipeline.Compile(processors));
+
+  vision::Mat mat_chain(mat.clone());
+  FDTensor chain;
+  RunProcessorChain(processors, &mat_chain, &chain);
+
+  std::vector<vision::Mat> mats = {vision::Mat(mat)};
+  vision::FDMatBatch mat_batch(&mats);
+  FDTensor fused;
+  ASSERT_TRUE(pipeline.Run(&mat_batch, &fused));
+
+  std::vector<int64_t> shape = chain.shape;
+  shape.insert(shape.begin(), 1);
+  check_shape(shape, fused.shape);
+  check_data(reinterpret_cast<const float*>(chain.Data()),
+             reinterpret_cast<const float*>(fused.Data()), chain.Numel(),
+             atol);
+}
+
+TEST(fastdeploy, opencv_fused_pipeline_normalize) {
+  std::vector<std::shared_ptr<vision::Processor>> processors = {
+      std::make_shared<vision::BGR2RGB>(),
+      std::make_shared<vision::Normalize>(
+          std::vector<float>({0.485, 0.456, 0.406}),
+          std::vector<float>({0.229, 0.224, 0.225})),
+      std::make_shared<vision::HWC2CHW>()};
+  // Without resize the result is exactly the same
+  CheckFusedPipeline(processors, 61, 83, 1e-05);
+}
+
+TEST(fastdeploy, opencv_fused_pipeline_resize_nearest) {
+  std::vector<std::shared_ptr<vision::Processor>> processors = {
+      std::make_shared<vision::BGR2RGB>(),
+      std::make_shared<vision::Resize>(97, 53, -1.0, -1.0, 0),
+      std::make_shared<vision::Normalize>(
+          std::vector<float>({0.5, 0.5, 0.5}),
+          std::vector<float>({0.5, 0.5, 0.5})),
+      std::make_shared<vision::HWC2CHW>()};
+  CheckFusedPipeline(processors, 128, 160, 1e-05);
+}
+
+TEST(fastdeploy, opencv_fused_pipeline_resize_crop) {
+  std::vector<std::shared_ptr<vision::Processor>> processors = {
+      std::make_shared<vision::BGR2RGB>(),
+      std::make_shared<vision::ResizeByShort>(64, 1, false),
+      std::make_shared<vision::CenterCrop>(56, 56),
+      std::make_shared<vision::Normalize>(
+          std::vector<float>({0.485, 0.456, 0.406}),
+          std::vector<float>({0.229, 0.224, 0.225})),
+      std::make_shared<vision::HWC2CHW>()};
+  // The bilinear result isn't rounded to uint8, differs within 1 level
+  float atol = 1.0 / (255 * 0.224) + 1e-05;
+  CheckFusedPipeline(processors, 240, 320, atol);
+  CheckFusedPipeline(processors, 50, 40, atol);
+}
+
+TEST(fastdeploy, opencv_fused_pipeline_yuv) {
+  CheckShape check_shape;
+  CheckData check_data;
+
+  int height = 120;
+  int width = 160;
+  cv::Mat bgr(height, width, CV_8UC3);
+  cv::randu(bgr, cv::Scalar::all(0), cv::Scalar::all(255));
+  cv::Mat i420;
+  cv::cvtColor(bgr, i420, cv::COLOR_BGR2YUV_I420);
+  // NV12 shares the Y plane of I420, with the U and V planes interleaved
+  cv::Mat nv12 = i420.clone();
+  const uint8_t* u = i420.ptr<uint8_t>() + height * width;
+  const uint8_t* v = u + height * width / 4;
+  uint8_t* uv = nv12.ptr<uint8_t>() + height * width;
+  for (int i = 0; i < height * width / 4; ++i) {
+    uv[2 * i] = u[i];
+    uv[2 * i + 1] = v[i];
+  }
+
+  std::vector<std::shared_ptr<vision::Processor>> processors = {
+      std::make_shared<vision::BGR2RGB>(),
+      std::make_shared<vision::ResizeByShort>(64, 1, false),
+      std::make_shared<vision::CenterCrop>(56, 56),
+      std::make_shared<vision::Normalize>(
+          std::vector<float>({0.485, 0.456, 0.406}),
+          std::vector<float>({0.229, 0.224, 0.225})),
+      std::make_shared<vision::HWC2CHW>()};
+  vision::FuseTransforms(&processors);
+  vision::FusedPipeline pipeline;
+  ASSERT_TRUE(pipeline.Compile(processors));
+  float atol = 1.0 / (255 * 0.224) + 1e-05;
+
+  std::vector<std::pair<vision::YuvFormat, cv::Mat*>> frames = {
+      {vision::YuvFormat::I420, &i420}, {vision::YuvFormat::NV12, &nv12}};
+  for (auto& frame : frames) {
+    // The processors convert the frame to BGR implicitly
+    vision::Mat mat_chain = vision::Mat::CreateFromYuv(
+        height, width, frame.first, frame.second->ptr<uint8_t>());
+    ASSERT_EQ(mat_chain.Channels(), 3);
+    FDTensor chain;
+    RunProcessorChain(processors, &mat_chain, &chain);
+
+    std::vector<vision::Mat> mats = {vision::Mat::CreateFromYuv(
+        height, width, frame.first, frame.second->ptr<uint8_t>())};
+    vision::FDMatBatch mat_batch(&mats);
+    FDTensor fused;
+    ASSERT_TRUE(pipeline.Run(&mat_batch, &fused));
+    // The frame is read in place by the pipeline
+    ASSERT_EQ(mats[0].yuv_format, frame.first);
+
+    std::vector<int64_t> shape = chain.shape;
+    shape.insert(shape.begin(), 1);
+    check_shape(shape, fused.shape);
+    check_data(reinterpret_cast<const float*>(chain.Data()),
+               reinterpret_cast<const float*>(fused.Data()), chain.Numel(),
+               atol);
+  }
+}
+
+TEST(fastdeploy, opencv_fused_pipeline_unsupported) {
+  std::vector<std::shared_ptr<vision::Processor>> processors = {
+      std::make_shared<vision::Resize>(64, 64),
+      std::make_shared<vision::StridePad>(32, std::vector<float>(3, 0)),
+      std::make_shared<vision::NormalizeAndPermute>(
+          std::vector<float>({0.5, 0.5, 0.5}),
+          std::vector<float>({0.5, 0.5, 0.5}))};
+  vision::FusedPipeline pipeline;
+  ASSERT_FALSE(pipeline.Compile(processors));
+}
+
+}  // namespace fastdeploy
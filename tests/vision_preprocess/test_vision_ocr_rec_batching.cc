@@ -0,0 +1,47 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+#include "fastdeploy/vision.h"
+#include "gtest/gtest.h"
+#include "gtest_utils.h"
+
+namespace fastdeploy {
+
+TEST(fastdeploy, ocr_rec_width_buckets) {
+  CheckShape check_shape;
+  // Crops of 2 images, the recognizer input is 320x48
+  std::vector<float> wh_ratios = {3.0f, 30.0f, 8.0f, 2.0f, 7.5f, 28.0f, 9.0f};
+  float min_wh_ratio = 320.0f / 48.0f;
+
+  // Without limit of padding, only the batch size splits the sorted crops
+  auto buckets = vision::ocr::BucketByWidth(wh_ratios, min_wh_ratio, 3, 1.0f);
+  ASSERT_EQ(buckets.size(), 3u);
+  check_shape(buckets[0], std::vector<int>({3, 0, 4}));
+  check_shape(buckets[1], std::vector<int>({2, 6, 5}));
+  check_shape(buckets[2], std::vector<int>({1}));
+
+  // The long lines are not batched with the short ones
+  buckets = vision::ocr::BucketByWidth(wh_ratios, min_wh_ratio, -1, 0.2f);
+  ASSERT_EQ(buckets.size(), 2u);
+  check_shape(buckets[0], std::vector<int>({3, 0, 4, 2, 6}));
+  check_shape(buckets[1], std::vector<int>({5, 1}));
+
+  // No padding but the one of the crops narrower than the input
+  buckets = vision::ocr::BucketByWidth(wh_ratios, min_wh_ratio, -1, 0.0f);
+  ASSERT_EQ(buckets.size(), 6u);
+  check_shape(buckets[0], std::vector<int>({3, 0}));
+}
+
+}  // namespace fastdeploy
@@ -0,0 +1,77 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <vector>
+#include "fastdeploy/vision.h"
+#include "gtest/gtest.h"
+#include "gtest_utils.h"
+
+namespace fastdeploy {
+
+TEST(fastdeploy, ocr_rotate_crop_to_rec_input) {
+  // A smooth image, so the warp and resize in one interpolation is close to
+  // the one in two interpolations
+  cv::Mat image(200, 300, CV_8UC3);
+  for (int y = 0; y < image.rows; ++y) {
+    for (int x = 0; x < image.cols; ++x) {
+      image.at<cv::Vec3b>(y, x) = cv::Vec3b(
+          cv::saturate_cast<uchar>(120 + 100 * std::sin(x / 7.0)),
+          cv::saturate_cast<uchar>(120 + 100 * std::cos(y / 5.0)),
+          cv::saturate_cast<uchar>((x + y) / 2));
+    }
+  }
+  // A rotated line, and a vertical one which is rotated to horizontal
+  std::vector<std::array<int, 8>> boxes = {
+      {20, 30, 150, 40, 148, 70, 18, 60},
+      {100, 20, 130, 22, 125, 160, 95, 158}};
+  std::vector<bool> flips = {false, true};
+
+  std::vector<cv::Mat> images;
+  std::vector<vision::ocr::RotateCrop> crops;
+  for (size_t i = 0; i < boxes.size(); ++i) {
+    cv::Mat crop_image = vision::ocr::GetRotateCropImage(image, boxes[i]);
+    vision::ocr::RotateCrop crop = vision::ocr::GetRotateCrop(image, boxes[i]);
+    ASSERT_EQ(crop.width, crop_image.cols);
+    ASSERT_EQ(crop.height, crop_image.rows);
+    if (flips[i]) {
+      cv::rotate(crop_image, crop_image, 1);
+      crop.Rotate180();
+    }
+    images.push_back(crop_image);
+    crops.push_back(crop);
+  }
+
+  vision::ocr::RecognizerPreprocessor preprocessor;
+  std::vector<FDMat> mats = vision::WrapMat(images);
+  std::vector<FDTensor> expected;
+  ASSERT_TRUE(preprocessor.Run(&mats, &expected, 0, 2, {1, 0}));
+  preprocessor.SetThreadNum(2);
+  std::vector<FDTensor> outputs;
+  ASSERT_TRUE(preprocessor.Run(crops, &outputs, 0, 2, {1, 0}));
+
+  CheckShape check_shape;
+  check_shape(outputs[0].shape, expected[0].shape);
+  const float* data = reinterpret_cast<const float*>(outputs[0].Data());
+  const float* expected_data =
+      reinterpret_cast<const float*>(expected[0].Data());
+  double diff = 0;
+  for (int i = 0; i < outputs[0].Numel(); ++i) {
+    diff += std::abs(data[i] - expected_data[i]);
+  }
+  // The values are normalized to [-1, 1]
+  ASSERT_LT(diff / outputs[0].Numel(), 0.02);
+}
+
+}  // namespace fastdeploy
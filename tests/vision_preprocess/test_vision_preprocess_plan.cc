@@ -0,0 +1,81 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include "fastdeploy/vision.h"
+#include "gtest/gtest.h"
+#include "gtest_utils.h"
+
+namespace fastdeploy {
+
+TEST(fastdeploy, preprocess_plan_shared) {
+  std::string config_file = "preprocess_plan_infer_cfg.yml";
+  {
+    std::ofstream fout(config_file);
+    fout << "PreProcess:\n"
+            "  transform_ops:\n"
+            "  - ResizeImage:\n"
+            "      resize_short: 64\n"
+            "  - CropImage:\n"
+            "      size: 56\n"
+            "  - NormalizeImage:\n"
+            "      mean: [0.485, 0.456, 0.406]\n"
+            "      std: [0.229, 0.224, 0.225]\n"
+            "      scale: 0.00392157\n"
+            "  - ToCHWImage: null\n";
+  }
+
+  vision::classification::PaddleClasPreprocessor preprocessor0(config_file);
+  vision::classification::PaddleClasPreprocessor preprocessor1(config_file);
+  auto plan = preprocessor0.GetPlan();
+  ASSERT_TRUE(plan != nullptr);
+  // The preprocessors of the same config share the plan
+  ASSERT_EQ(plan.get(), preprocessor1.GetPlan().get());
+  ASSERT_TRUE(plan->GetFusedPipeline() != nullptr);
+  // BGR2RGB is fused into NormalizeAndPermute
+  ASSERT_EQ(plan->Str(),
+            "ResizeByShort -> CenterCrop -> NormalizeAndPermute(fused)");
+  ASSERT_TRUE(preprocessor0.PrepareInputSize(320, 240));
+  ASSERT_FALSE(preprocessor0.PrepareInputSize(0, 240));
+
+  // The options build a different plan
+  preprocessor1.DisableNormalize();
+  ASSERT_NE(plan.get(), preprocessor1.GetPlan().get());
+  ASSERT_FALSE(preprocessor1.GetPlan()->HasProcessor("NormalizeAndPermute"));
+  ASSERT_EQ(plan.get(), preprocessor0.GetPlan().get());
+
+  // The cached plan preprocesses as the processors run one by one
+  cv::Mat im(240, 320, CV_8UC3);
+  cv::randu(im, cv::Scalar::all(0), cv::Scalar::all(255));
+  std::vector<vision::FDMat> images = {vision::WrapMat(im.clone())};
+  std::vector<FDTensor> outputs;
+  ASSERT_TRUE(preprocessor0.Run(&images, &outputs));
+  preprocessor0.EnableFusedPipeline();
+  images = {vision::WrapMat(im.clone())};
+  std::vector<FDTensor> fused_outputs;
+  ASSERT_TRUE(preprocessor0.Run(&images, &fused_outputs));
+
+  CheckShape check_shape;
+  CheckData check_data;
+  check_shape(outputs[0].shape, std::vector<int64_t>({1, 3, 56, 56}));
+  check_shape(outputs[0].shape, fused_outputs[0].shape);
+  check_data(reinterpret_cast<const float*>(outputs[0].Data()),
+             reinterpret_cast<const float*>(fused_outputs[0].Data()),
+             outputs[0].Numel(), 1.0f / (255 * 0.224f) + 1e-05f);
+  std::remove(config_file.c_str());
+}
+
+}  // namespace fastdeploy
@@ -0,0 +1,78 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <thread>
+#include <vector>
+#include "fastdeploy/vision/common/processors/proc_lib.h"
+#include "gtest/gtest.h"
+
+namespace fastdeploy {
+
+TEST(fastdeploy, proc_lib_scope) {
+  ASSERT_EQ(vision::ResolveProcLib("Resize"),
+            vision::DefaultProcLib::default_lib);
+
+  vision::ProcLibConfig config;
+  config.lib = vision::ProcLib::FLYCV;
+  config.op_libs["Resize"] = vision::ProcLib::OPENCV;
+  {
+    vision::ProcLibScope scope(&config);
+    ASSERT_EQ(vision::ResolveProcLib("Resize"), vision::ProcLib::OPENCV);
+    ASSERT_EQ(vision::ResolveProcLib("Normalize"), vision::ProcLib::FLYCV);
+    // The lib requested by the caller has the highest priority
+    ASSERT_EQ(vision::ResolveProcLib("Normalize", vision::ProcLib::OPENCV),
+              vision::ProcLib::OPENCV);
+
+    // The other threads are not affected
+    vision::ProcLib other_lib = vision::ProcLib::FLYCV;
+    std::thread thread(
+        [&other_lib]() { other_lib = vision::ResolveProcLib("Normalize"); });
+    thread.join();
+    ASSERT_EQ(other_lib, vision::DefaultProcLib::default_lib);
+  }
+  ASSERT_EQ(vision::ResolveProcLib("Normalize"),
+            vision::DefaultProcLib::default_lib);
+}
+
+TEST(fastdeploy, proc_lib_choose_by_cost) {
+  std::vector<std::string> ops({"BGR2RGB", "Resize", "NormalizeAndPermute"});
+
+  // Only OpenCV is available
+  auto op_libs = vision::ChooseProcLibsByCost(ops, {});
+  for (const auto& op : ops) {
+    ASSERT_EQ(op_libs[op], vision::ProcLib::OPENCV);
+  }
+
+  // The GPU stages are contiguous to save the transfers, BGR2RGB has no
+  // CV-CUDA implementation so it stays on CPU
+  op_libs = vision::ChooseProcLibsByCost(ops, {vision::ProcLib::CVCUDA});
+  ASSERT_EQ(op_libs["BGR2RGB"], vision::ProcLib::OPENCV);
+  ASSERT_EQ(op_libs["Resize"], vision::ProcLib::CVCUDA);
+  ASSERT_EQ(op_libs["NormalizeAndPermute"], vision::ProcLib::CVCUDA);
+
+  // A single cheap GPU op between CPU ops is not worth the transfers
+  op_libs = vision::ChooseProcLibsByCost({"Pad", "CenterCrop", "HWC2CHW"},
+                                         {vision::ProcLib::CVCUDA});
+  ASSERT_EQ(op_libs["CenterCrop"], vision::ProcLib::OPENCV);
+
+  // The SIMD kernels stay on CPU, so they're chosen per op without transfers
+  op_libs = vision::ChooseProcLibsByCost(
+      {"Resize", "BGR2RGB", "Normalize", "HWC2CHW"}, {vision::ProcLib::SIMD});
+  ASSERT_EQ(op_libs["Resize"], vision::ProcLib::SIMD);
+  ASSERT_EQ(op_libs["BGR2RGB"], vision::ProcLib::OPENCV);
+  ASSERT_EQ(op_libs["Normalize"], vision::ProcLib::SIMD);
+  ASSERT_EQ(op_libs["HWC2CHW"], vision::ProcLib::SIMD);
+}
+
+}  // namespace fastdeploy
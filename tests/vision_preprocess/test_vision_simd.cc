@@ -0,0 +1,184 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <vector>
+#include "fastdeploy/vision.h"
+#include "fastdeploy/vision/common/processors/simd_kernels.h"
+#include "gtest/gtest.h"
+#include "gtest_utils.h"
+
+namespace fastdeploy {
+
+TEST(fastdeploy, simd_processors) {
+  CheckShape check_shape;
+  CheckData check_data;
+  CheckType check_type;
+
+  cv::Mat im(61, 83, CV_8UC3);
+  cv::randu(im, cv::Scalar::all(0), cv::Scalar::all(255));
+  vision::FDMat mat = vision::WrapMat(im.clone());
+  vision::FDMat expected_mat = vision::WrapMat(im.clone());
+  // The SIMD processors write to the caches of the mat
+  FDTensor input_cache;
+  FDTensor output_cache;
+  mat.input_cache = &input_cache;
+  mat.output_cache = &output_cache;
+
+  std::vector<float> mean({0.25, 0.35, 0.45});
+  std::vector<float> std({0.33, 0.22, 0.54});
+  std::vector<std::shared_ptr<vision::Processor>> processors;
+  processors.push_back(std::make_shared<vision::ResizeByShort>(48));
+  processors.push_back(std::make_shared<vision::Resize>(50, 40));
+  processors.push_back(std::make_shared<vision::CenterCrop>(32, 30));
+  processors.push_back(std::make_shared<vision::Pad>(
+      1, 2, 3, 4, std::vector<float>({10.0, 20.0, 300.0})));
+  processors.push_back(std::make_shared<vision::Cast>("float"));
+  processors.push_back(std::make_shared<vision::Normalize>(mean, std));
+  processors.push_back(std::make_shared<vision::HWC2CHW>());
+  for (auto& processor : processors) {
+    ASSERT_TRUE((*processor)(&mat, vision::ProcLib::SIMD));
+    ASSERT_TRUE((*processor)(&expected_mat, vision::ProcLib::OPENCV));
+    ASSERT_EQ(mat.mat_type, vision::ProcLib::SIMD);
+    ASSERT_EQ(mat.Height(), expected_mat.Height());
+    ASSERT_EQ(mat.Width(), expected_mat.Width());
+    ASSERT_EQ(mat.Channels(), expected_mat.Channels());
+    check_type(mat.Type(), expected_mat.Type());
+    int num = mat.Height() * mat.Width() * mat.Channels();
+    // The bilinear resize may differ from OpenCV by 1 level of the uint8
+    // pixel value
+    if (mat.Type() == FDDataType::UINT8) {
+      check_data(reinterpret_cast<const uint8_t*>(mat.Data()),
+                 reinterpret_cast<const uint8_t*>(expected_mat.Data()), num, 1);
+    } else {
+      check_data(reinterpret_cast<const float*>(mat.Data()),
+                 reinterpret_cast<const float*>(expected_mat.Data()), num,
+                 0.02f);
+    }
+  }
+  ASSERT_EQ(mat.layout, vision::Layout::CHW);
+  check_shape(mat.Tensor()->shape, std::vector<int64_t>({3, 33, 39}));
+
+  // The mat can be processed by OpenCV afterwards
+  cv::Mat* cv_mat = mat.GetOpenCVMat();
+  ASSERT_EQ(mat.mat_type, vision::ProcLib::OPENCV);
+  ASSERT_EQ(cv_mat->rows, 33);
+  ASSERT_EQ(cv_mat->cols, 39);
+}
+
+TEST(fastdeploy, simd_resize_engine) {
+  CheckData check_data;
+
+  cv::Mat im(61, 83, CV_8UC3);
+  cv::randu(im, cv::Scalar::all(0), cv::Scalar::all(255));
+  // Nearest, bilinear and area(downscale and upscale) as cv::resize
+  std::vector<std::array<int, 3>> cases = {
+      {0, 40, 50}, {1, 130, 170}, {3, 20, 41}, {3, 122, 166}};
+  for (auto& c : cases) {
+    int interp = c[0];
+    int height = c[1];
+    int width = c[2];
+    for (int frame = 0; frame < 2; ++frame) {
+      vision::FDMat mat = vision::WrapMat(im.clone());
+      FDTensor input_cache;
+      FDTensor output_cache;
+      mat.input_cache = &input_cache;
+      mat.output_cache = &output_cache;
+      vision::Resize resize(width, height, -1.0, -1.0, interp);
+      ASSERT_TRUE(resize(&mat, vision::ProcLib::SIMD));
+      ASSERT_EQ(mat.mat_type, vision::ProcLib::SIMD);
+      cv::Mat expected;
+      cv::resize(im, expected, cv::Size(width, height), 0, 0, interp);
+      check_data(reinterpret_cast<const uint8_t*>(mat.Data()),
+                 expected.ptr<uint8_t>(), height * width * 3,
+                 interp == 0 ? 0 : 1);
+    }
+  }
+
+  // The tables of the same resize are computed once and shared
+  auto tables = vision::simd::GetResizeTables(61, 83, 3, 61.0 / 40,
+                                              83.0 / 50, 40, 50, 1);
+  ASSERT_EQ(tables.get(), vision::simd::GetResizeTables(61, 83, 3, 61.0 / 40,
+                                                        83.0 / 50, 40, 50, 1)
+                              .get());
+  ASSERT_GT(vision::simd::NumCachedResizeTables(), 0u);
+}
+
+TEST(fastdeploy, simd_resize_crop_resize) {
+  CheckData check_data;
+
+  cv::Mat im(61, 83, CV_8UC3);
+  cv::randu(im, cv::Scalar::all(0), cv::Scalar::all(255));
+  vision::FDMat mat = vision::WrapMat(im.clone());
+  FDTensor input_cache;
+  FDTensor output_cache;
+  mat.input_cache = &input_cache;
+  mat.output_cache = &output_cache;
+  ASSERT_TRUE(vision::Resize::Run(&mat, 80, 60, -1.0, -1.0, 1, false,
+                                  vision::ProcLib::SIMD));
+  ASSERT_EQ(mat.mat_type, vision::ProcLib::SIMD);
+  cv::Mat expected;
+  cv::resize(im, expected, cv::Size(80, 60), 0, 0, 1);
+  check_data(reinterpret_cast<const uint8_t*>(mat.Data()),
+             expected.ptr<uint8_t>(), 60 * 80 * 3, 1);
+
+  // Crop the rows without a copy, the data of the mat is a ROI inside the
+  // cache the resize has written to
+  cv::Mat resized = mat.GetOpenCVMat()->clone();
+  cv::Rect roi(0, 10, 80, 40);
+  mat.SetMat((*mat.GetOpenCVMat())(roi));
+  mat.SetHeight(40);
+  ASSERT_NE(mat.Data(), output_cache.Data());
+  ASSERT_TRUE(vision::Resize::Run(&mat, 40, 30, -1.0, -1.0, 1, false,
+                                  vision::ProcLib::SIMD));
+  ASSERT_EQ(mat.mat_type, vision::ProcLib::SIMD);
+  cv::resize(resized(roi), expected, cv::Size(40, 30), 0, 0, 1);
+  check_data(reinterpret_cast<const uint8_t*>(mat.Data()),
+             expected.ptr<uint8_t>(), 30 * 40 * 3, 1);
+}
+
+TEST(fastdeploy, simd_warp_affine) {
+  CheckData check_data;
+
+  // A smooth image, so the sub-pixel positions quantized by OpenCV only
+  // change the result slightly
+  cv::Mat im(40, 50, CV_8UC3);
+  for (int y = 0; y < im.rows; ++y) {
+    for (int x = 0; x < im.cols; ++x) {
+      im.at<cv::Vec3b>(y, x) = cv::Vec3b(x * 4, y * 5, (x + y) * 2);
+    }
+  }
+  vision::FDMat mat = vision::WrapMat(im.clone());
+  vision::FDMat expected_mat = vision::WrapMat(im.clone());
+  FDTensor input_cache;
+  FDTensor output_cache;
+  mat.input_cache = &input_cache;
+  mat.output_cache = &output_cache;
+
+  cv::Mat trans_matrix =
+      cv::getRotationMatrix2D(cv::Point2f(25.0f, 20.0f), 30.0, 0.8);
+  vision::WarpAffine warp_affine(trans_matrix, 45, 35, cv::INTER_LINEAR,
+                                 cv::BORDER_CONSTANT,
+                                 cv::Scalar(127, 127, 127));
+  ASSERT_TRUE(warp_affine(&mat, vision::ProcLib::SIMD));
+  ASSERT_TRUE(warp_affine(&expected_mat, vision::ProcLib::OPENCV));
+  ASSERT_EQ(mat.mat_type, vision::ProcLib::SIMD);
+  ASSERT_EQ(mat.Height(), 35);
+  ASSERT_EQ(mat.Width(), 45);
+  check_data(reinterpret_cast<const uint8_t*>(mat.Data()),
+             reinterpret_cast<const uint8_t*>(expected_mat.Data()),
+             35 * 45 * 3, 2);
+}
+
+}  // namespace fastdeploy
@@ -0,0 +1,74 @@
+// Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+#include "fastdeploy/vision.h"
+#include "gtest/gtest.h"
+#include "gtest_utils.h"
+
+namespace fastdeploy {
+
+TEST(fastdeploy, opencv_write_to_batch) {
+  CheckShape check_shape;
+  CheckData check_data;
+
+  std::vector<float> mean({0.25, 0.35, 0.45});
+  std::vector<float> std({0.33, 0.22, 0.54});
+  vision::NormalizeAndPermute normalize_permute(mean, std);
+
+  // 2 images of different sizes are padded to 48x64
+  std::vector<cv::Mat> ims;
+  ims.emplace_back(48, 64, CV_8UC3);
+  ims.emplace_back(32, 40, CV_8UC3);
+  std::vector<vision::FDMat> mats;
+  std::vector<vision::FDMat> expected_mats;
+  for (auto& im : ims) {
+    cv::randu(im, cv::Scalar::all(0), cv::Scalar::all(255));
+    mats.push_back(vision::WrapMat(im));
+    expected_mats.push_back(vision::WrapMat(im.clone()));
+  }
+  std::vector<float> pad_values({-1.0, -2.0, -3.0});
+  vision::FDMatBatch mat_batch(&mats);
+  FDTensor output;
+  ASSERT_TRUE(vision::WriteToBatchTensor(&normalize_permute, &mat_batch, 48,
+                                         64, pad_values, &output));
+  check_shape(output.shape, std::vector<int64_t>({2, 3, 48, 64}));
+
+  const float* data = reinterpret_cast<const float*>(output.Data());
+  for (size_t i = 0; i < expected_mats.size(); ++i) {
+    ASSERT_TRUE(normalize_permute(&expected_mats[i], vision::ProcLib::OPENCV));
+    int h = expected_mats[i].Height();
+    int w = expected_mats[i].Width();
+    const float* expected =
+        reinterpret_cast<const float*>(expected_mats[i].Data());
+    for (int c = 0; c < 3; ++c) {
+      const float* plane = data + (i * 3 + c) * 48 * 64;
+      for (int y = 0; y < 48; ++y) {
+        if (y < h) {
+          check_data(plane + y * 64, expected + (c * h + y) * w, w);
+        }
+        for (int x = (y < h ? w : 0); x < 64; ++x) {
+          ASSERT_EQ(plane[y * 64 + x], pad_values[c]);
+        }
+      }
+    }
+  }
+
+  // The uint8 images can't be written by HWC2CHW, the caller falls back
+  vision::HWC2CHW hwc2chw;
+  ASSERT_FALSE(vision::WriteToBatchTensor(&hwc2chw, &mat_batch, 48, 64,
+                                          pad_values, &output));
+}
+
+}  // namespace fastdeploy